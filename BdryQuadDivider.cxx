@@ -25,9 +25,6 @@
 
 #include "BdryQuadDivider.h"
 
-void BdryQuadDivider::divideInterior() {
-}
-
 void BdryQuadDivider::createNewCells() {
 	// Okay, sure, these aren't actually cells in the usual sense, but so what?
 	for (int jj = 0; jj <= nDivs - 1; jj++) {
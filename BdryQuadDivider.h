@@ -27,12 +27,10 @@
 #define SRC_BDRYQUADDIVIDER_H_
 
 #include "CellDivider.h"
-#include "Mapping.h"
 
 class BdryQuadDivider: public CellDivider {
 public:
-	BdryQuadDivider(UMesh *pInitMesh, const int segmentsPerEdge,
-			const Mapping::MappingType type = Mapping::Uniform) :
+	BdryQuadDivider(UMesh *pInitMesh, const int segmentsPerEdge) :
 			CellDivider(pInitMesh, segmentsPerEdge) {
 		vertIJK[0][0] = 0;
 		vertIJK[0][1] = 0;
@@ -91,18 +89,15 @@ public:
 		faceEdgeIndices[0][1] = 1;
 		faceEdgeIndices[0][2] = 2;
 		faceEdgeIndices[0][3] = 3;
-
-		if (type == Mapping::Lagrange) {
-			m_Map = new LagrangeCubicQuadMapping(pInitMesh);
-		}
-		else {
-			m_Map = new Q1QuadMapping(pInitMesh);
-		}
 	}
 	~BdryQuadDivider() {
 	}
-	void divideInterior();
 	void createNewCells();
+	void createDivisionVerts(exa_map<Edge, EdgeVerts> &vertsOnEdges,
+			exa_set<TriFaceVerts> &vertsOnTris,
+			exa_set<QuadFaceVerts> &vertsOnQuads) {
+		divideEdgesAndFaces(NoMapping(), vertsOnEdges, vertsOnTris, vertsOnQuads);
+	}
 
 	// TODO: Currently, there's no coord mapping set up for bdry faces
 	void setupCoordMapping(const emInt verts[]) {
@@ -111,8 +106,6 @@ public:
 		}
 
 	}
-	void getPhysCoordsFromParamCoords(const double /*uvw*/[], double /*xyz*/[]) {
-	}
 
 	// These definition ensure that we'll get no interior points for
 	// bdry quads.  The way things are set up, "interior" is "cell
@@ -25,9 +25,6 @@
 
 #include "BdryTriDivider.h"
 
-void BdryTriDivider::divideInterior() {
-}
-
 void BdryTriDivider::createNewCells() {
 	// Okay, sure, these aren't actually cells in the usual sense, but so what?
 	// Create topologically up-pointing triangles.
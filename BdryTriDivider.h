@@ -79,8 +79,12 @@ public:
 	}
 	~BdryTriDivider() {
 	}
-	void divideInterior();
 	void createNewCells();
+	void createDivisionVerts(exa_map<Edge, EdgeVerts> &vertsOnEdges,
+			exa_set<TriFaceVerts> &vertsOnTris,
+			exa_set<QuadFaceVerts> &vertsOnQuads) {
+		divideEdgesAndFaces(NoMapping(), vertsOnEdges, vertsOnTris, vertsOnQuads);
+	}
 
 	// TODO: Currently, there's no coord mapping set up for bdry faces
 	void setupCoordMapping(const emInt verts[]) {
@@ -89,8 +93,6 @@ public:
 		}
 
 	}
-	void getPhysCoordsFromParamCoords(const double /*uvw*/[], double /*xyz*/[]) {
-	}
 
 	// These definition ensure that we'll get no interior points for
 	// bdry tris.  The way things are set up, "interior" is "cell
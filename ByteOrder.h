@@ -0,0 +1,92 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * ByteOrder.h
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#ifndef SRC_BYTEORDER_H_
+#define SRC_BYTEORDER_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+inline bool hostIsBigEndian() {
+	return __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+}
+
+// Reverse the bytes of each of nWords words of WordBytes bytes (4 or 8), in
+// place.  Whole vector registers are shuffled at once where the instruction
+// set has a byte shuffle; anything left over is done a word at a time.
+template<int WordBytes>
+inline void swapByteOrder(void* data, const size_t nWords) {
+	static_assert(WordBytes == 4 || WordBytes == 8, "Words must be 4 or 8 bytes");
+	char* bytes = static_cast<char*>(data);
+	size_t ii = 0;
+#if defined(__AVX2__)
+	const __m256i shuffle256 =
+			(WordBytes == 4) ?
+					_mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13,
+														12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15,
+														14, 13, 12) :
+					_mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9,
+														8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11,
+														10, 9, 8);
+	for (; ii + 32 / WordBytes <= nWords; ii += 32 / WordBytes) {
+		__m256i* block = reinterpret_cast<__m256i*>(bytes + ii * WordBytes);
+		_mm256_storeu_si256(block,
+												_mm256_shuffle_epi8(_mm256_loadu_si256(block),
+																						shuffle256));
+	}
+#endif
+#if defined(__SSSE3__)
+	const __m128i shuffle128 =
+			(WordBytes == 4) ?
+					_mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+					_mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+	for (; ii + 16 / WordBytes <= nWords; ii += 16 / WordBytes) {
+		__m128i* block = reinterpret_cast<__m128i*>(bytes + ii * WordBytes);
+		_mm_storeu_si128(block,
+											_mm_shuffle_epi8(_mm_loadu_si128(block), shuffle128));
+	}
+#endif
+	for (; ii < nWords; ii++) {
+		char* word = bytes + ii * WordBytes;
+		if (WordBytes == 4) {
+			uint32_t value;
+			memcpy(&value, word, 4);
+			value = __builtin_bswap32(value);
+			memcpy(word, &value, 4);
+		}
+		else {
+			uint64_t value;
+			memcpy(&value, word, 8);
+			value = __builtin_bswap64(value);
+			memcpy(word, &value, 8);
+		}
+	}
+}
+
+#endif /* SRC_BYTEORDER_H_ */
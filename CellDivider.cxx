@@ -397,8 +397,10 @@ void CellDivider::getEdgeParametricDivision(EdgeVerts &EV) const {
 	EV.m_param_t[nDivs] = 1;
 }
 
-void CellDivider::getEdgeVerts(exa_map<Edge, EdgeVerts> &vertsOnEdges,
-		const int edge, const double dihedral, EdgeVerts &EV) {
+template<typename MapT>
+void CellDivider::getEdgeVerts(const MapT& map,
+		exa_map<Edge, EdgeVerts> &vertsOnEdges, const int edge,
+		const double dihedral, EdgeVerts &EV) {
 	int ind0 = edgeVertIndices[edge][0];
 	int ind1 = edgeVertIndices[edge][1];
 
@@ -407,7 +409,12 @@ void CellDivider::getEdgeVerts(exa_map<Edge, EdgeVerts> &vertsOnEdges,
 //	printf("Edge: %5d %5d ", vert0, vert1);
 
 	Edge E(vert0, vert1);
-	auto iterEdges = vertsOnEdges.find(E);
+	instrumentCount(eCountEdgeLookups);
+	exa_map<Edge, EdgeVerts>::iterator iterEdges;
+	{
+		ScopedTimer ST(eTimeHashLookup);
+		iterEdges = vertsOnEdges.find(E);
+	}
 
 	if (iterEdges == vertsOnEdges.end()) {
 //		printf("new\n");
@@ -447,12 +454,14 @@ void CellDivider::getEdgeVerts(exa_map<Edge, EdgeVerts> &vertsOnEdges,
 					uvwStart[1] + EV.m_param_t[ii] * delta[1], uvwStart[2]
 							+ EV.m_param_t[ii] * delta[2] };
 			double newCoords[3];
-			getPhysCoordsFromParamCoords(uvw, newCoords);
+			mapToPhysCoords(map, uvw, newCoords);
 			EV.m_verts[ii] = m_pMesh->addVert(newCoords);
 //			printf("%3d %5f (%5f %5f %5f) (%8f %8f %8f)\n",
 //					ii, EV.m_param_t[ii], uvw[0], uvw[1], uvw[2],
 //					newCoords[0], newCoords[1], newCoords[2]);
 		}
+		instrumentCount(eCountEdgeInserts);
+		ScopedTimer ST(eTimeHashInsert);
 		vertsOnEdges.insert(std::make_pair(E, EV));
 	} else {
 //		printf("old\n");
@@ -582,8 +591,9 @@ void CellDivider::initPerimeterParams(TriFaceVerts &TFV, const int face) const {
 	}
 }
 
-TriFaceVerts CellDivider::getTriVerts(
-exa_set<TriFaceVerts> &vertsOnTris, const int face) {
+template<typename MapT>
+TriFaceVerts CellDivider::getTriVerts(const MapT& map,
+		exa_set<TriFaceVerts> &vertsOnTris, const int face) {
 	int ind0 = faceVertIndices[face][0];
 	int ind1 = faceVertIndices[face][1];
 	int ind2 = faceVertIndices[face][2];
@@ -606,7 +616,12 @@ exa_set<TriFaceVerts> &vertsOnTris, const int face) {
 
 	// Find the existing iterator if the face has already been operated
 	// on once.
-	auto iterTris = vertsOnTris.find(TFV);
+	instrumentCount(eCountTriLookups);
+	exa_set<TriFaceVerts>::iterator iterTris;
+	{
+		ScopedTimer ST(eTimeHashLookup);
+		iterTris = vertsOnTris.find(TFV);
+	}
 	bool newFace = (iterTris == vertsOnTris.end());
 	int rotCase = 0;
 	if (!newFace) {
@@ -646,13 +661,15 @@ exa_set<TriFaceVerts> &vertsOnTris, const int face) {
 			TFV.setVertUVWParams(ii, jj, uvw);
 			if (newFace) {
 				double newCoords[3];
-				getPhysCoordsFromParamCoords(uvw, newCoords);
+				mapToPhysCoords(map, uvw, newCoords);
 				vert = m_pMesh->addVert(newCoords);
 			}
 			TFV.setIntVertInd(ii, jj, vert);
 		}
 	} // Done looping over all interior verts for the triangle.
 	if (newFace) {
+		instrumentCount(eCountTriInserts);
+		ScopedTimer ST(eTimeHashInsert);
 		vertsOnTris.insert(TFV);
 	} else {
 		vertsOnTris.erase(iterTris); // Will never need this again.
@@ -766,8 +783,9 @@ void CellDivider::initPerimeterParams(QuadFaceVerts &QFV,
 	}
 }
 
-QuadFaceVerts CellDivider::getQuadVerts(exa_set<QuadFaceVerts> &vertsOnQuads,
-		const int face) {
+template<typename MapT>
+QuadFaceVerts CellDivider::getQuadVerts(const MapT& map,
+		exa_set<QuadFaceVerts> &vertsOnQuads, const int face) {
 	int ind0 = faceVertIndices[face][0];
 	int ind1 = faceVertIndices[face][1];
 	int ind2 = faceVertIndices[face][2];
@@ -799,7 +817,12 @@ QuadFaceVerts CellDivider::getQuadVerts(exa_set<QuadFaceVerts> &vertsOnQuads,
 	QuadFaceVerts QFV(nDivs, vert0, vert1, vert2, vert3);
 	initPerimeterParams(QFV, face);
 
-	auto iterQuads = vertsOnQuads.find(QFV);
+	instrumentCount(eCountQuadLookups);
+	exa_set<QuadFaceVerts>::iterator iterQuads;
+	{
+		ScopedTimer ST(eTimeHashLookup);
+		iterQuads = vertsOnQuads.find(QFV);
+	}
 
 	bool newFace = (iterQuads == vertsOnQuads.end());
 	int rotCase = 0;
@@ -844,13 +867,15 @@ QuadFaceVerts CellDivider::getQuadVerts(exa_set<QuadFaceVerts> &vertsOnQuads,
 			QFV.setVertUVWParams(ii, jj, uvw);
 			if (newFace) {
 				double newCoords[3];
-				getPhysCoordsFromParamCoords(uvw, newCoords);
+				mapToPhysCoords(map, uvw, newCoords);
 				vert = m_pMesh->addVert(newCoords);
 			}
 			QFV.setIntVertInd(ii, jj, vert);
 		}
 	} // Done looping over all interior verts for the quad.
 	if (newFace) {
+		instrumentCount(eCountQuadInserts);
+		ScopedTimer ST(eTimeHashInsert);
 		vertsOnQuads.insert(QFV);
 	} else {
 		vertsOnQuads.erase(iterQuads); // Will never need this again.
@@ -858,14 +883,16 @@ QuadFaceVerts CellDivider::getQuadVerts(exa_set<QuadFaceVerts> &vertsOnQuads,
 	return QFV;
 }
 
-void CellDivider::divideEdges(exa_map<Edge, EdgeVerts> &vertsOnEdges) {
+template<typename MapT>
+void CellDivider::divideEdges(const MapT& map,
+		exa_map<Edge, EdgeVerts> &vertsOnEdges) {
 // Divide all the edges, including storing info about which new verts
 // are on which edges
 	for (int iE = 0; iE < numEdges; iE++) {
 
 		EdgeVerts &EV = m_EV[iE];
 		double dihedral = 0;
-		getEdgeVerts(vertsOnEdges, iE, dihedral, EV);
+		getEdgeVerts(map, vertsOnEdges, iE, dihedral, EV);
 
 		// Now transcribe these into the master table for this cell.
 		emInt startIndex = 1000, endIndex = 1000;
@@ -911,14 +938,15 @@ void CellDivider::divideEdges(exa_map<Edge, EdgeVerts> &vertsOnEdges) {
 	}
 }
 
-void CellDivider::divideFaces(exa_set<TriFaceVerts> &vertsOnTris,
-exa_set<QuadFaceVerts> &vertsOnQuads) {
+template<typename MapT>
+void CellDivider::divideFaces(const MapT& map,
+		exa_set<TriFaceVerts> &vertsOnTris, exa_set<QuadFaceVerts> &vertsOnQuads) {
 // Divide all the faces, including storing info about which new verts
 // are on which faces
 
 // The quad faces are first.
 	for (int iF = 0; iF < numQuadFaces; iF++) {
-		QuadFaceVerts QFV = getQuadVerts(vertsOnQuads, iF);
+		QuadFaceVerts QFV = getQuadVerts(map, vertsOnQuads, iF);
 		// Now extract info from the QFV and stuff it into the cell's point
 		// array.
 
@@ -966,7 +994,7 @@ exa_set<QuadFaceVerts> &vertsOnQuads) {
 	}
 
 	for (int iF = numQuadFaces; iF < numQuadFaces + numTriFaces; iF++) {
-		TriFaceVerts TFV = getTriVerts(vertsOnTris, iF);
+		TriFaceVerts TFV = getTriVerts(map, vertsOnTris, iF);
 		// Now extract info from the TFV and stuff it into the cell's point
 		// array.
 
@@ -1041,7 +1069,8 @@ void CellDivider::computeParaCoords(const int ii, const int jj, const int kk,
 	assert(uvw[2] >= 0 && uvw[2] <= 1);
 }
 
-void CellDivider::divideInterior() {
+template<typename MapT>
+void CellDivider::divideInterior(const MapT& map) {
 // Number of verts added:
 //    Tets:      (nD-1)(nD-2)(nD-3)/2
 //    Pyrs:      (nD-1)(nD-2)(2 nD-3)/6
@@ -1054,27 +1083,33 @@ void CellDivider::divideInterior() {
 		for (int jj = 1; jj < jMax; jj++) {
 			int iMax = maxI(jj, kk);
 			for (int ii = 1; ii < iMax; ii++) {
-				double uvw[3];
-				// Now find uvw by finding the near-intersection point
-				// of the lines of constant i, j, k
-				computeParaCoords(ii, jj, kk, uvw);
-
-				double &u = uvw[0];
-				double &v = uvw[1];
-				double &w = uvw[2];
-				double coords[3];
-				m_Map->computeTransformedCoords(uvw, coords);
-				emInt vNew = m_pMesh->addVert(coords);
-				localVerts[ii][jj][kk] = vNew;
-				m_uvw[ii][jj][kk][0] = u;
-				m_uvw[ii][jj][kk][1] = v;
-				m_uvw[ii][jj][kk][2] = w;
-//				printf("%3d %3d %3d %5f %5f %5f\n", ii, jj, kk, u, v, w);
+				createInteriorVert(map, ii, jj, kk);
 			}
 		}
 	} // Done looping to create all verts inside the cell.
 }
 
+template<typename MapT>
+void CellDivider::createInteriorVert(const MapT& map, const int ii,
+		const int jj, const int kk) {
+	double uvw[3];
+	// Now find uvw by finding the near-intersection point
+	// of the lines of constant i, j, k
+	computeParaCoords(ii, jj, kk, uvw);
+
+	double &u = uvw[0];
+	double &v = uvw[1];
+	double &w = uvw[2];
+	double coords[3];
+	mapToPhysCoords(map, uvw, coords);
+	emInt vNew = m_pMesh->addVert(coords);
+	localVerts[ii][jj][kk] = vNew;
+	m_uvw[ii][jj][kk][0] = u;
+	m_uvw[ii][jj][kk][1] = v;
+	m_uvw[ii][jj][kk][2] = w;
+//	printf("%3d %3d %3d %5f %5f %5f\n", ii, jj, kk, u, v, w);
+}
+
 void getCellInteriorParametricIntersectionPoint(const double uvwA[3],
 		const double uvwB[3], const double uvwC[3], const double uvwD[3],
 		const double uvwE[3], const double uvwF[3], double uvw[3]) {
@@ -1218,3 +1253,29 @@ void CellDivider::printAllPoints() {
 		printf("\n");
 	}
 }
+
+// The divider member templates are instantiated here for each mapping that
+// subdividePartMesh uses, so that their definitions can stay out of the header.
+#define INSTANTIATE_DIVIDER_FOR_MAPPING(MapT) \
+	template void CellDivider::divideEdges(const MapT& map, \
+			exa_map<Edge, EdgeVerts> &vertsOnEdges); \
+	template void CellDivider::divideFaces(const MapT& map, \
+			exa_set<TriFaceVerts> &vertsOnTris, \
+			exa_set<QuadFaceVerts> &vertsOnQuads); \
+	template void CellDivider::divideInterior(const MapT& map); \
+	template void CellDivider::createInteriorVert(const MapT& map, \
+			const int ii, const int jj, const int kk)
+
+INSTANTIATE_DIVIDER_FOR_MAPPING(Q1TetMapping);
+INSTANTIATE_DIVIDER_FOR_MAPPING(Q1PyramidMapping);
+INSTANTIATE_DIVIDER_FOR_MAPPING(Q1PrismMapping);
+INSTANTIATE_DIVIDER_FOR_MAPPING(Q1HexMapping);
+INSTANTIATE_DIVIDER_FOR_MAPPING(LagrangeCubicTetMapping);
+INSTANTIATE_DIVIDER_FOR_MAPPING(LagrangeCubicPyramidMapping);
+INSTANTIATE_DIVIDER_FOR_MAPPING(LagrangeCubicPrismMapping);
+INSTANTIATE_DIVIDER_FOR_MAPPING(LagrangeCubicHexMapping);
+
+template void CellDivider::divideEdges(const NoMapping& map,
+		exa_map<Edge, EdgeVerts> &vertsOnEdges);
+template void CellDivider::divideFaces(const NoMapping& map,
+		exa_set<TriFaceVerts> &vertsOnTris, exa_set<QuadFaceVerts> &vertsOnQuads);
@@ -30,13 +30,16 @@
 #include <cmath>
 
 #include "exa-defs.h"
+#include "DividerTables.h"
 #include "ExaMesh.h"
+#include "Instrument.h"
 #include "Mapping.h"
 #include "UMesh.h"
 
 class CellDivider {
 protected:
 	UMesh *m_pMesh;
+	// Owned by the MappedDivider, and only used here for length scales.
 	Mapping *m_Map;
 	emInt (*localVerts)[MAX_DIVS + 1][MAX_DIVS + 1];
 	double (*m_uvw)[MAX_DIVS+1][MAX_DIVS+1][3];
@@ -52,13 +55,57 @@ protected:
 
 	// Used by both tets and pyramids.
 	int checkOrient3D(const emInt verts[4]) const;
+	// All mapping evaluations for new verts go through here, so that they
+	// can be counted and timed.  The mapping is passed as its concrete type,
+	// so the evaluation is a direct call, and inlined for the Q1 mappings.
+	template<typename MapT>
+	void mapToPhysCoords(const MapT& map, const double uvw[3], double xyz[3]) {
+		instrumentCount(eCountMappingEvals);
+		ScopedTimer ST(eTimeMapping);
+		map.computeTransformedCoords(uvw, xyz);
+	}
+	template<typename MapT>
+	void createInteriorVert(const MapT& map, const int ii, const int jj,
+			const int kk);
+	// The same verts as divideInterior, but from a compile-time table, so
+	// without the virtual loop bounds.
+	template<int N, typename Shape, typename MapT>
+	void divideInteriorFixed(const MapT& map) {
+		assert(nDivs == N);
+		static constexpr InteriorVertTable<N, Shape> table;
+		for (int vv = 0; vv < table.count; vv++) {
+			createInteriorVert(map, table.ijk[vv][0], table.ijk[vv][1],
+													table.ijk[vv][2]);
+		}
+	}
+	template<typename MapT>
+	void divideEdgesAndFaces(const MapT& map,
+			exa_map<Edge, EdgeVerts> &vertsOnEdges,
+			exa_set<TriFaceVerts> &vertsOnTris,
+			exa_set<QuadFaceVerts> &vertsOnQuads) {
+		{
+			ScopedTimer ST(eTimeEdges);
+			divideEdges(map, vertsOnEdges);
+		}
+
+		// Divide all the faces, including storing info about which new verts
+		// are on which faces
+		{
+			ScopedTimer ST(eTimeFaces);
+			divideFaces(map, vertsOnTris, vertsOnQuads);
+		}
+	}
 private:
-	void getEdgeVerts(exa_map<Edge, EdgeVerts> &vertsOnEdges, const int edge,
-			const double dihedral, EdgeVerts &EV);
+	template<typename MapT>
+	void getEdgeVerts(const MapT& map, exa_map<Edge, EdgeVerts> &vertsOnEdges,
+			const int edge, const double dihedral, EdgeVerts &EV);
 
-	QuadFaceVerts getQuadVerts(exa_set<QuadFaceVerts> &vertsOnQuads, const int face);
+	template<typename MapT>
+	QuadFaceVerts getQuadVerts(const MapT& map,
+			exa_set<QuadFaceVerts> &vertsOnQuads, const int face);
 
-	TriFaceVerts getTriVerts(
+	template<typename MapT>
+	TriFaceVerts getTriVerts(const MapT& map,
 			exa_set<TriFaceVerts> &vertsOnTris,
 			const int face);
 public:
@@ -84,32 +131,18 @@ public:
 	virtual ~CellDivider() {
 		delete[] localVerts;
 		delete[] m_uvw;
-		if (m_Map) delete m_Map;
-	}
-	void createDivisionVerts(exa_map<Edge, EdgeVerts> &vertsOnEdges,
-			exa_set<TriFaceVerts> &vertsOnTris,
-			exa_set<QuadFaceVerts> &vertsOnQuads) {
-		divideEdges(vertsOnEdges);
-
-		// Divide all the faces, including storing info about which new verts
-		// are on which faces
-		divideFaces(vertsOnTris, vertsOnQuads);
-
-		// Divide the cell
-		divideInterior();
-
-//		printAllPoints();
 	}
-	void divideEdges(exa_map<Edge, EdgeVerts> &vertsOnEdges);
-	void divideFaces(exa_set<TriFaceVerts> &vertsOnTris,
+	template<typename MapT>
+	void divideEdges(const MapT& map, exa_map<Edge, EdgeVerts> &vertsOnEdges);
+	template<typename MapT>
+	void divideFaces(const MapT& map, exa_set<TriFaceVerts> &vertsOnTris,
 	exa_set<QuadFaceVerts> &vertsOnQuads);
-	virtual void divideInterior();
+	template<typename MapT>
+	void divideInterior(const MapT& map);
 	virtual void createNewCells() = 0;
-	virtual void setupCoordMapping(const emInt verts[]) = 0;
-	virtual void getPhysCoordsFromParamCoords(const double uvw[],
-			double xyz[]) = 0;
+	int getNumDivs() const {return nDivs;}
 	void getParamCoords(const int i, const int j, const int k,
-			double uvw[]) {
+			double uvw[]) const {
 		assert(i >= 0 && i <= MAX_DIVS);
 		assert(j >= 0 && j <= MAX_DIVS);
 		assert(k >= 0 && k <= MAX_DIVS);
@@ -117,6 +150,30 @@ public:
 		uvw[1] = m_uvw[i][j][k][1];
 		uvw[2] = m_uvw[i][j][k][2];
 	}
+	emInt getLocalVert(const int i, const int j, const int k) const {
+		assert(i >= 0 && i <= MAX_DIVS);
+		assert(j >= 0 && j <= MAX_DIVS);
+		assert(k >= 0 && k <= MAX_DIVS);
+		return localVerts[i][j][k];
+	}
+	// Take the verts and param coords of every ratio'th point of a finer
+	// divider's lattice, where ratio is its nDivs over this one's, so that
+	// createNewCells makes a coarser division with the same verts.
+	void copyCoarserLattice(const CellDivider& finer) {
+		assert(finer.nDivs % nDivs == 0);
+		const int ratio = finer.nDivs / nDivs;
+		for (int ii = 0; ii <= nDivs; ii++) {
+			for (int jj = 0; jj <= nDivs; jj++) {
+				for (int kk = 0; kk <= nDivs; kk++) {
+					localVerts[ii][jj][kk] =
+							finer.localVerts[ratio * ii][ratio * jj][ratio * kk];
+					std::copy(finer.m_uvw[ratio * ii][ratio * jj][ratio * kk],
+										finer.m_uvw[ratio * ii][ratio * jj][ratio * kk] + 3,
+										m_uvw[ii][jj][kk]);
+				}
+			}
+		}
+	}
 
 	// The virtual functions here will be overridden in most subclasses.
 	int minI(const int /*j*/, const int /*k*/) const {return 0;}
@@ -128,6 +185,23 @@ public:
 	virtual int maxK(const int /*i*/, const int /*j*/) const {return nDivs;}
 
 	virtual int getMinInteriorDivs() const {return 3;}
+	// How many verts divideInterior creates.  They're the last ones created
+	// for each cell, and no other cell uses them.
+	int countInteriorVerts() const {
+		if (nDivs < getMinInteriorDivs()) return 0;
+		int count = 0;
+		for (int kk = 1; kk < nDivs; kk++) {
+			int jMax = maxJ(1, kk);
+			for (int jj = 1; jj < jMax; jj++) {
+				count += std::max(maxI(jj, kk) - 1, 0);
+			}
+		}
+		return count;
+	}
+	// Whether createNewCells reads the coords of interior verts, as tets and
+	// pyramids do to choose how to split.  If not, those coords can be
+	// evaluated later, for several cells at once.
+	static constexpr bool newCellsNeedCoords = true;
 	void computeParaCoords(const int ii, const int jj, const int kk,
 			double uvw[3]) const;
 	// Output for diagnostic purposes
@@ -140,6 +214,188 @@ private:
 			emInt cornerStart, emInt cornerEnd) const;
 };
 
+// Interior verts of up to BATCH_WIDTH coarse cells of one type, whose coords
+// are evaluated together, with one cell in each SIMD lane.  The verts are
+// numbered as each cell is divided, so the output is the same as dividing
+// one cell at a time.  Batching is only for mappings that can evaluate
+// lanes, and only for up to maxBatchedPoints interior verts per cell; past
+// that, there's plenty of work in each cell on its own.
+template<class MapT, bool hasLanes = MapT::hasLaneEvaluation>
+class InteriorBatch {
+public:
+	InteriorBatch(UMesh* /*pMesh*/, const int /*nPoints*/) {
+	}
+	bool isActive() const {return false;}
+	int addLane(const MapT& /*map*/, const emInt /*firstVert*/) {
+		assert(0);
+		return 0;
+	}
+	void setParamCoords(const int /*lane*/, const int /*point*/,
+			const double /*uvw*/[3]) {
+		assert(0);
+	}
+	bool isFull() const {return false;}
+	void evaluate() {
+	}
+};
+
+template<class MapT>
+class InteriorBatch<MapT, true> {
+	UMesh *m_pMesh;
+	int m_nPoints, m_nLanes;
+	emInt m_firstVert[BATCH_WIDTH];
+	double m_coeffs[MapT::numCoeffs][3][BATCH_WIDTH];
+	// Param coords of each interior vert, by lane.
+	double (*m_uvw)[3][BATCH_WIDTH];
+	InteriorBatch(const InteriorBatch&);
+	InteriorBatch& operator=(const InteriorBatch&);
+public:
+	static constexpr int maxBatchedPoints = 4096;
+	InteriorBatch(UMesh *pMesh, const int nPoints) :
+			m_pMesh(pMesh), m_nPoints(nPoints), m_nLanes(0), m_firstVert(),
+					m_coeffs(), m_uvw(nullptr) {
+		if (nPoints > 0 && nPoints <= maxBatchedPoints) {
+			m_uvw = new double[nPoints][3][BATCH_WIDTH]();
+		}
+	}
+	~InteriorBatch() {
+		// Anything left in the batch should have been flushed by now.
+		assert(m_nLanes == 0);
+		delete[] m_uvw;
+	}
+	bool isActive() const {return m_uvw != nullptr;}
+	// Returns the lane for the next cell, whose interior verts start at
+	// firstVert.
+	int addLane(const MapT& map, const emInt firstVert) {
+		assert(isActive() && m_nLanes < BATCH_WIDTH);
+		map.getLaneCoeffs(m_coeffs, m_nLanes);
+		m_firstVert[m_nLanes] = firstVert;
+		return m_nLanes++;
+	}
+	void setParamCoords(const int lane, const int point, const double uvw[3]) {
+		assert(lane < m_nLanes && point < m_nPoints);
+		m_uvw[point][0][lane] = uvw[0];
+		m_uvw[point][1][lane] = uvw[1];
+		m_uvw[point][2][lane] = uvw[2];
+	}
+	bool isFull() const {return m_nLanes == BATCH_WIDTH;}
+	// Set the coords of all the verts in the batch, and empty it.  Unused
+	// lanes are evaluated too, and their results thrown away.
+	void evaluate() {
+		if (m_nLanes == 0) return;
+		instrumentCount(eCountMappingEvals, size_t(m_nLanes) * m_nPoints);
+		ScopedTimer ST(eTimeMapping);
+		for (int pp = 0; pp < m_nPoints; pp++) {
+			double xyz[3][BATCH_WIDTH];
+			MapT::computeTransformedCoordsLanes(m_coeffs, m_uvw[pp], xyz);
+			for (int ll = 0; ll < m_nLanes; ll++) {
+				double coords[] = {xyz[0][ll], xyz[1][ll], xyz[2][ll]};
+				m_pMesh->setCoords(m_firstVert[ll] + pp, coords);
+			}
+		}
+		m_nLanes = 0;
+	}
+};
+
+// A divider for one cell type together with its coordinate mapping.  The
+// mapping is held by value, with its concrete type, rather than through a
+// Mapping*, so no virtual call is made for each new vert.  The choice of
+// mapping is made once per part, in subdividePartMesh.
+template<class DividerBase, class MapT>
+class MappedDivider: public DividerBase {
+	MapT m_mapping;
+	int m_nInterior;
+	InteriorBatch<MapT> m_batch;
+	// Number the interior verts and find their param coords, in the same
+	// order as CellDivider::divideInterior, but leave evaluating their
+	// coords to the batch.
+	void queueInteriorVerts() {
+		if (m_nInterior == 0) return;
+		emInt vert = this->m_pMesh->reserveVerts(m_nInterior);
+		const int lane = m_batch.addLane(m_mapping, vert);
+		int point = 0;
+		for (int kk = 1; kk < this->nDivs; kk++) {
+			int jMax = this->maxJ(1, kk);
+			for (int jj = 1; jj < jMax; jj++) {
+				int iMax = this->maxI(jj, kk);
+				for (int ii = 1; ii < iMax; ii++) {
+					double *uvw = this->m_uvw[ii][jj][kk];
+					this->computeParaCoords(ii, jj, kk, uvw);
+					this->localVerts[ii][jj][kk] = vert++;
+					m_batch.setParamCoords(lane, point++, uvw);
+				}
+			}
+		}
+		assert(point == m_nInterior);
+		if (m_batch.isFull()) m_batch.evaluate();
+	}
+public:
+	MappedDivider(UMesh *pVolMesh, const ExaMesh* const pInitMesh,
+			const int segmentsPerEdge) :
+			DividerBase(pVolMesh, segmentsPerEdge), m_mapping(pInitMesh),
+					m_nInterior(this->countInteriorVerts()),
+					m_batch(pVolMesh, DividerBase::newCellsNeedCoords ? 0 : m_nInterior) {
+		this->m_Map = &m_mapping;
+	}
+	void setupCoordMapping(const emInt verts[]) {
+		for (int ii = 0; ii < this->numVerts; ii++) {
+			this->cellVerts[ii] = verts[ii];
+		}
+		m_mapping.setupCoordMapping(verts);
+	}
+	void getPhysCoordsFromParamCoords(const double uvw[], double xyz[]) const {
+		m_mapping.computeTransformedCoords(uvw, xyz);
+	}
+	void createDivisionVerts(exa_map<Edge, EdgeVerts> &vertsOnEdges,
+			exa_set<TriFaceVerts> &vertsOnTris,
+			exa_set<QuadFaceVerts> &vertsOnQuads) {
+		this->divideEdgesAndFaces(m_mapping, vertsOnEdges, vertsOnTris,
+															vertsOnQuads);
+		// Divide the cell
+		{
+			ScopedTimer ST(eTimeInterior);
+			DividerBase::divideInterior(m_mapping);
+		}
+
+//		this->printAllPoints();
+	}
+	// The same as createDivisionVerts, except that coords of interior verts
+	// may not be set until their batch is full or flushInteriorVerts is
+	// called.  For callers that don't need those coords in the meantime.
+	void createDivisionVertsDeferred(exa_map<Edge, EdgeVerts> &vertsOnEdges,
+			exa_set<TriFaceVerts> &vertsOnTris,
+			exa_set<QuadFaceVerts> &vertsOnQuads) {
+		if (!m_batch.isActive()) {
+			createDivisionVerts(vertsOnEdges, vertsOnTris, vertsOnQuads);
+			return;
+		}
+		this->divideEdgesAndFaces(m_mapping, vertsOnEdges, vertsOnTris,
+															vertsOnQuads);
+		ScopedTimer ST(eTimeInterior);
+		queueInteriorVerts();
+	}
+	void flushInteriorVerts() {
+		ScopedTimer ST(eTimeInterior);
+		m_batch.evaluate();
+	}
+	void divideEdges(exa_map<Edge, EdgeVerts> &vertsOnEdges) {
+		DividerBase::divideEdges(m_mapping, vertsOnEdges);
+	}
+	void divideFaces(exa_set<TriFaceVerts> &vertsOnTris,
+			exa_set<QuadFaceVerts> &vertsOnQuads) {
+		DividerBase::divideFaces(m_mapping, vertsOnTris, vertsOnQuads);
+	}
+};
+
+// Bdry faces only pick up verts that the cells next to them have already
+// created, so their dividers never evaluate a mapping.
+struct NoMapping {
+	void computeTransformedCoords(const double /*uvw*/[3],
+			double /*xyz*/[3]) const {
+		assert(0);
+	}
+};
+
 void getFaceParametricIntersectionPoint(
 		const double uvL[2], const double uvR[2],
 		const double uvB[2], const double uvT[2],
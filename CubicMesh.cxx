@@ -26,8 +26,13 @@
 #include <algorithm>
 #include <cstdio>
 #include <memory>
+#include <vector>
 #include <stdlib.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "exa_config.h"
 #include "GeomUtils.h"
 
@@ -38,6 +43,7 @@
 #endif
 
 #include "CubicMesh.h"
+#include "Instrument.h"
 #include "UMesh.h"
 
 CubicMesh::CubicMesh(const emInt nVerts, const emInt nBdryVerts,
@@ -59,14 +65,89 @@ CubicMesh::CubicMesh(const emInt nVerts, const emInt nBdryVerts,
 	m_Hex64Conn = new emInt[m_nHex64][64];
 }
 
-void CubicMesh::decrementVertIndices(emInt connSize, emInt* const connect) {
-	for (emInt ii = 0; ii < connSize; ii++) {
-		connect[ii]--;
+CubicMesh::CubicMesh(const MeshSize& MS) :
+		CubicMesh(MS.nVerts, MS.nBdryVerts, MS.nBdryTris, MS.nBdryQuads, MS.nTets,
+							MS.nPyrs, MS.nPrisms, MS.nHexes) {
+}
+
+// Cubic refinement divides each coarse cell three times as finely as asked,
+// and every vert of that division is a node of the fine mesh.  Bdry verts
+// are counted once the fine bdry faces exist.
+static MeshSize fineCubicMeshSize(const CubicMesh& CMIn, const int nDivs) {
+	if (nDivs < 1 || 3 * nDivs > MAX_DIVS) {
+		fprintf(stderr, "Cubic refinement needs 1 to %d divisions, not %d.\n",
+						MAX_DIVS / 3, nDivs);
+		exit(1);
 	}
+	MeshSize MSOut = CMIn.computeFineMeshSize(nDivs);
+	size_t nVerts = CMIn.countFineVerts(3 * nDivs);
+	if (nVerts > EMINT_MAX) {
+		fprintf(stderr, "Output mesh will exceed max index size!\n");
+		exit(2);
+	}
+	MSOut.nVerts = nVerts;
+	MSOut.nBdryVerts = 0;
+	return MSOut;
+}
+
+CubicMesh::CubicMesh(const CubicMesh& CMIn, const int nDivs) :
+		CubicMesh(fineCubicMeshSize(CMIn, nDivs)) {
+	subdivideCubicMesh(&CMIn, this, nDivs);
+	assert(m_vert == m_nVerts && m_tri == m_nTri10 && m_quad == m_nQuad16);
+	assert(m_tet == m_nTet20 && m_pyr == m_nPyr30 && m_prism == m_nPrism40);
+	assert(m_hex == m_nHex64);
+
+	std::vector<unsigned char> isBdryVert(m_nVerts, 0);
+	for (emInt ii = 0; ii < m_nTri10; ii++) {
+		for (int jj = 0; jj < 3; jj++) {
+			isBdryVert[m_Tri10Conn[ii][jj]] = 1;
+		}
+	}
+	for (emInt ii = 0; ii < m_nQuad16; ii++) {
+		for (int jj = 0; jj < 4; jj++) {
+			isBdryVert[m_Quad16Conn[ii][jj]] = 1;
+		}
+	}
+	m_nBdryVerts = std::count(isBdryVert.begin(), isBdryVert.end(), 1);
+	reorderCubicMesh();
+
+	assert(verifyTetValidity() && verifyPyramidValidity() &&
+			verifyPrismValidity() && verifyHexValidity());
 }
 
 #if (HAVE_CGNS == 1)
-void CubicMesh::readCGNSfile(const char CGNSfilename[]) {
+// Connectivity is read in chunks of about this many nodes.
+static const cgsize_t maxChunkNodes = cgsize_t(1) << 20;
+
+// Convert one chunk of CGNS connectivity to 0-based emInts, in place in the
+// mesh, and tag the corners of the elements in it: vertex nodes for cells,
+// bdry verts for bdry faces.  Several chunks may be converted at once, and
+// they all tag the same arrays.
+static void convertConnectivityChunk(const cgsize_t chunk[],
+		const size_t nValues, emInt conn[], const int nNodes, const int nCorners,
+		const cgsize_t nVerts, unsigned char tags[]) {
+	for (size_t ii = 0; ii < nValues; ii++) {
+		cgsize_t node = chunk[ii];
+		if (node < 1 || node > nVerts) {
+			fprintf(stderr, "Node index %lld out of range in CGNS file.\n",
+							static_cast<long long>(node));
+			exit(1);
+		}
+		conn[ii] = emInt(node - 1);
+		if (int(ii % nNodes) < nCorners) {
+#pragma omp atomic write
+			tags[node - 1] = 1;
+		}
+	}
+}
+
+// The CGNS library isn't thread-safe, so one thread does all the reading,
+// a bounded chunk at a time.  While it reads the next chunk, other threads
+// convert the ones already read and tag the vertex nodes that
+// reorderCubicMesh needs, so that pass doesn't have to happen separately.
+// Coords are read straight into place while the last conversions finish.
+void CubicMesh::readCGNSfile(const char CGNSfilename[],
+		std::vector<unsigned char>& isVertexNode) {
 	int status;
 	int index_file;
 	status = cg_open(CGNSfilename, CG_MODE_READ, &index_file);
@@ -98,34 +179,44 @@ void CubicMesh::readCGNSfile(const char CGNSfilename[]) {
 		fprintf(stderr, "Bad zone type %d\n", zoneType);
 		exit(1);
 	}
-	int zoneSize[3];
+	cgsize_t zoneSize[3];
 	char zoneName[33];
 	status = cg_zone_read(index_file, 1, 1, zoneName, zoneSize);
 	CHECK_STATUS;
-	fprintf(stderr, "Got zone %s, size: %u verts, %u cells\n", zoneName,
-					zoneSize[0], zoneSize[1]);
+	fprintf(stderr, "Got zone %s, size: %lld verts, %lld cells\n", zoneName,
+					static_cast<long long>(zoneSize[0]),
+					static_cast<long long>(zoneSize[1]));
+	if (size_t(zoneSize[0]) > EMINT_MAX) {
+		fprintf(stderr, "Too many verts for the index size!\n");
+		exit(1);
+	}
 	m_nVerts = zoneSize[0];
-	m_nBdryVerts = zoneSize[2];
 	int nSections = -1;
-	cg_nsections(index_file, 1, 1, &nSections);
+	status = cg_nsections(index_file, 1, 1, &nSections);
 	CHECK_STATUS;
 	fprintf(stderr, "Zone has %d sections\n", nSections);
 	// Now parse the sections to see how many of what kind of elements there are.
 	size_t elementCounts[CGNS_ENUMV(HEXA_125) + 1] = { 0 };
 	for (int iSec = 1; iSec <= nSections; iSec++) {
-		int start, end, count;
+		cgsize_t start, end;
 		int nBdry, parentFlag;
 		ElementType_t eType;
 		char sectionName[33];
 		status = cg_section_read(index_file, 1, 1, iSec, sectionName, &eType,
 															&start, &end, &nBdry, &parentFlag);
 		CHECK_STATUS;
-		count = end - start + 1;
-		fprintf(stderr, "Scanned section %3d (%20s).  %10u elements of type %d.\n",
+		size_t count = end - start + 1;
+		fprintf(stderr,
+						"Scanned section %3d (%20s).  %10lu elements of type %d.\n",
 						iSec, sectionName, count, eType);
 		elementCounts[eType] += count;
 	}
 	for (int type = 0; type <= CGNS_ENUMV(HEXA_125); type++) {
+		if (elementCounts[type] > EMINT_MAX) {
+			fprintf(stderr, "Too many elements of type %d for the index size!\n",
+							type);
+			exit(1);
+		}
 		if (elementCounts[type] != 0) {
 			fprintf(stderr, "%10lu elements of type %d.\n", elementCounts[type],
 							type);
@@ -137,146 +228,146 @@ void CubicMesh::readCGNSfile(const char CGNSfilename[]) {
 	m_nPyr30 = elementCounts[CGNS_ENUMV(PYRA_30)];
 	m_nPrism40 = elementCounts[CGNS_ENUMV(PENTA_40)];
 	m_nHex64 = elementCounts[CGNS_ENUMV(HEXA_64)];
-	fprintf(stderr, "Allocating space for connectivity.\n");
-	// We'd better hope that an emInt and a cgsize_t are compatible.
+	fprintf(stderr, "Allocating space for connectivity and coordinates.\n");
 	m_Tri10Conn = new emInt[m_nTri10][10];
 	m_Quad16Conn = new emInt[m_nQuad16][16];
 	m_Tet20Conn = new emInt[m_nTet20][20];
 	m_Pyr30Conn = new emInt[m_nPyr30][30];
 	m_Prism40Conn = new emInt[m_nPrism40][40];
 	m_Hex64Conn = new emInt[m_nHex64][64];
+	m_xcoords = new double[m_nVerts];
+	m_ycoords = new double[m_nVerts];
+	m_zcoords = new double[m_nVerts];
+
+	isVertexNode.assign(m_nVerts, 0);
+	std::vector<unsigned char> isBdryVert(m_nVerts, 0);
+	// Each buffer is in use by at most one conversion task at a time.
+#ifdef _OPENMP
+	const int maxChunksInFlight = 2 * omp_get_max_threads();
+#else
+	const int maxChunksInFlight = 2;
+#endif
+	std::vector<std::vector<cgsize_t> > buffers(maxChunksInFlight);
+	const cgsize_t nVerts = m_nVerts;
+
 	fprintf(stderr, "Reading connectivity.\n");
-	emInt tri10count = 0, quad16count = 0, tet20count = 0, pyr30count = 0,
-			prism40count = 0, hex64count = 0;
-	for (int iSec = 1; iSec <= nSections; iSec++) {
-		int start, end, count, totalCount;
-		int nBdry, parentFlag;
-		ElementType_t eType;
-		char sectionName[33];
-		status = cg_section_read(index_file, 1, 1, iSec, sectionName, &eType,
-															&start, &end, &nBdry, &parentFlag);
-		CHECK_STATUS;
-		count = end - start + 1;
-		switch (eType) {
-			case CGNS_ENUMV(TRI_10):
-				status = cg_elements_partial_read(
-						index_file, 1, 1, iSec, start, end,
-						reinterpret_cast<int*>(m_Tri10Conn + tri10count), nullptr);
-				totalCount = tri10count += count;
-				break;
-			case CGNS_ENUMV(QUAD_16):
-				status = cg_elements_partial_read(
-						index_file, 1, 1, iSec, start, end,
-						reinterpret_cast<int*>(m_Quad16Conn + quad16count), nullptr);
-				totalCount = quad16count += count;
-				break;
-			case CGNS_ENUMV(TETRA_20):
-				status = cg_elements_partial_read(
-						index_file, 1, 1, iSec, start, end,
-						reinterpret_cast<int*>(m_Tet20Conn + tet20count), nullptr);
-				totalCount = tet20count += count;
-				break;
-			case CGNS_ENUMV(PYRA_30):
-				status = cg_elements_partial_read(
-						index_file, 1, 1, iSec, start, end,
-						reinterpret_cast<int*>(m_Pyr30Conn + pyr30count), nullptr);
-				totalCount = pyr30count += count;
-				break;
-			case CGNS_ENUMV(PENTA_40):
-				status = cg_elements_partial_read(
-						index_file, 1, 1, iSec, start, end,
-						reinterpret_cast<int*>(m_Prism40Conn + prism40count), nullptr);
-				totalCount = prism40count += count;
-				break;
-			case CGNS_ENUMV(HEXA_64):
-				status = cg_elements_partial_read(
-						index_file, 1, 1, iSec, start, end,
-						reinterpret_cast<int*>(m_Hex64Conn + hex64count), nullptr);
-				totalCount = hex64count += count;
-				break;
-			default:
-				assert(0);
-				break;
+#pragma omp parallel
+#pragma omp single
+	{
+		size_t tri10count = 0, quad16count = 0, tet20count = 0, pyr30count = 0,
+				prism40count = 0, hex64count = 0;
+		int nextBuffer = 0;
+		for (int iSec = 1; iSec <= nSections; iSec++) {
+			cgsize_t start, end;
+			int nBdry, parentFlag;
+			ElementType_t eType;
+			char sectionName[33];
+			status = cg_section_read(index_file, 1, 1, iSec, sectionName, &eType,
+																&start, &end, &nBdry, &parentFlag);
+			CHECK_STATUS;
+			emInt* conn = nullptr;
+			int nNodes = 0, nCorners = 0;
+			unsigned char* tags = isVertexNode.data();
+			size_t* sectionCount = nullptr;
+			switch (eType) {
+				case CGNS_ENUMV(TRI_10):
+					conn = &m_Tri10Conn[0][0];
+					nNodes = 10;
+					nCorners = 3;
+					tags = isBdryVert.data();
+					sectionCount = &tri10count;
+					break;
+				case CGNS_ENUMV(QUAD_16):
+					conn = &m_Quad16Conn[0][0];
+					nNodes = 16;
+					nCorners = 4;
+					tags = isBdryVert.data();
+					sectionCount = &quad16count;
+					break;
+				case CGNS_ENUMV(TETRA_20):
+					conn = &m_Tet20Conn[0][0];
+					nNodes = 20;
+					nCorners = 4;
+					sectionCount = &tet20count;
+					break;
+				case CGNS_ENUMV(PYRA_30):
+					conn = &m_Pyr30Conn[0][0];
+					nNodes = 30;
+					nCorners = 5;
+					sectionCount = &pyr30count;
+					break;
+				case CGNS_ENUMV(PENTA_40):
+					conn = &m_Prism40Conn[0][0];
+					nNodes = 40;
+					nCorners = 6;
+					sectionCount = &prism40count;
+					break;
+				case CGNS_ENUMV(HEXA_64):
+					conn = &m_Hex64Conn[0][0];
+					nNodes = 64;
+					nCorners = 8;
+					sectionCount = &hex64count;
+					break;
+				default:
+					fprintf(stderr, "Can't handle elements of type %d.\n", eType);
+					exit(1);
+					break;
+			}
+			const cgsize_t chunkElements = std::max(cgsize_t(1),
+																							maxChunkNodes / nNodes);
+			for (cgsize_t first = start; first <= end; first += chunkElements) {
+				cgsize_t last = std::min(end, first + chunkElements - 1);
+				if (nextBuffer == maxChunksInFlight) {
+					// Wait for conversions to catch up, so buffers can be reused.
+#pragma omp taskwait
+					nextBuffer = 0;
+				}
+				std::vector<cgsize_t>& buffer = buffers[nextBuffer++];
+				size_t nValues = size_t(last - first + 1) * nNodes;
+				buffer.resize(nValues);
+				status = cg_elements_partial_read(index_file, 1, 1, iSec, first, last,
+																					buffer.data(), nullptr);
+				CHECK_STATUS;
+				const cgsize_t* chunk = buffer.data();
+				emInt* chunkConn = conn + (*sectionCount + (first - start)) * nNodes;
+#pragma omp task firstprivate(chunk, nValues, chunkConn, nNodes, nCorners, tags)
+				convertConnectivityChunk(chunk, nValues, chunkConn, nNodes, nCorners,
+																	nVerts, tags);
+			}
+			size_t count = end - start + 1;
+			*sectionCount += count;
+			fprintf(stderr,
+							"Read section %3d (%20s).  %10lu elements of type %d, %10lu total.\n",
+							iSec, sectionName, count, eType, *sectionCount);
+		}
+
+		const char* coordNames[] = { "CoordinateX", "CoordinateY", "CoordinateZ" };
+		double* coords[] = { m_xcoords, m_ycoords, m_zcoords };
+		for (int dd = 0; dd < 3; dd++) {
+			for (cgsize_t first = 1; first <= nVerts; first += maxChunkNodes) {
+				cgsize_t min = first, max = std::min(nVerts,
+																						first + maxChunkNodes - 1);
+				status = cg_coord_read(index_file, 1, 1, coordNames[dd],
+																CGNS_ENUMV(RealDouble), &min, &max,
+																coords[dd] + first - 1);
+				CHECK_STATUS;
+			}
+			fprintf(stderr, "Read %s\n", coordNames[dd]);
 		}
-		fprintf(stderr,
-						"Read section %3d (%20s).  %10u elements of type %d, %10u total.\n",
-						iSec, sectionName, count, eType, totalCount);
-		fflush(stderr);
 	}
-	fprintf(stderr, "Allocating space for coordinates.\n");
-	m_xcoords = new double[zoneSize[0]];
-	m_ycoords = new double[zoneSize[0]];
-	m_zcoords = new double[zoneSize[0]];
-	DataType_t dataType = CGNS_ENUMT(RealDouble);
-	int min = 1, max = zoneSize[0];
-	status = cg_coord_read(index_file, 1, 1, "CoordinateX", dataType, &min, &max,
-													m_xcoords);
-	CHECK_STATUS;
-	fprintf(stderr, "Read x coords, min %u, max %u\n", min, max);
-	status = cg_coord_read(index_file, 1, 1, "CoordinateY", dataType, &min, &max,
-													m_ycoords);
-	CHECK_STATUS;
-	fprintf(stderr, "Read y coords, min %u, max %u\n", min, max);
-	status = cg_coord_read(index_file, 1, 1, "CoordinateZ", dataType, &min, &max,
-													m_zcoords);
-	CHECK_STATUS;
-	fprintf(stderr, "Read z coords, min %u, max %u\n", min, max);
 	status = cg_close(index_file);
 	CHECK_STATUS;
-//	fprintf(stderr, "First few points are:\n");
-//	for (int ii = 0; ii < 10; ii++) {
-//		fprintf(stderr, "%2d (%.8f %.8f %.8f)\n", ii, m_xcoords[ii], m_ycoords[ii],
-//						m_zcoords[ii]);
-//	}
-//	fprintf(stderr, "First few cells are:\n");
-//	for (int ii = 0; ii < 10; ii++) {
-//		fprintf(stderr, "%2d %8d %8d %8d %8d\n", ii, m_Tet20Conn[ii][0],
-//						m_Tet20Conn[ii][1], m_Tet20Conn[ii][2], m_Tet20Conn[ii][3]);
-//	}
-
-// Need to decrement all the connectivity, because CGNS is 1-based, and
-// everything else in the non-Fortran parts of the universe is 0-based.
-// With a little casting, this can be factored and easy.
-	decrementVertIndices(10 * m_nTri10, reinterpret_cast<emInt*>(m_Tri10Conn));
-	decrementVertIndices(16 * m_nQuad16, reinterpret_cast<emInt*>(m_Quad16Conn));
-	decrementVertIndices(20 * m_nTet20, reinterpret_cast<emInt*>(m_Tet20Conn));
-	decrementVertIndices(30 * m_nPyr30, reinterpret_cast<emInt*>(m_Pyr30Conn));
-	decrementVertIndices(40 * m_nPrism40,
-												reinterpret_cast<emInt*>(m_Prism40Conn));
-	decrementVertIndices(64 * m_nHex64, reinterpret_cast<emInt*>(m_Hex64Conn));
-
-	fprintf(stderr, "Counting bdry verts: ");
-	// Now tag all bdry verts
-	bool *isBdryVert = new bool[m_nVerts];
-	for (emInt ii = 0; ii < m_nVerts; ii++) {
-		isBdryVert[ii] = false;
-	}
-	for (emInt iTri = 0; iTri < m_nTri10; iTri++) {
-		isBdryVert[m_Tri10Conn[iTri][0]] = true;
-		isBdryVert[m_Tri10Conn[iTri][1]] = true;
-		isBdryVert[m_Tri10Conn[iTri][2]] = true;
-	}
-	for (emInt iQuad = 0; iQuad < m_nQuad16; iQuad++) {
-		isBdryVert[m_Quad16Conn[iQuad][0]] = true;
-		isBdryVert[m_Quad16Conn[iQuad][1]] = true;
-		isBdryVert[m_Quad16Conn[iQuad][2]] = true;
-		isBdryVert[m_Quad16Conn[iQuad][3]] = true;
-	}
-	m_nBdryVerts = 0;
-	for (emInt ii = 0; ii < m_nVerts; ii++) {
-		if (isBdryVert[ii]) {
-			m_nBdryVerts++;
-		}
-	}
-	delete[] isBdryVert;
-	fprintf(stderr, "%'u\n", m_nBdryVerts);
+
+	m_nBdryVerts = std::count(isBdryVert.begin(), isBdryVert.end(), 1);
+	fprintf(stderr, "%'u bdry verts\n", m_nBdryVerts);
 
 	assert(verifyTetValidity() && verifyPyramidValidity() &&
 			verifyPrismValidity() && verifyHexValidity());
 }
 
 CubicMesh::CubicMesh(const char CGNSfilename[]) {
-	readCGNSfile(CGNSfilename);
+	std::vector<unsigned char> isVertexNode;
+	readCGNSfile(CGNSfilename, isVertexNode);
 	m_vert = m_nVerts;
 	m_tri = m_nTri10;
 	m_quad = m_nQuad16;
@@ -284,30 +375,99 @@ CubicMesh::CubicMesh(const char CGNSfilename[]) {
 	m_pyr = m_nPyr30;
 	m_prism = m_nPrism40;
 	m_hex = m_nHex64;
-	reorderCubicMesh();
+	reorderCubicMesh(isVertexNode);
 //	buildFaceCellConnectivity();
 }
-#endif
 
-void CubicMesh::renumberNodes(emInt thisSize, emInt* aliasConn,
-		emInt* newNodeInd) {
-	emInt* cloneConn = new emInt[thisSize];
-	std::copy(aliasConn, aliasConn + thisSize, cloneConn);
-	for (emInt ii = 0; ii < thisSize; ii++) {
-		aliasConn[ii] = newNodeInd[cloneConn[ii]];
+// One section per element type, converted to 1-based indices and written
+// in chunks the same size as those read.  Elements are numbered
+// consecutively across sections.
+static void writeCGNSSection(const int index_file, const char sectionName[],
+		const ElementType_t eType, const emInt conn[], const emInt nElements,
+		const int nNodes, cgsize_t& nextElement) {
+	if (nElements == 0) return;
+	int status, index_section;
+	const cgsize_t start = nextElement, end = nextElement + nElements - 1;
+	status = cg_section_partial_write(index_file, 1, 1, sectionName, eType,
+																		start, end, 0, &index_section);
+	CHECK_STATUS;
+	const cgsize_t chunkElements = std::max(cgsize_t(1), maxChunkNodes / nNodes);
+	std::vector<cgsize_t> buffer;
+	for (cgsize_t first = start; first <= end; first += chunkElements) {
+		cgsize_t last = std::min(end, first + chunkElements - 1);
+		const emInt* chunkConn = conn + size_t(first - start) * nNodes;
+		size_t nValues = size_t(last - first + 1) * nNodes;
+		buffer.resize(nValues);
+		for (size_t ii = 0; ii < nValues; ii++) {
+			buffer[ii] = cgsize_t(chunkConn[ii]) + 1;
+		}
+		status = cg_elements_partial_write(index_file, 1, 1, index_section, first,
+																				last, buffer.data());
+		CHECK_STATUS;
 	}
-	delete[] cloneConn;
+	nextElement = end + 1;
+	fprintf(stderr, "Wrote section %20s.  %10u elements of type %d.\n",
+					sectionName, nElements, eType);
 }
 
-void CubicMesh::reorderCubicMesh() {
-	emInt *newNodeInd = new emInt[m_nVerts];
-	bool *isVertexNode = new bool[m_nVerts];
+bool CubicMesh::writeCGNSFile(const char CGNSfilename[]) const {
+	int status;
+	int index_file;
+	status = cg_open(CGNSfilename, CG_MODE_WRITE, &index_file);
+	if (status != CG_OK) {
+		fprintf(stderr, "Couldn't open CGNS file %s for writing.\n",
+						CGNSfilename);
+		return false;
+	}
+	int index_base, index_zone;
+	status = cg_base_write(index_file, "Base", 3, 3, &index_base);
+	CHECK_STATUS;
+	cgsize_t zoneSize[] = { cgsize_t(m_nVerts),
+													cgsize_t(size_t(m_nTet20) + m_nPyr30 + m_nPrism40
+																		+ m_nHex64), 0 };
+	status = cg_zone_write(index_file, index_base, "Zone", zoneSize,
+													CGNS_ENUMV(Unstructured), &index_zone);
+	CHECK_STATUS;
 
-	for (emInt ii = 0; ii < m_nVerts; ii++) {
-		newNodeInd[ii] = EMINT_MAX;
-		isVertexNode[ii] = false;
+	const char* coordNames[] = { "CoordinateX", "CoordinateY", "CoordinateZ" };
+	const double* coords[] = { m_xcoords, m_ycoords, m_zcoords };
+	for (int dd = 0; dd < 3; dd++) {
+		int index_coord;
+		status = cg_coord_write(index_file, index_base, index_zone,
+														CGNS_ENUMV(RealDouble), coordNames[dd],
+														coords[dd], &index_coord);
+		CHECK_STATUS;
 	}
 
+	// Cells first, then bdry faces.
+	cgsize_t nextElement = 1;
+	writeCGNSSection(index_file, "Tets", CGNS_ENUMV(TETRA_20),
+										&m_Tet20Conn[0][0], m_nTet20, 20, nextElement);
+	writeCGNSSection(index_file, "Pyramids", CGNS_ENUMV(PYRA_30),
+										&m_Pyr30Conn[0][0], m_nPyr30, 30, nextElement);
+	writeCGNSSection(index_file, "Prisms", CGNS_ENUMV(PENTA_40),
+										&m_Prism40Conn[0][0], m_nPrism40, 40, nextElement);
+	writeCGNSSection(index_file, "Hexes", CGNS_ENUMV(HEXA_64),
+										&m_Hex64Conn[0][0], m_nHex64, 64, nextElement);
+	writeCGNSSection(index_file, "BdryTris", CGNS_ENUMV(TRI_10),
+										&m_Tri10Conn[0][0], m_nTri10, 10, nextElement);
+	writeCGNSSection(index_file, "BdryQuads", CGNS_ENUMV(QUAD_16),
+										&m_Quad16Conn[0][0], m_nQuad16, 16, nextElement);
+
+	status = cg_close(index_file);
+	CHECK_STATUS;
+	fprintf(stderr, "Wrote CGNS file %s\n", CGNSfilename);
+	return true;
+}
+#endif
+
+void CubicMesh::reorderCubicMesh() {
+	std::vector<unsigned char> isVertexNode(m_nVerts, 0);
+	tagVertexNodes(isVertexNode);
+	reorderCubicMesh(isVertexNode);
+}
+
+void CubicMesh::tagVertexNodes(std::vector<unsigned char>& isVertexNode) const {
 	fprintf(stderr, "Tagging vertex nodes.\n");
 	for (emInt ii = 0; ii < m_nTet20; ii++) {
 		for (emInt jj = 0; jj < 4; jj++) {
@@ -333,67 +493,136 @@ void CubicMesh::reorderCubicMesh() {
 			isVertexNode[node] = true;
 		}
 	}
+}
 
-	fprintf(stderr, "Renumbering vertex nodes\n");
-	emInt node = 0;
-	for (emInt ii = 0; ii < m_nVerts; ii++) {
-		if (isVertexNode[ii]) {
-			assert(newNodeInd[ii] == EMINT_MAX);
-			newNodeInd[ii] = node;
-			node++;
-		}
+// Connectivity is remapped in place; each entry is independent.
+void CubicMesh::renumberNodes(const size_t thisSize, emInt* aliasConn,
+		const emInt newNodeInd[]) {
+#pragma omp parallel for schedule(static)
+	for (size_t ii = 0; ii < thisSize; ii++) {
+		aliasConn[ii] = newNodeInd[aliasConn[ii]];
 	}
-	m_nVertNodes = node;
-	fprintf(stderr, "%'u vertex nodes.\nRenumbering other nodes.\n", node);
+}
+
+// Move the coords of each node ii to newNodeInd[ii], in place.  One walk
+// over the permutation finds its cycles, marking each node visited in
+// tags, and breaks them into segments of at most segmentLength nodes.
+// With the original coords at each segment start saved, segments don't
+// depend on each other, so they're moved in parallel.
+void CubicMesh::permuteCoords(const emInt newNodeInd[],
+		std::vector<unsigned char>& tags) {
+	const emInt segmentLength = 1 << 16;
+	const unsigned char visited = 2;
+	std::vector<emInt> segStart, segLength;
 	for (emInt ii = 0; ii < m_nVerts; ii++) {
-		if (!isVertexNode[ii]) {
-			assert(newNodeInd[ii] == EMINT_MAX);
-			newNodeInd[ii] = node;
-			node++;
+		if (tags[ii] & visited) continue;
+		tags[ii] |= visited;
+		if (newNodeInd[ii] == ii) continue;
+		segStart.push_back(ii);
+		emInt node = newNodeInd[ii], length = 1;
+		while (node != ii) {
+			tags[node] |= visited;
+			if (length == segmentLength) {
+				segLength.push_back(length);
+				segStart.push_back(node);
+				length = 0;
+			}
+			node = newNodeInd[node];
+			length++;
 		}
+		segLength.push_back(length);
 	}
-	assert(node == m_nVerts);
-	delete[] isVertexNode;
-
-	// Clone and re-order the coordinates.  This is an out-of-place
-	// re-ordering, but I'm about to go nuts on memory anyway, so who cares
-	// about the overhead?
-	fprintf(stderr, "Permuting coordinate storage order: x");
-	double *cloneCoords = new double[m_nVerts];
-	std::copy(m_xcoords, m_xcoords + m_nVerts, cloneCoords);
-	for (emInt ii = 0; ii < m_nVerts; ii++) {
-		m_xcoords[newNodeInd[ii]] = cloneCoords[ii];
+
+	const size_t nSegs = segStart.size();
+	std::vector<double> saved(3 * nSegs);
+	for (size_t ss = 0; ss < nSegs; ss++) {
+		saved[3 * ss] = m_xcoords[segStart[ss]];
+		saved[3 * ss + 1] = m_ycoords[segStart[ss]];
+		saved[3 * ss + 2] = m_zcoords[segStart[ss]];
 	}
-	fprintf(stderr, " y");
-	std::copy(m_ycoords, m_ycoords + m_nVerts, cloneCoords);
-	for (emInt ii = 0; ii < m_nVerts; ii++) {
-		m_ycoords[newNodeInd[ii]] = cloneCoords[ii];
+	// Each segment writes the nodes it steps to, the last of which is the
+	// start of the next segment in the cycle.  Nobody reads that one.
+#pragma omp parallel for schedule(dynamic)
+	for (size_t ss = 0; ss < nSegs; ss++) {
+		double x = saved[3 * ss], y = saved[3 * ss + 1], z = saved[3 * ss + 2];
+		emInt node = segStart[ss];
+		for (emInt step = 1; step <= segLength[ss]; step++) {
+			emInt next = newNodeInd[node];
+			double nextX = m_xcoords[next], nextY = m_ycoords[next], nextZ =
+					m_zcoords[next];
+			m_xcoords[next] = x;
+			m_ycoords[next] = y;
+			m_zcoords[next] = z;
+			x = nextX;
+			y = nextY;
+			z = nextZ;
+			node = next;
+		}
 	}
-	fprintf(stderr, " z");
-	std::copy(m_zcoords, m_zcoords + m_nVerts, cloneCoords);
-	for (emInt ii = 0; ii < m_nVerts; ii++) {
-		m_zcoords[newNodeInd[ii]] = cloneCoords[ii];
+}
+
+// Vertex nodes keep their relative order and go first; other nodes keep
+// their relative order and follow.  Numbering is a parallel prefix count
+// over the tags, which are then reused to mark nodes visited while
+// permuting the coords.  Apart from the new index for each node, nothing
+// is copied.
+void CubicMesh::reorderCubicMesh(std::vector<unsigned char>& isVertexNode) {
+	std::vector<emInt> newNodeInd(m_nVerts);
+	// Without OpenMP, this is one segment covering all the nodes.
+#ifdef _OPENMP
+	const int nThreads = omp_get_max_threads();
+#else
+	const int nThreads = 1;
+#endif
+	std::vector<emInt> vertStart(nThreads + 1, 0), otherStart(nThreads + 1, 0);
+
+	fprintf(stderr, "Renumbering nodes\n");
+#pragma omp parallel num_threads(nThreads)
+	{
+#ifdef _OPENMP
+		const int thread = omp_get_thread_num();
+#else
+		const int thread = 0;
+#endif
+		const emInt first = size_t(m_nVerts) * thread / nThreads;
+		const emInt last = size_t(m_nVerts) * (thread + 1) / nThreads;
+		emInt nVertNodes = 0;
+		for (emInt ii = first; ii < last; ii++) {
+			if (isVertexNode[ii]) nVertNodes++;
+		}
+		vertStart[thread + 1] = nVertNodes;
+		otherStart[thread + 1] = (last - first) - nVertNodes;
+#pragma omp barrier
+#pragma omp single
+		{
+			for (int tt = 0; tt < nThreads; tt++) {
+				vertStart[tt + 1] += vertStart[tt];
+				otherStart[tt + 1] += otherStart[tt];
+			}
+		}
+		emInt vertNode = vertStart[thread];
+		emInt otherNode = vertStart[nThreads] + otherStart[thread];
+		for (emInt ii = first; ii < last; ii++) {
+			newNodeInd[ii] = isVertexNode[ii] ? vertNode++ : otherNode++;
+		}
 	}
-	fprintf(stderr, "\n");
-	delete[] cloneCoords;
+	m_nVertNodes = vertStart[nThreads];
+	fprintf(stderr, "%'u vertex nodes.\n", m_nVertNodes);
+
+	fprintf(stderr, "Permuting coordinate storage order.\n");
+	permuteCoords(newNodeInd.data(), isVertexNode);
 
 	// Now update the connectivity.  This is done with a "mapping" to a 1D
 	// array to reduce loop overhead and, at least as importantly, make it so
 	// that I can factor the whole thing.
-	renumberNodes(10 * m_nTri10, reinterpret_cast<emInt*>(m_Tri10Conn),
-								newNodeInd);
-	renumberNodes(16 * m_nQuad16, reinterpret_cast<emInt*>(m_Quad16Conn),
-								newNodeInd);
-	renumberNodes(20 * m_nTet20, reinterpret_cast<emInt*>(m_Tet20Conn),
-								newNodeInd);
-	renumberNodes(30 * m_nPyr30, reinterpret_cast<emInt*>(m_Pyr30Conn),
-								newNodeInd);
-	renumberNodes(40 * m_nPrism40, reinterpret_cast<emInt*>(m_Prism40Conn),
-								newNodeInd);
-	renumberNodes(64 * m_nHex64, reinterpret_cast<emInt*>(m_Hex64Conn),
-								newNodeInd);
-
-	delete[] newNodeInd;
+	renumberNodes(10 * size_t(m_nTri10), &m_Tri10Conn[0][0], newNodeInd.data());
+	renumberNodes(16 * size_t(m_nQuad16), &m_Quad16Conn[0][0],
+								newNodeInd.data());
+	renumberNodes(20 * size_t(m_nTet20), &m_Tet20Conn[0][0], newNodeInd.data());
+	renumberNodes(30 * size_t(m_nPyr30), &m_Pyr30Conn[0][0], newNodeInd.data());
+	renumberNodes(40 * size_t(m_nPrism40), &m_Prism40Conn[0][0],
+								newNodeInd.data());
+	renumberNodes(64 * size_t(m_nHex64), &m_Hex64Conn[0][0], newNodeInd.data());
 }
 
 CubicMesh::~CubicMesh() {
@@ -416,6 +645,87 @@ static void remapIndices(const emInt nPts, const emInt newIndices[],
 	}
 }
 
+// Marks on the nodes of a cubic mesh, for extracting one coarse part.  A
+// node's marks count only if its stamp carries the current epoch, so
+// starting a new part clears all the marks at once.
+class PartNodeMarks {
+	std::vector<uint32_t> m_stamps;
+	uint32_t m_epoch;
+public:
+	enum Mark {
+		eUsed = 1, eCorner = 2, eBdry = 4
+	};
+	PartNodeMarks() :
+			m_epoch(0) {
+	}
+	void startPart(const emInt nNodes) {
+		if (m_stamps.size() < nNodes) m_stamps.resize(nNodes, 0);
+		m_epoch++;
+		// Three low bits hold the marks; the rest hold the epoch.
+		if (m_epoch == (uint32_t(1) << 29)) {
+			std::fill(m_stamps.begin(), m_stamps.end(), 0);
+			m_epoch = 1;
+		}
+	}
+	bool isMarked(const emInt node, const Mark mark) const {
+		const uint32_t stamp = m_stamps[node];
+		return (stamp >> 3) == m_epoch && (stamp & mark);
+	}
+	// Returns true if the node didn't already have this mark.
+	bool mark(const emInt node, const Mark mark) {
+		uint32_t& stamp = m_stamps[node];
+		if ((stamp >> 3) != m_epoch) stamp = m_epoch << 3;
+		const bool isNew = !(stamp & mark);
+		stamp |= mark;
+		return isNew;
+	}
+};
+
+// Parts are extracted in parallel, so each thread keeps its own marks and
+// index map, and reuses them for every part it extracts.  Only entries for
+// nodes in the current part are ever read from newIndices, so it never
+// needs clearing.  This stays allocated for the life of the thread, and
+// extractScratchBytes charges it to every part in flight, so the memory
+// budget covers it for every thread that's busy with a part.
+struct PartExtractScratch {
+	PartNodeMarks marks;
+	std::vector<emInt> newIndices;
+	std::vector<emInt> usedNodes;
+	emInt nCornerNodes, nBdryNodes;
+};
+static thread_local PartExtractScratch extractScratch;
+
+static void markCellNodes(PartExtractScratch& scratch, const emInt conn[],
+		const int nNodes, const int nCorners) {
+	for (int jj = 0; jj < nNodes; jj++) {
+		if (scratch.marks.mark(conn[jj], PartNodeMarks::eUsed)) {
+			scratch.usedNodes.push_back(conn[jj]);
+		}
+	}
+	for (int jj = 0; jj < nCorners; jj++) {
+		if (scratch.marks.mark(conn[jj], PartNodeMarks::eCorner)) {
+			scratch.nCornerNodes++;
+		}
+	}
+}
+
+static void markBdryNodes(PartExtractScratch& scratch, const emInt conn[],
+		const int nCorners) {
+	for (int jj = 0; jj < nCorners; jj++) {
+		if (scratch.marks.mark(conn[jj], PartNodeMarks::eBdry)) {
+			scratch.nBdryNodes++;
+		}
+	}
+}
+
+static bool allCornersInPart(const PartExtractScratch& scratch,
+		const emInt conn[], const int nCorners) {
+	for (int jj = 0; jj < nCorners; jj++) {
+		if (!scratch.marks.isMarked(conn[jj], PartNodeMarks::eCorner)) return false;
+	}
+	return true;
+}
+
 std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 		std::vector<CellPartData>& vecCPD, const int numDivs) const {
 	CALLGRIND_TOGGLE_COLLECT
@@ -431,10 +741,10 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 	emInt nTris(0), nQuads(0), nTets(0), nPyrs(0), nPrisms(0), nHexes(0);
 	const emInt *conn;
 
-//	std::vector<bool> isVertUsed(numVerts(), false);
-	bool *isVertUsed = reinterpret_cast<bool*>(calloc(numVerts(), sizeof(bool)));
-	exa_set<emInt> bdryVerts;
-	exa_set<emInt> cornerNodes;
+	PartExtractScratch& scratch = extractScratch;
+	scratch.marks.startPart(numVerts());
+	scratch.usedNodes.clear();
+	scratch.nCornerNodes = scratch.nBdryNodes = 0;
 
 	for (emInt ii = first; ii < last; ii++) {
 		emInt type = vecCPD[ii].getCellType();
@@ -455,11 +765,7 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 				addUniquely(partBdryTris, TFV013);
 				addUniquely(partBdryTris, TFV123);
 				addUniquely(partBdryTris, TFV203);
-//				vertsUsed.insert(conn, conn + 20);
-				for (int jj = 0; jj < 20; jj++) {
-					isVertUsed[conn[jj]] = true;
-				}
-				cornerNodes.insert(conn, conn + 4);
+				markCellNodes(scratch, conn, 20, 4);
 				break;
 			}
 			case PYRA_30: {
@@ -475,11 +781,7 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 				addUniquely(partBdryTris, TFV124);
 				addUniquely(partBdryTris, TFV234);
 				addUniquely(partBdryTris, TFV304);
-//				vertsUsed.insert(conn, conn + 30);
-				for (int jj = 0; jj < 30; jj++) {
-					isVertUsed[conn[jj]] = true;
-				}
-				cornerNodes.insert(conn, conn + 5);
+				markCellNodes(scratch, conn, 30, 5);
 				break;
 			}
 			case PENTA_40: {
@@ -498,12 +800,7 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 				addUniquely(partBdryQuads, QFV2035);
 				addUniquely(partBdryTris, TFV012);
 				addUniquely(partBdryTris, TFV345);
-//				vertsUsed.insert(conn, conn + 40);
-
-				for (int jj = 0; jj < 40; jj++) {
-					isVertUsed[conn[jj]] = true;
-				}
-				cornerNodes.insert(conn, conn + 6);
+				markCellNodes(scratch, conn, 40, 6);
 				break;
 			}
 			case HEXA_64: {
@@ -521,24 +818,21 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 				addUniquely(partBdryQuads, QFV3047);
 				addUniquely(partBdryQuads, QFV0123);
 				addUniquely(partBdryQuads, QFV4567);
-//				vertsUsed.insert(conn, conn + 64);
-				for (int jj = 0; jj < 64; jj++) {
-					isVertUsed[conn[jj]] = true;
-				}
-				cornerNodes.insert(conn, conn + 8);
+				markCellNodes(scratch, conn, 64, 8);
 				break;
 			}
 		} // end switch
 	} // end loop to gather information
 
 	// Now check to see which bdry entities are in this part.  That'll be the
-	// ones whose verts are all marked as used.  Unfortunately, this requires
-	// searching through -all- the bdry entities for each part.
+	// ones whose corners are all corners of cells in the part; only those are
+	// worth looking up.  Unfortunately, this requires scanning through -all-
+	// the bdry entities for each part.
 	std::vector<emInt> realBdryTris;
 	std::vector<emInt> realBdryQuads;
 	for (emInt ii = 0; ii < numBdryTris(); ii++) {
 		conn = getBdryTriConn(ii);
-		if (isVertUsed[conn[0]] && isVertUsed[conn[1]] && isVertUsed[conn[2]]) {
+		if (allCornersInPart(scratch, conn, 3)) {
 			TriFaceVerts TFV(numDivs, conn[0], conn[1], conn[2]);
 			auto iter = partBdryTris.find(TFV);
 			// If this bdry tri is an unmatched tri from this part, match it, and
@@ -547,9 +841,7 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 			// bdry face from slipping through.
 			if (iter != partBdryTris.end()) {
 				partBdryTris.erase(iter);
-				bdryVerts.insert(conn[0]);
-				bdryVerts.insert(conn[1]);
-				bdryVerts.insert(conn[2]);
+				markBdryNodes(scratch, conn, 3);
 				realBdryTris.push_back(ii);
 				nTris++;
 			}
@@ -557,8 +849,7 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 	}
 	for (emInt ii = 0; ii < numBdryQuads(); ii++) {
 		conn = getBdryQuadConn(ii);
-		if (isVertUsed[conn[0]] && isVertUsed[conn[1]] && isVertUsed[conn[2]]
-				&& isVertUsed[conn[3]]) {
+		if (allCornersInPart(scratch, conn, 4)) {
 			QuadFaceVerts QFV(numDivs, conn[0], conn[1], conn[2], conn[3]);
 			auto iter = partBdryQuads.find(QFV);
 			// If this bdry tri is an unmatched tri from this part, match it, and
@@ -567,10 +858,7 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 			// bdry face from slipping through.
 			if (iter != partBdryQuads.end()) {
 				partBdryQuads.erase(iter);
-				bdryVerts.insert(conn[0]);
-				bdryVerts.insert(conn[1]);
-				bdryVerts.insert(conn[2]);
-				bdryVerts.insert(conn[3]);
+				markBdryNodes(scratch, conn, 4);
 				realBdryQuads.push_back(ii);
 				nQuads++;
 			}
@@ -581,24 +869,18 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 	emInt nPartBdryQuads = partBdryQuads.size();
 
 	for (auto tri : partBdryTris) {
-		bdryVerts.insert(tri.getCorner(0));
-		bdryVerts.insert(tri.getCorner(1));
-		bdryVerts.insert(tri.getCorner(2));
+		const emInt corners[] = { tri.getCorner(0), tri.getCorner(1),
+				tri.getCorner(2) };
+		markBdryNodes(scratch, corners, 3);
 	}
 	for (auto quad : partBdryQuads) {
-		bdryVerts.insert(quad.getCorner(0));
-		bdryVerts.insert(quad.getCorner(1));
-		bdryVerts.insert(quad.getCorner(2));
-		bdryVerts.insert(quad.getCorner(3));
-	}
-	emInt nBdryVerts = 0, nNodes = 0;
-	emInt nVertNodes = 0;
-	emInt nVerts = numVerts();
-	for (emInt ii = 0; ii < nVerts; ii++) {
-		if (isVertUsed[ii]) nNodes++;
+		const emInt corners[] = { quad.getCorner(0), quad.getCorner(1),
+				quad.getCorner(2), quad.getCorner(3) };
+		markBdryNodes(scratch, corners, 4);
 	}
-	nBdryVerts = bdryVerts.size();
-	nVertNodes = cornerNodes.size();
+	emInt nNodes = scratch.usedNodes.size();
+	emInt nBdryVerts = scratch.nBdryNodes;
+	emInt nVertNodes = scratch.nCornerNodes;
 
 	// Now set up the data structures for the new coarse UMesh
 	auto UCM = std::make_unique<CubicMesh>(nNodes, nBdryVerts,
@@ -609,18 +891,22 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 
 	// Store the vertices, while keeping a mapping from the full list of verts
 	// to the restricted list so the connectivity can be copied properly.
-	emInt *newIndices = new emInt[nVerts];
-	for (emInt ii = 0; ii < nVerts; ii++) {
-		if (isVertUsed[ii]) {
-			double coords[3];
-			getCoords(ii, coords);
-			newIndices[ii] = UCM->addVert(coords);
-			// Copy length scale for vertices from the parent; otherwise, there will be
-			// mismatches in the refined meshes.
-			UCM->setLengthScale(newIndices[ii], getLengthScale(ii));
-		}
+	// Sorting the nodes keeps them in the same order as in the whole mesh.
+	std::sort(scratch.usedNodes.begin(), scratch.usedNodes.end());
+	if (scratch.newIndices.size() < numVerts()) {
+		scratch.newIndices.resize(numVerts());
+	}
+	emInt *newIndices = scratch.newIndices.data();
+	std::vector<emInt> globalVerts(nNodes);
+	for (emInt ii : scratch.usedNodes) {
+		double coords[3];
+		getCoords(ii, coords);
+		newIndices[ii] = UCM->addVert(coords);
+		globalVerts[newIndices[ii]] = ii;
+		// Copy length scale for vertices from the parent; otherwise, there will be
+		// mismatches in the refined meshes.
+		UCM->setLengthScale(newIndices[ii], getLengthScale(ii));
 	}
-	free(isVertUsed);
 
 	// Now copy connectivity.
 	emInt newConn[64];
@@ -670,9 +956,9 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 		UCM->addBdryQuad(newConn);
 	}
 
-	// Now, finally, the part bdry connectivity.
-	// TODO: Currently, there's nothing in the data structure that marks which
-	// are part bdry faces.
+	// Now, finally, the part bdry connectivity.  These go after all the real
+	// bdry faces, which is how the part data identifies them.
+	UCM->setPartData(globalVerts, nTris, nQuads);
 	for (auto tri : partBdryTris) {
 		emInt cellInd = tri.getVolElement();
 		emInt conn[10];
@@ -1208,7 +1494,6 @@ std::unique_ptr<CubicMesh> CubicMesh::extractCoarseMesh(Part& P,
 		remapIndices(10, newIndices, conn, newConn);
 		UCM->addBdryQuad(newConn);
 	}
-	delete[] newIndices;
 	CALLGRIND_TOGGLE_COLLECT
 	;
 	return UCM;
@@ -1280,7 +1565,9 @@ std::unique_ptr<UMesh> CubicMesh::createFineUMesh(const emInt numDivs, Part& P,
 		std::vector<CellPartData>& vecCPD, struct RefineStats& RS) const {
 	// Create a coarse
 	double start = exaTime();
+	ScopedTimer extractTimer(eTimeExtract);
 	auto coarse = extractCoarseMesh(P, vecCPD, numDivs);
+	extractTimer.stop();
 	double middle = exaTime();
 	RS.extractTime = middle - start;
 
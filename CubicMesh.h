@@ -28,6 +28,8 @@
 
 #include <assert.h>
 
+#include <vector>
+
 #include "exa_config.h"
 #include "ExaMesh.h"
 
@@ -46,10 +48,19 @@ class CubicMesh: public ExaMesh {
 
 	CubicMesh(const CubicMesh&);
 	CubicMesh& operator=(const CubicMesh&);
-	void readCGNSfile(const char CGNSfilename[]);
-	void reorderCubicMesh();
-	void renumberNodes(emInt thisSize, emInt* aliasConn, emInt* newNodeInd);
-	void decrementVertIndices(emInt connSize, emInt* const connect);
+	CubicMesh(const MeshSize& MS);
+#if (HAVE_CGNS == 1)
+	// Also tags vertex nodes, for reorderCubicMesh.
+	void readCGNSfile(const char CGNSfilename[],
+			std::vector<unsigned char>& isVertexNode);
+#endif
+	void renumberNodes(const size_t thisSize, emInt* aliasConn,
+			const emInt newNodeInd[]);
+	void tagVertexNodes(std::vector<unsigned char>& isVertexNode) const;
+	void permuteCoords(const emInt newNodeInd[],
+			std::vector<unsigned char>& tags);
+	// Uses the tags as scratch space.
+	void reorderCubicMesh(std::vector<unsigned char>& isVertexNode);
 
 	// Confirm positive volume for all subelements
 	bool verifyTetValidity() const;
@@ -65,10 +76,19 @@ public:
 #if (HAVE_CGNS == 1)
 	CubicMesh(const char CGNSFileName[]);
 #endif
+	// A fine cubic mesh, with each coarse cell divided nDivs times.  Nodes
+	// are evaluated from the coarse mapping.  nDivs can be at most
+	// MAX_DIVS / 3.
+	CubicMesh(const CubicMesh& CMIn, const int nDivs);
 	virtual ~CubicMesh();
+	// Puts vertex nodes first and counts them.  Meshes built in memory need to
+	// call this once all their cells are added.
+	void reorderCubicMesh();
 
-	// Will eventually want to create a fine CubicMesh from a coarse CubicMesh
-	// (for the mapping). Not urgent.
+#if (HAVE_CGNS == 1)
+	// One zone, with a section for each element type that's present.
+	bool writeCGNSFile(const char CGNSFileName[]) const;
+#endif
 
 	virtual emInt numVerts() const {
 		return m_nVerts;
@@ -164,6 +184,14 @@ public:
 
 	std::unique_ptr<CubicMesh> extractCoarseMesh(Part& P,
 			std::vector<CellPartData>& vecCPD, const int numDivs) const;
+	// Each extracting thread keeps a stamp and a new index for every node.
+	virtual size_t extractScratchBytes() const {
+		return (sizeof(uint32_t) + sizeof(emInt)) * size_t(numVerts());
+	}
+	virtual std::unique_ptr<ExaMesh> extractCoarsePart(const emInt numDivs,
+			Part& P, std::vector<CellPartData>& vecCPD) const {
+		return extractCoarseMesh(P, vecCPD, numDivs);
+	}
 
 	virtual std::unique_ptr<UMesh> createFineUMesh(const emInt numDivs, Part& P,
 			std::vector<CellPartData>& vecCPD, struct RefineStats& RS) const;
@@ -177,4 +205,9 @@ public:
 	}
 };
 
+// Defined in refineCubic.cxx.  The output mesh must already be sized for
+// the fine mesh.
+void subdivideCubicMesh(const CubicMesh* const pCM_input,
+		CubicMesh* const pCM_output, const int nDivs);
+
 #endif /* SRC_CUBICMESH_H_ */
@@ -0,0 +1,227 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * DividerTables.h
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#ifndef SRC_DIVIDERTABLES_H_
+#define SRC_DIVIDERTABLES_H_
+
+#include "exa-defs.h"
+
+// Child connectivity and interior vert tables for the cell dividers, built
+// at compile time for the common numbers of divisions.  Entries are offsets
+// into a divider's localVerts array, so emitting a cell's children is just
+// a gather.  Children and interior verts come out in exactly the same order
+// as from the generic loops in the dividers, so output doesn't depend on
+// which path was taken.  The dividers use tables for nDivs = 2, 3, 4 and 8,
+// and the generic loops otherwise.
+
+constexpr int localVertOffset(const int i, const int j, const int k) {
+	return (i * (MAX_DIVS + 1) + j) * (MAX_DIVS + 1) + k;
+}
+
+// Bounds on interior (i,j,k) for each cell type, matching maxI, maxJ and
+// getMinInteriorDivs in that type's divider.
+struct TetShape {
+	static constexpr int minInteriorDivs = 4;
+	static constexpr int maxI(const int N, const int j, const int k) {
+		return N - k - j;
+	}
+	static constexpr int maxJ(const int N, const int i, const int k) {
+		return N - k - i;
+	}
+	static constexpr int numInterior(const int N) {
+		return (N - 1) * (N - 2) * (N - 3) / 6;
+	}
+};
+
+struct PrismShape {
+	static constexpr int minInteriorDivs = 3;
+	static constexpr int maxI(const int N, const int j, const int /*k*/) {
+		return N - j;
+	}
+	static constexpr int maxJ(const int N, const int i, const int /*k*/) {
+		return N - i;
+	}
+	static constexpr int numInterior(const int N) {
+		return (N - 1) * (N - 2) * (N - 1) / 2;
+	}
+};
+
+struct HexShape {
+	static constexpr int minInteriorDivs = 2;
+	static constexpr int maxI(const int N, const int /*j*/, const int /*k*/) {
+		return N;
+	}
+	static constexpr int maxJ(const int N, const int /*i*/, const int /*k*/) {
+		return N;
+	}
+	static constexpr int numInterior(const int N) {
+		return (N - 1) * (N - 1) * (N - 1);
+	}
+};
+
+// Interior verts, in the order CellDivider::divideInterior creates them.
+template<int N, typename Shape>
+struct InteriorVertTable {
+	static constexpr int count =
+			(N < Shape::minInteriorDivs) ? 0 : Shape::numInterior(N);
+	int ijk[count > 0 ? count : 1][3];
+	constexpr InteriorVertTable() :
+			ijk() {
+		int vv = 0;
+		if (count == 0) return;
+		for (int kk = 1; kk < N; kk++) {
+			int jMax = Shape::maxJ(N, 1, kk);
+			for (int jj = 1; jj < jMax; jj++) {
+				int iMax = Shape::maxI(N, jj, kk);
+				for (int ii = 1; ii < iMax; ii++) {
+					ijk[vv][0] = ii;
+					ijk[vv][1] = jj;
+					ijk[vv][2] = kk;
+					vv++;
+				}
+			}
+		}
+	}
+};
+
+// Hexes, in the order of HexDivider::createNewCells.
+template<int N>
+struct HexChildTable {
+	static constexpr int count = N * N * N;
+	int conn[count][8];
+	constexpr HexChildTable() :
+			conn() {
+		int cc = 0;
+		for (int level = 1; level <= N; level++) {
+			for (int jj = 0; jj < N; jj++) {
+				for (int ii = 0; ii < N; ii++) {
+					conn[cc][0] = localVertOffset(ii, jj, level);
+					conn[cc][1] = localVertOffset(ii + 1, jj, level);
+					conn[cc][2] = localVertOffset(ii + 1, jj + 1, level);
+					conn[cc][3] = localVertOffset(ii, jj + 1, level);
+					conn[cc][4] = localVertOffset(ii, jj, level - 1);
+					conn[cc][5] = localVertOffset(ii + 1, jj, level - 1);
+					conn[cc][6] = localVertOffset(ii + 1, jj + 1, level - 1);
+					conn[cc][7] = localVertOffset(ii, jj + 1, level - 1);
+					cc++;
+				}
+			}
+		}
+	}
+};
+
+// Prisms, in the order of PrismDivider::createNewCells.
+template<int N>
+struct PrismChildTable {
+	static constexpr int count = N * N * N;
+	int conn[count][6];
+	constexpr PrismChildTable() :
+			conn() {
+		int cc = 0;
+		for (int level = 1; level <= N; level++) {
+			for (int jj = 0; jj < N; jj++) {
+				for (int ii = 0; ii < N - jj; ii++) {
+					conn[cc][0] = localVertOffset(ii, jj, level);
+					conn[cc][1] = localVertOffset(ii + 1, jj, level);
+					conn[cc][2] = localVertOffset(ii, jj + 1, level);
+					conn[cc][3] = localVertOffset(ii, jj, level - 1);
+					conn[cc][4] = localVertOffset(ii + 1, jj, level - 1);
+					conn[cc][5] = localVertOffset(ii, jj + 1, level - 1);
+					cc++;
+					// The other prism of the pair, except at the end of the row.
+					if (ii < N - jj - 1) {
+						conn[cc][0] = localVertOffset(ii + 1, jj, level);
+						conn[cc][1] = localVertOffset(ii + 1, jj + 1, level);
+						conn[cc][2] = localVertOffset(ii, jj + 1, level);
+						conn[cc][3] = localVertOffset(ii + 1, jj, level - 1);
+						conn[cc][4] = localVertOffset(ii + 1, jj + 1, level - 1);
+						conn[cc][5] = localVertOffset(ii, jj + 1, level - 1);
+						cc++;
+					}
+				}
+			}
+		}
+	}
+};
+
+// Tets, in the order of TetDivider::createNewCells.  Within each level,
+// there are first the up- and down-pointing tets, which are fixed, then the
+// octahedra, which are split into four tets along their shortest diagonal
+// once the coords of their verts are known.  Octahedron verts are in the
+// order A-F used by TetDivider.
+template<int N>
+struct TetChildTable {
+	static constexpr int numFixed = N * (N + 1) * (N + 2) / 6
+			+ (N - 2) * (N - 1) * N / 6;
+	static constexpr int numOcts = (N - 1) * N * (N + 1) / 6;
+	static constexpr int count = numFixed + 4 * numOcts;
+	int fixed[numFixed][4];
+	int octs[numOcts][6];
+	constexpr TetChildTable() :
+			fixed(), octs() {
+		int ff = 0, oo = 0;
+		for (int level = 1; level <= N; level++) {
+			int kk = N - level;
+			for (int jj = 0; jj < level; jj++) {
+				for (int ii = 0; ii < level - jj; ii++) {
+					fixed[ff][0] = localVertOffset(ii, jj, kk);
+					fixed[ff][1] = localVertOffset(ii + 1, jj, kk);
+					fixed[ff][2] = localVertOffset(ii, jj + 1, kk);
+					fixed[ff][3] = localVertOffset(ii, jj, kk + 1);
+					ff++;
+				}
+			}
+			for (int jj = 0; jj <= level - 3; jj++) {
+				for (int ii = 1; ii <= level - jj - 2; ii++) {
+					fixed[ff][0] = localVertOffset(ii, jj, kk + 1);
+					fixed[ff][1] = localVertOffset(ii - 1, jj + 1, kk + 1);
+					fixed[ff][2] = localVertOffset(ii, jj + 1, kk + 1);
+					fixed[ff][3] = localVertOffset(ii, jj + 1, kk);
+					ff++;
+				}
+			}
+			for (int jj = 0; jj <= level - 2; jj++) {
+				for (int ii = 1; ii <= level - jj - 1; ii++) {
+					octs[oo][0] = localVertOffset(ii, jj, kk);
+					octs[oo][1] = localVertOffset(ii, jj + 1, kk);
+					octs[oo][2] = localVertOffset(ii - 1, jj + 1, kk);
+					octs[oo][3] = localVertOffset(ii - 1, jj, kk + 1);
+					octs[oo][4] = localVertOffset(ii, jj, kk + 1);
+					octs[oo][5] = localVertOffset(ii - 1, jj + 1, kk + 1);
+					oo++;
+				}
+			}
+		}
+	}
+	// Up- and down-pointing tets in one level.
+	static constexpr int fixedInLevel(const int level) {
+		return level * (level + 1) / 2 + (level - 1) * (level - 2) / 2;
+	}
+	static constexpr int octsInLevel(const int level) {
+		return level * (level - 1) / 2;
+	}
+};
+
+#endif /* SRC_DIVIDERTABLES_H_ */
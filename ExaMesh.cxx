@@ -24,7 +24,14 @@
  */
 
 #include <assert.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <iostream>
 
@@ -33,9 +40,14 @@ using std::endl;
 
 #include "ExaMesh.h"
 #include "GeomUtils.h"
+#include "Instrument.h"
 #include "Part.h"
+#include "SharedUGrid.h"
 #include "UMesh.h"
 
+#if (HAVE_CGNS == 1)
+#include <cgnslib.h>
+#endif
 
 
 static void triUnitNormal(const double coords0[], const double coords1[],
@@ -58,6 +70,7 @@ static void quadUnitNormal(const double coords0[], const double coords1[],
 }
 
 void ExaMesh::setupLengthScales() {
+	ScopedTimer lengthScaleTimer(eTimeLengthScales);
 	if (!m_lenScale) {
 		m_lenScale = new double[numVerts()];
 	}
@@ -281,18 +294,23 @@ void ExaMesh::setupLengthScales() {
 	} // Done with hexahedra
 
 	// Now loop over verts computing the length scale
-	for (emInt vv = 0; vv < numVerts(); vv++) {
+	for (emInt vv = 0; vv < numVertsToCopy(); vv++) {
 //		assert(vertVolume[vv] > 0 && vertSolidAngle[vv] > 0);
 		double volume = vertVolume[vv] * (4 * M_PI) / vertSolidAngle[vv];
 		double radius = cbrt(volume / (4 * M_PI / 3.));
 		m_lenScale[vv] = radius;
 	}
+	// Higher-order nodes aren't cell corners, so they get the same default as
+	// a mesh with no length scales at all.
+	for (emInt vv = numVertsToCopy(); vv < numVerts(); vv++) {
+		m_lenScale[vv] = 1;
+	}
 }
 
 MeshSize ExaMesh::computeFineMeshSize(const int nDivs) const {
 	MeshSize MSIn, MSOut;
 	MSIn.nBdryVerts = numBdryVerts();
-	MSIn.nVerts = numVerts();
+	MSIn.nVerts = numVertsToCopy();
 	MSIn.nBdryTris = numBdryTris();
 	MSIn.nBdryQuads = numBdryQuads();
 	MSIn.nTets = numTets();
@@ -302,9 +320,71 @@ MeshSize ExaMesh::computeFineMeshSize(const int nDivs) const {
 	bool sizesOK = ::computeMeshSize(MSIn, nDivs, MSOut);
 	if (!sizesOK) exit(2);
 
+	// The vert count from computeMeshSize comes from the Euler characteristic,
+	// which is only an estimate for parts that aren't a single solid with
+	// a connected bdry.  Parts are small enough to count exactly.
+	if (isPartMesh()) {
+		size_t nVerts = countFineVerts(nDivs);
+		if (nVerts > EMINT_MAX) {
+			fprintf(stderr, "Output mesh will exceed max index size!\n");
+			exit(2);
+		}
+		MSOut.nVerts = nVerts;
+	}
 	return MSOut;
 }
 
+static void addCellEdges(std::vector<std::pair<emInt, emInt> >& edges,
+		const emInt conn[], const int edgeVerts[][2], const int nEdges) {
+	for (int ee = 0; ee < nEdges; ee++) {
+		emInt v0 = conn[edgeVerts[ee][0]], v1 = conn[edgeVerts[ee][1]];
+		edges.push_back(std::make_pair(std::min(v0, v1), std::max(v0, v1)));
+	}
+}
+
+size_t ExaMesh::countFineVerts(const int n) const {
+	static const int tetEdges[][2] = { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 0, 3 },
+																			{ 1, 3 }, { 2, 3 } };
+	static const int pyrEdges[][2] = { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 },
+																			{ 0, 4 }, { 1, 4 }, { 2, 4 }, { 3, 4 } };
+	static const int prismEdges[][2] = { { 0, 1 }, { 1, 2 }, { 2, 0 },
+																				{ 3, 4 }, { 4, 5 }, { 5, 3 },
+																				{ 0, 3 }, { 1, 4 }, { 2, 5 } };
+	static const int hexEdges[][2] = { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 },
+																			{ 4, 5 }, { 5, 6 }, { 6, 7 }, { 7, 4 },
+																			{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 } };
+	std::vector<std::pair<emInt, emInt> > edges;
+	edges.reserve(6 * size_t(numTets()) + 8 * size_t(numPyramids())
+			+ 9 * size_t(numPrisms()) + 12 * size_t(numHexes()));
+	for (emInt ii = 0; ii < numTets(); ii++) {
+		addCellEdges(edges, getTetConn(ii), tetEdges, 6);
+	}
+	for (emInt ii = 0; ii < numPyramids(); ii++) {
+		addCellEdges(edges, getPyrConn(ii), pyrEdges, 8);
+	}
+	for (emInt ii = 0; ii < numPrisms(); ii++) {
+		addCellEdges(edges, getPrismConn(ii), prismEdges, 9);
+	}
+	for (emInt ii = 0; ii < numHexes(); ii++) {
+		addCellEdges(edges, getHexConn(ii), hexEdges, 12);
+	}
+	std::sort(edges.begin(), edges.end());
+	size_t nEdges = std::unique(edges.begin(), edges.end()) - edges.begin();
+
+	// Every face is either on the bdry or shared by two cells.
+	size_t nTris = (size_t(numBdryTris()) + 4 * size_t(numTets())
+			+ 4 * size_t(numPyramids()) + 2 * size_t(numPrisms())) / 2;
+	size_t nQuads = (size_t(numBdryQuads()) + numPyramids()
+			+ 3 * size_t(numPrisms()) + 6 * size_t(numHexes())) / 2;
+
+	return numVertsToCopy() + nEdges * (n - 1)
+			+ nTris * ((n - 1) * (n - 2) / 2) + nQuads * ((n - 1) * (n - 1))
+			+ numTets() * size_t((n - 3) * (n - 2) * (n - 1) / 6)
+			+ numPyramids() * size_t((2 * n - 3) * (n - 2) * (n - 1) / 6)
+			+ numPrisms() * size_t((n - 1) * (n - 2) * (n - 1) / 2)
+			+ numHexes() * size_t((n - 1) * (n - 1) * (n - 1));
+}
+
 void ExaMesh::printMeshSizeStats() {
 	cout << "Mesh has:" << endl;
 	cout.width(16);
@@ -343,8 +423,203 @@ void ExaMesh::prettyPrintCellCount(size_t cells, const char* prefix) const {
 	}
 }
 
-void ExaMesh::refineForParallel(const emInt numDivs,
-		const emInt maxCellsPerPart) const {
+bool ExaMesh::estimateCoarsePartSize(const Part& P,
+		const std::vector<CellPartData>& vecCPD, struct MeshSize& MSIn) const {
+	// Count cells of each type in the part.  Both linear and cubic cell types
+	// can show up here, depending on which kind of mesh we are.
+	size_t nTets(0), nPyrs(0), nPrisms(0), nHexes(0);
+	for (emInt ii = P.getFirst(); ii < P.getLast(); ii++) {
+		switch (vecCPD[ii].getCellType()) {
+			case TETRA_4:
+			case TETRA_20:
+				nTets++;
+				break;
+			case PYRA_5:
+			case PYRA_30:
+				nPyrs++;
+				break;
+			case PENTA_6:
+			case PENTA_40:
+				nPrisms++;
+				break;
+			case HEXA_8:
+			case HEXA_64:
+				nHexes++;
+				break;
+			default:
+				assert(0);
+				break;
+		}
+	}
+	size_t partCells = nTets + nPyrs + nPrisms + nHexes;
+	size_t allCells = size_t(numTets()) + numPyramids() + numPrisms()
+			+ numHexes();
+	if (partCells == 0 || allCells == 0) return false;
+	double frac = double(partCells) / allCells;
+
+	// Verts and real bdry faces are assumed to be spread evenly over the parts.
+	// Part bdry faces are estimated as the surface of a cube-shaped part, split
+	// between tris and quads in proportion to cell faces of each kind.
+	double partSurf = 6 * pow(double(partCells), 2. / 3.);
+	double cellTris = 4. * nTets + 4. * nPyrs + 2. * nPrisms;
+	double cellQuads = 1. * nPyrs + 3. * nPrisms + 6. * nHexes;
+	double triShare = cellTris / (cellTris + cellQuads);
+
+	MSIn.nVerts = std::min(double(EMINT_MAX), numVerts() * frac + partSurf);
+	MSIn.nBdryVerts = std::min(double(MSIn.nVerts),
+															numBdryVerts() * frac + partSurf);
+	MSIn.nBdryTris = std::min(double(EMINT_MAX),
+														numBdryTris() * frac + partSurf * triShare);
+	MSIn.nBdryQuads = std::min(double(EMINT_MAX),
+															numBdryQuads() * frac + partSurf * (1 - triShare));
+	MSIn.nTets = nTets;
+	MSIn.nPyrs = nPyrs;
+	MSIn.nPrisms = nPrisms;
+	MSIn.nHexes = nHexes;
+	return true;
+}
+
+size_t ExaMesh::estimatePartMemory(const emInt numDivs, const Part& P,
+		const std::vector<CellPartData>& vecCPD) const {
+	MeshSize MSIn;
+	if (!estimateCoarsePartSize(P, vecCPD, MSIn)) return 0;
+
+	// Extraction also needs scratch space over all the verts in the whole
+	// coarse mesh.
+	size_t bytes = estimateRefinementMemory(MSIn, numDivs);
+	if (bytes == SIZE_MAX) return bytes;
+	return bytes + extractScratchBytes();
+}
+
+static void printBytes(const char* prefix, const size_t bytes) {
+	if (bytes >> 30) {
+		printf("%s %.2f GB\n", prefix, (bytes >> 20) / 1024.);
+	}
+	else {
+		printf("%s %.2f MB\n", prefix, (bytes >> 10) / 1024.);
+	}
+}
+
+// Hands out parts, biggest first, keeping the predicted memory of the parts in
+// flight within the budget (no limit if the budget is zero).  A part that
+// doesn't fit at all is still handed out once nothing else is in flight.
+// Threads with nothing to do sleep until some part finishes.
+class PartScheduler {
+	const std::vector<size_t>& m_partBytes;
+	const std::vector<emInt>& m_order;
+	const size_t m_budget;
+	std::vector<bool> m_isAdmitted;
+	emInt m_nAdmitted;
+	size_t m_bytesInFlight, m_peakBytesInFlight;
+	std::mutex m_mutex;
+	std::condition_variable m_partDone;
+public:
+	PartScheduler(const std::vector<size_t>& partBytes,
+			const std::vector<emInt>& order, const size_t budget) :
+			m_partBytes(partBytes), m_order(order), m_budget(budget),
+			m_isAdmitted(order.size(), false), m_nAdmitted(0), m_bytesInFlight(0),
+			m_peakBytesInFlight(0) {
+	}
+	// Returns the number of parts once every part has been handed out.
+	emInt admit() {
+		const emInt nParts = m_order.size();
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (m_nAdmitted < nParts) {
+			for (emInt jj = 0; jj < nParts; jj++) {
+				emInt cand = m_order[jj];
+				if (m_isAdmitted[cand]) continue;
+				if (m_budget == 0 || m_bytesInFlight == 0
+						|| m_bytesInFlight + m_partBytes[cand] <= m_budget) {
+					m_isAdmitted[cand] = true;
+					m_nAdmitted++;
+					m_bytesInFlight += m_partBytes[cand];
+					m_peakBytesInFlight = std::max(m_peakBytesInFlight, m_bytesInFlight);
+					return cand;
+				}
+			}
+			m_partDone.wait(lock);
+		}
+		return nParts;
+	}
+	void finish(const emInt part) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_bytesInFlight -= m_partBytes[part];
+		}
+		m_partDone.notify_all();
+	}
+	size_t getPeakBytesInFlight() const {
+		return m_peakBytesInFlight;
+	}
+};
+
+// What the manifest needs to know about each part after it's gone.
+struct PartOutputInfo {
+	size_t fileSize;
+	emInt verts, bdryTris, bdryQuads, tets, pyrs, prisms, hexes;
+	double extractTime, refineTime, writeTime;
+};
+
+static void writePartFileName(char fileName[], const char outFileBase[],
+		const emInt part, const char suffix[]) {
+	snprintf(fileName, FILE_NAME_LEN, "%s.part%04u.%s", outFileBase, part,
+						suffix);
+}
+
+static void writeUGridPartFileName(char fileName[], const char outFileBase[],
+		const char outInfix[], const emInt part) {
+	snprintf(fileName, FILE_NAME_LEN, "%s.part%04u.%s.ugrid", outFileBase, part,
+						outInfix);
+}
+
+// With a shared output file, every part lists that file, and no bdry map or
+// global ID file unless partMaps is set (one CGNS zone per part).
+static bool writeManifest(const char outFileBase[], const char outInfix[],
+		const emInt numDivs, const std::vector<PartOutputInfo>& partInfo,
+		const char sharedFileName[] = nullptr, const bool partMaps = false) {
+	char fileName[FILE_NAME_LEN];
+	snprintf(fileName, FILE_NAME_LEN, "%s.manifest", outFileBase);
+	FILE* outFile = fopen(fileName, "w");
+	if (!outFile) {
+		fprintf(stderr, "Couldn't open file %s for writing.  Bummer!\n", fileName);
+		return false;
+	}
+	fprintf(outFile, "# ExaMesh parallel refinement manifest\n");
+	fprintf(outFile, "divs %u\n", numDivs);
+	fprintf(outFile, "parts %lu\n", partInfo.size());
+	fprintf(outFile, "# part ugrid_file bytes verts bdry_tris bdry_quads tets "
+					"pyrs prisms hexes extract_sec refine_sec write_sec bdry_map_file "
+					"gids_file\n");
+	for (emInt ii = 0; ii < partInfo.size(); ii++) {
+		const PartOutputInfo& PI = partInfo[ii];
+		char ugridName[FILE_NAME_LEN], mapName[FILE_NAME_LEN],
+				gidsName[FILE_NAME_LEN];
+		if (sharedFileName) {
+			snprintf(ugridName, FILE_NAME_LEN, "%s", sharedFileName);
+		}
+		else {
+			writeUGridPartFileName(ugridName, outFileBase, outInfix, ii);
+		}
+		if (sharedFileName && !partMaps) {
+			snprintf(mapName, FILE_NAME_LEN, "-");
+			snprintf(gidsName, FILE_NAME_LEN, "-");
+		}
+		else {
+			writePartFileName(mapName, outFileBase, ii, "bdrymap");
+			writePartFileName(gidsName, outFileBase, ii, "gids");
+		}
+		fprintf(outFile, "%u %s %lu %u %u %u %u %u %u %u %.3f %.3f %.3f %s %s\n",
+						ii, ugridName, PI.fileSize, PI.verts, PI.bdryTris, PI.bdryQuads,
+						PI.tets, PI.pyrs, PI.prisms, PI.hexes, PI.extractTime,
+						PI.refineTime, PI.writeTime, mapName, gidsName);
+	}
+	fclose(outFile);
+	return true;
+}
+
+emInt ExaMesh::partitionForRefinement(const emInt numDivs,
+		const emInt maxCellsPerPart, const bool useGraphPartitioner,
+		std::vector<Part>& parts, std::vector<CellPartData>& vecCPD) const {
 	// Find size of output mesh
 	size_t numCells = numTets() + numPyramids() + numHexes() + numPrisms();
 	size_t outputCells = numCells * (numDivs * numDivs * numDivs);
@@ -355,52 +630,255 @@ void ExaMesh::refineForParallel(const emInt numDivs,
 	if (nParts > numCells) nParts = numCells;
 
 	// Partition the mesh.
+	ScopedTimer partitionTimer(eTimePartition);
+	if (useGraphPartitioner) {
+		partitionCellsMultilevel(this, nParts, parts, vecCPD);
+	}
+	else {
+		partitionCells(this, nParts, parts, vecCPD);
+	}
+	return nParts;
+}
+
+void ExaMesh::refineForParallel(const emInt numDivs,
+		const emInt maxCellsPerPart, const size_t memoryBudget,
+		const char outFileBase[], const bool singleFile,
+		const bool useGraphPartitioner, const char outInfix[],
+		const bool evaluatePartitions) const {
+	// CGNS output keeps the default UGRID format for the layout, which never
+	// writes a UGRID file.
+	UGridFormat format { sizeof(double), true, false };
+	const bool cgnsOutput = outFileBase && strcmp(outInfix, "cgns") == 0;
+#if (HAVE_CGNS != 1)
+	if (cgnsOutput) {
+		fprintf(stderr, "Not compiled with CGNS; can't write CGNS files.\n");
+		exit(1);
+	}
+#endif
+	if (outFileBase && !cgnsOutput && !parseUGridInfix(outInfix, format)) {
+		fprintf(stderr, "Can't write UGRID files with infix %s.\n", outInfix);
+		exit(1);
+	}
+	if (outFileBase && singleFile && format.fortranRecords) {
+		fprintf(stderr, "A single shared file can't have Fortran records; "
+						"use b8, lb8, b4 or lb4.\n");
+		exit(1);
+	}
 	std::vector<Part> parts;
 	std::vector<CellPartData> vecCPD;
 	double start = exaTime();
-	partitionCells(this, nParts, parts, vecCPD);
+	emInt nParts = partitionForRefinement(numDivs, maxCellsPerPart,
+																				useGraphPartitioner, parts, vecCPD);
 	double partitionTime = exaTime() - start;
 
+	if (evaluatePartitions) {
+		size_t cutFaces;
+		double imbalance;
+		evaluatePartition(this, parts, vecCPD, cutFaces, imbalance);
+		printf("Partition: %lu faces between parts, imbalance %.3f\n", cutFaces,
+						imbalance);
+		if (useGraphPartitioner) {
+			// Compare with what coordinate bisection would have done.
+			std::vector<Part> RCBParts;
+			std::vector<CellPartData> RCBvecCPD;
+			partitionCells(this, nParts, RCBParts, RCBvecCPD);
+			evaluatePartition(this, RCBParts, RCBvecCPD, cutFaces, imbalance);
+			printf("Coordinate bisection would have had %lu faces between parts, "
+							"imbalance %.3f\n", cutFaces, imbalance);
+		}
+	}
+
+	// Predict how much memory each part will need, and schedule the biggest
+	// ones first.  Small parts then fill in around them at the end, when
+	// there's less budget left over.
+	std::vector<size_t> partBytes(nParts);
+	std::vector<emInt> order(nParts);
+	for (emInt ii = 0; ii < nParts; ii++) {
+		partBytes[ii] = estimatePartMemory(numDivs, parts[ii], vecCPD);
+		order[ii] = ii;
+	}
+	std::stable_sort(order.begin(), order.end(),
+			[&partBytes](const emInt a, const emInt b) {
+				return partBytes[a] > partBytes[b];
+			});
+	if (memoryBudget > 0) {
+		printBytes("Memory budget:", memoryBudget);
+		printBytes("Largest part predicted to need:", partBytes[order[0]]);
+		if (partBytes[order[0]] > memoryBudget) {
+			fprintf(stderr, "Warning: some parts are predicted to exceed the "
+							"memory budget; these will be refined one at a time.\n");
+		}
+	}
+
+	// Global numbering of fine verts has to be known before any part is
+	// written, whether to its own file (with a global ID map) or to its share
+	// of a single file.  That takes an extra pass of coarse part extraction,
+	// which is cheap compared with refinement.  Extraction needs no more than
+	// refinement does, so the same budget and predictions keep it in bounds.
+	std::unique_ptr<SharedUGridLayout> pLayout;
+	char sharedFileName[FILE_NAME_LEN];
+	int sharedFD = -1;
+	double layoutTime = 0;
+	if (outFileBase) {
+		double layoutStart = exaTime();
+		pLayout.reset(new SharedUGridLayout(numDivs, nParts, format));
+		PartScheduler layoutScheduler(partBytes, order, memoryBudget);
+#pragma omp parallel
+		{
+			for (emInt ii = layoutScheduler.admit(); ii < nParts;
+					ii = layoutScheduler.admit()) {
+				std::unique_ptr<ExaMesh> pCoarse = extractCoarsePart(numDivs,
+																															parts[ii],
+																															vecCPD);
+				pLayout->addPart(ii, *pCoarse);
+				pCoarse.reset();
+				layoutScheduler.finish(ii);
+			}
+		}
+		pLayout->finalize();
+		layoutTime = exaTime() - layoutStart;
+		printf("Global vert numbering: %u verts, %u on part bdries; %.3F seconds\n",
+						pLayout->numVerts(), pLayout->numSharedVerts(), layoutTime);
+	}
+#if (HAVE_CGNS == 1)
+	int cgnsFile = 0, cgnsBase = 0;
+	if (cgnsOutput) {
+		snprintf(sharedFileName, FILE_NAME_LEN, "%s.cgns", outFileBase);
+		if (cg_open(sharedFileName, CG_MODE_WRITE, &cgnsFile) != CG_OK
+				|| cg_base_write(cgnsFile, "Base", 3, 3, &cgnsBase) != CG_OK
+				|| (singleFile && !pLayout->writeCGNSHeader(cgnsFile, cgnsBase))) {
+			fprintf(stderr, "Couldn't set up file %s for writing.  Bummer!\n",
+							sharedFileName);
+			exit(1);
+		}
+	}
+#endif
+	if (outFileBase && singleFile && !cgnsOutput) {
+		snprintf(sharedFileName, FILE_NAME_LEN, "%s.%s.ugrid", outFileBase,
+							outInfix);
+		sharedFD = open(sharedFileName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (sharedFD < 0
+				|| ftruncate(sharedFD, pLayout->getFileSize()) != 0
+				|| !pLayout->writeHeader(sharedFD)) {
+			fprintf(stderr, "Couldn't set up file %s for writing.  Bummer!\n",
+							sharedFileName);
+			exit(1);
+		}
+	}
+
 	// Create new sub-meshes and refine them.
 	double totalRefineTime = 0;
 	double totalExtractTime = 0;
 	size_t totalCells = 0;
 	size_t totalTets = 0, totalPyrs = 0, totalPrisms = 0, totalHexes = 0;
 	size_t totalFileSize = 0;
-	struct RefineStats RS;
-	double totalTime = partitionTime;
-	emInt ii;
-//#pragma omp parallel for schedule(dynamic) reduction(+: totalRefineTime, totalExtractTime, totalTets, totalPyrs, totalPrisms, totalHexes, totalCells) num_threads(8)
-	for (ii = 0; ii < nParts; ii++) {
-		start = exaTime();
-//		char filename[100];
-//		sprintf(filename, "/tmp/submesh%03d.vtk", ii);
-//		writeVTKFile(filename);
-		printf("Part %3d: cells %5d-%5d.\n", ii, parts[ii].getFirst(),
-						parts[ii].getLast());
-		std::unique_ptr<UMesh> pUM = createFineUMesh(numDivs, parts[ii], vecCPD,
-																									RS);
-		totalRefineTime += RS.refineTime;
-		totalExtractTime += RS.extractTime;
-		totalCells += RS.cells;
-		totalTets += pUM->numTets();
-		totalPyrs += pUM->numPyramids();
-		totalPrisms += pUM->numPrisms();
-		totalHexes += pUM->numHexes();
-		totalFileSize += pUM->getFileImageSize();
-		totalTime += exaTime() - start;
-		printf("\nCPU time for refinement = %5.2F seconds\n",
-						RS.refineTime);
-		printf("                          %5.2F million cells / minute\n",
-						(RS.cells / 1000000.) / (RS.refineTime / 60));
-
-//		char filename[100];
-//		sprintf(filename, "/tmp/fine-submesh%03d.vtk", ii);
-//		pUM->writeVTKFile(filename);
+	std::vector<PartOutputInfo> partInfo(nParts);
+	PartScheduler scheduler(partBytes, order, memoryBudget);
+	start = exaTime();
+#pragma omp parallel reduction(+: totalRefineTime, totalExtractTime, totalTets, totalPyrs, totalPrisms, totalHexes, totalCells, totalFileSize)
+	{
+		for (emInt ii = scheduler.admit(); ii < nParts; ii = scheduler.admit()) {
+			printf("Part %3d: cells %5d-%5d.\n", ii, parts[ii].getFirst(),
+							parts[ii].getLast());
+			struct RefineStats RS;
+			std::unique_ptr<UMesh> pUM = createFineUMesh(numDivs, parts[ii], vecCPD,
+																										RS);
+			totalRefineTime += RS.refineTime;
+			totalExtractTime += RS.extractTime;
+			totalCells += RS.cells;
+			totalTets += pUM->numTets();
+			totalPyrs += pUM->numPyramids();
+			totalPrisms += pUM->numPrisms();
+			totalHexes += pUM->numHexes();
+			const size_t fileSize = cgnsOutput ? 0 : pUM->getUGridFileSize(format);
+			totalFileSize += fileSize;
+			printf("\nCPU time for refinement = %5.2F seconds\n",
+							RS.refineTime);
+			printf("                          %5.2F million cells / minute\n",
+							(RS.cells / 1000000.) / (RS.refineTime / 60));
+
+			PartOutputInfo& PI = partInfo[ii];
+			PI.fileSize = fileSize;
+			PI.verts = pUM->numVerts();
+			PI.bdryTris = pUM->numBdryTris();
+			PI.bdryQuads = pUM->numBdryQuads();
+			PI.tets = pUM->numTets();
+			PI.pyrs = pUM->numPyramids();
+			PI.prisms = pUM->numPrisms();
+			PI.hexes = pUM->numHexes();
+			PI.extractTime = RS.extractTime;
+			PI.refineTime = RS.refineTime;
+			PI.writeTime = 0;
+			if (cgnsOutput) {
+#if (HAVE_CGNS == 1)
+				double writeStart = exaTime();
+				if (singleFile) {
+					if (!pLayout->writeCGNSPart(cgnsFile, ii, *pUM)) {
+						fprintf(stderr, "Couldn't write part %u to %s.\n", ii,
+										sharedFileName);
+						exit(1);
+					}
+				}
+				else {
+					char name[FILE_NAME_LEN];
+					snprintf(name, FILE_NAME_LEN, "Zone%04u", ii);
+					pUM->writeCGNSZone(cgnsFile, cgnsBase, name);
+					writePartFileName(name, outFileBase, ii, "bdrymap");
+					pUM->writePartBdryMap(name);
+					writePartFileName(name, outFileBase, ii, "gids");
+					pLayout->writeGlobalIDs(name, ii, *pUM);
+				}
+				PI.writeTime = exaTime() - writeStart;
+#endif
+			}
+			else if (singleFile && outFileBase) {
+				double writeStart = exaTime();
+				if (!pLayout->writePart(sharedFD, ii, *pUM)) {
+					fprintf(stderr, "Couldn't write part %u to %s.\n", ii,
+									sharedFileName);
+					exit(1);
+				}
+				PI.writeTime = exaTime() - writeStart;
+			}
+			else if (outFileBase) {
+				double writeStart = exaTime();
+				char fileName[FILE_NAME_LEN];
+				writeUGridPartFileName(fileName, outFileBase, outInfix, ii);
+				pUM->writeUGridFile(fileName, outInfix);
+				writePartFileName(fileName, outFileBase, ii, "bdrymap");
+				pUM->writePartBdryMap(fileName);
+				writePartFileName(fileName, outFileBase, ii, "gids");
+				pLayout->writeGlobalIDs(fileName, ii, *pUM);
+				PI.writeTime = exaTime() - writeStart;
+			}
+			pUM.reset();
+			scheduler.finish(ii);
+		}
+	}
+	double totalTime = partitionTime + layoutTime + exaTime() - start;
+	if (cgnsOutput) {
+#if (HAVE_CGNS == 1)
+		if (cg_close(cgnsFile) != CG_OK) {
+			fprintf(stderr, "Couldn't close file %s.\n", sharedFileName);
+			exit(1);
+		}
+#endif
+		writeManifest(outFileBase, outInfix, numDivs, partInfo, sharedFileName,
+									!singleFile);
+	}
+	else if (singleFile && outFileBase) {
+		close(sharedFD);
+		writeManifest(outFileBase, outInfix, numDivs, partInfo, sharedFileName);
+	}
+	else if (outFileBase) {
+		writeManifest(outFileBase, outInfix, numDivs, partInfo);
 	}
 	printf("\nDone parallel refinement with %d parts.\n", nParts);
 	printf("Time for partitioning:           %10.3F seconds\n",
 					partitionTime);
+	if (outFileBase) {
+		printf("Time for global vert numbering:  %10.3F seconds\n", layoutTime);
+	}
 	printf("Time for coarse mesh extraction: %10.3F seconds\n",
 					totalExtractTime);
 	printf("Time for refinement:             %10.3F seconds\n",
@@ -409,16 +887,20 @@ void ExaMesh::refineForParallel(const emInt numDivs,
 					(totalCells / 1000000.) / (totalRefineTime / 60));
 	printf("Rate (overall):          %5.2F million cells / minute\n",
 					(totalCells / 1000000.) / (totalTime / 60));
+	printBytes("Peak predicted memory in flight:",
+						scheduler.getPeakBytesInFlight());
 
-	if (totalFileSize >> 37) {
-		printf("Total ugrid file size = %lu GB\n", totalFileSize >> 30);
-	}
-	else if (totalFileSize >> 30) {
-		printf("Total ugrid file size = %.2f GB\n",
-						(totalFileSize >> 20) / 1024.);
-	}
-	else {
-		printf("Total ugrid file size = %lu MB\n", totalFileSize >> 20);
+	if (!cgnsOutput) {
+		if (totalFileSize >> 37) {
+			printf("Total ugrid file size = %lu GB\n", totalFileSize >> 30);
+		}
+		else if (totalFileSize >> 30) {
+			printf("Total ugrid file size = %.2f GB\n",
+							(totalFileSize >> 20) / 1024.);
+		}
+		else {
+			printf("Total ugrid file size = %lu MB\n", totalFileSize >> 20);
+		}
 	}
 
 	prettyPrintCellCount(totalCells, "Total cells");
@@ -428,6 +910,175 @@ void ExaMesh::refineForParallel(const emInt numDivs,
 	prettyPrintCellCount(totalHexes, "Total hexes");
 }
 
+// Resident set size of this process right now, in bytes.
+static size_t currentRSS() {
+	size_t pages = 0, residentPages = 0;
+	FILE* statFile = fopen("/proc/self/statm", "r");
+	if (!statFile) return 0;
+	if (fscanf(statFile, "%lu %lu", &pages, &residentPages) != 2) {
+		residentPages = 0;
+	}
+	fclose(statFile);
+	return residentPages * sysconf(_SC_PAGESIZE);
+}
+
+bool ExaMesh::planRefinement(const emInt numDivs,
+		const emInt maxCellsPerPart, const size_t memoryBudget,
+		const int nThreads, struct RefinePlan& plan,
+		const bool useGraphPartitioner) const {
+	std::vector<Part> parts;
+	std::vector<CellPartData> vecCPD;
+	double start = exaTime();
+	emInt nParts = partitionForRefinement(numDivs, maxCellsPerPart,
+																				useGraphPartitioner, parts, vecCPD);
+	plan.nParts = nParts;
+	plan.partitionTime = exaTime() - start;
+	plan.fineVerts = plan.fineCells = plan.fileBytes = 0;
+	plan.largestPartBytes = 0;
+	plan.layoutTime = 0;
+	plan.indexOverflow = false;
+
+	// Fine mesh size, file size, memory and time for each part.  The part is
+	// never extracted; its coarse size is estimated the same way as for
+	// memory scheduling.
+	std::vector<size_t> partBytes(nParts), partFileBytes(nParts);
+	std::vector<double> partTime(nParts);
+	std::vector<emInt> order(nParts);
+	printf("Refinement plan: %d divisions, %u parts, %d threads\n", numDivs,
+					nParts, nThreads);
+	printf("%6s %12s %12s %10s %10s %10s\n", "part", "fine cells",
+					"fine verts", "file MB", "memory MB", "seconds");
+	for (emInt ii = 0; ii < nParts; ii++) {
+		order[ii] = ii;
+		MeshSize MSIn, MSOut;
+		if (!estimateCoarsePartSize(parts[ii], vecCPD, MSIn)) {
+			partBytes[ii] = partFileBytes[ii] = 0;
+			partTime[ii] = 0;
+			continue;
+		}
+		if (!computeMeshSize(MSIn, numDivs, MSOut)) {
+			fprintf(stderr, "Part %u will exceed max index size; use more parts.\n",
+							ii);
+			plan.indexOverflow = true;
+			partBytes[ii] = partFileBytes[ii] = 0;
+			partTime[ii] = 0;
+			continue;
+		}
+		size_t fineCells = size_t(MSOut.nTets) + MSOut.nPyrs + MSOut.nPrisms
+				+ MSOut.nHexes;
+		partBytes[ii] = estimatePartMemory(numDivs, parts[ii], vecCPD);
+		partFileBytes[ii] = ugridFileBytes(MSOut);
+		double extractTime = estimateExtractTime(MSIn);
+		partTime[ii] = extractTime + estimateRefinementTime(MSIn, numDivs)
+				+ estimateWriteTime(partFileBytes[ii]);
+		plan.layoutTime += extractTime;
+		plan.fineVerts += MSOut.nVerts;
+		plan.fineCells += fineCells;
+		plan.fileBytes += partFileBytes[ii];
+		plan.largestPartBytes = std::max(plan.largestPartBytes, partBytes[ii]);
+		printf("%6u %12lu %12u %10.2f %10.2f %10.3f\n", ii, fineCells,
+						MSOut.nVerts, (partFileBytes[ii] >> 10) / 1024.,
+						(partBytes[ii] >> 10) / 1024., partTime[ii]);
+	}
+	// The global vert numbering pass extracts every part again, in parallel.
+	plan.layoutTime /= nThreads;
+
+	// Replay the scheduling in refineForParallel: whenever a thread is free,
+	// it takes the largest part that fits in what's left of the budget, or
+	// waits for a running part to finish if none does.
+	std::stable_sort(order.begin(), order.end(),
+			[&partBytes](const emInt a, const emInt b) {
+				return partBytes[a] > partBytes[b];
+			});
+	std::vector<double> threadFree(nThreads, 0);
+	std::vector<std::pair<double, size_t> > running;
+	std::vector<bool> isAdmitted(nParts, false);
+	emInt nAdmitted = 0;
+	size_t bytesInFlight = 0;
+	double makespan = 0;
+	plan.peakBytesInFlight = 0;
+	while (nAdmitted < nParts) {
+		int thread = std::min_element(threadFree.begin(), threadFree.end())
+				- threadFree.begin();
+		double now = threadFree[thread];
+		for (size_t rr = 0; rr < running.size();) {
+			if (running[rr].first <= now) {
+				bytesInFlight -= running[rr].second;
+				running[rr] = running.back();
+				running.pop_back();
+			}
+			else {
+				rr++;
+			}
+		}
+		emInt next = nParts;
+		for (emInt jj = 0; jj < nParts; jj++) {
+			emInt cand = order[jj];
+			if (isAdmitted[cand]) continue;
+			if (memoryBudget == 0 || bytesInFlight == 0
+					|| bytesInFlight + partBytes[cand] <= memoryBudget) {
+				next = cand;
+				break;
+			}
+		}
+		if (next == nParts) {
+			// Nothing fits, so something must be running; wait for it.
+			double firstDone = running[0].first;
+			for (size_t rr = 1; rr < running.size(); rr++) {
+				firstDone = std::min(firstDone, running[rr].first);
+			}
+			threadFree[thread] = firstDone;
+			continue;
+		}
+		isAdmitted[next] = true;
+		nAdmitted++;
+		bytesInFlight += partBytes[next];
+		plan.peakBytesInFlight = std::max(plan.peakBytesInFlight, bytesInFlight);
+		threadFree[thread] = now + partTime[next];
+		running.push_back(std::make_pair(threadFree[thread], partBytes[next]));
+		makespan = std::max(makespan, threadFree[thread]);
+	}
+	plan.wallTime = plan.partitionTime + plan.layoutTime + makespan;
+
+	// The coarse mesh and partition data are already in memory, so they're
+	// part of the current RSS.
+	plan.peakRSS = currentRSS() + plan.peakBytesInFlight;
+	plan.physicalMemory = size_t(sysconf(_SC_PHYS_PAGES))
+			* sysconf(_SC_PAGESIZE);
+
+	printf("\nPredicted totals:\n");
+	prettyPrintCellCount(plan.fineCells, "Fine cells");
+	prettyPrintCellCount(plan.fineVerts, "Fine verts (summed over parts)");
+	printBytes("Total ugrid file size:", plan.fileBytes);
+	printBytes("Largest part memory:", plan.largestPartBytes);
+	printBytes("Peak memory in flight:", plan.peakBytesInFlight);
+	printBytes("Peak RSS:", plan.peakRSS);
+	printBytes("Physical memory:", plan.physicalMemory);
+	printf("Time for partitioning:           %10.3F seconds (measured)\n",
+					plan.partitionTime);
+	printf("Time for global vert numbering:  %10.3F seconds\n",
+					plan.layoutTime);
+	printf("Time for refinement and output:  %10.3F seconds\n", makespan);
+	printf("Estimated wall time on %3d threads: %7.3F seconds\n", nThreads,
+					plan.wallTime);
+
+	bool OK = true;
+	if (plan.indexOverflow) {
+		fprintf(stderr, "Plan fails: some parts exceed the max index size.\n");
+		OK = false;
+	}
+	if (plan.physicalMemory > 0 && plan.peakRSS > plan.physicalMemory) {
+		fprintf(stderr, "Plan fails: predicted peak RSS exceeds physical "
+						"memory; set a memory budget (-M) or use smaller parts.\n");
+		OK = false;
+	}
+	if (memoryBudget > 0 && plan.largestPartBytes > memoryBudget) {
+		fprintf(stderr, "Warning: some parts are predicted to exceed the "
+						"memory budget; these will be refined one at a time.\n");
+	}
+	return OK;
+}
+
 //void ExaMesh::buildFaceCellConnectivity() {
 //	fprintf(stderr, "Starting to build face cell connectivity\n");
 //	// Create a multimap that will hold all of the face data, in duplicate.
@@ -29,6 +29,7 @@
 #include <limits.h>
 #include <assert.h>
 #include <memory>
+#include <vector>
 
 #include "Mapping.h"
 #include "Part.h"
@@ -41,19 +42,38 @@ struct MeshSize {
 			nHexes;
 };
 
+// Predicted totals for refineForParallel, from planRefinement.  Fine counts
+// and file bytes are summed over parts, so verts on part bdries are counted
+// once per part that has them.
+struct RefinePlan {
+	emInt nParts;
+	size_t fineVerts, fineCells, fileBytes;
+	size_t largestPartBytes, peakBytesInFlight, peakRSS, physicalMemory;
+	double partitionTime, layoutTime, wallTime;
+	bool indexOverflow;
+};
+
 class ExaMesh {
 protected:
 	double *m_lenScale;
 
-	void setupLengthScales();
+	// For a coarse mesh extracted from one part of a partitioned mesh: the
+	// index in the whole mesh of each vert, and where the part bdry faces start
+	// in the lists of bdry faces.  All part bdry faces come after all real
+	// bdry faces.
+	std::vector<emInt> m_globalVerts;
+	emInt m_firstPartBdryTri, m_firstPartBdryQuad;
 
 public:
 	ExaMesh() :
-			m_lenScale(nullptr) {
+			m_lenScale(nullptr), m_firstPartBdryTri(EMINT_MAX),
+					m_firstPartBdryQuad(EMINT_MAX) {
 	}
 	virtual ~ExaMesh() {
 		if (m_lenScale) delete[] m_lenScale;
 	}
+	// Readers call this; meshes built in memory have to call it themselves.
+	void setupLengthScales();
 	virtual double getX(const emInt vert) const = 0;
 	virtual double getY(const emInt vert) const = 0;
 	virtual double getZ(const emInt vert) const =0;
@@ -109,19 +129,91 @@ public:
 		}
 	}
 	MeshSize computeFineMeshSize(const int nDivs) const;
+	// Exact vert count after refinement, found by counting edges explicitly.
+	size_t countFineVerts(const int nDivs) const;
+
+	bool isPartMesh() const {
+		return !m_globalVerts.empty();
+	}
+	emInt getGlobalVert(const emInt vert) const {
+		assert(vert < m_globalVerts.size());
+		return m_globalVerts[vert];
+	}
+	bool isPartBdryTri(const emInt tri) const {
+		return tri >= m_firstPartBdryTri;
+	}
+	bool isPartBdryQuad(const emInt quad) const {
+		return quad >= m_firstPartBdryQuad;
+	}
+	void setPartData(std::vector<emInt>& globalVerts,
+			const emInt firstPartBdryTri, const emInt firstPartBdryQuad) {
+		m_globalVerts.swap(globalVerts);
+		m_firstPartBdryTri = firstPartBdryTri;
+		m_firstPartBdryQuad = firstPartBdryQuad;
+	}
 
 	void buildFaceCellConnectivity();
 
+	// A memory budget of zero means no limit on how many parts can be in
+	// flight at once.
+	// If outFileBase is given, each part is written to
+	// <outFileBase>.partNNNN.<outInfix>.ugrid, along with a map of its part
+	// bdry verts and the global IDs and owners of its verts (.gids), and
+	// <outFileBase>.manifest lists them all.  With singleFile, all
+	// parts instead write their share of one <outFileBase>.<outInfix>.ugrid,
+	// with verts on part bdries appearing only once.  An outInfix of cgns
+	// writes <outFileBase>.cgns instead: one zone per part (ZoneNNNN, with
+	// the same map files), or with singleFile, one zone that each part
+	// writes its share of.  Parts come from
+	// partitionCellsMultilevel instead of partitionCells if
+	// useGraphPartitioner is set.  With evaluatePartitions, the number of
+	// faces between parts and the imbalance are reported, and compared with
+	// coordinate bisection when the graph partitioner is used.
 	virtual void refineForParallel(const emInt numDivs,
-			const emInt maxCellsPerPart) const;
+			const emInt maxCellsPerPart, const size_t memoryBudget = 0,
+			const char outFileBase[] = nullptr, const bool singleFile = false,
+			const bool useGraphPartitioner = false,
+			const char outInfix[] = "b8",
+			const bool evaluatePartitions = false) const;
+
+	// Partition and predict the cost of refineForParallel, without creating
+	// any fine meshes: fine mesh size, file size, memory, and run time for
+	// each part and in total, with parts scheduled on nThreads threads as
+	// refineForParallel would.  Returns false if refinement is predicted to
+	// fail, either by exceeding the index size or by running out of memory.
+	bool planRefinement(const emInt numDivs, const emInt maxCellsPerPart,
+			const size_t memoryBudget, const int nThreads, struct RefinePlan& plan,
+			const bool useGraphPartitioner = false) const;
+
+	// Bytes of scratch space over all the verts of the whole coarse mesh
+	// used while extracting one part.  Two bit vectors, by default.
+	virtual size_t extractScratchBytes() const {
+		return numVerts() / 4;
+	}
+	// Predict the peak number of bytes needed to extract and refine one part.
+	size_t estimatePartMemory(const emInt numDivs, const Part& P,
+			const std::vector<CellPartData>& vecCPD) const;
+	// The predicted size of the coarse mesh for one part.  Returns false for
+	// an empty part.
+	bool estimateCoarsePartSize(const Part& P,
+			const std::vector<CellPartData>& vecCPD, struct MeshSize& MSIn) const;
 
 	virtual std::unique_ptr<UMesh> createFineUMesh(const emInt numDivs, Part& P,
 			std::vector<CellPartData>& vecCPD, struct RefineStats& RS) const = 0;
 
+	// The coarse mesh for one part, with its part data set.
+	virtual std::unique_ptr<ExaMesh> extractCoarsePart(const emInt numDivs,
+			Part& P, std::vector<CellPartData>& vecCPD) const = 0;
+
 	virtual void setupCellDataForPartitioning(std::vector<CellPartData>& vecCPD,
 			double &xmin, double& ymin, double& zmin, double& xmax, double& ymax,
 			double& zmax) const = 0;
 	void prettyPrintCellCount(size_t cells, const char* prefix) const;
+	// Partition for refinement into parts of about maxCellsPerPart fine cells,
+	// as refineForParallel and planRefinement do.  Returns the number of parts.
+	emInt partitionForRefinement(const emInt numDivs,
+			const emInt maxCellsPerPart, const bool useGraphPartitioner,
+			std::vector<Part>& parts, std::vector<CellPartData>& vecCPD) const;
 
 protected:
 	void addCellToPartitionData(const emInt* verts, emInt nPts, emInt ii,
@@ -146,13 +238,99 @@ void addUniquely(exa_set<T>& mySet, T& val) {
 bool computeMeshSize(const struct MeshSize& MSIn, const emInt nDivs,
 		struct MeshSize& MSOut);
 
-// Defined elsewhere.
+size_t estimateRefinementMemory(const struct MeshSize& MSIn,
+		const emInt nDivs);
+
+// Bytes in a UGRID file (or a UMesh file image) for a mesh of this size.
+size_t ugridFileBytes(const struct MeshSize& MS);
+
+// Predicted single-thread seconds to extract a part of this size, to refine
+// it, and to write a file of this many bytes.
+double estimateExtractTime(const struct MeshSize& MSIn);
+double estimateRefinementTime(const struct MeshSize& MSIn, const emInt nDivs);
+double estimateWriteTime(const size_t bytes);
+
+// Receives a refined mesh as it's created, so that it can go straight into
+// someone else's data structures.  Fine verts are numbered as in
+// subdividePartMesh.  Each call hands over everything created for one coarse
+// entity at once; the arrays are only valid during the call.  Cell and face
+// types are TETRA_4, PYRA_5, PENTA_6, HEXA_8, TRI_3 and QUAD_4.
+class RefineVisitor {
+public:
+	virtual ~RefineVisitor() {
+	}
+	// Fine verts firstVert through firstVert + count - 1.  Every vert is
+	// visited before any cell or face that uses it.  The coarse verts come
+	// first, by themselves.
+	virtual void onVerts(const emInt firstVert, const emInt count,
+			const double coords[][3]) = 0;
+	// Children of one type of coarseCell, which counts tets, then pyramids,
+	// prisms and hexes.  A pyramid has both tet and pyramid children.
+	virtual void onCells(const emInt coarseCell, const int type,
+			const emInt count, const emInt conn[]) = 0;
+	// Children of coarse bdry tri or quad coarseFace.
+	virtual void onBdryFaces(const emInt coarseFace, const int type,
+			const emInt count, const emInt conn[]) = 0;
+	// Called once everything has been visited.
+	virtual void onDone() {
+	}
+	// Visitors that want to know where each fine vert came from say so here;
+	// finding out costs a pass over each coarse cell's lattice of verts.
+	virtual bool wantsVertParents() const {
+		return false;
+	}
+	// Called after onVerts, for the same verts, all of which were created by
+	// coarseCell, with their param coords in it.  The coarse verts, which keep
+	// their indices, have a coarseCell of EMINT_MAX and no param coords.
+	virtual void onVertParents(const emInt /*firstVert*/, const emInt /*count*/,
+			const emInt /*coarseCell*/, const double /*uvw*/[][3]) {
+	}
+};
+
+// Progress lines on stderr during refinement; off by default.  Set this
+// outside parallel regions.
+void showRefineProgress(const bool show);
+// Defined elsewhere.  Progress goes to stderr if it's been turned on with
+// showRefineProgress, unless showProgress is false.
 emInt subdividePartMesh(const ExaMesh * const pVM_input,
 		UMesh * const pVM_output,
-		const int nDivs);
+		const int nDivs, const bool showProgress = true);
+// The same refinement, but with cells and bdry faces passed to the visitor
+// and never stored.  Coords are only kept for the fine verts that coarse
+// cells share (coarse verts and those on coarse edges and faces) and for
+// the inside of the cell being divided, since the dividers read them to
+// choose how to split tets and pyramids.  Returns the number of fine
+// cells.  Fine verts on part bdry faces aren't recorded for stitching, so
+// the input can't be a part mesh; the same goes for subdivideNestedLevels.
+emInt subdividePartMesh(const ExaMesh * const pVM_input,
+		RefineVisitor& visitor, const int nDivs);
+// Refinement into several nested levels in one pass over the coarse cells,
+// for multigrid.  nDivs increases, and each entry divides the next, so
+// every vert of a level is also a vert of each finer level.  Only the
+// finest level creates verts, so the edge and face tables and the mapping
+// setup for each coarse cell are shared; coarser levels pick their verts
+// out of its lattice.  visitors[ll] gets level ll.  The coarse verts keep
+// their indices in every level, and each other vert is numbered when a
+// coarse cell first uses it.  If coarseToFine isn't null,
+// coarseToFine[ll][vv] is the index in level ll + 1 of vert vv of level ll.
+// Returns false, having done nothing, if the levels don't nest.
+bool subdivideNestedLevels(const ExaMesh * const pVM_input, const int nLevels,
+		const int nDivs[], RefineVisitor * const visitors[],
+		std::vector<emInt> coarseToFine[] = nullptr);
 
 bool partitionCells(const ExaMesh* const pEM, const emInt nPartsToMake,
 		std::vector<Part>& parts, std::vector<CellPartData>& vecCPD);
+// Multilevel partitioning of the dual graph, with cells weighted by type.
+// Slower than partitionCells, but with much smaller part bdries on
+// stretched meshes.
+bool partitionCellsMultilevel(const ExaMesh* const pEM,
+		const emInt nPartsToMake, std::vector<Part>& parts,
+		std::vector<CellPartData>& vecCPD);
+// Number of faces between parts, and heaviest part weight relative to the
+// average.
+void evaluatePartition(const ExaMesh* const pEM,
+		const std::vector<Part>& parts, const std::vector<CellPartData>& vecCPD,
+		size_t& cutFaces, double& imbalance);
 
 void sortVerts3(const emInt input[3], emInt output[3]);
 void sortVerts4(const emInt input[4], emInt output[4]);
@@ -0,0 +1,183 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * HashedFaceCellVisitor.cxx
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#include <algorithm>
+
+#include "HashedFaceCellVisitor.h"
+
+// Faces of each fine cell type, as local verts; -1 ends a tri.
+struct CellFaceTable {
+	int nPts, nFaces;
+	int faces[6][4];
+};
+
+static const CellFaceTable cellFaceTables[] = {
+// Tets
+		{ 4, 4, { { 0, 1, 2, -1 }, { 0, 1, 3, -1 }, { 1, 2, 3, -1 },
+							{ 2, 0, 3, -1 } } },
+		// Pyramids
+		{ 5, 5, { { 0, 1, 2, 3 }, { 0, 4, 1, -1 }, { 1, 4, 2, -1 },
+							{ 2, 4, 3, -1 }, { 3, 4, 0, -1 } } },
+		// Prisms
+		{ 6, 5, { { 2, 1, 4, 5 }, { 1, 0, 3, 4 }, { 0, 2, 5, 3 },
+							{ 0, 1, 2, -1 }, { 5, 4, 3, -1 } } },
+		// Hexes
+		{ 8, 6, { { 0, 1, 2, 3 }, { 0, 1, 5, 4 }, { 1, 2, 6, 5 },
+							{ 2, 3, 7, 6 }, { 3, 0, 4, 7 }, { 4, 5, 6, 7 } } } };
+
+static int typeIndex(const int type) {
+	switch (type) {
+		case TETRA_4:
+			return 0;
+		case PYRA_5:
+			return 1;
+		case PENTA_6:
+			return 2;
+		default:
+			assert(type == HEXA_8);
+			return 3;
+	}
+}
+
+static FineFaceKey makeKey(const emInt verts[4]) {
+	FineFaceKey FK;
+	std::copy(verts, verts + 4, FK.sorted);
+	// EMINT_MAX sorts last, so tris and quads can't collide.
+	std::sort(FK.sorted, FK.sorted + 4);
+	return FK;
+}
+
+HashedFaceCellVisitor::HashedFaceCellVisitor(const MeshSize& fine,
+		RefineVisitor *next) :
+		m_next(next), m_cellCount(), m_bdryFaceCount(), m_coarseCell(EMINT_MAX),
+				m_nUnmatched(0) {
+	m_firstCell[0] = 0;
+	m_firstCell[1] = m_firstCell[0] + fine.nTets;
+	m_firstCell[2] = m_firstCell[1] + fine.nPyrs;
+	m_firstCell[3] = m_firstCell[2] + fine.nPrisms;
+	m_nCells = m_firstCell[3] + fine.nHexes;
+	m_firstBdryFace[0] = m_nCells;
+	m_firstBdryFace[1] = m_nCells + fine.nBdryTris;
+	// Every interior face is seen twice and every bdry face once.
+	m_faces.reserve(
+			(4 * size_t(fine.nTets) + 5 * size_t(fine.nPyrs)
+					+ 5 * size_t(fine.nPrisms) + 6 * size_t(fine.nHexes)
+					+ fine.nBdryTris + fine.nBdryQuads) / 2);
+}
+
+void HashedFaceCellVisitor::onVerts(const emInt firstVert, const emInt count,
+		const double coords[][3]) {
+	if (m_next) m_next->onVerts(firstVert, count, coords);
+}
+
+// Faces of the last coarse cell that weren't matched by a sibling lie on
+// its bdry, so they're matched with the neighboring coarse cell, or wait
+// for it or for a bdry face.
+void HashedFaceCellVisitor::closeCoarseCell() {
+	for (auto& cellFace : m_cellFaces) {
+		auto open = m_openFaces.find(cellFace.first);
+		if (open == m_openFaces.end()) {
+			m_openFaces.insert(cellFace);
+		}
+		else {
+			open->second.right = cellFace.second.left;
+			m_faces.push_back(open->second);
+			m_openFaces.erase(open);
+		}
+	}
+	m_cellFaces.clear();
+}
+
+void HashedFaceCellVisitor::onCells(const emInt coarseCell, const int type,
+		const emInt count, const emInt conn[]) {
+	if (coarseCell != m_coarseCell) {
+		closeCoarseCell();
+		m_coarseCell = coarseCell;
+	}
+	const int tt = typeIndex(type);
+	const CellFaceTable& CFT = cellFaceTables[tt];
+	for (emInt ii = 0; ii < count; ii++) {
+		const emInt *verts = conn + size_t(ii) * CFT.nPts;
+		const emInt cell = m_firstCell[tt] + m_cellCount[tt]++;
+		for (int ff = 0; ff < CFT.nFaces; ff++) {
+			FineFace face;
+			for (int vv = 0; vv < 4; vv++) {
+				const int local = CFT.faces[ff][vv];
+				face.verts[vv] = (local < 0) ? EMINT_MAX : verts[local];
+			}
+			face.left = cell;
+			face.right = EMINT_MAX;
+			const FineFaceKey FK = makeKey(face.verts);
+			auto sibling = m_cellFaces.find(FK);
+			if (sibling == m_cellFaces.end()) {
+				m_cellFaces.insert(std::make_pair(FK, face));
+			}
+			else {
+				sibling->second.right = cell;
+				m_faces.push_back(sibling->second);
+				m_cellFaces.erase(sibling);
+			}
+		}
+	}
+	if (m_next) m_next->onCells(coarseCell, type, count, conn);
+}
+
+void HashedFaceCellVisitor::onBdryFaces(const emInt coarseFace,
+		const int type, const emInt count, const emInt conn[]) {
+	closeCoarseCell();
+	const int isQuad = (type == QUAD_4);
+	const int nPts = isQuad ? 4 : 3;
+	for (emInt ii = 0; ii < count; ii++) {
+		emInt verts[] = { EMINT_MAX, EMINT_MAX, EMINT_MAX, EMINT_MAX };
+		std::copy(conn + size_t(ii) * nPts, conn + size_t(ii + 1) * nPts, verts);
+		const emInt bdryFace = m_firstBdryFace[isQuad]
+				+ m_bdryFaceCount[isQuad]++;
+		auto open = m_openFaces.find(makeKey(verts));
+		if (open == m_openFaces.end()) {
+			// No cell next to this bdry face.
+			FineFace face;
+			std::copy(verts, verts + 4, face.verts);
+			face.left = bdryFace;
+			face.right = EMINT_MAX;
+			m_faces.push_back(face);
+			m_nUnmatched++;
+			continue;
+		}
+		open->second.right = bdryFace;
+		m_faces.push_back(open->second);
+		m_openFaces.erase(open);
+	}
+	if (m_next) m_next->onBdryFaces(coarseFace, type, count, conn);
+}
+
+void HashedFaceCellVisitor::onDone() {
+	closeCoarseCell();
+	for (auto& open : m_openFaces) {
+		m_faces.push_back(open.second);
+	}
+	m_nUnmatched += m_openFaces.size();
+	m_openFaces.clear();
+	if (m_next) m_next->onDone();
+}
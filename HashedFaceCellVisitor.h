@@ -0,0 +1,130 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * HashedFaceCellVisitor.h
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#ifndef SRC_HASHEDFACECELLVISITOR_H_
+#define SRC_HASHEDFACECELLVISITOR_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "ExaMesh.h"
+
+// One face of a refined mesh, with the cells on either side.  Cells are
+// numbered as in numCells order:  all tets, then pyramids, prisms and
+// hexes, each in the order subdividePartMesh creates them.  On the bdry,
+// right is numCells plus the index of the bdry face, counting bdry tris and
+// then bdry quads.  A face that no cell or bdry face matches has a right of
+// EMINT_MAX.  The verts are in the order the left cell lists them.
+struct FineFace {
+	emInt verts[4];	// verts[3] is EMINT_MAX for a tri.
+	emInt left, right;
+};
+
+// Sorted verts of a fine face, with EMINT_MAX last for a tri.
+struct FineFaceKey {
+	emInt sorted[4];
+};
+
+inline bool operator==(const FineFaceKey& a, const FineFaceKey& b) {
+	return a.sorted[0] == b.sorted[0] && a.sorted[1] == b.sorted[1]
+			&& a.sorted[2] == b.sorted[2] && a.sorted[3] == b.sorted[3];
+}
+
+inline bool operator<(const FineFaceKey& a, const FineFaceKey& b) {
+	return std::lexicographical_compare(a.sorted, a.sorted + 4, b.sorted,
+																			b.sorted + 4);
+}
+
+#ifndef USE_ORDERED
+namespace std {
+	template<> struct hash<FineFaceKey> {
+		typedef FineFaceKey argument_type;
+		typedef std::size_t result_type;
+		// Fine faces near each other have nearly the same verts, so each vert
+		// is mixed in with a multiply and a rotate; shifting and xoring them
+		// would put many of those faces in the same bucket.
+		result_type operator()(const argument_type& FK) const noexcept
+		{
+			uint64_t hash = 0;
+			for (int ii = 0; ii < 4; ii++) {
+				hash = (hash ^ FK.sorted[ii]) * UINT64_C(0x9E3779B97F4A7C15);
+				hash = (hash << 27) | (hash >> 37);
+			}
+			return result_type(hash);
+		}
+	};
+}
+#endif
+
+// A convenience for finding the fine faces and their cells while a mesh is
+// being refined, so the fine mesh doesn't have to be stored and walked
+// again to find them.  Faces are matched by hashing their verts, just as a
+// pass over the finished mesh would; adjacency isn't taken from the
+// dividers' child tables or from the face records refinement shares between
+// coarse cells.  What's saved is the size of the tables.  Faces between
+// children of one coarse cell are matched within that cell, in a table that
+// never holds more than one coarse cell's faces.  Only faces on coarse
+// faces wait to be matched by a neighbor, and they're dropped from the
+// waiting table as soon as they are, so it only holds the fine faces on
+// coarse faces between refined and unrefined cells.
+//
+// Everything is passed on to another visitor, if there is one, so this can
+// sit in front of whatever is taking the fine mesh.
+class HashedFaceCellVisitor: public RefineVisitor {
+	RefineVisitor *m_next;
+	emInt m_firstCell[4], m_cellCount[4], m_nCells;
+	emInt m_firstBdryFace[2], m_bdryFaceCount[2];
+	emInt m_coarseCell, m_nUnmatched;
+	std::vector<FineFace> m_faces;
+	// Faces waiting for a match:  those of the current coarse cell, and
+	// those on coarse faces.
+	exa_map<FineFaceKey, FineFace> m_cellFaces, m_openFaces;
+
+	HashedFaceCellVisitor(const HashedFaceCellVisitor&);
+	HashedFaceCellVisitor& operator=(const HashedFaceCellVisitor&);
+	void closeCoarseCell();
+public:
+	// The sizes are those of the fine mesh, as from computeFineMeshSize.
+	HashedFaceCellVisitor(const MeshSize& fine, RefineVisitor *next = nullptr);
+	virtual ~HashedFaceCellVisitor() {
+	}
+	virtual void onVerts(const emInt firstVert, const emInt count,
+			const double coords[][3]);
+	virtual void onCells(const emInt coarseCell, const int type,
+			const emInt count, const emInt conn[]);
+	virtual void onBdryFaces(const emInt coarseFace, const int type,
+			const emInt count, const emInt conn[]);
+	virtual void onDone();
+
+	const std::vector<FineFace>& getFaces() const {
+		return m_faces;
+	}
+	// Faces that were still unmatched when refinement finished.
+	emInt numUnmatchedFaces() const {
+		return m_nUnmatched;
+	}
+};
+
+#endif /* SRC_HASHEDFACECELLVISITOR_H_ */
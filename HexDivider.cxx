@@ -25,18 +25,6 @@
 
 #include "HexDivider.h"
 
-void HexDivider::setupCoordMapping(const emInt verts[]) {
-	for (int ii = 0; ii < 8; ii++) {
-		cellVerts[ii] = verts[ii];
-	}
-	m_Map->setupCoordMapping(verts);
-}
-
-void HexDivider::getPhysCoordsFromParamCoords(const double uvw[3],
-		double xyz[3]) {
-	m_Map->computeTransformedCoords(uvw, xyz);
-}
-
 //void HexDivider::setupCoordMapping(const emInt verts[]) {
 //	for (int ii = 0; ii < 8; ii++) {
 //		cellVerts[ii] = verts[ii];
@@ -107,7 +95,58 @@ void HexDivider::getPhysCoordsFromParamCoords(const double uvw[3],
 //  }   // Done looping over all levels for the prism.
 //}
 
+template<typename MapT>
+void HexDivider::divideInterior(const MapT& map) {
+	switch (nDivs) {
+		case 2:
+			divideInteriorFixed<2, HexShape>(map);
+			break;
+		case 3:
+			divideInteriorFixed<3, HexShape>(map);
+			break;
+		case 4:
+			divideInteriorFixed<4, HexShape>(map);
+			break;
+		case 8:
+			divideInteriorFixed<8, HexShape>(map);
+			break;
+		default:
+			CellDivider::divideInterior(map);
+			break;
+	}
+}
+
+template<int N>
+void HexDivider::createNewCellsFixed() {
+	assert(nDivs == N);
+	static constexpr HexChildTable<N> table;
+	const emInt* const verts = &localVerts[0][0][0];
+	emInt (*newHexes)[8] = m_pMesh->reserveHexes(table.count);
+	for (int cc = 0; cc < table.count; cc++) {
+		for (int vv = 0; vv < 8; vv++) {
+			newHexes[cc][vv] = verts[table.conn[cc][vv]];
+		}
+	}
+}
+
 void HexDivider::createNewCells() {
+	switch (nDivs) {
+		case 2:
+			createNewCellsFixed<2>();
+			return;
+		case 3:
+			createNewCellsFixed<3>();
+			return;
+		case 4:
+			createNewCellsFixed<4>();
+			return;
+		case 8:
+			createNewCellsFixed<8>();
+			return;
+		default:
+			break;
+	}
+
 	// Output info about the points for this hex, layer by layer
 
 //	for (int level = 0; level <= nDivs; level++) {
@@ -141,3 +180,7 @@ void HexDivider::createNewCells() {
     } // Done with this row (constant j)
   }   // Done with this level
 }
+
+template void HexDivider::divideInterior(const Q1HexMapping& map);
+template void HexDivider::divideInterior(
+		const LagrangeCubicHexMapping& map);
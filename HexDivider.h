@@ -34,10 +34,7 @@ class HexDivider: public CellDivider {
 	double xyzOffsetTop[3], uVecTop[3], vVecTop[3], uvVecTop[3];
 
 public:
-	HexDivider(UMesh *pVolMesh, const ExaMesh* const pInitMesh,
-			const int segmentsPerEdge,
-			const Mapping::MappingType type = Mapping::Invalid)
-      :
+	HexDivider(UMesh *pVolMesh, const int segmentsPerEdge) :
 			CellDivider(pVolMesh, segmentsPerEdge) {
     vertIJK[0][0] = 0;
     vertIJK[0][1] = 0;
@@ -202,30 +199,21 @@ public:
 		faceEdgeIndices[5][1] = 7;
 		faceEdgeIndices[5][2] = 8;
 		faceEdgeIndices[5][3] = 3;
-	      
-		Mapping::MappingType myType = type;
-		if (myType == Mapping::Invalid) {
-			myType = pInitMesh->getDefaultMappingType();
-		}
-		switch (myType) {
-		case Mapping::Lagrange:
-			m_Map = new LagrangeCubicHexMapping(pInitMesh);
-			break;
-		case Mapping::Uniform:
-		default:
-			m_Map = new Q1HexMapping(pInitMesh);
-			break;
-		}
   }
 	~HexDivider() {
 	}
-//	void divideInterior();
+	template<typename MapT> void divideInterior(const MapT& map);
   void createNewCells();
-	void setupCoordMapping(const emInt verts[]);
-	void getPhysCoordsFromParamCoords(const double uvw[], double xyz[]);
+	// Table-driven versions for the common numbers of divisions.
+	template<int N> void createNewCellsFixed();
+	// New cells come from the topology alone.
+	static constexpr bool newCellsNeedCoords = false;
 
 	virtual int getMinInteriorDivs() const {return 2;}
 
 };
 
+typedef MappedDivider<HexDivider, Q1HexMapping> Q1HexDivider;
+typedef MappedDivider<HexDivider, LagrangeCubicHexMapping> CubicHexDivider;
+
 #endif /* APPS_EXAMESH_HEXDIVIDER_H_ */
@@ -0,0 +1,508 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * ImplicitRefinedMesh.cxx
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "ImplicitRefinedMesh.h"
+#include "Instrument.h"
+
+// Faces of each cell type, by local corner, as in extractCoarseMesh.
+// Types are in cell order:  tets, pyramids, prisms, hexes.
+struct CellFaces {
+	int nVerts, nTris, nQuads;
+	int tris[4][3];
+	int quads[6][4];
+};
+
+static const CellFaces cellFaces[] = {
+		{ 4, 4, 0, { { 0, 1, 2 }, { 0, 1, 3 }, { 1, 2, 3 }, { 2, 0, 3 } }, { } },
+		{ 5, 4, 1, { { 0, 1, 4 }, { 1, 2, 4 }, { 2, 3, 4 }, { 3, 0, 4 } },
+			{ { 0, 1, 2, 3 } } },
+		{ 6, 2, 3, { { 0, 1, 2 }, { 3, 4, 5 } },
+			{ { 0, 1, 4, 3 }, { 1, 2, 5, 4 }, { 2, 0, 3, 5 } } },
+		{ 8, 0, 6, { },
+			{ { 0, 1, 5, 4 }, { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 0, 4, 7 },
+				{ 0, 1, 2, 3 }, { 4, 5, 6, 7 } } } };
+
+static std::vector<emInt> sortedCorners(const int nCorners,
+		const emInt corners[]) {
+	std::vector<emInt> sorted(corners, corners + nCorners);
+	std::sort(sorted.begin(), sorted.end());
+	return sorted;
+}
+
+ImplicitRefinedMesh::ImplicitRefinedMesh(const UMesh& coarse, const int nDivs,
+		const size_t cacheSize) :
+		m_coarse(coarse), m_nDivs(nDivs), m_nCells(0), m_firstCell(),
+				m_firstEdgeVert(0), m_firstTriVert(0), m_firstQuadVert(0),
+				m_firstInteriorVert(), m_interiorVerts(), m_tetsPerTet(0),
+				m_tetsPerPyr(0), m_pyrsPerPyr(0), m_cellsPerCell(0),
+				m_facesPerFace(0), m_fine(), m_cacheSize(cacheSize), m_clock(0),
+				m_nExpansions(0) {
+	assert(nDivs >= 1 && nDivs <= MAX_DIVS);
+	assert(cacheSize >= 1);
+	// Pointers into cached conn stay put only if the cache never grows.
+	m_cache.reserve(cacheSize);
+
+	// Number the edges and faces in the order cells first reach them, which
+	// is the order UMesh(coarse, nDivs) creates their verts in.
+	const emInt counts[] = { coarse.numTets(), coarse.numPyramids(),
+			coarse.numPrisms(), coarse.numHexes() };
+	for (int type = 0; type < 4; type++) {
+		m_firstCell[type] = m_nCells;
+		m_nCells += counts[type];
+	}
+	for (emInt cell = 0; cell < m_nCells; cell++) {
+		int type;
+		const emInt* conn = getCellConn(cell, type);
+		addCellEntities(cell, conn, type);
+	}
+	for (emInt ii = 0; ii < coarse.numBdryTris(); ii++) {
+		auto iter = m_tris.find(triFaceKey(coarse.getBdryTriConn(ii)));
+		if (iter == m_tris.end()) {
+			fprintf(stderr, "Bdry tri %u isn't a face of any cell.\n", ii);
+			exit(1);
+		}
+		m_bdryTriCell.push_back(m_triOwner[iter->second]);
+	}
+	for (emInt ii = 0; ii < coarse.numBdryQuads(); ii++) {
+		auto iter = m_quads.find(quadFaceKey(coarse.getBdryQuadConn(ii)));
+		if (iter == m_quads.end()) {
+			fprintf(stderr, "Bdry quad %u isn't a face of any cell.\n", ii);
+			exit(1);
+		}
+		m_bdryQuadCell.push_back(m_quadOwner[iter->second]);
+	}
+
+	const size_t n = nDivs;
+	// Interior verts of a tet, pyramid, prism and hex.
+	const size_t interior[] = { (n - 1) * (n - 2) * (n - 3) / 6,
+			(n - 2) * (n - 1) * (2 * n - 3) / 6, (n - 1) * (n - 1) * (n - 2) / 2,
+			(n - 1) * (n - 1) * (n - 1) };
+	// Use 64-bit sums, so that overflow can be caught.
+	size_t next = coarse.numVerts();
+	m_firstEdgeVert = next;
+	next += m_edgeOwner.size() * (n - 1);
+	m_firstTriVert = std::min(next, size_t(EMINT_MAX));
+	next += m_triOwner.size() * ((n - 1) * (n - 2) / 2);
+	m_firstQuadVert = std::min(next, size_t(EMINT_MAX));
+	next += m_quadOwner.size() * (n - 1) * (n - 1);
+	for (int type = 0; type < 4; type++) {
+		m_firstInteriorVert[type] = std::min(next, size_t(EMINT_MAX));
+		m_interiorVerts[type] = interior[type];
+		next += counts[type] * interior[type];
+	}
+	if (next > EMINT_MAX) {
+		fprintf(stderr, "Output mesh will exceed max index size!\n");
+		exit(2);
+	}
+	m_firstInteriorVert[4] = next;
+
+	m_fine = coarse.computeFineMeshSize(nDivs);
+	m_fine.nVerts = next;
+	m_tetsPerTet = n * n * n;
+	m_tetsPerPyr = (n * n * n - n) * 2 / 3;
+	m_pyrsPerPyr = (2 * n * n * n + n) / 3;
+	m_cellsPerCell = n * n * n;
+	m_facesPerFace = n * n;
+	assert(m_fine.nTets == counts[0] * m_tetsPerTet + counts[1] * m_tetsPerPyr);
+	assert(m_fine.nPyrs == counts[1] * m_pyrsPerPyr);
+}
+
+void ImplicitRefinedMesh::addCellEntities(const emInt cell,
+		const emInt conn[], const int type) {
+	const CellFaces& CF = cellFaces[type];
+	for (int ff = 0; ff < CF.nTris + CF.nQuads; ff++) {
+		const bool isTri = ff < CF.nTris;
+		const int nCorners = isTri ? 3 : 4;
+		const int* local = isTri ? CF.tris[ff] : CF.quads[ff - CF.nTris];
+		emInt corners[4];
+		for (int cc = 0; cc < nCorners; cc++) {
+			corners[cc] = conn[local[cc]];
+		}
+		if (isTri) {
+			if (m_tris.emplace(triFaceKey(corners), m_triOwner.size()).second) {
+				m_triOwner.push_back(cell);
+			}
+		}
+		else {
+			if (m_quads.emplace(quadFaceKey(corners), m_quadOwner.size()).second) {
+				m_quadOwner.push_back(cell);
+			}
+		}
+		for (int cc = 0; cc < nCorners; cc++) {
+			Edge E(corners[cc], corners[(cc + 1) % nCorners]);
+			if (m_edges.emplace(E, m_edgeOwner.size()).second) {
+				m_edgeOwner.push_back(cell);
+			}
+		}
+	}
+}
+
+const emInt* ImplicitRefinedMesh::getCellConn(const emInt cell,
+		int& type) const {
+	assert(cell < m_nCells);
+	type = 3;
+	while (type > 0 && cell < m_firstCell[type]) {
+		type--;
+	}
+	const emInt ind = cell - m_firstCell[type];
+	switch (type) {
+		case 0:
+			return m_coarse.getTetConn(ind);
+		case 1:
+			return m_coarse.getPyrConn(ind);
+		case 2:
+			return m_coarse.getPrismConn(ind);
+		default:
+			return m_coarse.getHexConn(ind);
+	}
+}
+
+// The coarse cell whose refinement sets the coords of a fine vert.
+emInt ImplicitRefinedMesh::getOwner(const emInt vert) const {
+	assert(vert >= m_firstEdgeVert && vert < m_fine.nVerts);
+	const emInt n = m_nDivs;
+	if (vert < m_firstTriVert) {
+		return m_edgeOwner[(vert - m_firstEdgeVert) / (n - 1)];
+	}
+	if (vert < m_firstQuadVert) {
+		return m_triOwner[(vert - m_firstTriVert) / ((n - 1) * (n - 2) / 2)];
+	}
+	if (vert < m_firstInteriorVert[0]) {
+		return m_quadOwner[(vert - m_firstQuadVert) / ((n - 1) * (n - 1))];
+	}
+	int type = 0;
+	while (vert >= m_firstInteriorVert[type + 1]) {
+		type++;
+	}
+	return m_firstCell[type]
+			+ (vert - m_firstInteriorVert[type]) / m_interiorVerts[type];
+}
+
+// The cell is refined as a part of its own, with all its faces on the part
+// bdry, so that the part bdry vert map says which coarse entity each fine
+// vert is on, in an orientation fixed by the entity alone.
+void ImplicitRefinedMesh::refineCoarseCell(const emInt key,
+		Expansion& E) const {
+	emInt cell = key;
+	int nFaceCorners = 0;
+	const emInt* faceConn = nullptr;
+	if (key >= m_nCells + m_coarse.numBdryTris()) {
+		emInt quad = key - m_nCells - m_coarse.numBdryTris();
+		cell = m_bdryQuadCell[quad];
+		faceConn = m_coarse.getBdryQuadConn(quad);
+		nFaceCorners = 4;
+	}
+	else if (key >= m_nCells) {
+		emInt tri = key - m_nCells;
+		cell = m_bdryTriCell[tri];
+		faceConn = m_coarse.getBdryTriConn(tri);
+		nFaceCorners = 3;
+	}
+	int type;
+	const emInt* conn = getCellConn(cell, type);
+	const CellFaces& CF = cellFaces[type];
+	// Local verts are in the same order as global ones, so that edges and
+	// faces are divided in the same direction, with the same roundoff, as in
+	// UMesh(coarse, nDivs).
+	std::vector<emInt> globalVerts(conn, conn + CF.nVerts);
+	std::sort(globalVerts.begin(), globalVerts.end());
+	emInt localConn[8];
+	for (int vv = 0; vv < CF.nVerts; vv++) {
+		localConn[vv] = std::lower_bound(globalVerts.begin(), globalVerts.end(),
+																			conn[vv]) - globalVerts.begin();
+	}
+
+	// Faces in local verts, with the requested bdry face first.
+	std::vector<std::vector<emInt> > tris, quads;
+	if (nFaceCorners != 0) {
+		std::vector<emInt> face;
+		for (int cc = 0; cc < nFaceCorners; cc++) {
+			face.push_back(std::lower_bound(globalVerts.begin(), globalVerts.end(),
+																			faceConn[cc]) - globalVerts.begin());
+			assert(face.back() < emInt(CF.nVerts)
+							&& globalVerts[face.back()] == faceConn[cc]);
+		}
+		(nFaceCorners == 3 ? tris : quads).push_back(face);
+	}
+	for (int ff = 0; ff < CF.nTris + CF.nQuads; ff++) {
+		const bool isTri = ff < CF.nTris;
+		const int nCorners = isTri ? 3 : 4;
+		const int* local = isTri ? CF.tris[ff] : CF.quads[ff - CF.nTris];
+		std::vector<emInt> face(nCorners);
+		emInt corners[4];
+		for (int cc = 0; cc < nCorners; cc++) {
+			face[cc] = localConn[local[cc]];
+			corners[cc] = conn[local[cc]];
+		}
+		if (nCorners == nFaceCorners
+				&& sortedCorners(nCorners, corners)
+						== sortedCorners(nCorners, faceConn)) {
+			continue;
+		}
+		(isTri ? tris : quads).push_back(face);
+	}
+
+	UMesh cellMesh(CF.nVerts, CF.nVerts, tris.size(), quads.size(), type == 0,
+									type == 1, type == 2, type == 3);
+	for (int vv = 0; vv < CF.nVerts; vv++) {
+		double coords[3];
+		m_coarse.getCoords(globalVerts[vv], coords);
+		cellMesh.addVert(coords);
+		cellMesh.setLengthScale(vv, m_coarse.getLengthScale(globalVerts[vv]));
+	}
+	for (auto& tri : tris) {
+		cellMesh.addBdryTri(tri.data());
+	}
+	for (auto& quad : quads) {
+		cellMesh.addBdryQuad(quad.data());
+	}
+	switch (type) {
+		case 0:
+			cellMesh.addTet(localConn);
+			break;
+		case 1:
+			cellMesh.addPyramid(localConn);
+			break;
+		case 2:
+			cellMesh.addPrism(localConn);
+			break;
+		default:
+			cellMesh.addHex(localConn);
+			break;
+	}
+	cellMesh.setPartData(globalVerts, 0, 0);
+
+	MeshSize MS = cellMesh.computeFineMeshSize(m_nDivs);
+	UMesh fine(MS.nVerts, MS.nBdryVerts, MS.nBdryTris, MS.nBdryQuads, MS.nTets,
+							MS.nPyrs, MS.nPrisms, MS.nHexes);
+	// This happens at every cache miss, so there's no progress to report.
+	subdividePartMesh(&cellMesh, &fine, m_nDivs, false);
+
+	// Fine verts on the cell bdry go with the coarse entity they're on; the
+	// rest are numbered in the order they were created.
+	std::vector<emInt> fineVerts(fine.numVerts(), EMINT_MAX);
+	PartBdryVerts PBV;
+	fine.getPartBdryVerts(PBV);
+	for (auto& vert : PBV.verts) {
+		fineVerts[vert.second] = vert.first;
+	}
+	for (auto& edge : PBV.edges) {
+		emInt first = m_firstEdgeVert
+				+ m_edges.at(Edge(edge.first.first, edge.first.second))
+						* emInt(m_nDivs - 1);
+		for (emInt ii = 0; ii < edge.second.size(); ii++) {
+			fineVerts[edge.second[ii]] = first + ii;
+		}
+	}
+	for (auto& tri : PBV.tris) {
+		emInt first = m_firstTriVert
+				+ m_tris.at(tri.first) * emInt((m_nDivs - 1) * (m_nDivs - 2) / 2);
+		for (emInt ii = 0; ii < tri.second.size(); ii++) {
+			fineVerts[tri.second[ii]] = first + ii;
+		}
+	}
+	for (auto& quad : PBV.quads) {
+		emInt first = m_firstQuadVert
+				+ m_quads.at(quad.first) * emInt((m_nDivs - 1) * (m_nDivs - 1));
+		for (emInt ii = 0; ii < quad.second.size(); ii++) {
+			fineVerts[quad.second[ii]] = first + ii;
+		}
+	}
+	emInt next = m_firstInteriorVert[type]
+			+ (cell - m_firstCell[type]) * m_interiorVerts[type];
+	for (auto& fv : fineVerts) {
+		if (fv == EMINT_MAX) fv = next++;
+	}
+	assert(next == m_firstInteriorVert[type]
+			+ (cell - m_firstCell[type] + 1) * m_interiorVerts[type]);
+
+	E.verts.resize(fine.numVerts());
+	E.coords.resize(3 * size_t(fine.numVerts()));
+	for (emInt vv = 0; vv < fine.numVerts(); vv++) {
+		E.verts[vv] = std::make_pair(fineVerts[vv], vv);
+		fine.getCoords(vv, &E.coords[3 * size_t(vv)]);
+	}
+	std::sort(E.verts.begin(), E.verts.end());
+
+	auto renumber = [&fineVerts](const emInt* fineConn, const emInt nEnts,
+			const int nPts, std::vector<emInt>& out) {
+		out.resize(size_t(nEnts) * nPts);
+		for (size_t ii = 0; ii < out.size(); ii++) {
+			out[ii] = fineVerts[fineConn[ii]];
+		}
+	};
+	// Only a bdry face's own children are kept.
+	emInt nTris = (nFaceCorners == 3) ? m_facesPerFace : 0;
+	emInt nQuads = (nFaceCorners == 4) ? m_facesPerFace : 0;
+	renumber(nTris ? fine.getBdryTriConn(0) : nullptr, nTris, 3, E.triConn);
+	renumber(nQuads ? fine.getBdryQuadConn(0) : nullptr, nQuads, 4, E.quadConn);
+	renumber(fine.numTets() ? fine.getTetConn(0) : nullptr, fine.numTets(), 4,
+						E.tetConn);
+	renumber(fine.numPyramids() ? fine.getPyrConn(0) : nullptr,
+						fine.numPyramids(), 5, E.pyrConn);
+	renumber(fine.numPrisms() ? fine.getPrismConn(0) : nullptr,
+						fine.numPrisms(), 6, E.prismConn);
+	renumber(fine.numHexes() ? fine.getHexConn(0) : nullptr, fine.numHexes(),
+						8, E.hexConn);
+}
+
+const ImplicitRefinedMesh::Expansion& ImplicitRefinedMesh::expand(
+		const emInt key) const {
+	m_clock++;
+	for (auto& E : m_cache) {
+		if (E.key == key) {
+			E.lastUse = m_clock;
+			return E;
+		}
+	}
+	// Reuse the least recently used entry once the cache is full.
+	if (m_cache.size() < m_cacheSize) {
+		m_cache.emplace_back();
+	}
+	else {
+		auto LRU = std::min_element(m_cache.begin(), m_cache.end(),
+				[](const Expansion& a, const Expansion& b) {
+					return a.lastUse < b.lastUse;
+				});
+		std::swap(*LRU, m_cache.back());
+	}
+	Expansion& E = m_cache.back();
+	E.key = key;
+	E.lastUse = m_clock;
+	refineCoarseCell(key, E);
+	m_nExpansions++;
+	return E;
+}
+
+void ImplicitRefinedMesh::getCoords(const emInt vert, double coords[3]) const {
+	assert(vert < m_fine.nVerts);
+	if (vert < m_firstEdgeVert) {
+		m_coarse.getCoords(vert, coords);
+		return;
+	}
+	const Expansion& E = expand(getOwner(vert));
+	auto iter = std::lower_bound(E.verts.begin(), E.verts.end(),
+																std::make_pair(vert, emInt(0)));
+	assert(iter != E.verts.end() && iter->first == vert);
+	const double* xyz = &E.coords[3 * size_t(iter->second)];
+	coords[0] = xyz[0];
+	coords[1] = xyz[1];
+	coords[2] = xyz[2];
+}
+
+const emInt* ImplicitRefinedMesh::getBdryTriConn(const emInt bdryTri) const {
+	assert(bdryTri < m_fine.nBdryTris);
+	const Expansion& E = expand(m_nCells + bdryTri / m_facesPerFace);
+	return &E.triConn[3 * size_t(bdryTri % m_facesPerFace)];
+}
+
+const emInt* ImplicitRefinedMesh::getBdryQuadConn(const emInt bdryQuad) const {
+	assert(bdryQuad < m_fine.nBdryQuads);
+	const Expansion& E = expand(m_nCells + m_coarse.numBdryTris()
+															+ bdryQuad / m_facesPerFace);
+	return &E.quadConn[4 * size_t(bdryQuad % m_facesPerFace)];
+}
+
+// Tets come first from coarse tets, then from coarse pyramids.
+const emInt* ImplicitRefinedMesh::getTetConn(const emInt tet) const {
+	assert(tet < m_fine.nTets);
+	const emInt fromTets = m_firstCell[1] * m_tetsPerTet;
+	if (tet < fromTets) {
+		const Expansion& E = expand(tet / m_tetsPerTet);
+		return &E.tetConn[4 * size_t(tet % m_tetsPerTet)];
+	}
+	const emInt ind = tet - fromTets;
+	const Expansion& E = expand(m_firstCell[1] + ind / m_tetsPerPyr);
+	return &E.tetConn[4 * size_t(ind % m_tetsPerPyr)];
+}
+
+const emInt* ImplicitRefinedMesh::getPyrConn(const emInt pyr) const {
+	assert(pyr < m_fine.nPyrs);
+	const Expansion& E = expand(m_firstCell[1] + pyr / m_pyrsPerPyr);
+	return &E.pyrConn[5 * size_t(pyr % m_pyrsPerPyr)];
+}
+
+const emInt* ImplicitRefinedMesh::getPrismConn(const emInt prism) const {
+	assert(prism < m_fine.nPrisms);
+	const Expansion& E = expand(m_firstCell[2] + prism / m_cellsPerCell);
+	return &E.prismConn[6 * size_t(prism % m_cellsPerCell)];
+}
+
+const emInt* ImplicitRefinedMesh::getHexConn(const emInt hex) const {
+	assert(hex < m_fine.nHexes);
+	const Expansion& E = expand(m_firstCell[3] + hex / m_cellsPerCell);
+	return &E.hexConn[8 * size_t(hex % m_cellsPerCell)];
+}
+
+std::unique_ptr<UMesh> ImplicitRefinedMesh::createFineUMesh(
+		const emInt /*numDivs*/, Part& /*P*/,
+		std::vector<CellPartData>& /*vecCPD*/,
+		struct RefineStats& /*RS*/) const {
+	fprintf(stderr, "Can't refine an implicit fine mesh; refine its coarse "
+					"mesh instead.\n");
+	exit(1);
+}
+
+std::unique_ptr<ExaMesh> ImplicitRefinedMesh::extractCoarsePart(
+		const emInt /*numDivs*/, Part& /*P*/,
+		std::vector<CellPartData>& /*vecCPD*/) const {
+	fprintf(stderr, "Can't refine an implicit fine mesh; refine its coarse "
+					"mesh instead.\n");
+	exit(1);
+}
+
+// Conn is copied before the coords are found, since finding them may push
+// its cell out of the cache.
+void ImplicitRefinedMesh::setupCellDataForPartitioning(
+		std::vector<CellPartData>& vecCPD, double &xmin, double& ymin,
+		double& zmin, double& xmax, double& ymax, double& zmax) const {
+	emInt verts[8];
+	for (emInt ii = 0; ii < numTets(); ii++) {
+		std::copy(getTetConn(ii), getTetConn(ii) + 4, verts);
+		addCellToPartitionData(verts, 4, ii, TETRA_4, vecCPD, xmin, ymin, zmin,
+														xmax, ymax, zmax);
+	}
+	for (emInt ii = 0; ii < numPyramids(); ii++) {
+		std::copy(getPyrConn(ii), getPyrConn(ii) + 5, verts);
+		addCellToPartitionData(verts, 5, ii, PYRA_5, vecCPD, xmin, ymin, zmin, xmax,
+														ymax, zmax);
+	}
+	for (emInt ii = 0; ii < numPrisms(); ii++) {
+		std::copy(getPrismConn(ii), getPrismConn(ii) + 6, verts);
+		addCellToPartitionData(verts, 6, ii, PENTA_6, vecCPD, xmin, ymin, zmin,
+														xmax, ymax, zmax);
+	}
+	for (emInt ii = 0; ii < numHexes(); ii++) {
+		std::copy(getHexConn(ii), getHexConn(ii) + 8, verts);
+		addCellToPartitionData(verts, 8, ii, HEXA_8, vecCPD, xmin, ymin, zmin, xmax,
+														ymax, zmax);
+	}
+}
@@ -0,0 +1,209 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * ImplicitRefinedMesh.h
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#ifndef SRC_IMPLICITREFINEDMESH_H_
+#define SRC_IMPLICITREFINEDMESH_H_
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "exa-defs.h"
+#include "ExaMesh.h"
+#include "UMesh.h"
+
+// The mesh UMesh(coarse, nDivs) would create, without creating it.  Only
+// the coarse mesh and a numbering of its entities are kept; fine verts and
+// cells are found by refining one coarse cell at a time, as they're asked
+// for, with the same dividers and mappings.  The most recently refined
+// cells are cached.
+//
+// Fine verts are numbered by the coarse entity they lie on:  coarse verts
+// keep their indices, then come the verts inside each coarse edge, tri,
+// quad and cell, entity by entity.  Fine cells and bdry faces are numbered
+// by their coarse parents, in the same order UMesh(coarse, nDivs) uses, and
+// there are the same number of each.  A vert shared by several coarse cells
+// always gets its coords from the first of them, in the order tets,
+// pyramids, prisms, hexes, just as in UMesh(coarse, nDivs).
+//
+// The fine cells aren't always the same ones, though.  Each octahedron
+// inside a coarse tet is split along its shortest diagonal, and when there's
+// a tie, roundoff in the coords of verts on the coarse tet's edges and faces
+// decides.  Refined on its own, a cell computes those itself, so a tie can
+// go the other way.  The result is still a valid mesh, with the same verts
+// and bdry faces, since the split never changes an octahedron's faces.
+//
+// Pointers returned by the get*Conn functions stay valid until cacheSize
+// other coarse cells or bdry faces have been used since.  Since the cache
+// is changed by const functions, one mesh can't be used by several threads
+// at once.
+class ImplicitRefinedMesh: public ExaMesh {
+	// One coarse cell, refined on its own, with its fine verts renumbered to
+	// the whole fine mesh.  For a bdry face, the cell next to it is refined,
+	// with the face's children first among its fine bdry faces.
+	struct Expansion {
+		emInt key;
+		size_t lastUse;
+		std::vector<emInt> triConn, quadConn, tetConn, pyrConn, prismConn,
+				hexConn;
+		// Sorted by fine vert, with the index of its coords.
+		std::vector<std::pair<emInt, emInt> > verts;
+		std::vector<double> coords;
+	};
+	const UMesh& m_coarse;
+	int m_nDivs;
+	emInt m_nCells, m_firstCell[4];
+	exa_map<Edge, emInt> m_edges;
+	std::map<std::vector<emInt>, emInt> m_tris, m_quads;
+	// The first coarse cell to have each edge or face, and the one cell next
+	// to each bdry face.
+	std::vector<emInt> m_edgeOwner, m_triOwner, m_quadOwner;
+	std::vector<emInt> m_bdryTriCell, m_bdryQuadCell;
+	emInt m_firstEdgeVert, m_firstTriVert, m_firstQuadVert;
+	emInt m_firstInteriorVert[5], m_interiorVerts[4];
+	emInt m_tetsPerTet, m_tetsPerPyr, m_pyrsPerPyr, m_cellsPerCell,
+			m_facesPerFace;
+	MeshSize m_fine;
+
+	size_t m_cacheSize;
+	mutable std::vector<Expansion> m_cache;
+	mutable size_t m_clock, m_nExpansions;
+
+	ImplicitRefinedMesh(const ImplicitRefinedMesh&);
+	ImplicitRefinedMesh& operator=(const ImplicitRefinedMesh&);
+
+	void addCellEntities(const emInt cell, const emInt conn[], const int type);
+	const emInt* getCellConn(const emInt cell, int& type) const;
+	const Expansion& expand(const emInt key) const;
+	void refineCoarseCell(const emInt key, Expansion& E) const;
+	emInt getOwner(const emInt vert) const;
+public:
+	// The coarse mesh must outlive this one, unchanged.
+	ImplicitRefinedMesh(const UMesh& coarse, const int nDivs,
+			const size_t cacheSize = 16);
+	virtual ~ImplicitRefinedMesh() {
+	}
+
+	virtual double getX(const emInt vert) const {
+		double coords[3];
+		getCoords(vert, coords);
+		return coords[0];
+	}
+	virtual double getY(const emInt vert) const {
+		double coords[3];
+		getCoords(vert, coords);
+		return coords[1];
+	}
+	virtual double getZ(const emInt vert) const {
+		double coords[3];
+		getCoords(vert, coords);
+		return coords[2];
+	}
+	virtual void getCoords(const emInt vert, double coords[3]) const;
+
+	virtual emInt numVerts() const {
+		return m_fine.nVerts;
+	}
+	virtual emInt numBdryVerts() const {
+		return m_fine.nBdryVerts;
+	}
+	virtual emInt numBdryTris() const {
+		return m_fine.nBdryTris;
+	}
+	virtual emInt numBdryQuads() const {
+		return m_fine.nBdryQuads;
+	}
+	virtual emInt numTets() const {
+		return m_fine.nTets;
+	}
+	virtual emInt numPyramids() const {
+		return m_fine.nPyrs;
+	}
+	virtual emInt numPrisms() const {
+		return m_fine.nPrisms;
+	}
+	virtual emInt numHexes() const {
+		return m_fine.nHexes;
+	}
+
+	// The fine mesh can't be changed.
+	virtual emInt addVert(const double /*newCoords*/[3]) {
+		assert(0);
+		return EMINT_MAX;
+	}
+	virtual emInt addBdryTri(const emInt /*verts*/[]) {
+		assert(0);
+		return EMINT_MAX;
+	}
+	virtual emInt addBdryQuad(const emInt /*verts*/[]) {
+		assert(0);
+		return EMINT_MAX;
+	}
+	virtual emInt addTet(const emInt /*verts*/[]) {
+		assert(0);
+		return EMINT_MAX;
+	}
+	virtual emInt addPyramid(const emInt /*verts*/[]) {
+		assert(0);
+		return EMINT_MAX;
+	}
+	virtual emInt addPrism(const emInt /*verts*/[]) {
+		assert(0);
+		return EMINT_MAX;
+	}
+	virtual emInt addHex(const emInt /*verts*/[]) {
+		assert(0);
+		return EMINT_MAX;
+	}
+
+	virtual const emInt* getBdryTriConn(const emInt bdryTri) const;
+	virtual const emInt* getBdryQuadConn(const emInt bdryQuad) const;
+	virtual const emInt* getTetConn(const emInt tet) const;
+	virtual const emInt* getPyrConn(const emInt pyr) const;
+	virtual const emInt* getPrismConn(const emInt prism) const;
+	virtual const emInt* getHexConn(const emInt hex) const;
+
+	virtual Mapping::MappingType getDefaultMappingType() const {
+		return Mapping::Uniform;
+	}
+
+	// Refining the fine mesh again would mean creating it after all.
+	virtual std::unique_ptr<UMesh> createFineUMesh(const emInt numDivs, Part& P,
+			std::vector<CellPartData>& vecCPD, struct RefineStats& RS) const;
+	virtual std::unique_ptr<ExaMesh> extractCoarsePart(const emInt numDivs,
+			Part& P, std::vector<CellPartData>& vecCPD) const;
+	virtual void setupCellDataForPartitioning(std::vector<CellPartData>& vecCPD,
+			double &xmin, double& ymin, double& zmin, double& xmax, double& ymax,
+			double& zmax) const;
+
+	size_t numExpansions() const {
+		return m_nExpansions;
+	}
+	size_t numCachedCells() const {
+		return m_cache.size();
+	}
+};
+
+#endif /* SRC_IMPLICITREFINEDMESH_H_ */
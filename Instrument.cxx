@@ -0,0 +1,391 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * Instrument.cxx
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#include <string.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Instrument.h"
+
+bool g_instrumentEnabled = false;
+bool g_hardwareCountersEnabled = false;
+
+static const char* timerNames[] = { "read", "length_scales", "partition",
+		"extract", "refine", "tet_loop", "pyr_loop", "prism_loop", "hex_loop",
+		"bdry_tri_loop", "bdry_quad_loop", "edges", "faces", "interior", "cells",
+		"hash_lookup", "hash_insert", "mapping", "write" };
+
+static const char* counterNames[] = { "verts_created", "cells_created",
+		"edge_lookups", "edge_inserts", "tri_lookups", "tri_inserts",
+		"quad_lookups", "quad_inserts", "mapping_evals", "bytes_written" };
+
+static const char* hwCounterNames[] = { "cycles", "instructions",
+		"llc_misses", "branch_misses" };
+
+static_assert(sizeof(timerNames) / sizeof(timerNames[0]) == eNumTimers,
+		"Every timer needs a name");
+static_assert(sizeof(counterNames) / sizeof(counterNames[0]) == eNumCounters,
+		"Every counter needs a name");
+static_assert(sizeof(hwCounterNames) / sizeof(hwCounterNames[0])
+		== eNumHWCounters, "Every hardware counter needs a name");
+
+// Buffers are allocated separately, and padded so that threads never share
+// a cache line.
+struct ThreadBuffer {
+	char frontPadding[64];
+	int ompThread;
+	double seconds[eNumTimers];
+	size_t calls[eNumTimers];
+	size_t counts[eNumCounters];
+	uint64_t hwCounts[eNumTimers][eNumHWCounters];
+	// The perf event group for this thread; the cycle counter leads it.
+	int perfFD[eNumHWCounters];
+	bool perfTried;
+	char backPadding[64];
+	ThreadBuffer(const int thread) :
+			ompThread(thread), perfTried(false) {
+		for (int ii = 0; ii < eNumHWCounters; ii++) {
+			perfFD[ii] = -1;
+		}
+		clear();
+	}
+	~ThreadBuffer() {
+		for (int ii = 0; ii < eNumHWCounters; ii++) {
+			if (perfFD[ii] >= 0) close(perfFD[ii]);
+		}
+	}
+	void clear() {
+		memset(seconds, 0, sizeof(seconds));
+		memset(calls, 0, sizeof(calls));
+		memset(counts, 0, sizeof(counts));
+		memset(hwCounts, 0, sizeof(hwCounts));
+	}
+};
+
+// Buffers live until the program exits, so a report can be written after
+// the threads that filled them are gone.
+static std::mutex bufferMutex;
+static std::vector<std::unique_ptr<ThreadBuffer> > allBuffers;
+static thread_local ThreadBuffer* myBuffer = nullptr;
+// Reports include hardware counts once they've been turned on.
+static bool s_hardwareUsed = false;
+
+static ThreadBuffer* getThreadBuffer() {
+	if (!myBuffer) {
+		int thread = 0;
+#ifdef _OPENMP
+		thread = omp_get_thread_num();
+#endif
+		std::lock_guard<std::mutex> lock(bufferMutex);
+		allBuffers.emplace_back(new ThreadBuffer(thread));
+		myBuffer = allBuffers.back().get();
+	}
+	return myBuffer;
+}
+
+// Counting is for this thread only, in user space only, which is what an
+// unprivileged process is normally allowed.
+static bool openPerfEvents(ThreadBuffer& buffer) {
+	buffer.perfTried = true;
+#ifdef __linux__
+	static const uint64_t configs[] = { PERF_COUNT_HW_CPU_CYCLES,
+			PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+			PERF_COUNT_HW_BRANCH_MISSES };
+	for (int ii = 0; ii < eNumHWCounters; ii++) {
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(attr);
+		attr.config = configs[ii];
+		attr.disabled = (ii == 0);
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+				| PERF_FORMAT_TOTAL_TIME_RUNNING;
+		int fd = syscall(SYS_perf_event_open, &attr, 0, -1, buffer.perfFD[0], 0);
+		if (fd < 0) {
+			for (int jj = 0; jj < ii; jj++) {
+				close(buffer.perfFD[jj]);
+				buffer.perfFD[jj] = -1;
+			}
+			return false;
+		}
+		buffer.perfFD[ii] = fd;
+	}
+	ioctl(buffer.perfFD[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(buffer.perfFD[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void enableInstrumentation(const bool enable) {
+	g_instrumentEnabled = enable;
+}
+
+bool enableHardwareCounters(const bool enable) {
+	if (enable) {
+		ThreadBuffer* buffer = getThreadBuffer();
+		if (!buffer->perfTried) openPerfEvents(*buffer);
+		if (buffer->perfFD[0] < 0) {
+			fprintf(stderr, "Hardware counters aren't available; "
+							"check perf_event_paranoid.\n");
+			g_hardwareCountersEnabled = false;
+			return false;
+		}
+	}
+	g_hardwareCountersEnabled = enable;
+	if (enable) s_hardwareUsed = true;
+	return true;
+}
+
+bool readHardwareCounters(uint64_t counts[eNumHWCounters]) {
+	ThreadBuffer* buffer = getThreadBuffer();
+	if (!buffer->perfTried) openPerfEvents(*buffer);
+	if (buffer->perfFD[0] < 0) return false;
+	// Group read format: number of events, time enabled, time running, then
+	// the counts in the order the events were opened.
+	uint64_t data[3 + eNumHWCounters];
+	if (read(buffer->perfFD[0], data, sizeof(data)) != ssize_t(sizeof(data))
+			|| data[0] != eNumHWCounters) {
+		return false;
+	}
+	// If the PMU was shared with other events, scale up for the time the
+	// group wasn't counting.
+	double scale = (data[2] > 0) ? double(data[1]) / data[2] : 0;
+	for (int ii = 0; ii < eNumHWCounters; ii++) {
+		counts[ii] = uint64_t(data[3 + ii] * scale);
+	}
+	return true;
+}
+
+void instrumentAddHardwareCounts(const InstrumentTimer timer,
+		const uint64_t start[eNumHWCounters], const uint64_t end[eNumHWCounters]) {
+	ThreadBuffer* buffer = getThreadBuffer();
+	for (int ii = 0; ii < eNumHWCounters; ii++) {
+		// Scaling can make a multiplexed count go slightly backwards.
+		if (end[ii] > start[ii]) buffer->hwCounts[timer][ii] += end[ii] - start[ii];
+	}
+}
+
+void resetInstrumentation() {
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	for (auto& buffer : allBuffers) {
+		buffer->clear();
+	}
+}
+
+void instrumentAddTime(const InstrumentTimer timer, const double seconds) {
+	ThreadBuffer* buffer = getThreadBuffer();
+	buffer->seconds[timer] += seconds;
+	buffer->calls[timer]++;
+}
+
+void instrumentAddCount(const InstrumentCounter counter, const size_t count) {
+	getThreadBuffer()->counts[counter] += count;
+}
+
+double getInstrumentTime(const InstrumentTimer timer) {
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	double total = 0;
+	for (auto& buffer : allBuffers) {
+		total += buffer->seconds[timer];
+	}
+	return total;
+}
+
+size_t getInstrumentCalls(const InstrumentTimer timer) {
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	size_t total = 0;
+	for (auto& buffer : allBuffers) {
+		total += buffer->calls[timer];
+	}
+	return total;
+}
+
+size_t getInstrumentCount(const InstrumentCounter counter) {
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	size_t total = 0;
+	for (auto& buffer : allBuffers) {
+		total += buffer->counts[counter];
+	}
+	return total;
+}
+
+uint64_t getHardwareCount(const InstrumentTimer timer,
+		const InstrumentHWCounter counter) {
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	uint64_t total = 0;
+	for (auto& buffer : allBuffers) {
+		total += buffer->hwCounts[timer][counter];
+	}
+	return total;
+}
+
+static void sumBuffers(ThreadBuffer& total) {
+	total.clear();
+	for (auto& buffer : allBuffers) {
+		for (int tt = 0; tt < eNumTimers; tt++) {
+			total.seconds[tt] += buffer->seconds[tt];
+			total.calls[tt] += buffer->calls[tt];
+			for (int hh = 0; hh < eNumHWCounters; hh++) {
+				total.hwCounts[tt][hh] += buffer->hwCounts[tt][hh];
+			}
+		}
+		for (int cc = 0; cc < eNumCounters; cc++) {
+			total.counts[cc] += buffer->counts[cc];
+		}
+	}
+}
+
+// Hardware counts for one timer, raw and per output cell.
+static void writeHardwareJSON(FILE* outFile, const ThreadBuffer& buffer,
+		const int timer) {
+	const uint64_t* hw = buffer.hwCounts[timer];
+	for (int hh = 0; hh < eNumHWCounters; hh++) {
+		fprintf(outFile, ", \"%s\": %lu", hwCounterNames[hh], hw[hh]);
+	}
+	fprintf(outFile, ", \"ipc\": %.4f",
+					hw[eHWCycles] ? double(hw[eHWInstructions]) / hw[eHWCycles] : 0.);
+	size_t cells = buffer.counts[eCountCellsCreated];
+	if (cells == 0) {
+		fprintf(outFile, ", \"per_cell\": null");
+		return;
+	}
+	fprintf(outFile, ", \"per_cell\": {");
+	for (int hh = 0; hh < eNumHWCounters; hh++) {
+		fprintf(outFile, "%s\"%s\": %.4f", hh ? ", " : "", hwCounterNames[hh],
+						double(hw[hh]) / cells);
+	}
+	fprintf(outFile, "}");
+}
+
+static void writeBufferJSON(FILE* outFile, const ThreadBuffer& buffer,
+		const char indent[]) {
+	fprintf(outFile, "%s\"timers\": {\n", indent);
+	for (int tt = 0; tt < eNumTimers; tt++) {
+		fprintf(outFile, "%s  \"%s\": {\"seconds\": %.9f, \"calls\": %lu", indent,
+						timerNames[tt], buffer.seconds[tt], buffer.calls[tt]);
+		if (s_hardwareUsed && hasHardwareCounters(InstrumentTimer(tt))) {
+			writeHardwareJSON(outFile, buffer, tt);
+		}
+		fprintf(outFile, "}%s\n", (tt + 1 < eNumTimers) ? "," : "");
+	}
+	fprintf(outFile, "%s},\n", indent);
+	fprintf(outFile, "%s\"counters\": {\n", indent);
+	for (int cc = 0; cc < eNumCounters; cc++) {
+		fprintf(outFile, "%s  \"%s\": %lu%s\n", indent, counterNames[cc],
+						buffer.counts[cc], (cc + 1 < eNumCounters) ? "," : "");
+	}
+	fprintf(outFile, "%s}\n", indent);
+}
+
+bool writeInstrumentReportJSON(FILE* outFile) {
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	ThreadBuffer total(-1);
+	sumBuffers(total);
+	fprintf(outFile, "{\n");
+	fprintf(outFile, "  \"enabled\": %s,\n",
+					g_instrumentEnabled ? "true" : "false");
+	fprintf(outFile, "  \"hardware_counters\": %s,\n",
+					s_hardwareUsed ? "true" : "false");
+	fprintf(outFile, "  \"total\": {\n");
+	writeBufferJSON(outFile, total, "    ");
+	fprintf(outFile, "  },\n");
+	fprintf(outFile, "  \"threads\": [\n");
+	for (size_t ii = 0; ii < allBuffers.size(); ii++) {
+		fprintf(outFile, "    {\n");
+		fprintf(outFile, "      \"omp_thread\": %d,\n", allBuffers[ii]->ompThread);
+		writeBufferJSON(outFile, *allBuffers[ii], "      ");
+		fprintf(outFile, "    }%s\n", (ii + 1 < allBuffers.size()) ? "," : "");
+	}
+	fprintf(outFile, "  ]\n}\n");
+	return !ferror(outFile);
+}
+
+static void writeBufferCSV(FILE* outFile, const ThreadBuffer& buffer,
+		const char thread[]) {
+	for (int tt = 0; tt < eNumTimers; tt++) {
+		fprintf(outFile, "%s,timer,%s,%lu,%.9f\n", thread, timerNames[tt],
+						buffer.calls[tt], buffer.seconds[tt]);
+	}
+	if (s_hardwareUsed) {
+		size_t cells = buffer.counts[eCountCellsCreated];
+		for (int tt = 0; tt < eNumTimers; tt++) {
+			if (!hasHardwareCounters(InstrumentTimer(tt))) continue;
+			for (int hh = 0; hh < eNumHWCounters; hh++) {
+				fprintf(outFile, "%s,hardware,%s.%s,,%lu\n", thread, timerNames[tt],
+								hwCounterNames[hh], buffer.hwCounts[tt][hh]);
+				if (cells > 0) {
+					fprintf(outFile, "%s,hardware_per_cell,%s.%s,,%.4f\n", thread,
+									timerNames[tt], hwCounterNames[hh],
+									double(buffer.hwCounts[tt][hh]) / cells);
+				}
+			}
+		}
+	}
+	for (int cc = 0; cc < eNumCounters; cc++) {
+		fprintf(outFile, "%s,counter,%s,,%lu\n", thread, counterNames[cc],
+						buffer.counts[cc]);
+	}
+}
+
+bool writeInstrumentReportCSV(FILE* outFile) {
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	ThreadBuffer total(-1);
+	sumBuffers(total);
+	fprintf(outFile, "thread,kind,name,calls,value\n");
+	writeBufferCSV(outFile, total, "all");
+	for (auto& buffer : allBuffers) {
+		char thread[20];
+		snprintf(thread, 20, "%d", buffer->ompThread);
+		writeBufferCSV(outFile, *buffer, thread);
+	}
+	return !ferror(outFile);
+}
+
+bool writeInstrumentReport(const char fileName[]) {
+	FILE* outFile = fopen(fileName, "w");
+	if (!outFile) {
+		fprintf(stderr, "Couldn't open file %s for writing.  Bummer!\n",
+						fileName);
+		return false;
+	}
+	size_t len = strlen(fileName);
+	bool isCSV = (len >= 4 && strcmp(fileName + len - 4, ".csv") == 0);
+	bool OK = isCSV ? writeInstrumentReportCSV(outFile) :
+										writeInstrumentReportJSON(outFile);
+	fclose(outFile);
+	return OK;
+}
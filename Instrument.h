@@ -0,0 +1,175 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * Instrument.h
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#ifndef SRC_INSTRUMENT_H_
+#define SRC_INSTRUMENT_H_
+
+#include <stdint.h>
+
+#include <cstdio>
+#include <cstddef>
+
+#include "exa-defs.h"
+
+// Timers and counters for the phases of refinement.  Each thread
+// accumulates into its own buffer, so nothing is shared in the hot loops;
+// buffers are only combined when a report is written.  Instrumentation is
+// off by default, and then each timer or counter costs one test of a global
+// flag.  Timers nest, and times are inclusive.
+
+enum InstrumentTimer {
+	eTimeRead,
+	eTimeLengthScales,
+	eTimePartition,
+	eTimeExtract,
+	eTimeRefine,
+	// One timer per cell type loop in subdividePartMesh.
+	eTimeTetLoop,
+	eTimePyrLoop,
+	eTimePrismLoop,
+	eTimeHexLoop,
+	eTimeBdryTriLoop,
+	eTimeBdryQuadLoop,
+	// Work done within each cell.
+	eTimeEdges,
+	eTimeFaces,
+	eTimeInterior,
+	eTimeCells,
+	eTimeHashLookup,
+	eTimeHashInsert,
+	eTimeMapping,
+	eTimeWrite,
+	eNumTimers
+};
+
+enum InstrumentCounter {
+	eCountVertsCreated,
+	eCountCellsCreated,
+	eCountEdgeLookups,
+	eCountEdgeInserts,
+	eCountTriLookups,
+	eCountTriInserts,
+	eCountQuadLookups,
+	eCountQuadInserts,
+	eCountMappingEvals,
+	eCountBytesWritten,
+	eNumCounters
+};
+
+// Hardware counters, sampled with perf_event_open on Linux.  LLC misses
+// are the kernel's generic cache miss event, which is last level cache
+// misses on most CPUs.
+enum InstrumentHWCounter {
+	eHWCycles, eHWInstructions, eHWLLCMisses, eHWBranchMisses, eNumHWCounters
+};
+
+extern bool g_instrumentEnabled;
+extern bool g_hardwareCountersEnabled;
+
+inline bool isInstrumentEnabled() {
+	return g_instrumentEnabled;
+}
+
+// Turning instrumentation on or off should happen outside parallel regions.
+void enableInstrumentation(const bool enable);
+// Zero all timers and counters for all threads.
+void resetInstrumentation();
+// Hardware counters are only read when instrumentation is also enabled.
+// Returns false, and leaves them off, if perf events can't be opened here
+// (no kernel support, or perf_event_paranoid is too strict).
+bool enableHardwareCounters(const bool enable);
+
+// Reading the counters is a system call, so they're only sampled for the
+// phase and cell type loop timers.  Everything from eTimeEdges through
+// eTimeMapping runs once per cell or more often, which is far too
+// fine-grained for that.
+inline bool hasHardwareCounters(const InstrumentTimer timer) {
+	return timer < eTimeEdges || timer == eTimeWrite;
+}
+
+// Internal; use ScopedTimer and instrumentCount instead.
+void instrumentAddTime(const InstrumentTimer timer, const double seconds);
+void instrumentAddCount(const InstrumentCounter counter, const size_t count);
+bool readHardwareCounters(uint64_t counts[eNumHWCounters]);
+void instrumentAddHardwareCounts(const InstrumentTimer timer,
+		const uint64_t start[eNumHWCounters], const uint64_t end[eNumHWCounters]);
+
+inline void instrumentCount(const InstrumentCounter counter,
+		const size_t count = 1) {
+	if (g_instrumentEnabled) instrumentAddCount(counter, count);
+}
+
+class ScopedTimer {
+	InstrumentTimer m_timer;
+	double m_start;
+	bool m_hardware;
+	uint64_t m_hwStart[eNumHWCounters];
+	ScopedTimer(const ScopedTimer&);
+	ScopedTimer& operator=(const ScopedTimer&);
+public:
+	ScopedTimer(const InstrumentTimer timer) :
+			m_timer(timer), m_start(-1), m_hardware(false) {
+		if (g_instrumentEnabled) {
+			if (g_hardwareCountersEnabled && hasHardwareCounters(timer)) {
+				m_hardware = readHardwareCounters(m_hwStart);
+			}
+			m_start = exaTime();
+		}
+	}
+	~ScopedTimer() {
+		stop();
+	}
+	// For phases that don't end at the end of a scope.
+	void stop() {
+		if (m_start >= 0) instrumentAddTime(m_timer, exaTime() - m_start);
+		m_start = -1;
+		if (m_hardware) {
+			uint64_t hwEnd[eNumHWCounters];
+			if (readHardwareCounters(hwEnd)) {
+				instrumentAddHardwareCounts(m_timer, m_hwStart, hwEnd);
+			}
+			m_hardware = false;
+		}
+	}
+};
+
+// Totals across threads.
+double getInstrumentTime(const InstrumentTimer timer);
+size_t getInstrumentCalls(const InstrumentTimer timer);
+size_t getInstrumentCount(const InstrumentCounter counter);
+uint64_t getHardwareCount(const InstrumentTimer timer,
+		const InstrumentHWCounter counter);
+
+// Structured reports, with totals and a breakdown by thread.  The CSV
+// version has one row per thread and timer or counter, with "all" as the
+// thread for totals.  With hardware counters on, timers also report their
+// counts, both raw and per output cell (cells_created).
+bool writeInstrumentReportJSON(FILE* outFile);
+bool writeInstrumentReportCSV(FILE* outFile);
+// Picks the format from the file name: CSV for names ending in .csv, JSON
+// otherwise.
+bool writeInstrumentReport(const char fileName[]);
+
+#endif /* SRC_INSTRUMENT_H_ */
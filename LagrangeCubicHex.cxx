@@ -18,1718 +18,497 @@
 
 #include "Mapping.h"
 
-void LagrangeCubicHexMapping::setModalValues() {
-	for (int ii = 0; ii < 3; ii++) {
-		// Bottom
-		double& c000 = m_nodalValues[0][ii];
-		double& c100 = m_nodalValues[8][ii];
-		double& c200 = m_nodalValues[9][ii];
-		double& c300 = m_nodalValues[1][ii];
-		double& c010 = m_nodalValues[15][ii];
-		double& c110 = m_nodalValues[32][ii];
-		double& c210 = m_nodalValues[33][ii];
-		double& c310 = m_nodalValues[10][ii];
-		double& c020 = m_nodalValues[14][ii];
-		double& c120 = m_nodalValues[35][ii];
-		double& c220 = m_nodalValues[34][ii];
-		double& c320 = m_nodalValues[11][ii];
-		double& c030 = m_nodalValues[3][ii];
-		double& c130 = m_nodalValues[13][ii];
-		double& c230 = m_nodalValues[12][ii];
-		double& c330 = m_nodalValues[2][ii];
-			// Lower interior layer
-		double& c001 = m_nodalValues[16][ii];
-		double& c101 = m_nodalValues[36][ii];
-		double& c201 = m_nodalValues[37][ii];
-		double& c301 = m_nodalValues[18][ii];
-		double& c011 = m_nodalValues[49][ii];
-		double& c111 = m_nodalValues[56][ii];
-		double& c211 = m_nodalValues[57][ii];
-		double& c311 = m_nodalValues[40][ii];
-		double& c021 = m_nodalValues[48][ii];
-		double& c121 = m_nodalValues[59][ii];
-		double& c221 = m_nodalValues[58][ii];
-		double& c321 = m_nodalValues[41][ii];
-		double& c031 = m_nodalValues[22][ii];
-		double& c131 = m_nodalValues[45][ii];
-		double& c231 = m_nodalValues[44][ii];
-		double& c331 = m_nodalValues[20][ii];
-
-			// Upper interior layer
-		double& c002 = m_nodalValues[17][ii];
-		double& c102 = m_nodalValues[39][ii];
-		double& c202 = m_nodalValues[38][ii];
-		double& c302 = m_nodalValues[19][ii];
-		double& c012 = m_nodalValues[50][ii];
-		double& c112 = m_nodalValues[60][ii];
-		double& c212 = m_nodalValues[61][ii];
-		double& c312 = m_nodalValues[43][ii];
-		double& c022 = m_nodalValues[51][ii];
-		double& c122 = m_nodalValues[63][ii];
-		double& c222 = m_nodalValues[62][ii];
-		double& c322 = m_nodalValues[42][ii];
-		double& c032 = m_nodalValues[23][ii];
-		double& c132 = m_nodalValues[46][ii];
-		double& c232 = m_nodalValues[47][ii];
-		double& c332 = m_nodalValues[21][ii];
-
-			// Top
-		double& c003 = m_nodalValues[4][ii];
-		double& c103 = m_nodalValues[24][ii];
-		double& c203 = m_nodalValues[25][ii];
-		double& c303 = m_nodalValues[5][ii];
-		double& c013 = m_nodalValues[31][ii];
-		double& c113 = m_nodalValues[52][ii];
-		double& c213 = m_nodalValues[53][ii];
-		double& c313 = m_nodalValues[26][ii];
-		double& c023 = m_nodalValues[30][ii];
-		double& c123 = m_nodalValues[55][ii];
-		double& c223 = m_nodalValues[54][ii];
-		double& c323 = m_nodalValues[27][ii];
-		double& c033 = m_nodalValues[7][ii];
-		double& c133 = m_nodalValues[29][ii];
-		double& c233 = m_nodalValues[28][ii];
-		double& c333 = m_nodalValues[6][ii];
-		// Constant term
-
-		C[ii] = c000;
-
-		// Linear terms (3)
-
-		Cu[ii] = +(-11. / 2. * c000 + 9. * c100 + c300 - 9. / 2. * c200);
-		Cv[ii] = +(-11. / 2. * c000 + c030 + 9. * c010 - 9. / 2. * c020);
-		Cw[ii] = +(-11. / 2. * c000 + 9. * c001 - 9. / 2. * c002 + c003);
-
-		// Quadratic terms (6) 2-0-0 (3), 1-1-0 (3)
-
-		Cu2[ii] = +(-9. / 2. * c300 + 18. * c200 - 45. / 2. * c100 + 9. * c000);
-		Cv2[ii] = +(-9. / 2. * c030 + 18. * c020 - 45. / 2. * c010 + 9. * c000);
-		Cw2[ii] = +(18. * c002 - 9. / 2. * c003 - 45. / 2. * c001 + 9. * c000);
-
-		Cuv[ii] = +(121. / 4. * c000 + 99. / 4. * c020 - 99. / 2. * c010
-						- 11. / 2. * c030 - 9. / 2. * c320
-						+ c330 + 9. * c310
-						- 81. / 2. * c120 - 81. / 2. * c210
-						+ 81. / 4. * c220
-						- 9. / 2. * c230
-						+ 9. * c130 + 81. * c110
-						- 99. / 2. * c100 - 11. / 2. * c300
-								+ 99. / 4. * c200);
-
-		Cuw[ii] = +(121. / 4. * c000 - 11. / 2. * c003 + 99. / 4. * c002
-				- 99. / 2. * c001
-						+ 81. * c101 + c303
-						- 9. / 2. * c203 - 81. / 2. * c102
-						+ 81. / 4. * c202 + 9. * c301
-						- 9. / 2. * c302 - 81. / 2. * c201
-						+ 9. * c103
-						- 99. / 2. * c100 - 11. / 2. * c300
-								+ 99. / 4. * c200);
-
-		Cvw[ii] = +(121. / 4. * c000 - 11. / 2. * c003 + 99. / 4. * c002
-				- 99. / 2. * c001
-						+ 99. / 4. * c020
-						- 99. / 2. * c010 - 11. / 2. * c030
-						+ 81. / 4. * c022
-						- 9. / 2. * c023
-						+ 9. * c031
-						- 9. / 2. * c032
-						+ c033 + 81. * c011
-						- 81. / 2. * c012
-						+ 9. * c013
-								- 81. / 2. * c021);
-
-		// Cubic terms (10) 3-0-0 (3), 2-1-0 (6), 1-1-1 (1)
-
-		Cu3[ii] = +(9. / 2. * c300 - 27. / 2. * c200 + 27. / 2. * c100
-				- 9. / 2. * c000);
-
-		Cv3[ii] = +(9. / 2. * c030 - 27. / 2. * c020 + 27. / 2. * c010
-				- 9. / 2. * c000);
-
-		Cw3[ii] = +(-27. / 2. * c002 + 9. / 2. * c003 + 27. / 2. * c001
-				- 9. / 2. * c000);
-
-		Cu2v[ii] = +(-9. / 2. * c330 - 81. / 2. * c310 + 81. / 4. * c320
-				- 99. / 2. * c000 - 81. / 2. * c020
-							+ 81. * c010 + 9. * c030 + 162. * c210 + 495. / 4. * c100
-							- 81. * c220
-							+ 18. * c230 + 99. / 4. * c300
-							- 99. * c200 - 45. / 2. * c130 - 405. / 2. * c110
-									+ 405. / 4. * c120);
-
-		Cuv2[ii] = +(-9. / 2. * c330 - 45. / 2. * c310 + 18. * c320
-				- 99. / 2. * c000
-							- 99. * c020
-							+ 495. / 4. * c010
-							+ 99. / 4. * c030
-							+ 405. / 4. * c210
-							+ 81. * c100
-							- 81. * c220
-							+ 81. / 4. * c230 + 9. * c300
-							- 81. / 2. * c200 - 81. / 2. * c130 - 405. / 2. * c110
-									+ 162. * c120);
-
-		Cu2w[ii] = +(18. * c203 - 9. / 2. * c303 - 405. / 2. * c101
-									- 99. / 2. * c000
-							- 81. / 2. * c002
-							+ 9. * c003 + 81. * c001 + 495. / 4. * c100 + 405. / 4. * c102
-							- 81. * c202
-							+ 99. / 4. * c300
-							- 81. / 2. * c301
-							+ 81. / 4. * c302 + 162. * c201
-									- 99. * c200 - 45. / 2. * c103);
-
-		Cuw2[ii] = +(81. / 4. * c203 - 9. / 2. * c303 - 405. / 2. * c101
-							- 99. / 2. * c000 - 99. * c002
-							+ 99. / 4. * c003 + 495. / 4. * c001 + 81. * c100 + (162 * c102)
-							- 81. * c202
-							+ 9. * c300
-							- 45. / 2. * c301
-							+ (18 * c302) + 405. / 4. * c201
-									- 81. / 2. * c200 - 81. / 2. * c103);
-
-		Cv2w[ii] = +(-99. / 2. * c000 - 81. / 2. * c002 + 9. * c003 + 81. * c001
-							+ 162. * c021
-							- 81. * c022 - 99. * c020
-							+ 405. / 4. * c012
-							- 45. / 2. * c013 - 405. / 2. * c011
-							+ 495. / 4. * c010 + 81. / 4. * c032
-							- 9. / 2. * c033
-							+ 99. / 4. * c030
-							- 81. / 2. * c031
-									+ 18. * c023);
-
-		Cvw2[ii] = +(-99. / 2. * c000 + 99. / 4. * c003 - 99. * c002
-				+ 495. / 4. * c001
-							+ 405. / 4. * c021
-							- 81. * c022 - 81. / 2. * c020
-							+ 162. * c012
-							- 81. / 2. * c013 - 405. / 2. * c011
-							+ 81. * c010 + 18. * c032
-							- 9. / 2. * c033
-							+ 9. * c030
-							- 45. / 2. * c031
-									+ 81. / 4. * c023);
-
-		Cuvw[ii] = +(-81. / 2. * c231 + 99. / 4. * c230 + 81. * c311
-									+ 1089. / 4. * c010
-							+ 81. / 4. * c232
-							- 1331. / 8. * c000 - 729. / 2. * c112
-							+ 729. / 4. * c221
-							- 81. / 2. * c123
-							+ 891. / 4. * c102
-							+ 9. * c331
-							+ 891. / 4. * c120
-							+ 891. / 4. * c021
-							- 81. / 2. * c321
-							- 1089. / 8. * c020
-							- 99. / 2. * c103
-							- 99. / 2. * c310
-							+ 729. * c111
-							- 891. / 8. * c202 - 99. / 2. * c013 - 9. / 2. * c323
-							+ 729. / 4. * c122
-							- 81. / 2. * c312
-							+ 9. * c313 + 99. / 4. * c023
-							- 729. / 2. * c121 - 9. / 2. * c233
-							+ 121. / 4. * c300
-							- 9. / 2. * c332
-							+ 99. / 4. * c302 + 81. * c131
-							- 99. / 2. * c301
-							+ c333 + 81. * c113
-							- 729. / 2. * c211
-							+ 81. / 4. * c322 + 9. * c133
-							- 729. / 8. * c222
-							+ 81. / 4. * c223 + 99. / 4. * c203
-							- 1089. / 8. * c200
-							+ 891. / 4. * c201
-							- 11. / 2. * c033 - 99. / 2. * c031
-							+ 99. / 4. * c032
-							- 99. / 2. * c130
-							+ 1089. / 4. * c100
-							- 81. / 2. * c213
-							+ 729. / 4. * c212
-							- 891. / 8. * c022 - 11. / 2. * c303
-							+ 121. / 4. * c030 + 121. / 4. * c003 + 891. / 4. * c210
-							- 1089. / 8. * c002
-							+ 1089. / 4. * c001 + 891. / 4. * c012
-							- 81. / 2. * c132
-							+ 99. / 4. * c320
-							- 11. / 2. * c330
-							- 891. / 2. * c110
-							- 891. / 2. * c011
-									- 891. / 8. * c220 - 891. / 2. * c101);
-
-		// Quartic terms (12?) 2-2-0 (3), 2-1-1 (3), 3-1-0 (6)
-
-		Cu2v2[ii] = +(81. / 4. * c330 + 405. / 4. * c310 - 81. * c320 + 81. * c000
-							+ 162. * c020
-							- 405. / 2. * c010
-							- 81. / 2. * c030
-							- 405. * c210
-							- 405. / 2. * c100
-							+ 324. * c220
-							- 81. * c230 - 81. / 2. * c300
-							+ 162. * c200 + 405. / 4. * c130 + 2025. / 4. * c110
-									- 405. * c120);
-
-		Cu2w2[ii] = +(-81. * c203 + 81. / 4. * c303 + 2025. / 4. * c101 + 81. * c000
-				- 81. / 2. * c003
-							+ 162. * c002
-							- 405. / 2. * c001 - 405. / 2. * c100 - (405 * c102)
-							+ 324. * c202
-							- 81. / 2. * c300
-							+ 405. / 4. * c301
-							- (81 * c302) - 405. * c201
-									+ 162. * c200 + 405. / 4. * c103);
-
-		Cv2w2[ii] = +(81. * c000 - 81. / 2. * c003 + 162. * c002 - 405. / 2. * c001
-							- 405. * c021
-							+ 324. * c022 + 162. * c020
-							- 405. * c012
-							+ 405. / 4. * c013 + 2025. / 4. * c011
-							- 405. / 2. * c010 - 81. * c032
-							+ 81. / 4. * c033
-							- 81. / 2. * c030
-							+ 405. / 4. * c031
-									- 81. * c023);
-		;
-
-		Cu2vw[ii] = +(162. * c231 - 99. * c230 - 729. / 2. * c311 - 891. / 2. * c010
-							- 81. * c232
-							+ 1089. / 4. * c000 + 3645. / 4. * c112
-							- 729. * c221
-							+ 405. / 4. * c123
-							- 0.4455e4 / 8. * c102
-							- 81. / 2. * c331
-							- 0.4455e4 / 8. * c120
-							- 729. / 2. * c021
-							+ 729. / 4. * c321
-							+ 891. / 4. * c020
-							+ 495. / 4. * c103
-							+ 891. / 4. * c310
-							- 3645. / 2. * c111
-							+ 891. / 2. * c202 + 81. * c013 + 81. / 4. * c323
-							- 3645. / 8. * c122
-							+ 729. / 4. * c312
-							- 81. / 2. * c313 - 81. / 2. * c023
-							+ 3645. / 4. * c121 + 18. * c233
-							- 1089. / 8. * c300
-							+ 81. / 4. * c332
-							- 891. / 8. * c302 - 405. / 2. * c131
-							+ 891. / 4. * c301
-							- 9. / 2. * c333 - 405. / 2. * c113
-							+ 0.1458e4 * c211
-							- 729. / 8. * c322 - 45. / 2. * c133
-							+ 729. / 2. * c222
-							- 81. * c223 - 99. * c203
-							+ 1089. / 2. * c200
-							- 891. * c201
-							+ 9. * c033 + 81. * c031
-							- 81. / 2. * c032
-							+ 495. / 4. * c130
-							- 0.5445e4 / 8. * c100
-							+ 162. * c213
-							- 729. * c212
-							+ 729. / 4. * c022 + 99. / 4. * c303
-							- 99. / 2. * c030 - 99. / 2. * c003 - 891. * c210
-							+ 891. / 4. * c002
-							- 891. / 2. * c001 - 729. / 2. * c012
-							+ 405. / 4. * c132
-							- 891. / 8. * c320
-							+ 99. / 4. * c330
-							+ 0.4455e4 / 4. * c110
-							+ 729. * c011
-									+ 891. / 2. * c220 + 0.4455e4 / 4. * c101);
-
-		Cuv2w[ii] = +(729. / 4. * c231 - 891. / 8. * c230 - 405. / 2. * c311
-							- 0.5445e4 / 8. * c010 - 729. / 8. * c232
-							+ 1089. / 4. * c000 + 3645. / 4. * c112
-							- 729. * c221
-							+ 162. * c123
-							- 729. / 2. * c102 - 81. / 2. * c331 - 891. * c120 - 891. * c021
-							+ 162. * c321 + 1089. / 2. * c020 + 81. * c103 + 495. / 4. * c310
-							- 3645. / 2. * c111
-							+ 729. / 4. * c202 + 495. / 4. * c013 + 18. * c323
-							- (729 * c122)
-							+ 405. / 4. * c312
-							- 0.45e2 / 2. * c313 - 99. * c023
-							+ 0.1458e4 * c121 + 81. / 4. * c233
-							- 99. / 2. * c300
-							+ 81. / 4. * c332
-							- 81. / 2. * c302 - 729. / 2. * c131
-							+ 81. * c301
-							- 9. / 2. * c333 - 405. / 2. * c113
-							+ 3645. / 4. * c211
-							- (81 * c322) - 81. / 2. * c133
-							+ 729. / 2. * c222
-							- 81. * c223 - 81. / 2. * c203
-							+ 891. / 4. * c200
-							- 729. / 2. * c201
-							+ 99. / 4. * c033 + 891. / 4. * c031
-							- 891. / 8. * c032
-							+ 891. / 4. * c130
-							- 891. / 2. * c100
-							+ 405. / 4. * c213
-							- 3645. / 8. * c212
-							+ 891. / 2. * c022 + 9. * c303
-							- 1089. / 8. * c030 - 99. / 2. * c003 - 0.4455e4 / 8. * c210
-							+ 891. / 4. * c002
-							- 891. / 2. * c001 - 0.4455e4 / 8. * c012
-							+ 729. / 4. * c132
-							- 99. * c320
-							+ 99. / 4. * c330
-							+ 0.4455e4 / 4. * c110
-							+ 0.4455e4 / 4. * c011
-							+ 891. / 2. * c220 + 729. * c101);
-
-		Cuvw2[ii] = +(405. / 4. * c231 - 81. / 2. * c230 - 405. / 2. * c311
-							- 891. / 2. * c010 - 81. * c232
-							+ 1089. / 4. * c000 + (1458 * c112)
-							- 3645. / 8. * c221
-							+ 729. / 4. * c123
-							- (891 * c102)
-							- 0.45e2 / 2. * c331
-							- 729. / 2. * c120
-							- 0.4455e4 / 8. * c021
-							+ 405. / 4. * c321
-							+ 891. / 4. * c020
-							+ 891. / 4. * c103
-							+ 81. * c310
-							- 3645. / 2. * c111
-							+ 891. / 2. * c202 + 891. / 4. * c013 + 81. / 4. * c323
-							- (729 * c122)
-							+ (162 * c312)
-							- 81. / 2. * c313 - 891. / 8. * c023
-							+ 3645. / 4. * c121 + 81. / 4. * c233
-							- 99. / 2. * c300
-							+ (18 * c332)
-							- (99 * c302) - 405. / 2. * c131
-							+ 495. / 4. * c301
-							- 9. / 2. * c333 - 729. / 2. * c113
-							+ 3645. / 4. * c211
-							- (81 * c322) - 81. / 2. * c133
-							+ 729. / 2. * c222
-							- 729. / 8. * c223 - 891. / 8. * c203
-							+ 891. / 4. * c200
-							- 0.4455e4 / 8. * c201
-							+ 99. / 4. * c033 + 495. / 4. * c031
-							- 99. * c032
-							+ 81. * c130
-							- 891. / 2. * c100
-							+ 729. / 4. * c213
-							- 729. * c212
-							+ 891. / 2. * c022 + 99. / 4. * c303
-							- 99. / 2. * c030 - 1089. / 8. * c003 - 729. / 2. * c210
-							+ 1089. / 2. * c002
-							- 0.5445e4 / 8. * c001 - 891. * c012
-							+ (162 * c132)
-							- 81. / 2. * c320
-							+ 9. * c330
-							+ 729. * c110
-							+ 0.4455e4 / 4. * c011
-									+ 729. / 4. * c220 + 0.4455e4 / 4. * c101);
-
-		Cu3v[ii] = +(9. / 2. * c330 + 81. / 2. * c310 - 81. / 4. * c320
-				+ 99. / 4. * c000 + 81. / 4. * c020
-							- 81. / 2. * c010
-							- 9. / 2. * c030
-							- 0.243e3 / 2. * c210
-							- 0.297e3 / 4. * c100
-							+ 0.243e3 / 4. * c220
-							- 0.27e2 / 2. * c230 - 99. / 4. * c300
-							+ 0.297e3 / 4. * c200 + 0.27e2 / 2. * c130 + 0.243e3 / 2. * c110
-									- 0.243e3 / 4. * c120);
-
-		Cuv3[ii] = +(9. / 2. * c330 + 0.27e2 / 2. * c310 - 0.27e2 / 2. * c320
-				+ 99. / 4. * c000 + 0.297e3 / 4. * c020
-							- 0.297e3 / 4. * c010
-							- 99. / 4. * c030
-							- 0.243e3 / 4. * c210
-							- 81. / 2. * c100
-							+ 0.243e3 / 4. * c220
-							- 81. / 4. * c230 - 9. / 2. * c300
-							+ 81. / 4. * c200 + 81. / 2. * c130 + 0.243e3 / 2. * c110
-									- 0.243e3 / 2. * c120);
-
-		Cv3w[ii] = +(99. / 4. * c000 + 81. / 4. * c002 - 9. / 2. * c003
-							- 81. / 2. * c001 - 0.243e3 / 2. * c021
-							+ 0.243e3 / 4. * c022
-							+ 0.297e3 / 4. * c020
-							+ 0.27e2 / 2. * c013
-							+ 0.243e3 / 2. * c011
-							- 0.243e3 / 4. * c012 - 0.297e3 / 4. * c010 - 81. / 4. * c032
-							+ 9. / 2. * c033
-							- 99. / 4. * c030
-							+ 81. / 2. * c031
-									- 0.27e2 / 2. * c023);
-
-		Cvw3[ii] = +(99. / 4. * c000 - 99. / 4. * c003 + 0.297e3 / 4. * c002
-				- 0.297e3 / 4. * c001 - 0.243e3 / 4. * c021
-							+ 0.243e3 / 4. * c022
-							+ 81. / 4. * c020
-							+ 81. / 2. * c013
-							+ 0.243e3 / 2. * c011
-							- 0.243e3 / 2. * c012 - 81. / 2. * c010 - 0.27e2 / 2. * c032
-							+ 9. / 2. * c033
-							- 9. / 2. * c030
-							+ 0.27e2 / 2. * c031
-									- 81. / 4. * c023);
-
-		Cuw3[ii] = +(-81. / 4. * c203 + 9. / 2. * c303 + 0.243e3 / 2. * c101
-							+ 99. / 4. * c000
-							- 99. / 4. * c003
-							+ 0.297e3 / 4. * c002
-							- 0.297e3 / 4. * c001 - 81. / 2. * c100 - 0.243e3 / 2. * c102
-							+ 0.243e3 / 4. * c202
-							- 9. / 2. * c300
-							+ 0.27e2 / 2. * c301
-							- 0.27e2 / 2. * c302 - 0.243e3 / 4. * c201
-									+ 81. / 4. * c200 + 81. / 2. * c103);
-
-		Cu3w[ii] = +(-0.27e2 / 2. * c203 + 9. / 2. * c303 + 0.243e3 / 2. * c101
-							+ 99. / 4. * c000 + 81. / 4. * c002
-							- 9. / 2. * c003
-							- 81. / 2. * c001
-							- 0.297e3 / 4. * c100
-							- 0.243e3 / 4. * c102
-							+ 0.243e3 / 4. * c202
-							- 99. / 4. * c300
-							+ 81. / 2. * c301
-							- 81. / 4. * c302 - 0.243e3 / 2. * c201
-									+ 0.297e3 / 4. * c200 + 0.27e2 / 2. * c103);
-
-		// Quintic terms (12?) 3-1-1 (3), 3-2-0 (6), 2-2-1 (3)
+// The modal values are linear combinations of the nodal values, so each
+// row here gives one modal value in terms of the 64 nodal values.
+static const double hexNodalToModal[64][64] = {
+	// C
+	{ 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu
+	{ -5.5, 1, 0, 0, 0, 0, 0, 0, 9, -4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv
+	{ -5.5, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -4.5, 9, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cw
+	{ -5.5, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, -4.5, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu2
+	{ 9, -4.5, 0, 0, 0, 0, 0, 0, -22.5, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuv
+	{ 30.25, -5.5, 1, -5.5, 0, 0, 0, 0, -49.5, 24.75, 9, -4.5, -4.5, 9, 24.75,
+			-49.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 81, -40.5, 20.25,
+			-40.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0 },
+	// Cv2
+	{ 9, 0, 0, -4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 18, -22.5, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cvw
+	{ 30.25, 0, 0, -5.5, -5.5, 0, 0, 1, 0, 0, 0, 0, 0, 0, 24.75, -49.5, -49.5,
+			24.75, 0, 0, 0, 0, 9, -4.5, 0, 0, 0, 0, 0, 0, -4.5, 9, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -40.5, 81, -40.5, 20.25, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0 },
+	// Cw2
+	{ 9, 0, 0, 0, -4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -22.5, 18, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuw
+	{ 30.25, -5.5, 0, 0, -5.5, 1, 0, 0, -49.5, 24.75, 0, 0, 0, 0, 0, 0, -49.5,
+			24.75, 9, -4.5, 0, 0, 0, 0, 9, -4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 81,
+			-40.5, 20.25, -40.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0 },
+	// Cu3
+	{ -4.5, 4.5, 0, 0, 0, 0, 0, 0, 13.5, -13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv3
+	{ -4.5, 0, 0, 4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -13.5, 13.5, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cw3
+	{ -4.5, 0, 0, 0, 4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 13.5, -13.5, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu2v
+	{ -49.5, 24.75, -4.5, 9, 0, 0, 0, 0, 123.75, -99, -40.5, 20.25, 18, -22.5,
+			-40.5, 81, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -202.5, 162,
+			-81, 101.25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuv2
+	{ -49.5, 9, -4.5, 24.75, 0, 0, 0, 0, 81, -40.5, -22.5, 18, 20.25, -40.5, -99,
+			123.75, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -202.5, 101.25,
+			-81, 162, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0 },
+	// Cv2w
+	{ -49.5, 0, 0, 24.75, 9, 0, 0, -4.5, 0, 0, 0, 0, 0, 0, -99, 123.75, 81, -40.5,
+			0, 0, 0, 0, -40.5, 20.25, 0, 0, 0, 0, 0, 0, 18, -22.5, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 162, -202.5, 101.25, -81, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0 },
+	// Cvw2
+	{ -49.5, 0, 0, 9, 24.75, 0, 0, -4.5, 0, 0, 0, 0, 0, 0, -40.5, 81, 123.75, -99,
+			0, 0, 0, 0, -22.5, 18, 0, 0, 0, 0, 0, 0, 20.25, -40.5, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 101.25, -202.5, 162, -81, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0 },
+	// Cu2w
+	{ -49.5, 24.75, 0, 0, 9, -4.5, 0, 0, 123.75, -99, 0, 0, 0, 0, 0, 0, 81, -40.5,
+			-40.5, 20.25, 0, 0, 0, 0, -22.5, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -202.5,
+			162, -81, 101.25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0 },
+	// Cuw2
+	{ -49.5, 9, 0, 0, 24.75, -4.5, 0, 0, 81, -40.5, 0, 0, 0, 0, 0, 0, 123.75, -99,
+			-22.5, 18, 0, 0, 0, 0, -40.5, 20.25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -202.5,
+			101.25, -81, 162, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0 },
+	// Cuvw
+	{ -166.375, 30.25, -5.5, 30.25, 30.25, -5.5, 1, -5.5, 272.25, -136.125, -49.5,
+			24.75, 24.75, -49.5, -136.125, 272.25, 272.25, -136.125, -49.5, 24.75, 9,
+			-4.5, -49.5, 24.75, -49.5, 24.75, 9, -4.5, -4.5, 9, 24.75, -49.5, -445.5,
+			222.75, -111.375, 222.75, -445.5, 222.75, -111.375, 222.75, 81, -40.5,
+			20.25, -40.5, -40.5, 81, -40.5, 20.25, 222.75, -445.5, 222.75, -111.375,
+			81, -40.5, 20.25, -40.5, 729, -364.5, 182.25, -364.5, -364.5, 182.25,
+			-91.125, 182.25 },
+	// Cu3v
+	{ 24.75, -24.75, 4.5, -4.5, 0, 0, 0, 0, -74.25, 74.25, 40.5, -20.25, -13.5,
+			13.5, 20.25, -40.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 121.5,
+			-121.5, 60.75, -60.75, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu3w
+	{ 24.75, -24.75, 0, 0, -4.5, 4.5, 0, 0, -74.25, 74.25, 0, 0, 0, 0, 0, 0,
+			-40.5, 20.25, 40.5, -20.25, 0, 0, 0, 0, 13.5, -13.5, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 121.5, -121.5, 60.75, -60.75, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuv3
+	{ 24.75, -4.5, 4.5, -24.75, 0, 0, 0, 0, -40.5, 20.25, 13.5, -13.5, -20.25,
+			40.5, 74.25, -74.25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			121.5, -60.75, 60.75, -121.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv3w
+	{ 24.75, 0, 0, -24.75, -4.5, 0, 0, 4.5, 0, 0, 0, 0, 0, 0, 74.25, -74.25,
+			-40.5, 20.25, 0, 0, 0, 0, 40.5, -20.25, 0, 0, 0, 0, 0, 0, -13.5, 13.5, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -121.5, 121.5, -60.75, 60.75,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuw3
+	{ 24.75, -4.5, 0, 0, -24.75, 4.5, 0, 0, -40.5, 20.25, 0, 0, 0, 0, 0, 0,
+			-74.25, 74.25, 13.5, -13.5, 0, 0, 0, 0, 40.5, -20.25, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 121.5, -60.75, 60.75, -121.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cvw3
+	{ 24.75, 0, 0, -4.5, -24.75, 0, 0, 4.5, 0, 0, 0, 0, 0, 0, 20.25, -40.5,
+			-74.25, 74.25, 0, 0, 0, 0, 13.5, -13.5, 0, 0, 0, 0, 0, 0, -20.25, 40.5, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -60.75, 121.5, -121.5, 60.75,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu2v2
+	{ 81, -40.5, 20.25, -40.5, 0, 0, 0, 0, -202.5, 162, 101.25, -81, -81, 101.25,
+			162, -202.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 506.25, -405,
+			324, -405, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0 },
+	// Cu2w2
+	{ 81, -40.5, 0, 0, -40.5, 20.25, 0, 0, -202.5, 162, 0, 0, 0, 0, 0, 0, -202.5,
+			162, 101.25, -81, 0, 0, 0, 0, 101.25, -81, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			506.25, -405, 324, -405, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv2w2
+	{ 81, 0, 0, -40.5, -40.5, 0, 0, 20.25, 0, 0, 0, 0, 0, 0, 162, -202.5, -202.5,
+			162, 0, 0, 0, 0, 101.25, -81, 0, 0, 0, 0, 0, 0, -81, 101.25, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -405, 506.25, -405, 324, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu2vw
+	{ 272.25, -136.125, 24.75, -49.5, -49.5, 24.75, -4.5, 9, -680.625, 544.5,
+			222.75, -111.375, -99, 123.75, 222.75, -445.5, -445.5, 222.75, 222.75,
+			-111.375, -40.5, 20.25, 81, -40.5, 123.75, -99, -40.5, 20.25, 18, -22.5,
+			-40.5, 81, 1113.75, -891, 445.5, -556.875, 1113.75, -891, 445.5, -556.875,
+			-364.5, 182.25, -91.125, 182.25, 162, -202.5, 101.25, -81, -364.5, 729,
+			-364.5, 182.25, -202.5, 162, -81, 101.25, -1822.5, 1458, -729, 911.25,
+			911.25, -729, 364.5, -455.625 },
+	// Cuv2w
+	{ 272.25, -49.5, 24.75, -136.125, -49.5, 9, -4.5, 24.75, -445.5, 222.75,
+			123.75, -99, -111.375, 222.75, 544.5, -680.625, -445.5, 222.75, 81, -40.5,
+			-40.5, 20.25, 222.75, -111.375, 81, -40.5, -22.5, 18, 20.25, -40.5, -99,
+			123.75, 1113.75, -556.875, 445.5, -891, 729, -364.5, 182.25, -364.5,
+			-202.5, 162, -81, 101.25, 182.25, -364.5, 182.25, -91.125, -891, 1113.75,
+			-556.875, 445.5, -202.5, 101.25, -81, 162, -1822.5, 911.25, -729, 1458,
+			911.25, -455.625, 364.5, -729 },
+	// Cuvw2
+	{ 272.25, -49.5, 9, -49.5, -136.125, 24.75, -4.5, 24.75, -445.5, 222.75, 81,
+			-40.5, -40.5, 81, 222.75, -445.5, -680.625, 544.5, 123.75, -99, -22.5, 18,
+			123.75, -99, 222.75, -111.375, -40.5, 20.25, 20.25, -40.5, -111.375,
+			222.75, 729, -364.5, 182.25, -364.5, 1113.75, -556.875, 445.5, -891,
+			-202.5, 101.25, -81, 162, 101.25, -202.5, 162, -81, -556.875, 1113.75,
+			-891, 445.5, -364.5, 182.25, -91.125, 182.25, -1822.5, 911.25, -455.625,
+			911.25, 1458, -729, 364.5, -729 },
+	// Cu3vw
+	{ -136.125, 136.125, -24.75, 24.75, 24.75, -24.75, 4.5, -4.5, 408.375,
+			-408.375, -222.75, 111.375, 74.25, -74.25, -111.375, 222.75, 222.75,
+			-111.375, -222.75, 111.375, 40.5, -20.25, -40.5, 20.25, -74.25, 74.25,
+			40.5, -20.25, -13.5, 13.5, 20.25, -40.5, -668.25, 668.25, -334.125,
+			334.125, -668.25, 668.25, -334.125, 334.125, 364.5, -182.25, 91.125,
+			-182.25, -121.5, 121.5, -60.75, 60.75, 182.25, -364.5, 182.25, -91.125,
+			121.5, -121.5, 60.75, -60.75, 1093.5, -1093.5, 546.75, -546.75, -546.75,
+			546.75, -273.375, 273.375 },
+	// Cuv3w
+	{ -136.125, 24.75, -24.75, 136.125, 24.75, -4.5, 4.5, -24.75, 222.75,
+			-111.375, -74.25, 74.25, 111.375, -222.75, -408.375, 408.375, 222.75,
+			-111.375, -40.5, 20.25, 40.5, -20.25, -222.75, 111.375, -40.5, 20.25,
+			13.5, -13.5, -20.25, 40.5, 74.25, -74.25, -668.25, 334.125, -334.125,
+			668.25, -364.5, 182.25, -91.125, 182.25, 121.5, -121.5, 60.75, -60.75,
+			-182.25, 364.5, -182.25, 91.125, 668.25, -668.25, 334.125, -334.125,
+			121.5, -60.75, 60.75, -121.5, 1093.5, -546.75, 546.75, -1093.5, -546.75,
+			273.375, -273.375, 546.75 },
+	// Cuvw3
+	{ -136.125, 24.75, -4.5, 24.75, 136.125, -24.75, 4.5, -24.75, 222.75,
+			-111.375, -40.5, 20.25, 20.25, -40.5, -111.375, 222.75, 408.375, -408.375,
+			-74.25, 74.25, 13.5, -13.5, -74.25, 74.25, -222.75, 111.375, 40.5, -20.25,
+			-20.25, 40.5, 111.375, -222.75, -364.5, 182.25, -91.125, 182.25, -668.25,
+			334.125, -334.125, 668.25, 121.5, -60.75, 60.75, -121.5, -60.75, 121.5,
+			-121.5, 60.75, 334.125, -668.25, 668.25, -334.125, 364.5, -182.25, 91.125,
+			-182.25, 1093.5, -546.75, 273.375, -546.75, -1093.5, 546.75, -273.375,
+			546.75 },
+	// Cu3v2
+	{ -40.5, 40.5, -20.25, 20.25, 0, 0, 0, 0, 121.5, -121.5, -101.25, 81, 60.75,
+			-60.75, -81, 101.25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			-303.75, 303.75, -243, 243, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu3w2
+	{ -40.5, 40.5, 0, 0, 20.25, -20.25, 0, 0, 121.5, -121.5, 0, 0, 0, 0, 0, 0,
+			101.25, -81, -101.25, 81, 0, 0, 0, 0, -60.75, 60.75, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, -303.75, 303.75, -243, 243, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu2v3
+	{ -40.5, 20.25, -20.25, 40.5, 0, 0, 0, 0, 101.25, -81, -60.75, 60.75, 81,
+			-101.25, -121.5, 121.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			-303.75, 243, -243, 303.75, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv3w2
+	{ -40.5, 0, 0, 40.5, 20.25, 0, 0, -20.25, 0, 0, 0, 0, 0, 0, -121.5, 121.5,
+			101.25, -81, 0, 0, 0, 0, -101.25, 81, 0, 0, 0, 0, 0, 0, 60.75, -60.75, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 303.75, -303.75, 243, -243,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu2w3
+	{ -40.5, 20.25, 0, 0, 40.5, -20.25, 0, 0, 101.25, -81, 0, 0, 0, 0, 0, 0,
+			121.5, -121.5, -60.75, 60.75, 0, 0, 0, 0, -101.25, 81, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, -303.75, 243, -243, 303.75, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv2w3
+	{ -40.5, 0, 0, 20.25, 40.5, 0, 0, -20.25, 0, 0, 0, 0, 0, 0, -81, 101.25,
+			121.5, -121.5, 0, 0, 0, 0, -60.75, 60.75, 0, 0, 0, 0, 0, 0, 81, -101.25,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 243, -303.75, 303.75,
+			-243, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu2v2w
+	{ -445.5, 222.75, -111.375, 222.75, 81, -40.5, 20.25, -40.5, 1113.75, -891,
+			-556.875, 445.5, 445.5, -556.875, -891, 1113.75, 729, -364.5, -364.5,
+			182.25, 182.25, -91.125, -364.5, 182.25, -202.5, 162, 101.25, -81, -81,
+			101.25, 162, -202.5, -2784.375, 2227.5, -1782, 2227.5, -1822.5, 1458,
+			-729, 911.25, 911.25, -729, 364.5, -455.625, -729, 911.25, -455.625,
+			364.5, 1458, -1822.5, 911.25, -729, 506.25, -405, 324, -405, 4556.25,
+			-3645, 2916, -3645, -2278.125, 1822.5, -1458, 1822.5 },
+	// Cu2vw2
+	{ -445.5, 222.75, -40.5, 81, 222.75, -111.375, 20.25, -40.5, 1113.75, -891,
+			-364.5, 182.25, 162, -202.5, -364.5, 729, 1113.75, -891, -556.875, 445.5,
+			101.25, -81, -202.5, 162, -556.875, 445.5, 182.25, -91.125, -81, 101.25,
+			182.25, -364.5, -1822.5, 1458, -729, 911.25, -2784.375, 2227.5, -1782,
+			2227.5, 911.25, -455.625, 364.5, -729, -405, 506.25, -405, 324, 911.25,
+			-1822.5, 1458, -729, 911.25, -729, 364.5, -455.625, 4556.25, -3645,
+			1822.5, -2278.125, -3645, 2916, -1458, 1822.5 },
+	// Cuv2w2
+	{ -445.5, 81, -40.5, 222.75, 222.75, -40.5, 20.25, -111.375, 729, -364.5,
+			-202.5, 162, 182.25, -364.5, -891, 1113.75, 1113.75, -891, -202.5, 162,
+			101.25, -81, -556.875, 445.5, -364.5, 182.25, 101.25, -81, -91.125,
+			182.25, 445.5, -556.875, -1822.5, 911.25, -729, 1458, -1822.5, 911.25,
+			-729, 1458, 506.25, -405, 324, -405, -455.625, 911.25, -729, 364.5,
+			2227.5, -2784.375, 2227.5, -1782, 911.25, -455.625, 364.5, -729, 4556.25,
+			-2278.125, 1822.5, -3645, -3645, 1822.5, -1458, 2916 },
+	// Cu3v3
+	{ 20.25, -20.25, 20.25, -20.25, 0, 0, 0, 0, -60.75, 60.75, 60.75, -60.75,
+			-60.75, 60.75, 60.75, -60.75, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 182.25, -182.25, 182.25, -182.25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu3w3
+	{ 20.25, -20.25, 0, 0, -20.25, 20.25, 0, 0, -60.75, 60.75, 0, 0, 0, 0, 0, 0,
+			-60.75, 60.75, 60.75, -60.75, 0, 0, 0, 0, 60.75, -60.75, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 182.25, -182.25, 182.25, -182.25, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv3w3
+	{ 20.25, 0, 0, -20.25, -20.25, 0, 0, 20.25, 0, 0, 0, 0, 0, 0, 60.75, -60.75,
+			-60.75, 60.75, 0, 0, 0, 0, 60.75, -60.75, 0, 0, 0, 0, 0, 0, -60.75, 60.75,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -182.25, 182.25, -182.25,
+			182.25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu3v2w
+	{ 222.75, -222.75, 111.375, -111.375, -40.5, 40.5, -20.25, 20.25, -668.25,
+			668.25, 556.875, -445.5, -334.125, 334.125, 445.5, -556.875, -364.5,
+			182.25, 364.5, -182.25, -182.25, 91.125, 182.25, -91.125, 121.5, -121.5,
+			-101.25, 81, 60.75, -60.75, -81, 101.25, 1670.625, -1670.625, 1336.5,
+			-1336.5, 1093.5, -1093.5, 546.75, -546.75, -911.25, 729, -364.5, 455.625,
+			546.75, -546.75, 273.375, -273.375, -729, 911.25, -455.625, 364.5,
+			-303.75, 303.75, -243, 243, -2733.75, 2733.75, -2187, 2187, 1366.875,
+			-1366.875, 1093.5, -1093.5 },
+	// Cu3vw2
+	{ 222.75, -222.75, 40.5, -40.5, -111.375, 111.375, -20.25, 20.25, -668.25,
+			668.25, 364.5, -182.25, -121.5, 121.5, 182.25, -364.5, -556.875, 445.5,
+			556.875, -445.5, -101.25, 81, 101.25, -81, 334.125, -334.125, -182.25,
+			91.125, 60.75, -60.75, -91.125, 182.25, 1093.5, -1093.5, 546.75, -546.75,
+			1670.625, -1670.625, 1336.5, -1336.5, -911.25, 455.625, -364.5, 729,
+			303.75, -303.75, 243, -243, -455.625, 911.25, -729, 364.5, -546.75,
+			546.75, -273.375, 273.375, -2733.75, 2733.75, -1366.875, 1366.875, 2187,
+			-2187, 1093.5, -1093.5 },
+	// Cu2v3w
+	{ 222.75, -111.375, 111.375, -222.75, -40.5, 20.25, -20.25, 40.5, -556.875,
+			445.5, 334.125, -334.125, -445.5, 556.875, 668.25, -668.25, -364.5,
+			182.25, 182.25, -91.125, -182.25, 91.125, 364.5, -182.25, 101.25, -81,
+			-60.75, 60.75, 81, -101.25, -121.5, 121.5, 1670.625, -1336.5, 1336.5,
+			-1670.625, 911.25, -729, 364.5, -455.625, -546.75, 546.75, -273.375,
+			273.375, 729, -911.25, 455.625, -364.5, -1093.5, 1093.5, -546.75, 546.75,
+			-303.75, 243, -243, 303.75, -2733.75, 2187, -2187, 2733.75, 1366.875,
+			-1093.5, 1093.5, -1366.875 },
+	// Cuv3w2
+	{ 222.75, -40.5, 40.5, -222.75, -111.375, 20.25, -20.25, 111.375, -364.5,
+			182.25, 121.5, -121.5, -182.25, 364.5, 668.25, -668.25, -556.875, 445.5,
+			101.25, -81, -101.25, 81, 556.875, -445.5, 182.25, -91.125, -60.75, 60.75,
+			91.125, -182.25, -334.125, 334.125, 1093.5, -546.75, 546.75, -1093.5,
+			911.25, -455.625, 364.5, -729, -303.75, 303.75, -243, 243, 455.625,
+			-911.25, 729, -364.5, -1670.625, 1670.625, -1336.5, 1336.5, -546.75,
+			273.375, -273.375, 546.75, -2733.75, 1366.875, -1366.875, 2733.75, 2187,
+			-1093.5, 1093.5, -2187 },
+	// Cu2vw3
+	{ 222.75, -111.375, 20.25, -40.5, -222.75, 111.375, -20.25, 40.5, -556.875,
+			445.5, 182.25, -91.125, -81, 101.25, 182.25, -364.5, -668.25, 668.25,
+			334.125, -334.125, -60.75, 60.75, 121.5, -121.5, 556.875, -445.5, -182.25,
+			91.125, 81, -101.25, -182.25, 364.5, 911.25, -729, 364.5, -455.625,
+			1670.625, -1336.5, 1336.5, -1670.625, -546.75, 273.375, -273.375, 546.75,
+			243, -303.75, 303.75, -243, -546.75, 1093.5, -1093.5, 546.75, -911.25,
+			729, -364.5, 455.625, -2733.75, 2187, -1093.5, 1366.875, 2733.75, -2187,
+			1093.5, -1366.875 },
+	// Cuv2w3
+	{ 222.75, -40.5, 20.25, -111.375, -222.75, 40.5, -20.25, 111.375, -364.5,
+			182.25, 101.25, -81, -91.125, 182.25, 445.5, -556.875, -668.25, 668.25,
+			121.5, -121.5, -60.75, 60.75, 334.125, -334.125, 364.5, -182.25, -101.25,
+			81, 91.125, -182.25, -445.5, 556.875, 911.25, -455.625, 364.5, -729,
+			1093.5, -546.75, 546.75, -1093.5, -303.75, 243, -243, 303.75, 273.375,
+			-546.75, 546.75, -273.375, -1336.5, 1670.625, -1670.625, 1336.5, -911.25,
+			455.625, -364.5, 729, -2733.75, 1366.875, -1093.5, 2187, 2733.75,
+			-1366.875, 1093.5, -2187 },
+	// Cu2v2w2
+	{ 729, -364.5, 182.25, -364.5, -364.5, 182.25, -91.125, 182.25, -1822.5, 1458,
+			911.25, -729, -729, 911.25, 1458, -1822.5, -1822.5, 1458, 911.25, -729,
+			-455.625, 364.5, 911.25, -729, 911.25, -729, -455.625, 364.5, 364.5,
+			-455.625, -729, 911.25, 4556.25, -3645, 2916, -3645, 4556.25, -3645, 2916,
+			-3645, -2278.125, 1822.5, -1458, 1822.5, 1822.5, -2278.125, 1822.5, -1458,
+			-3645, 4556.25, -3645, 2916, -2278.125, 1822.5, -1458, 1822.5, -11390.625,
+			9112.5, -7290, 9112.5, 9112.5, -7290, 5832, -7290 },
+	// Cu3v2w2
+	{ -364.5, 364.5, -182.25, 182.25, 182.25, -182.25, 91.125, -91.125, 1093.5,
+			-1093.5, -911.25, 729, 546.75, -546.75, -729, 911.25, 911.25, -729,
+			-911.25, 729, 455.625, -364.5, -455.625, 364.5, -546.75, 546.75, 455.625,
+			-364.5, -273.375, 273.375, 364.5, -455.625, -2733.75, 2733.75, -2187,
+			2187, -2733.75, 2733.75, -2187, 2187, 2278.125, -1822.5, 1458, -1822.5,
+			-1366.875, 1366.875, -1093.5, 1093.5, 1822.5, -2278.125, 1822.5, -1458,
+			1366.875, -1366.875, 1093.5, -1093.5, 6834.375, -6834.375, 5467.5,
+			-5467.5, -5467.5, 5467.5, -4374, 4374 },
+	// Cu2v3w2
+	{ -364.5, 182.25, -182.25, 364.5, 182.25, -91.125, 91.125, -182.25, 911.25,
+			-729, -546.75, 546.75, 729, -911.25, -1093.5, 1093.5, 911.25, -729,
+			-455.625, 364.5, 455.625, -364.5, -911.25, 729, -455.625, 364.5, 273.375,
+			-273.375, -364.5, 455.625, 546.75, -546.75, -2733.75, 2187, -2187,
+			2733.75, -2278.125, 1822.5, -1458, 1822.5, 1366.875, -1366.875, 1093.5,
+			-1093.5, -1822.5, 2278.125, -1822.5, 1458, 2733.75, -2733.75, 2187, -2187,
+			1366.875, -1093.5, 1093.5, -1366.875, 6834.375, -5467.5, 5467.5,
+			-6834.375, -5467.5, 4374, -4374, 5467.5 },
+	// Cu2v2w3
+	{ -364.5, 182.25, -91.125, 182.25, 364.5, -182.25, 91.125, -182.25, 911.25,
+			-729, -455.625, 364.5, 364.5, -455.625, -729, 911.25, 1093.5, -1093.5,
+			-546.75, 546.75, 273.375, -273.375, -546.75, 546.75, -911.25, 729,
+			455.625, -364.5, -364.5, 455.625, 729, -911.25, -2278.125, 1822.5, -1458,
+			1822.5, -2733.75, 2187, -2187, 2733.75, 1366.875, -1093.5, 1093.5,
+			-1366.875, -1093.5, 1366.875, -1366.875, 1093.5, 2187, -2733.75, 2733.75,
+			-2187, 2278.125, -1822.5, 1458, -1822.5, 6834.375, -5467.5, 4374, -5467.5,
+			-6834.375, 5467.5, -4374, 5467.5 },
+	// Cu3v3w
+	{ -111.375, 111.375, -111.375, 111.375, 20.25, -20.25, 20.25, -20.25, 334.125,
+			-334.125, -334.125, 334.125, 334.125, -334.125, -334.125, 334.125, 182.25,
+			-91.125, -182.25, 91.125, 182.25, -91.125, -182.25, 91.125, -60.75, 60.75,
+			60.75, -60.75, -60.75, 60.75, 60.75, -60.75, -1002.375, 1002.375,
+			-1002.375, 1002.375, -546.75, 546.75, -273.375, 273.375, 546.75, -546.75,
+			273.375, -273.375, -546.75, 546.75, -273.375, 273.375, 546.75, -546.75,
+			273.375, -273.375, 182.25, -182.25, 182.25, -182.25, 1640.25, -1640.25,
+			1640.25, -1640.25, -820.125, 820.125, -820.125, 820.125 },
+	// Cu3vw3
+	{ -111.375, 111.375, -20.25, 20.25, 111.375, -111.375, 20.25, -20.25, 334.125,
+			-334.125, -182.25, 91.125, 60.75, -60.75, -91.125, 182.25, 334.125,
+			-334.125, -334.125, 334.125, 60.75, -60.75, -60.75, 60.75, -334.125,
+			334.125, 182.25, -91.125, -60.75, 60.75, 91.125, -182.25, -546.75, 546.75,
+			-273.375, 273.375, -1002.375, 1002.375, -1002.375, 1002.375, 546.75,
+			-273.375, 273.375, -546.75, -182.25, 182.25, -182.25, 182.25, 273.375,
+			-546.75, 546.75, -273.375, 546.75, -546.75, 273.375, -273.375, 1640.25,
+			-1640.25, 820.125, -820.125, -1640.25, 1640.25, -820.125, 820.125 },
+	// Cuv3w3
+	{ -111.375, 20.25, -20.25, 111.375, 111.375, -20.25, 20.25, -111.375, 182.25,
+			-91.125, -60.75, 60.75, 91.125, -182.25, -334.125, 334.125, 334.125,
+			-334.125, -60.75, 60.75, 60.75, -60.75, -334.125, 334.125, -182.25,
+			91.125, 60.75, -60.75, -91.125, 182.25, 334.125, -334.125, -546.75,
+			273.375, -273.375, 546.75, -546.75, 273.375, -273.375, 546.75, 182.25,
+			-182.25, 182.25, -182.25, -273.375, 546.75, -546.75, 273.375, 1002.375,
+			-1002.375, 1002.375, -1002.375, 546.75, -273.375, 273.375, -546.75,
+			1640.25, -820.125, 820.125, -1640.25, -1640.25, 820.125, -820.125,
+			1640.25 },
+	// Cu3v3w2
+	{ 182.25, -182.25, 182.25, -182.25, -91.125, 91.125, -91.125, 91.125, -546.75,
+			546.75, 546.75, -546.75, -546.75, 546.75, 546.75, -546.75, -455.625,
+			364.5, 455.625, -364.5, -455.625, 364.5, 455.625, -364.5, 273.375,
+			-273.375, -273.375, 273.375, 273.375, -273.375, -273.375, 273.375,
+			1640.25, -1640.25, 1640.25, -1640.25, 1366.875, -1366.875, 1093.5,
+			-1093.5, -1366.875, 1366.875, -1093.5, 1093.5, 1366.875, -1366.875,
+			1093.5, -1093.5, -1366.875, 1366.875, -1093.5, 1093.5, -820.125, 820.125,
+			-820.125, 820.125, -4100.625, 4100.625, -4100.625, 4100.625, 3280.5,
+			-3280.5, 3280.5, -3280.5 },
+	// Cu3v2w3
+	{ 182.25, -182.25, 91.125, -91.125, -182.25, 182.25, -91.125, 91.125, -546.75,
+			546.75, 455.625, -364.5, -273.375, 273.375, 364.5, -455.625, -546.75,
+			546.75, 546.75, -546.75, -273.375, 273.375, 273.375, -273.375, 546.75,
+			-546.75, -455.625, 364.5, 273.375, -273.375, -364.5, 455.625, 1366.875,
+			-1366.875, 1093.5, -1093.5, 1640.25, -1640.25, 1640.25, -1640.25,
+			-1366.875, 1093.5, -1093.5, 1366.875, 820.125, -820.125, 820.125,
+			-820.125, -1093.5, 1366.875, -1366.875, 1093.5, -1366.875, 1366.875,
+			-1093.5, 1093.5, -4100.625, 4100.625, -3280.5, 3280.5, 4100.625,
+			-4100.625, 3280.5, -3280.5 },
+	// Cu2v3w3
+	{ 182.25, -91.125, 91.125, -182.25, -182.25, 91.125, -91.125, 182.25,
+			-455.625, 364.5, 273.375, -273.375, -364.5, 455.625, 546.75, -546.75,
+			-546.75, 546.75, 273.375, -273.375, -273.375, 273.375, 546.75, -546.75,
+			455.625, -364.5, -273.375, 273.375, 364.5, -455.625, -546.75, 546.75,
+			1366.875, -1093.5, 1093.5, -1366.875, 1366.875, -1093.5, 1093.5,
+			-1366.875, -820.125, 820.125, -820.125, 820.125, 1093.5, -1366.875,
+			1366.875, -1093.5, -1640.25, 1640.25, -1640.25, 1640.25, -1366.875,
+			1093.5, -1093.5, 1366.875, -4100.625, 3280.5, -3280.5, 4100.625, 4100.625,
+			-3280.5, 3280.5, -4100.625 },
+	// Cu3v3w3
+	{ -91.125, 91.125, -91.125, 91.125, 91.125, -91.125, 91.125, -91.125, 273.375,
+			-273.375, -273.375, 273.375, 273.375, -273.375, -273.375, 273.375,
+			273.375, -273.375, -273.375, 273.375, 273.375, -273.375, -273.375,
+			273.375, -273.375, 273.375, 273.375, -273.375, -273.375, 273.375, 273.375,
+			-273.375, -820.125, 820.125, -820.125, 820.125, -820.125, 820.125,
+			-820.125, 820.125, 820.125, -820.125, 820.125, -820.125, -820.125,
+			820.125, -820.125, 820.125, 820.125, -820.125, 820.125, -820.125, 820.125,
+			-820.125, 820.125, -820.125, 2460.375, -2460.375, 2460.375, -2460.375,
+			-2460.375, 2460.375, -2460.375, 2460.375 }
+};
 
-		Cuvw3[ii] = +(-0.243e3 / 4. * c231 + 81. / 4. * c230 + 0.243e3 / 2. * c311
-							+ 891. / 4. * c010 + 0.243e3 / 4. * c232
-							- 1089. / 8. * c000 - 0.2187e4 / 2. * c112
-							+ 0.2187e4 / 8. * c221
-							- 729. / 4. * c123
-							+ 0.2673e4 / 4. * c102
-							+ 0.27e2 / 2. * c331
-							+ 729. / 4. * c120
-							+ 0.2673e4 / 8. * c021
-							- 0.243e3 / 4. * c321
-							- 891. / 8. * c020
-							- 891. / 4. * c103
-							- 81. / 2. * c310
-							+ 0.2187e4 / 2. * c111
-							- 0.2673e4 / 8. * c202 - 891. / 4. * c013 - 81. / 4. * c323
-							+ 0.2187e4 / 4. * c122
-							- 0.243e3 / 2. * c312
-							+ 81. / 2. * c313 + 891. / 8. * c023
-							- 0.2187e4 / 4. * c121 - 81. / 4. * c233
-							+ 99. / 4. * c300
-							- 0.27e2 / 2. * c332
-							+ 0.297e3 / 4. * c302 + 0.243e3 / 2. * c131
-							- 0.297e3 / 4. * c301
-							+ 9. / 2. * c333 + 729. / 2. * c113
-							- 0.2187e4 / 4. * c211
-							+ 0.243e3 / 4. * c322 + 81. / 2. * c133
-							- 0.2187e4 / 8. * c222
-							+ 729. / 8. * c223 + 891. / 8. * c203
-							- 891. / 8. * c200
-							+ 0.2673e4 / 8. * c201
-							- 99. / 4. * c033 - 0.297e3 / 4. * c031
-							+ 0.297e3 / 4. * c032
-							- 81. / 2. * c130
-							+ 891. / 4. * c100
-							- 729. / 4. * c213
-							+ 0.2187e4 / 4. * c212
-							- 0.2673e4 / 8. * c022 - 99. / 4. * c303
-							+ 99. / 4. * c030 + 1089. / 8. * c003 + 729. / 4. * c210
-							- 0.3267e4 / 8. * c002
-							+ 0.3267e4 / 8. * c001 + 0.2673e4 / 4. * c012
-							- 0.243e3 / 2. * c132
-							+ 81. / 4. * c320
-							- 9. / 2. * c330
-							- 729. / 2. * c110
-							- 0.2673e4 / 4. * c011
-									- 729. / 8. * c220 - 0.2673e4 / 4. * c101);
-
-		Cu3vw[ii] = +(-0.243e3 / 2. * c231 + 0.297e3 / 4. * c230 + 729. / 2. * c311
-							+ 891. / 4. * c010 + 0.243e3 / 4. * c232
-							- 1089. / 8. * c000 - 0.2187e4 / 4. * c112
-							+ 0.2187e4 / 4. * c221
-							- 0.243e3 / 4. * c123
-							+ 0.2673e4 / 8. * c102
-							+ 81. / 2. * c331
-							+ 0.2673e4 / 8. * c120
-							+ 729. / 4. * c021
-							- 729. / 4. * c321
-							- 891. / 8. * c020
-							- 0.297e3 / 4. * c103
-							- 891. / 4. * c310
-							+ 0.2187e4 / 2. * c111
-							- 0.2673e4 / 8. * c202 - 81. / 2. * c013 - 81. / 4. * c323
-							+ 0.2187e4 / 8. * c122
-							- 729. / 4. * c312
-							+ 81. / 2. * c313 + 81. / 4. * c023
-							- 0.2187e4 / 4. * c121 - 0.27e2 / 2. * c233
-							+ 1089. / 8. * c300
-							- 81. / 4. * c332
-							+ 891. / 8. * c302 + 0.243e3 / 2. * c131
-							- 891. / 4. * c301
-							+ 9. / 2. * c333 + 0.243e3 / 2. * c113
-							- 0.2187e4 / 2. * c211
-							+ 729. / 8. * c322 + 0.27e2 / 2. * c133
-							- 0.2187e4 / 8. * c222
-							+ 0.243e3 / 4. * c223 + 0.297e3 / 4. * c203
-							- 0.3267e4 / 8. * c200
-							+ 0.2673e4 / 4. * c201
-							- 9. / 2. * c033 - 81. / 2. * c031
-							+ 81. / 4. * c032
-							- 0.297e3 / 4. * c130
-							+ 0.3267e4 / 8. * c100
-							- 0.243e3 / 2. * c213
-							+ 0.2187e4 / 4. * c212
-							- 729. / 8. * c022 - 99. / 4. * c303
-							+ 99. / 4. * c030 + 99. / 4. * c003 + 0.2673e4 / 4. * c210
-							- 891. / 8. * c002
-							+ 891. / 4. * c001 + 729. / 4. * c012
-							- 0.243e3 / 4. * c132
-							+ 891. / 8. * c320
-							- 99. / 4. * c330
-							- 0.2673e4 / 4. * c110
-							- 729. / 2. * c011
-									- 0.2673e4 / 8. * c220 - 0.2673e4 / 4. * c101);
-
-		Cuv3w[ii] = +(-729. / 4. * c231 + 891. / 8. * c230 + 0.243e3 / 2. * c311
-							+ 0.3267e4 / 8. * c010 + 729. / 8. * c232
-							- 1089. / 8. * c000 - 0.2187e4 / 4. * c112
-							+ 0.2187e4 / 4. * c221
-							- 0.243e3 / 2. * c123
-							+ 729. / 4. * c102
-							+ 81. / 2. * c331
-							+ 0.2673e4 / 4. * c120
-							+ 0.2673e4 / 4. * c021
-							- 0.243e3 / 2. * c321
-							- 0.3267e4 / 8. * c020
-							- 81. / 2. * c103
-							- 0.297e3 / 4. * c310
-							+ 0.2187e4 / 2. * c111
-							- 729. / 8. * c202 - 0.297e3 / 4. * c013 - 0.27e2 / 2. * c323
-							+ 0.2187e4 / 4. * c122
-							- 0.243e3 / 4. * c312
-							+ 0.27e2 / 2. * c313 + 0.297e3 / 4. * c023
-							- 0.2187e4 / 2. * c121 - 81. / 4. * c233
-							+ 99. / 4. * c300
-							- 81. / 4. * c332
-							+ 81. / 4. * c302 + 729. / 2. * c131
-							- 81. / 2. * c301
-							+ 9. / 2. * c333 + 0.243e3 / 2. * c113
-							- 0.2187e4 / 4. * c211
-							+ 0.243e3 / 4. * c322 + 81. / 2. * c133
-							- 0.2187e4 / 8. * c222
-							+ 0.243e3 / 4. * c223 + 81. / 4. * c203
-							- 891. / 8. * c200
-							+ 729. / 4. * c201
-							- 99. / 4. * c033 - 891. / 4. * c031
-							+ 891. / 8. * c032
-							- 891. / 4. * c130
-							+ 891. / 4. * c100
-							- 0.243e3 / 4. * c213
-							+ 0.2187e4 / 8. * c212
-							- 0.2673e4 / 8. * c022 - 9. / 2. * c303
-							+ 1089. / 8. * c030 + 99. / 4. * c003 + 0.2673e4 / 8. * c210
-							- 891. / 8. * c002
-							+ 891. / 4. * c001 + 0.2673e4 / 8. * c012
-							- 729. / 4. * c132
-							+ 0.297e3 / 4. * c320
-							- 99. / 4. * c330
-							- 0.2673e4 / 4. * c110
-							- 0.2673e4 / 4. * c011
-									- 0.2673e4 / 8. * c220
-									- 729. / 2. * c101);
-
-		Cv3w2[ii] = +(-81. / 2. * c000 + 81. / 4. * c003 - 81. * c002
-				+ 405. / 4. * c001
-							+ 0.1215e4 / 4. * c021
-							- 0.243e3 * c022 - 0.243e3 / 2. * c020
-							+ 0.243e3 * c012
-							- 0.243e3 / 4. * c013 - 0.1215e4 / 4. * c011
-							+ 0.243e3 / 2. * c010 + 81. * c032
-							- 81. / 4. * c033
-							+ 81. / 2. * c030
-							- 405. / 4. * c031
-									+ 0.243e3 / 4. * c023);
-
-		Cv2w3[ii] = +(-81. / 2. * c000 + 81. / 2. * c003 - 0.243e3 / 2. * c002
-				+ 0.243e3 / 2. * c001 + 0.243e3 * c021
-							- 0.243e3 * c022 - 81. * c020
-							+ 0.1215e4 / 4. * c012
-							- 405. / 4. * c013 - 0.1215e4 / 4. * c011
-							+ 405. / 4. * c010 + 0.243e3 / 4. * c032
-							- 81. / 4. * c033
-							+ 81. / 4. * c030
-							- 0.243e3 / 4. * c031
-									+ 81. * c023);
-
-		Cu3v2[ii] = +(-81. / 4. * c330 - 405. / 4. * c310 + 81. * c320
-				- 81. / 2. * c000
-							- 81. * c020
-							+ 405. / 4. * c010
-							+ 81. / 4. * c030
-							+ 0.1215e4 / 4. * c210
-							+ 0.243e3 / 2. * c100
-							- 0.243e3 * c220
-							+ 0.243e3 / 4. * c230 + 81. / 2. * c300
-							- 0.243e3 / 2. * c200 - 0.243e3 / 4. * c130 - 0.1215e4 / 4. * c110
-									+ 0.243e3 * c120);
-
-		Cu2v3[ii] = +(-81. / 4. * c330 - 0.243e3 / 4. * c310 + 0.243e3 / 4. * c320
-				- 81. / 2. * c000 - 0.243e3 / 2. * c020
-							+ 0.243e3 / 2. * c010
-							+ 81. / 2. * c030
-							+ 0.243e3 * c210
-							+ 405. / 4. * c100
-							- 0.243e3 * c220
-							+ 81. * c230 + 81. / 4. * c300
-							- 81. * c200 - 405. / 4. * c130 - 0.1215e4 / 4. * c110
-									+ 0.1215e4 / 4. * c120);
-
-		Cu2w3[ii] = +(81. * c203 - 81. / 4. * c303 - 0.1215e4 / 4. * c101
-							- 81. / 2. * c000
-							+ 81. / 2. * c003
-							- 0.243e3 / 2. * c002
-							+ 0.243e3 / 2. * c001 + 405. / 4. * c100 + 0.1215e4 / 4. * c102
-							- 0.243e3 * c202
-							+ 81. / 4. * c300
-							- 0.243e3 / 4. * c301
-							+ 0.243e3 / 4. * c302 + 0.243e3 * c201
-									- 81. * c200 - 405. / 4. * c103);
-
-		Cu3w2[ii] = +(0.243e3 / 4. * c203 - 81. / 4. * c303 - 0.1215e4 / 4. * c101
-							- 81. / 2. * c000
-							+ 81. / 4. * c003
-							- 81. * c002
-							+ 405. / 4. * c001 + 0.243e3 / 2. * c100 + (243 * c102)
-							- 0.243e3 * c202
-							+ 81. / 2. * c300
-							- 405. / 4. * c301
-							+ (81 * c302) + 0.1215e4 / 4. * c201
-									- 0.243e3 / 2. * c200 - 0.243e3 / 4. * c103);
-
-		Cu2v2w[ii] = +(-729. * c231 + 891. / 2. * c230 + 3645. / 4. * c311
-								+ 0.4455e4 / 4. * c010 + 729. / 2. * c232
-								- 891. / 2. * c000 - 0.18225e5 / 8. * c112
-								+ 0.2916e4 * c221
-								- 405. * c123
-								+ 3645. / 4. * c102
-								+ 729. / 4. * c331
-								+ 0.4455e4 / 2. * c120
-								+ 0.1458e4 * c021
-								- 729. * c321
-								- 891. * c020
-								- 405. / 2. * c103
-								- 0.4455e4 / 8. * c310
-								+ 0.18225e5 / 4. * c111
-								- 729. * c202 - 405. / 2. * c013 - 81. * c323
-								+ 3645. / 2. * c122
-								- 3645. / 8. * c312
-								+ 405. / 4. * c313 + 162. * c023
-								- 3645. * c121 - 81. * c233
-								+ 891. / 4. * c300
-								- 729. / 8. * c332
-								+ 729. / 4. * c302 + 3645. / 4. * c131
-								- 729. / 2. * c301
-								+ 81. / 4. * c333 + 2025. / 4. * c113
-								- 3645. * c211
-								+ 729. / 2. * c322 + 405. / 4. * c133
-								- 0.1458e4 * c222
-								+ 324. * c223 + 162. * c203
-								- 891. * c200
-								+ 0.1458e4 * c201
-								- 81. / 2. * c033 - 729. / 2. * c031
-								+ 729. / 4. * c032
-								- 0.4455e4 / 8. * c130
-								+ 0.4455e4 / 4. * c100
-								- 405. * c213
-								+ 3645. / 2. * c212
-								- 729. * c022 - 81. / 2. * c303
-								+ 891. / 4. * c030 + 81. * c003 + 0.4455e4 / 2. * c210
-								- 729. / 2. * c002
-								+ 729. * c001 + 3645. / 4. * c012
-								- 3645. / 8. * c132
-								+ 891. / 2. * c320
-								- 891. / 8. * c330
-								- 0.22275e5 / 8. * c110
-								- 3645. / 2. * c011
-								- 0.1782e4 * c220 - 3645. / 2. * c101);
-
-		Cu2vw2[ii] = +(-405. * c231 + 162. * c230 + 3645. / 4. * c311 + 729. * c010
-								+ 324. * c232
-								- 891. / 2. * c000 - (3645 * c112)
-								+ 3645. / 2. * c221
-								- 3645. / 8. * c123
-								+ 0.4455e4 / 2. * c102
-								+ 405. / 4. * c331
-								+ 3645. / 4. * c120
-								+ 3645. / 4. * c021
-								- 3645. / 8. * c321
-								- 729. / 2. * c020
-								- 0.4455e4 / 8. * c103
-								- 729. / 2. * c310
-								+ 0.18225e5 / 4. * c111
-								- 0.1782e4 * c202 - 729. / 2. * c013 - 729. / 8. * c323
-								+ 3645. / 2. * c122
-								- (729 * c312)
-								+ 729. / 4. * c313 + 729. / 4. * c023
-								- 0.18225e5 / 8. * c121 - 81. * c233
-								+ 891. / 4. * c300
-								- (81 * c332)
-								+ 891. / 2. * c302 + 2025. / 4. * c131
-								- 0.4455e4 / 8. * c301
-								+ 81. / 4. * c333 + 3645. / 4. * c113
-								- 3645. * c211
-								+ 729. / 2. * c322 + 405. / 4. * c133
-								- 0.1458e4 * c222
-								+ 729. / 2. * c223 + 891. / 2. * c203
-								- 891. * c200
-								+ 0.4455e4 / 2. * c201
-								- 81. / 2. * c033 - 405. / 2. * c031
-								+ 162. * c032
-								- 405. / 2. * c130
-								+ 0.4455e4 / 4. * c100
-								- 729. * c213
-								+ 0.2916e4 * c212
-								- 729. * c022 - 891. / 8. * c303
-								+ 81. * c030 + 891. / 4. * c003 + 0.1458e4 * c210
-								- 891. * c002
-								+ 0.4455e4 / 4. * c001 + 0.1458e4 * c012
-								- (405 * c132)
-								+ 729. / 4. * c320
-								- 81. / 2. * c330
-								- 3645. / 2. * c110
-								- 3645. / 2. * c011
-										- 729. * c220 - 0.22275e5 / 8. * c101);
-
-		Cuv2w2[ii] =
-				+(-3645. / 8. * c231 + 729. / 4. * c230 + 2025. / 4. * c311
-								+ 0.4455e4 / 4. * c010 + 729. / 2. * c232
-								- 891. / 2. * c000 - (3645 * c112)
-								+ 0.3645e4 / 2. * c221
-								- 729. * c123
-								+ (1458 * c102)
-								+ 405. / 4. * c331
-								+ 0.1458e4 * c120
-								+ 0.4455e4 / 2. * c021
-								- 405. * c321
-								- 891. * c020
-								- 729. / 2. * c103
-								- 405. / 2. * c310
-								+ 0.18225e5 / 4. * c111
-								- 729. * c202 - 0.4455e4 / 8. * c013 - 81. * c323
-								+ (2916 * c122)
-								- (405 * c312)
-								+ 405. / 4. * c313 + 891. / 2. * c023
-								- 0.3645e4 * c121 - 729. / 8. * c233
-								+ 81. * c300
-								- (81 * c332)
-								+ (162 * c302) + 0.3645e4 / 4. * c131
-								- 405. / 2. * c301
-								+ 81. / 4. * c333 + 0.3645e4 / 4. * c113
-								- 0.18225e5 / 8. * c211
-								+ (324 * c322) + 729. / 4. * c133
-								- 0.1458e4 * c222
-								+ 729. / 2. * c223 + 729. / 4. * c203
-								- 729. / 2. * c200
-								+ 0.3645e4 / 4. * c201
-								- 891. / 8. * c033 - 0.4455e4 / 8. * c031
-								+ 891. / 2. * c032
-								- 729. / 2. * c130
-								+ 729. * c100
-								- 0.3645e4 / 8. * c213
-								+ 0.3645e4 / 2. * c212
-								- 0.1782e4 * c022 - 81. / 2. * c303
-								+ 891. / 4. * c030 + 891. / 4. * c003 + 0.3645e4 / 4. * c210
-								- 891. * c002
-								+ 0.4455e4 / 4. * c001 + 0.4455e4 / 2. * c012
-								- (729 * c132)
-								+ 162. * c320
-								- 81. / 2. * c330
-								- 0.3645e4 / 2. * c110
-								- 0.22275e5 / 8. * c011
-					- 729. * c220 - 0.3645e4 / 2. * c101);
-
-		// Sixth power terms (10) 3-2-1 (6), 3-3-0 (3), 2-2-2 (1)
-
-		Cuv3w2[ii] = +(0.3645e4 / 8. * c231 - 729. / 4. * c230
-										- 0.1215e4 / 4. * c311
-								- 0.2673e4 / 4. * c010 - 729. / 2. * c232
-								+ 891. / 4. * c000 + (2187 * c112)
-								- 0.10935e5 / 8. * c221
-								+ 0.2187e4 / 4. * c123
-								- (729 * c102)
-								- 405. / 4. * c331
-								- 0.2187e4 / 2. * c120
-								- 0.13365e5 / 8. * c021
-								+ 0.1215e4 / 4. * c321
-								+ 0.2673e4 / 4. * c020
-								+ 729. / 4. * c103
-								+ 0.243e3 / 2. * c310
-								- 0.10935e5 / 4. * c111
-								+ 729. / 2. * c202 + 0.2673e4 / 8. * c013 + 0.243e3 / 4. * c323
-								- (2187 * c122)
-								+ (243 * c312)
-								- 0.243e3 / 4. * c313 - 0.2673e4 / 8. * c023
-								+ 0.10935e5 / 4. * c121 + 729. / 8. * c233
-								- 81. / 2. * c300
-								+ (81 * c332)
-								- (81 * c302) - 0.3645e4 / 4. * c131
-								+ 405. / 4. * c301
-								- 81. / 4. * c333 - 0.2187e4 / 4. * c113
-								+ 0.10935e5 / 8. * c211
-								- (243 * c322) - 729. / 4. * c133
-								+ 0.2187e4 / 2. * c222
-								- 0.2187e4 / 8. * c223 - 729. / 8. * c203
-								+ 729. / 4. * c200
-								- 0.3645e4 / 8. * c201
-								+ 891. / 8. * c033 + 0.4455e4 / 8. * c031
-								- 891. / 2. * c032
-								+ 729. / 2. * c130
-								- 729. / 2. * c100
-								+ 0.2187e4 / 8. * c213
-								- 0.2187e4 / 2. * c212
-								+ 0.2673e4 / 2. * c022 + 81. / 4. * c303
-								- 891. / 4. * c030 - 891. / 8. * c003 - 0.2187e4 / 4. * c210
-								+ 891. / 2. * c002
-								- 0.4455e4 / 8. * c001 - 0.2673e4 / 2. * c012
-								+ (729 * c132)
-								- 0.243e3 / 2. * c320
-								+ 81. / 2. * c330
-								+ 0.2187e4 / 2. * c110
-								+ 0.13365e5 / 8. * c011
-										+ 0.2187e4 / 4. * c220
-										+ 0.3645e4 / 4. * c101);
-
-		Cuv2w3[ii] = +(0.2187e4 / 8. * c231 - 729. / 8. * c230
-										- 0.1215e4 / 4. * c311
-								- 0.4455e4 / 8. * c010 - 0.2187e4 / 8. * c232
-								+ 891. / 4. * c000 + 0.10935e5 / 4. * c112
-								- 0.2187e4 / 2. * c221
-								+ 729. * c123
-								- 0.2187e4 / 2. * c102
-								- 0.243e3 / 4. * c331
-								- 729. * c120
-								- 0.2673e4 / 2. * c021
-								+ 0.243e3 * c321
-								+ 891. / 2. * c020
-								+ 729. / 2. * c103
-								+ 405. / 4. * c310
-								- 0.10935e5 / 4. * c111
-								+ 0.2187e4 / 4. * c202 + 0.4455e4 / 8. * c013 + 81. * c323
-								- (2187 * c122)
-								+ 0.1215e4 / 4. * c312
-								- 405. / 4. * c313 - 891. / 2. * c023
-								+ 0.2187e4 * c121 + 729. / 8. * c233
-								- 81. / 2. * c300
-								+ 0.243e3 / 4. * c332
-								- 0.243e3 / 2. * c302 - 0.2187e4 / 4. * c131
-								+ 0.243e3 / 2. * c301
-								- 81. / 4. * c333 - 0.3645e4 / 4. * c113
-								+ 0.10935e5 / 8. * c211
-								- (243 * c322) - 729. / 4. * c133
-								+ 0.2187e4 / 2. * c222
-								- 729. / 2. * c223 - 729. / 4. * c203
-								+ 729. / 4. * c200
-								- 0.2187e4 / 4. * c201
-								+ 891. / 8. * c033 + 0.2673e4 / 8. * c031
-								- 0.2673e4 / 8. * c032
-								+ 729. / 4. * c130
-								- 729. / 2. * c100
-								+ 0.3645e4 / 8. * c213
-								- 0.10935e5 / 8. * c212
-								+ 0.2673e4 / 2. * c022 + 81. / 2. * c303
-								- 891. / 8. * c030 - 891. / 4. * c003 - 0.3645e4 / 8. * c210
-								+ 0.2673e4 / 4. * c002
-								- 0.2673e4 / 4. * c001 - 0.13365e5 / 8. * c012
-								+ 0.2187e4 / 4. * c132
-								- 81. * c320
-								+ 81. / 4. * c330
-								+ 0.3645e4 / 4. * c110
-								+ 0.13365e5 / 8. * c011
-										+ 729. / 2. * c220
-										+ 0.2187e4 / 2. * c101);
-
-		Cu2v3w[ii] = +(729. * c231 - 891. / 2. * c230 - 0.2187e4 / 4. * c311
-								- 0.2673e4 / 4. * c010 - 729. / 2. * c232
-								+ 891. / 4. * c000 + 0.10935e5 / 8. * c112
-								- 0.2187e4 * c221
-								+ 0.1215e4 / 4. * c123
-								- 0.3645e4 / 8. * c102
-								- 729. / 4. * c331
-								- 0.13365e5 / 8. * c120 - 0.2187e4 / 2. * c021
-								+ 0.2187e4 / 4. * c321
-								+ 0.2673e4 / 4. * c020
-								+ 405. / 4. * c103
-								+ 0.2673e4 / 8. * c310
-								- 0.10935e5 / 4. * c111
-								+ 729. / 2. * c202 + 0.243e3 / 2. * c013 + 0.243e3 / 4. * c323
-								- 0.10935e5 / 8. * c122
-								+ 0.2187e4 / 8. * c312
-								- 0.243e3 / 4. * c313 - 0.243e3 / 2. * c023
-								+ 0.10935e5 / 4. * c121 + 81. * c233
-								- 891. / 8. * c300
-								+ 729. / 8. * c332
-								- 729. / 8. * c302 - 0.3645e4 / 4. * c131
-								+ 729. / 4. * c301
-								- 81. / 4. * c333 - 0.1215e4 / 4. * c113
-								+ 0.2187e4 * c211
-								- 0.2187e4 / 8. * c322 - 405. / 4. * c133
-								+ 0.2187e4 / 2. * c222
-								- 0.243e3 * c223 - 81. * c203
-								+ 891. / 2. * c200
-								- 729. * c201
-								+ 81. / 2. * c033 + 729. / 2. * c031
-								- 729. / 4. * c032
-								+ 0.4455e4 / 8. * c130
-								- 0.4455e4 / 8. * c100
-								+ 0.243e3 * c213
-								- 0.2187e4 / 2. * c212
-								+ 0.2187e4 / 4. * c022 + 81. / 4. * c303
-								- 891. / 4. * c030 - 81. / 2. * c003 - 0.2673e4 / 2. * c210
-								+ 729. / 4. * c002
-								- 729. / 2. * c001 - 0.2187e4 / 4. * c012
-								+ 0.3645e4 / 8. * c132
-								- 0.2673e4 / 8. * c320
-								+ 891. / 8. * c330
-								+ 0.13365e5 / 8. * c110
-								+ 0.2187e4 / 2. * c011
-								+ 0.2673e4 / 2. * c220
-										+ 0.3645e4 / 4. * c101);
-
-		Cu2vw3[ii] = +(0.243e3 * c231 - 81. * c230 - 0.2187e4 / 4. * c311
-								- 729. / 2. * c010 - 0.243e3 * c232
-								+ 891. / 4. * c000 + 0.10935e5 / 4. * c112
-								- 0.2187e4 / 2. * c221
-								+ 0.3645e4 / 8. * c123
-								- 0.13365e5 / 8. * c102
-								- 0.243e3 / 4. * c331
-								- 0.3645e4 / 8. * c120 - 0.2187e4 / 4. * c021
-								+ 0.2187e4 / 8. * c321
-								+ 729. / 4. * c020
-								+ 0.4455e4 / 8. * c103
-								+ 729. / 4. * c310
-								- 0.10935e5 / 4. * c111
-								+ 0.2673e4 / 2. * c202 + 729. / 2. * c013 + 729. / 8. * c323
-								- 0.10935e5 / 8. * c122
-								+ 0.2187e4 / 4. * c312
-								- 729. / 4. * c313 - 729. / 4. * c023
-								+ 0.10935e5 / 8. * c121 + 81. * c233
-								- 891. / 8. * c300
-								+ 0.243e3 / 4. * c332
-								- 0.2673e4 / 8. * c302 - 0.1215e4 / 4. * c131
-								+ 0.2673e4 / 8. * c301
-								- 81. / 4. * c333 - 0.3645e4 / 4. * c113
-								+ 0.2187e4 * c211
-								- 0.2187e4 / 8. * c322 - 405. / 4. * c133
-								+ 0.2187e4 / 2. * c222
-								- 729. / 2. * c223 - 891. / 2. * c203
-								+ 891. / 2. * c200
-								- 0.2673e4 / 2. * c201
-								+ 81. / 2. * c033 + 0.243e3 / 2. * c031
-								- 0.243e3 / 2. * c032
-								+ 405. / 4. * c130
-								- 0.4455e4 / 8. * c100
-								+ 729. * c213
-								- 0.2187e4 * c212
-								+ 0.2187e4 / 4. * c022 + 891. / 8. * c303
-								- 81. / 2. * c030 - 891. / 4. * c003 - 729. * c210
-								+ 0.2673e4 / 4. * c002
-								- 0.2673e4 / 4. * c001 - 0.2187e4 / 2. * c012
-								+ 0.1215e4 / 4. * c132
-								- 729. / 8. * c320
-								+ 81. / 4. * c330
-								+ 0.3645e4 / 4. * c110
-								+ 0.2187e4 / 2. * c011
-										+ 729. / 2. * c220
-										+ 0.13365e5 / 8. * c101);
-
-		Cu3vw2[ii] = +(0.1215e4 / 4. * c231 - 0.243e3 / 2. * c230
-										- 0.3645e4 / 4. * c311
-								- 729. / 2. * c010 - 0.243e3 * c232
-								+ 891. / 4. * c000 + (2187 * c112)
-								- 0.10935e5 / 8. * c221
-								+ 0.2187e4 / 8. * c123
-								- 0.2673e4 / 2. * c102
-								- 405. / 4. * c331
-								- 0.2187e4 / 4. * c120
-								- 0.3645e4 / 8. * c021
-								+ 0.3645e4 / 8. * c321
-								+ 729. / 4. * c020
-								+ 0.2673e4 / 8. * c103
-								+ 729. / 2. * c310
-								- 0.10935e5 / 4. * c111
-								+ 0.2673e4 / 2. * c202 + 729. / 4. * c013 + 729. / 8. * c323
-								- 0.2187e4 / 2. * c122
-								+ (729 * c312)
-								- 729. / 4. * c313 - 729. / 8. * c023
-								+ 0.10935e5 / 8. * c121 + 0.243e3 / 4. * c233
-								- 891. / 4. * c300
-								+ (81 * c332)
-								- 891. / 2. * c302 - 0.1215e4 / 4. * c131
-								+ 0.4455e4 / 8. * c301
-								- 81. / 4. * c333 - 0.2187e4 / 4. * c113
-								+ 0.10935e5 / 4. * c211
-								- 729. / 2. * c322 - 0.243e3 / 4. * c133
-								+ 0.2187e4 / 2. * c222
-								- 0.2187e4 / 8. * c223 - 0.2673e4 / 8. * c203
-								+ 0.2673e4 / 4. * c200
-								- 0.13365e5 / 8. * c201
-								+ 81. / 4. * c033 + 405. / 4. * c031
-								- 81. * c032
-								+ 0.243e3 / 2. * c130
-								- 0.2673e4 / 4. * c100
-								+ 0.2187e4 / 4. * c213
-								- 0.2187e4 * c212
-								+ 729. / 2. * c022 + 891. / 8. * c303
-								- 81. / 2. * c030 - 891. / 8. * c003 - 0.2187e4 / 2. * c210
-								+ 891. / 2. * c002
-								- 0.4455e4 / 8. * c001 - 729. * c012
-								+ (243 * c132)
-								- 729. / 4. * c320
-								+ 81. / 2. * c330
-								+ 0.2187e4 / 2. * c110
-								+ 0.3645e4 / 4. * c011
-										+ 0.2187e4 / 4. * c220
-										+ 0.13365e5 / 8. * c101);
-
-		Cu3v2w[ii] = +(0.2187e4 / 4. * c231 - 0.2673e4 / 8. * c230
-								- 0.3645e4 / 4. * c311 - 0.4455e4 / 8. * c010
-								- 0.2187e4 / 8. * c232
-								+ 891. / 4. * c000 + 0.10935e5 / 8. * c112
-								- 0.2187e4 * c221
-								+ 0.243e3 * c123
-								- 0.2187e4 / 4. * c102
-								- 729. / 4. * c331
-								- 0.2673e4 / 2. * c120
-								- 729. * c021
-								+ 729. * c321
-								+ 891. / 2. * c020
-								+ 0.243e3 / 2. * c103
-								+ 0.4455e4 / 8. * c310
-								- 0.10935e5 / 4. * c111
-								+ 0.2187e4 / 4. * c202 + 405. / 4. * c013 + 81. * c323
-								- 0.2187e4 / 2. * c122
-								+ 0.3645e4 / 8. * c312
-								- 405. / 4. * c313 - 81. * c023
-								+ 0.2187e4 * c121 + 0.243e3 / 4. * c233
-								- 891. / 4. * c300
-								+ 729. / 8. * c332
-								- 729. / 4. * c302 - 0.2187e4 / 4. * c131
-								+ 729. / 2. * c301
-								- 81. / 4. * c333 - 0.1215e4 / 4. * c113
-								+ 0.10935e5 / 4. * c211
-								- 729. / 2. * c322 - 0.243e3 / 4. * c133
-								+ 0.2187e4 / 2. * c222
-								- 0.243e3 * c223 - 0.243e3 / 2. * c203
-								+ 0.2673e4 / 4. * c200
-								- 0.2187e4 / 2. * c201
-								+ 81. / 4. * c033 + 729. / 4. * c031
-								- 729. / 8. * c032
-								+ 0.2673e4 / 8. * c130
-								- 0.2673e4 / 4. * c100
-								+ 0.1215e4 / 4. * c213
-								- 0.10935e5 / 8. * c212
-								+ 729. / 2. * c022 + 81. / 2. * c303
-								- 891. / 8. * c030 - 81. / 2. * c003 - 0.13365e5 / 8. * c210
-								+ 729. / 4. * c002
-								- 729. / 2. * c001 - 0.3645e4 / 8. * c012
-								+ 0.2187e4 / 8. * c132
-								- 891. / 2. * c320
-								+ 891. / 8. * c330
-								+ 0.13365e5 / 8. * c110
-								+ 0.3645e4 / 4. * c011
-								+ 0.2673e4 / 2. * c220
-										+ 0.2187e4 / 2. * c101);
-
-		Cu3v3[ii] = +(81. / 4. * c330 + 0.243e3 / 4. * c310 - 0.243e3 / 4. * c320
-				+ 81. / 4. * c000 + 0.243e3 / 4. * c020
-							- 0.243e3 / 4. * c010
-							- 81. / 4. * c030
-							- 729. / 4. * c210
-							- 0.243e3 / 4. * c100
-							+ 729. / 4. * c220
-							- 0.243e3 / 4. * c230 - 81. / 4. * c300
-							+ 0.243e3 / 4. * c200 + 0.243e3 / 4. * c130 + 729. / 4. * c110
-									- 729. / 4. * c120);
-
-		Cv3w3[ii] = +(81. / 4. * c000 - 81. / 4. * c003 + 0.243e3 / 4. * c002
-				- 0.243e3 / 4. * c001 - 729. / 4. * c021
-							+ 729. / 4. * c022 + 0.243e3 / 4. * c020
-							- 729. / 4. * c012
-							+ 0.243e3 / 4. * c013 + 729. / 4. * c011
-							- 0.243e3 / 4. * c010 - 0.243e3 / 4. * c032
-							+ 81. / 4. * c033
-							- 81. / 4. * c030
-							+ 0.243e3 / 4. * c031
-									- 0.243e3 / 4. * c023);
-
-		Cu3w3[ii] = +(-0.243e3 / 4. * c203 + 81. / 4. * c303 + 729. / 4. * c101
-							+ 81. / 4. * c000
-							- 81. / 4. * c003
-							+ 0.243e3 / 4. * c002
-							- 0.243e3 / 4. * c001 - 0.243e3 / 4. * c100 - 729. / 4. * c102
-							+ 729. / 4. * c202
-							- 81. / 4. * c300
-							+ 0.243e3 / 4. * c301
-							- 0.243e3 / 4. * c302 - 729. / 4. * c201
-									+ 0.243e3 / 4. * c200 + 0.243e3 / 4. * c103);
-
-		Cu2v2w2[ii] = +(0.3645e4 / 2. * c231 - 729. * c230 - 0.18225e5 / 8. * c311
-								- 0.3645e4 / 2. * c010 - 0.1458e4 * c232
-								+ 729. * c000 + 0.18225e5 / 2. * c112
-								- 0.7290e4 * c221
-								+ 0.3645e4 / 2. * c123
-								- (3645 * c102)
-								- 0.3645e4 / 8. * c331
-								- 0.3645e4 * c120
-								- 0.3645e4 * c021
-								+ 0.3645e4 / 2. * c321
-								+ 0.1458e4 * c020
-								+ 0.3645e4 / 4. * c103
-								+ 0.3645e4 / 4. * c310
-								- 0.91125e5 / 8. * c111
-								+ 0.2916e4 * c202 + 0.3645e4 / 4. * c013 + 729. / 2. * c323
-								- (7290 * c122)
-								+ 0.3645e4 / 2. * c312
-								- 0.3645e4 / 8. * c313 - 729. * c023
-								+ 0.18225e5 / 2. * c121 + 729. / 2. * c233
-								- 729. / 2. * c300
-								+ 729. / 2. * c332
-								- (729 * c302) - 0.18225e5 / 8. * c131
-								+ 0.3645e4 / 4. * c301
-								- 729. / 8. * c333 - 0.18225e5 / 8. * c113
-								+ 0.18225e5 / 2. * c211
-								- (1458 * c322) - 0.3645e4 / 8. * c133
-								+ 0.5832e4 * c222
-								- 0.1458e4 * c223 - 729. * c203
-								+ 0.1458e4 * c200
-								- 0.3645e4 * c201
-								+ 729. / 4. * c033 + 0.3645e4 / 4. * c031
-								- 729. * c032
-								+ 0.3645e4 / 4. * c130
-								- 0.3645e4 / 2. * c100
-								+ 0.3645e4 / 2. * c213
-								- 0.7290e4 * c212
-								+ 0.2916e4 * c022 + 729. / 4. * c303
-								- 729. / 2. * c030 - 729. / 2. * c003 - 0.3645e4 * c210
-								+ 0.1458e4 * c002
-								- 0.3645e4 / 2. * c001 - 0.3645e4 * c012
-								+ 0.3645e4 / 2. * c132
-								- 729. * c320
-								+ 729. / 4. * c330
-								+ 0.18225e5 / 4. * c110
-								+ 0.18225e5 / 4. * c011
-								+ 0.2916e4 * c220
-										+ 0.18225e5 / 4. * c101);
-
-		// Seventh power terms (6) 3-3-1 (3), 3-2-2 (3)
-
-		Cu3vw3[ii] = +(-729. / 4. * c231 + 0.243e3 / 4. * c230
-										+ 0.2187e4 / 4. * c311
-								+ 729. / 4. * c010 + 729. / 4. * c232
-								- 891. / 8. * c000 - 0.6561e4 / 4. * c112
-								+ 0.6561e4 / 8. * c221
-								- 0.2187e4 / 8. * c123
-								+ 0.8019e4 / 8. * c102
-								+ 0.243e3 / 4. * c331
-								+ 0.2187e4 / 8. * c120 + 0.2187e4 / 8. * c021
-								- 0.2187e4 / 8. * c321
-								- 729. / 8. * c020
-								- 0.2673e4 / 8. * c103
-								- 729. / 4. * c310
-								+ 0.6561e4 / 4. * c111
-								- 0.8019e4 / 8. * c202 - 729. / 4. * c013 - 729. / 8. * c323
-								+ 0.6561e4 / 8. * c122
-								- 0.2187e4 / 4. * c312
-								+ 729. / 4. * c313 + 729. / 8. * c023
-								- 0.6561e4 / 8. * c121 - 0.243e3 / 4. * c233
-								+ 891. / 8. * c300
-								- 0.243e3 / 4. * c332
-								+ 0.2673e4 / 8. * c302 + 729. / 4. * c131
-								- 0.2673e4 / 8. * c301
-								+ 81. / 4. * c333 + 0.2187e4 / 4. * c113
-								- 0.6561e4 / 4. * c211
-								+ 0.2187e4 / 8. * c322 + 0.243e3 / 4. * c133
-								- 0.6561e4 / 8. * c222
-								+ 0.2187e4 / 8. * c223 + 0.2673e4 / 8. * c203
-								- 0.2673e4 / 8. * c200
-								+ 0.8019e4 / 8. * c201
-								- 81. / 4. * c033 - 0.243e3 / 4. * c031
-								+ 0.243e3 / 4. * c032
-								- 0.243e3 / 4. * c130
-								+ 0.2673e4 / 8. * c100
-								- 0.2187e4 / 4. * c213
-								+ 0.6561e4 / 4. * c212
-								- 0.2187e4 / 8. * c022 - 891. / 8. * c303
-								+ 81. / 4. * c030 + 891. / 8. * c003 + 0.2187e4 / 4. * c210
-								- 0.2673e4 / 8. * c002
-								+ 0.2673e4 / 8. * c001 + 0.2187e4 / 4. * c012
-								- 729. / 4. * c132
-								+ 729. / 8. * c320
-								- 81. / 4. * c330
-								- 0.2187e4 / 4. * c110
-								- 0.2187e4 / 4. * c011
-										- 0.2187e4 / 8. * c220
-										- 0.8019e4 / 8. * c101);
-
-		Cu3v3w[ii] = +(-0.2187e4 / 4. * c231 + 0.2673e4 / 8. * c230
-								+ 0.2187e4 / 4. * c311 + 0.2673e4 / 8. * c010
-								+ 0.2187e4 / 8. * c232
-								- 891. / 8. * c000 - 0.6561e4 / 8. * c112
-								+ 0.6561e4 / 4. * c221
-								- 729. / 4. * c123
-								+ 0.2187e4 / 8. * c102
-								+ 729. / 4. * c331
-								+ 0.8019e4 / 8. * c120
-								+ 0.2187e4 / 4. * c021
-								- 0.2187e4 / 4. * c321
-								- 0.2673e4 / 8. * c020
-								- 0.243e3 / 4. * c103 - 0.2673e4 / 8. * c310
-								+ 0.6561e4 / 4. * c111
-								- 0.2187e4 / 8. * c202
-								- 0.243e3 / 4. * c013
-								- 0.243e3 / 4. * c323
-								+ 0.6561e4 / 8. * c122
-								- 0.2187e4 / 8. * c312
-								+ 0.243e3 / 4. * c313 + 0.243e3 / 4. * c023
-								- 0.6561e4 / 4. * c121 - 0.243e3 / 4. * c233
-								+ 891. / 8. * c300
-								- 729. / 8. * c332
-								+ 729. / 8. * c302 + 0.2187e4 / 4. * c131
-								- 729. / 4. * c301
-								+ 81. / 4. * c333 + 729. / 4. * c113
-								- 0.6561e4 / 4. * c211
-								+ 0.2187e4 / 8. * c322 + 0.243e3 / 4. * c133
-								- 0.6561e4 / 8. * c222
-								+ 729. / 4. * c223 + 0.243e3 / 4. * c203
-								- 0.2673e4 / 8. * c200
-								+ 0.2187e4 / 4. * c201
-								- 81. / 4. * c033 - 729. / 4. * c031
-								+ 729. / 8. * c032
-								- 0.2673e4 / 8. * c130
-								+ 0.2673e4 / 8. * c100
-								- 729. / 4. * c213
-								+ 0.6561e4 / 8. * c212
-								- 0.2187e4 / 8. * c022 - 81. / 4. * c303
-								+ 891. / 8. * c030 + 81. / 4. * c003 + 0.8019e4 / 8. * c210
-								- 729. / 8. * c002
-								+ 729. / 4. * c001 + 0.2187e4 / 8. * c012
-								- 0.2187e4 / 8. * c132
-								+ 0.2673e4 / 8. * c320
-								- 891. / 8. * c330
-								- 0.8019e4 / 8. * c110
-								- 0.2187e4 / 4. * c011
-										- 0.8019e4 / 8. * c220
-										- 0.2187e4 / 4. * c101);
-
-		Cuv3w3[ii] = +(-0.2187e4 / 8. * c231 + 729. / 8. * c230 + 729. / 4. * c311
-								+ 0.2673e4 / 8. * c010 + 0.2187e4 / 8. * c232
-								- 891. / 8. * c000 - 0.6561e4 / 4. * c112
-								+ 0.6561e4 / 8. * c221
-								- 0.2187e4 / 4. * c123
-								+ 0.2187e4 / 4. * c102
-								+ 0.243e3 / 4. * c331
-								+ 0.2187e4 / 4. * c120 + 0.8019e4 / 8. * c021
-								- 729. / 4. * c321
-								- 0.2673e4 / 8. * c020
-								- 729. / 4. * c103
-								- 0.243e3 / 4. * c310
-								+ 0.6561e4 / 4. * c111
-								- 0.2187e4 / 8. * c202
-								- 0.2673e4 / 8. * c013
-								- 0.243e3 / 4. * c323
-								+ 0.6561e4 / 4. * c122
-								- 729. / 4. * c312
-								+ 0.243e3 / 4. * c313 + 0.2673e4 / 8. * c023
-								- 0.6561e4 / 4. * c121 - 729. / 8. * c233
-								+ 81. / 4. * c300
-								- 0.243e3 / 4. * c332
-								+ 0.243e3 / 4. * c302 + 0.2187e4 / 4. * c131
-								- 0.243e3 / 4. * c301
-								+ 81. / 4. * c333 + 0.2187e4 / 4. * c113
-								- 0.6561e4 / 8. * c211
-								+ 729. / 4. * c322 + 729. / 4. * c133
-								- 0.6561e4 / 8. * c222
-								+ 0.2187e4 / 8. * c223 + 729. / 8. * c203
-								- 729. / 8. * c200
-								+ 0.2187e4 / 8. * c201
-								- 891. / 8. * c033 - 0.2673e4 / 8. * c031
-								+ 0.2673e4 / 8. * c032
-								- 729. / 4. * c130
-								+ 729. / 4. * c100
-								- 0.2187e4 / 8. * c213
-								+ 0.6561e4 / 8. * c212
-								- 0.8019e4 / 8. * c022 - 81. / 4. * c303
-								+ 891. / 8. * c030 + 891. / 8. * c003 + 0.2187e4 / 8. * c210
-								- 0.2673e4 / 8. * c002
-								+ 0.2673e4 / 8. * c001 + 0.8019e4 / 8. * c012
-								- 0.2187e4 / 0.4e1 * c132
-								+ 0.243e3 / 0.4e1 * c320
-								- 0.81e2 / 0.4e1 * c330
-								- 0.2187e4 / 0.4e1 * c110
-								- 0.8019e4 / 8. * c011
-								- 0.2187e4 / 8. * c220
-										- 0.2187e4 / 0.4e1 * c101);
-
-		Cu3v2w2[ii] = +(-0.10935e5 / 8. * c231 + 0.2187e4 / 0.4e1 * c230
-								+ 0.18225e5 / 8. * c311 + 0.3645e4 / 0.4e1 * c010
-								+ 0.2187e4 / 2. * c232
-								- 729. / 2. * c000 - 0.10935e5 / 2. * c112
-								+ 0.10935e5 / 2. * c221
-								- 0.2187e4 / 2. * c123
-								+ (2187 * c102)
-								+ 0.3645e4 / 8. * c331
-								+ 0.2187e4 * c120
-								+ 0.3645e4 / 2. * c021
-								- 0.3645e4 / 2. * c321
-								- 729. * c020
-								- 0.2187e4 / 0.4e1 * c103
-								- 0.3645e4 / 0.4e1 * c310
-								+ 0.54675e5 / 8. * c111
-								- 0.2187e4 * c202 - 0.3645e4 / 8. * c013 - 729. / 2. * c323
-								+ (4374 * c122)
-								- 0.3645e4 / 2. * c312
-								+ 0.3645e4 / 8. * c313 + 729. / 2. * c023
-								- 0.10935e5 / 2. * c121 - 0.2187e4 / 8. * c233
-								+ 729. / 2. * c300
-								- 729. / 2. * c332
-								+ (729 * c302) + 0.10935e5 / 8. * c131
-								- 0.3645e4 / 0.4e1 * c301
-								+ 729. / 8. * c333 + 0.10935e5 / 8. * c113
-								- 0.54675e5 / 8. * c211
-								+ (1458 * c322) + 0.2187e4 / 8. * c133
-								- 0.4374e4 * c222
-								+ 0.2187e4 / 2. * c223 + 0.2187e4 / 0.4e1 * c203
-								- 0.2187e4 / 2. * c200
-								+ 0.10935e5 / 0.4e1 * c201
-								- 729. / 8. * c033 - 0.3645e4 / 8. * c031
-								+ 729. / 2. * c032
-								- 0.2187e4 / 0.4e1 * c130
-								+ 0.2187e4 / 2. * c100
-								- 0.10935e5 / 8. * c213
-								+ 0.10935e5 / 2. * c212
-								- 0.1458e4 * c022 - 729. / 0.4e1 * c303
-								+ 729. / 0.4e1 * c030
-								+ 729. / 0.4e1 * c003
-								+ 0.10935e5 / 0.4e1 * c210
-								- 729. * c002
-								+ 0.3645e4 / 0.4e1 * c001 + 0.3645e4 / 2. * c012
-								- 0.2187e4 / 2. * c132
-								+ 729. * c320
-								- 729. / 0.4e1 * c330
-								- 0.10935e5 / 0.4e1 * c110
-								- 0.18225e5 / 8. * c011
-								- 0.2187e4 * c220
-										- 0.10935e5 / 0.4e1 * c101);
-
-		Cu2v3w2[ii] = +(-0.3645e4 / 2. * c231 + 729. * c230 + 0.10935e5 / 8. * c311
-								+ 0.2187e4 / 2. * c010 + 0.1458e4 * c232
-								- 729. / 2. * c000 - 0.10935e5 / 2. * c112
-								+ 0.10935e5 / 2. * c221
-								- 0.10935e5 / 8. * c123
-								+ 0.3645e4 / 2. * c102
-								+ 0.3645e4 / 8. * c331
-								+ 0.10935e5 / 0.4e1 * c120 + 0.10935e5 / 0.4e1 * c021
-								- 0.10935e5 / 8. * c321
-								- 0.2187e4 / 2. * c020
-								- 0.3645e4 / 8. * c103 - 0.2187e4 / 0.4e1 * c310
-								+ 0.54675e5 / 8. * c111
-								- 0.1458e4 * c202
-								- 0.2187e4 / 0.4e1 * c013
-								- 0.2187e4 / 8. * c323
-								+ 0.10935e5 / 2. * c122
-								- 0.2187e4 / 2. * c312
-								+ 0.2187e4 / 8. * c313 + 0.2187e4 / 0.4e1 * c023
-								- 0.54675e5 / 8. * c121 - 729. / 2. * c233
-								+ 729. / 0.4e1 * c300
-								- 729. / 2. * c332
-								+ 729. / 2. * c302 + 0.18225e5 / 8. * c131
-								- 0.3645e4 / 8. * c301
-								+ 729. / 8. * c333 + 0.10935e5 / 8. * c113
-								- 0.10935e5 / 2. * c211
-								+ 0.2187e4 / 2. * c322 + 0.3645e4 / 8. * c133
-								- 0.4374e4 * c222
-								+ 0.2187e4 / 2. * c223 + 729. / 2. * c203
-								- 729. * c200
-								+ 0.3645e4 / 2. * c201
-								- 729. / 0.4e1 * c033 - 0.3645e4 / 0.4e1 * c031
-								+ 729. * c032
-								- 0.3645e4 / 0.4e1 * c130
-								+ 0.3645e4 / 0.4e1 * c100
-								- 0.2187e4 / 2. * c213
-								+ 0.4374e4 * c212
-								- 0.2187e4 * c022 - 729. / 8. * c303
-								+ 729. / 2. * c030 + 729. / 0.4e1 * c003 + 0.2187e4 * c210
-								- 729. * c002
-								+ 0.3645e4 / 0.4e1 * c001 + 0.2187e4 * c012
-								- 0.3645e4 / 2. * c132
-								+ 0.2187e4 / 0.4e1 * c320
-								- 729. / 0.4e1 * c330
-								- 0.10935e5 / 0.4e1 * c110
-								- 0.10935e5 / 0.4e1 * c011
-								- 0.2187e4 * c220
-										- 0.18225e5 / 8. * c101);
-
-		Cu2v2w3[ii] = +(-0.2187e4 / 2. * c231 + 729. / 2. * c230
-										+ 0.10935e5 / 8. * c311
-								+ 0.3645e4 / 0.4e1 * c010 + 0.2187e4 / 2. * c232
-								- 729. / 2. * c000 - 0.54675e5 / 8. * c112
-								+ 0.4374e4 * c221
-								- 0.3645e4 / 2. * c123
-								+ 0.10935e5 / 0.4e1 * c102
-								+ 0.2187e4 / 8. * c331
-								+ 0.3645e4 / 2. * c120 + 0.2187e4 * c021
-								- 0.2187e4 / 2. * c321
-								- 729. * c020
-								- 0.3645e4 / 0.4e1 * c103
-								- 0.3645e4 / 8. * c310
-								+ 0.54675e5 / 8. * c111
-								- 0.2187e4 * c202 - 0.3645e4 / 0.4e1 * c013 - 729. / 2. * c323
-								+ 0.10935e5 / 2. * c122
-								- 0.10935e5 / 8. * c312
-								+ 0.3645e4 / 8. * c313 + 729. * c023
-								- 0.10935e5 / 2. * c121 - 729. / 2. * c233
-								+ 729. / 0.4e1 * c300
-								- 0.2187e4 / 8. * c332
-								+ 0.2187e4 / 0.4e1 * c302 + 0.10935e5 / 8. * c131
-								- 0.2187e4 / 0.4e1 * c301
-								+ 729. / 8. * c333 + 0.18225e5 / 8. * c113
-								- 0.10935e5 / 2. * c211
-								+ 0.2187e4 / 2. * c322 + 0.3645e4 / 8. * c133
-								- 0.4374e4 * c222
-								+ 0.1458e4 * c223 + 729. * c203
-								- 729. * c200
-								+ 0.2187e4 * c201
-								- 729. / 0.4e1 * c033 - 0.2187e4 / 0.4e1 * c031
-								+ 0.2187e4 / 0.4e1 * c032
-								- 0.3645e4 / 8. * c130
-								+ 0.3645e4 / 0.4e1 * c100
-								- 0.3645e4 / 2. * c213
-								+ 0.10935e5 / 2. * c212
-								- 0.2187e4 * c022 - 729. / 0.4e1 * c303
-								+ 729. / 0.4e1 * c030 + 729. / 2. * c003 + 0.3645e4 / 2. * c210
-								- 0.2187e4 / 2. * c002
-								+ 0.2187e4 / 2. * c001 + 0.10935e5 / 0.4e1 * c012
-								- 0.10935e5 / 8. * c132
-								+ 729. / 2. * c320
-								- 729. / 8. * c330
-								- 0.18225e5 / 8. * c110
-								- 0.10935e5 / 0.4e1 * c011
-								- 0.1458e4 * c220
-										- 0.10935e5 / 0.4e1 * c101);
-
-		// Eighth power terms (3) 3-3-2
-
-		Cu3v3w2[ii] = +(0.10935e5 / 8. * c231 - 0.2187e4 / 0.4e1 * c230
-								- 0.10935e5 / 8. * c311 - 0.2187e4 / 0.4e1 * c010
-								- 0.2187e4 / 2. * c232
-								+ 729. / 0.4e1 * c000 + 0.6561e4 / 2. * c112
-								- 0.32805e5 / 8. * c221
-								+ 0.6561e4 / 8. * c123
-								- 0.2187e4 / 2. * c102
-								- 0.3645e4 / 8. * c331
-								- 0.6561e4 / 0.4e1 * c120 - 0.10935e5 / 8. * c021
-								+ 0.10935e5 / 8. * c321
-								+ 0.2187e4 / 0.4e1 * c020
-								+ 0.2187e4 / 8. * c103 + 0.2187e4 / 0.4e1 * c310
-								- 0.32805e5 / 8. * c111
-								+ 0.2187e4 / 2. * c202
-								+ 0.2187e4 / 8. * c013
-								+ 0.2187e4 / 8. * c323
-								- 0.6561e4 / 2. * c122
-								+ 0.2187e4 / 2. * c312
-								- 0.2187e4 / 8. * c313 - 0.2187e4 / 8. * c023
-								+ 0.32805e5 / 8. * c121 + 0.2187e4 / 8. * c233
-								- 729. / 0.4e1 * c300
-								+ 729. / 2. * c332
-								- 729. / 2. * c302 - 0.10935e5 / 8. * c131
-								+ 0.3645e4 / 8. * c301
-								- 729. / 8. * c333 - 0.6561e4 / 8. * c113
-								+ 0.32805e5 / 8. * c211
-								- 0.2187e4 / 2. * c322 - 0.2187e4 / 8. * c133
-								+ 0.6561e4 / 2. * c222
-								- 0.6561e4 / 8. * c223 - 0.2187e4 / 8. * c203
-								+ 0.2187e4 / 0.4e1 * c200
-								- 0.10935e5 / 8. * c201
-								+ 729. / 8. * c033 + 0.3645e4 / 8. * c031
-								- 729. / 2. * c032
-								+ 0.2187e4 / 0.4e1 * c130
-								- 0.2187e4 / 0.4e1 * c100
-								+ 0.6561e4 / 8. * c213
-								- 0.6561e4 / 2. * c212
-								+ 0.2187e4 / 2. * c022 + 729. / 8. * c303
-								- 729. / 0.4e1 * c030
-								- 729. / 8. * c003
-								- 0.6561e4 / 0.4e1 * c210
-								+ 729. / 2. * c002
-								- 0.3645e4 / 8. * c001 - 0.2187e4 / 2. * c012
-								+ 0.2187e4 / 2. * c132
-								- 0.2187e4 / 0.4e1 * c320
-								+ 729. / 0.4e1 * c330
-								+ 0.6561e4 / 0.4e1 * c110
-								+ 0.10935e5 / 8. * c011
-								+ 0.6561e4 / 0.4e1 * c220
-										+ 0.10935e5 / 8. * c101);
-
-		Cu3v2w3[ii] = +(0.6561e4 / 8. * c231 - 0.2187e4 / 8. * c230
-								- 0.10935e5 / 8. * c311 - 0.3645e4 / 8. * c010
-								- 0.6561e4 / 8. * c232
-								+ 729. / 0.4e1 * c000 + 0.32805e5 / 8. * c112
-								- 0.6561e4 / 2. * c221
-								+ 0.2187e4 / 2. * c123
-								- 0.6561e4 / 0.4e1 * c102
-								- 0.2187e4 / 8. * c331
-								- 0.2187e4 / 2. * c120 - 0.2187e4 / 2. * c021
-								+ 0.2187e4 / 2. * c321
-								+ 729. / 2. * c020
-								+ 0.2187e4 / 0.4e1 * c103 + 0.3645e4 / 8. * c310
-								- 0.32805e5 / 8. * c111
-								+ 0.6561e4 / 0.4e1 * c202
-								+ 0.3645e4 / 8. * c013
-								+ 729. / 2. * c323
-								- 0.6561e4 / 2. * c122
-								+ 0.10935e5 / 8. * c312
-								- 0.3645e4 / 8. * c313 - 729. / 2. * c023
-								+ 0.6561e4 / 2. * c121 + 0.2187e4 / 8. * c233
-								- 729. / 0.4e1 * c300
-								+ 0.2187e4 / 8. * c332
-								- 0.2187e4 / 0.4e1 * c302 - 0.6561e4 / 8. * c131
-								+ 0.2187e4 / 0.4e1 * c301
-								- 729. / 8. * c333 - 0.10935e5 / 8. * c113
-								+ 0.32805e5 / 8. * c211
-								- 0.2187e4 / 2. * c322 - 0.2187e4 / 8. * c133
-								+ 0.6561e4 / 2. * c222
-								- 0.2187e4 / 2. * c223 - 0.2187e4 / 0.4e1 * c203
-								+ 0.2187e4 / 0.4e1 * c200
-								- 0.6561e4 / 0.4e1 * c201
-								+ 729. / 8. * c033 + 0.2187e4 / 8. * c031
-								- 0.2187e4 / 8. * c032
-								+ 0.2187e4 / 8. * c130
-								- 0.2187e4 / 0.4e1 * c100
-								+ 0.10935e5 / 8. * c213
-								- 0.32805e5 / 8. * c212
-								+ 0.2187e4 / 2. * c022 + 729. / 0.4e1 * c303
-								- 729. / 8. * c030 - 729. / 0.4e1 * c003 - 0.10935e5 / 8. * c210
-								+ 0.2187e4 / 0.4e1 * c002
-								- 0.2187e4 / 0.4e1 * c001 - 0.10935e5 / 8. * c012
-								+ 0.6561e4 / 8. * c132
-								- 729. / 2. * c320
-								+ 729. / 8. * c330
-								+ 0.10935e5 / 8. * c110
-								+ 0.10935e5 / 8. * c011
-								+ 0.2187e4 / 2. * c220
-										+ 0.6561e4 / 0.4e1 * c101);
-
-		Cu2v3w3[ii] = +(0.2187e4 / 2. * c231 - 729. / 2. * c230
-										- 0.6561e4 / 8. * c311
-								- 0.2187e4 / 0.4e1 * c010 - 0.2187e4 / 2. * c232
-								+ 729. / 0.4e1 * c000 + 0.32805e5 / 8. * c112
-								- 0.6561e4 / 2. * c221
-								+ 0.10935e5 / 8. * c123
-								- 0.10935e5 / 8. * c102
-								- 0.2187e4 / 8. * c331
-								- 0.10935e5 / 8. * c120 - 0.6561e4 / 0.4e1 * c021
-								+ 0.6561e4 / 8. * c321
-								+ 0.2187e4 / 0.4e1 * c020
-								+ 0.3645e4 / 8. * c103 + 0.2187e4 / 8. * c310
-								- 0.32805e5 / 8. * c111
-								+ 0.2187e4 / 2. * c202
-								+ 0.2187e4 / 0.4e1 * c013
-								+ 0.2187e4 / 8. * c323
-								- 0.32805e5 / 8. * c122
-								+ 0.6561e4 / 8. * c312
-								- 0.2187e4 / 8. * c313 - 0.2187e4 / 0.4e1 * c023
-								+ 0.32805e5 / 8. * c121 + 729. / 2. * c233
-								- 729. / 8. * c300
-								+ 0.2187e4 / 8. * c332
-								- 0.2187e4 / 8. * c302 - 0.10935e5 / 8. * c131
-								+ 0.2187e4 / 8. * c301
-								- 729. / 8. * c333 - 0.10935e5 / 8. * c113
-								+ 0.6561e4 / 2. * c211
-								- 0.6561e4 / 8. * c322 - 0.3645e4 / 8. * c133
-								+ 0.6561e4 / 2. * c222
-								- 0.2187e4 / 2. * c223 - 729. / 2. * c203
-								+ 729. / 2. * c200
-								- 0.2187e4 / 2. * c201
-								+ 729. / 0.4e1 * c033 + 0.2187e4 / 0.4e1 * c031
-								- 0.2187e4 / 0.4e1 * c032
-								+ 0.3645e4 / 8. * c130
-								- 0.3645e4 / 8. * c100
-								+ 0.2187e4 / 2. * c213
-								- 0.6561e4 / 2. * c212
-								+ 0.6561e4 / 0.4e1 * c022 + 729. / 8. * c303
-								- 729. / 0.4e1 * c030
-								- 729. / 0.4e1 * c003
-								- 0.2187e4 / 2. * c210
-								+ 0.2187e4 / 0.4e1 * c002
-								- 0.2187e4 / 0.4e1 * c001 - 0.6561e4 / 0.4e1 * c012
-								+ 0.10935e5 / 8. * c132
-								- 0.2187e4 / 8. * c320
-								+ 729. / 8. * c330
-								+ 0.10935e5 / 8. * c110
-								+ 0.6561e4 / 0.4e1 * c011
-								+ 0.2187e4 / 2. * c220
-										+ 0.10935e5 / 8. * c101);
-
-		// Ninth power terms (1) 3-3-3
-		Cu3v3w3[ii] = +(-0.6561e4 / 8. * c231 + 0.2187e4 / 8. * c230
-								+ 0.6561e4 / 8. * c311 + 0.2187e4 / 8. * c010
-								+ 0.6561e4 / 8. * c232
-								- 729. / 8. * c000 - 0.19683e5 / 8. * c112
-								+ 0.19683e5 / 8. * c221
-								- 0.6561e4 / 8. * c123
-								+ 0.6561e4 / 8. * c102
-								+ 0.2187e4 / 8. * c331
-								+ 0.6561e4 / 8. * c120 + 0.6561e4 / 8. * c021
-								- 0.6561e4 / 8. * c321
-								- 0.2187e4 / 8. * c020
-								- 0.2187e4 / 8. * c103 - 0.2187e4 / 8. * c310
-								+ 0.19683e5 / 8. * c111
-								- 0.6561e4 / 8. * c202
-								- 0.2187e4 / 8. * c013
-								- 0.2187e4 / 8. * c323
-								+ 0.19683e5 / 8. * c122
-								- 0.6561e4 / 8. * c312
-								+ 0.2187e4 / 8. * c313 + 0.2187e4 / 8. * c023
-								- 0.19683e5 / 8. * c121 - 0.2187e4 / 8. * c233
-								+ 729. / 8. * c300
-								- 0.2187e4 / 8. * c332
-								+ 0.2187e4 / 8. * c302 + 0.6561e4 / 8. * c131
-								- 0.2187e4 / 8. * c301
-								+ 729. / 8. * c333 + 0.6561e4 / 8. * c113
-								- 0.19683e5 / 8. * c211
-								+ 0.6561e4 / 8. * c322 + 0.2187e4 / 8. * c133
-								- 0.19683e5 / 8. * c222
-								+ 0.6561e4 / 8. * c223 + 0.2187e4 / 8. * c203
-								- 0.2187e4 / 8. * c200
-								+ 0.6561e4 / 8. * c201
-								- 729. / 8. * c033 - 0.2187e4 / 8. * c031
-								+ 0.2187e4 / 8. * c032
-								- 0.2187e4 / 8. * c130
-								+ 0.2187e4 / 8. * c100
-								- 0.6561e4 / 8. * c213
-								+ 0.19683e5 / 8. * c212
-								- 0.6561e4 / 8. * c022 - 729. / 8. * c303
-								+ 729. / 8. * c030 + 729. / 8. * c003 + 0.6561e4 / 8. * c210
-								- 0.2187e4 / 8. * c002
-								+ 0.2187e4 / 8. * c001 + 0.6561e4 / 8. * c012
-								- 0.6561e4 / 8. * c132
-								+ 0.2187e4 / 8. * c320
-								- 729. / 8. * c330
-								- 0.6561e4 / 8. * c110
-								- 0.6561e4 / 8. * c011
-										- 0.6561e4 / 8. * c220
-										- 0.6561e4 / 8. * c101);
-
-	}
+void LagrangeCubicHexMapping::setModalValues() {
+	convertNodalToModal(&hexNodalToModal[0][0], m_modal);
 }
 
 void LagrangeCubicHexMapping::computeTransformedCoords(
 		const double uvwCoords[3], double xyz[3]) const {
+	// Names for the modal values, in the order of the rows of hexNodalToModal.
+	const double* const C = m_modal[0];
+	const double* const Cu = m_modal[1];
+	const double* const Cv = m_modal[2];
+	const double* const Cw = m_modal[3];
+	const double* const Cu2 = m_modal[4];
+	const double* const Cuv = m_modal[5];
+	const double* const Cv2 = m_modal[6];
+	const double* const Cvw = m_modal[7];
+	const double* const Cw2 = m_modal[8];
+	const double* const Cuw = m_modal[9];
+	const double* const Cu3 = m_modal[10];
+	const double* const Cv3 = m_modal[11];
+	const double* const Cw3 = m_modal[12];
+	const double* const Cu2v = m_modal[13];
+	const double* const Cuv2 = m_modal[14];
+	const double* const Cv2w = m_modal[15];
+	const double* const Cvw2 = m_modal[16];
+	const double* const Cu2w = m_modal[17];
+	const double* const Cuw2 = m_modal[18];
+	const double* const Cuvw = m_modal[19];
+	const double* const Cu3v = m_modal[20];
+	const double* const Cu3w = m_modal[21];
+	const double* const Cuv3 = m_modal[22];
+	const double* const Cv3w = m_modal[23];
+	const double* const Cuw3 = m_modal[24];
+	const double* const Cvw3 = m_modal[25];
+	const double* const Cu2v2 = m_modal[26];
+	const double* const Cu2w2 = m_modal[27];
+	const double* const Cv2w2 = m_modal[28];
+	const double* const Cu2vw = m_modal[29];
+	const double* const Cuv2w = m_modal[30];
+	const double* const Cuvw2 = m_modal[31];
+	const double* const Cu3vw = m_modal[32];
+	const double* const Cuv3w = m_modal[33];
+	const double* const Cuvw3 = m_modal[34];
+	const double* const Cu3v2 = m_modal[35];
+	const double* const Cu3w2 = m_modal[36];
+	const double* const Cu2v3 = m_modal[37];
+	const double* const Cv3w2 = m_modal[38];
+	const double* const Cu2w3 = m_modal[39];
+	const double* const Cv2w3 = m_modal[40];
+	const double* const Cu2v2w = m_modal[41];
+	const double* const Cu2vw2 = m_modal[42];
+	const double* const Cuv2w2 = m_modal[43];
+	const double* const Cu3v3 = m_modal[44];
+	const double* const Cu3w3 = m_modal[45];
+	const double* const Cv3w3 = m_modal[46];
+	const double* const Cu3v2w = m_modal[47];
+	const double* const Cu3vw2 = m_modal[48];
+	const double* const Cu2v3w = m_modal[49];
+	const double* const Cuv3w2 = m_modal[50];
+	const double* const Cu2vw3 = m_modal[51];
+	const double* const Cuv2w3 = m_modal[52];
+	const double* const Cu2v2w2 = m_modal[53];
+	const double* const Cu3v2w2 = m_modal[54];
+	const double* const Cu2v3w2 = m_modal[55];
+	const double* const Cu2v2w3 = m_modal[56];
+	const double* const Cu3v3w = m_modal[57];
+	const double* const Cu3vw3 = m_modal[58];
+	const double* const Cuv3w3 = m_modal[59];
+	const double* const Cu3v3w2 = m_modal[60];
+	const double* const Cu3v2w3 = m_modal[61];
+	const double* const Cu2v3w3 = m_modal[62];
+	const double* const Cu3v3w3 = m_modal[63];
 	const double& u = uvwCoords[0];
 	const double& v = uvwCoords[1];
 	const double& w = uvwCoords[2];
@@ -18,109 +18,178 @@
 
 #include "Mapping.h"
 
-void LagrangeCubicPrismMapping::setModalValues() {
-	for (int ii = 0; ii < 3; ii++) {
-		{
-			// Bottom
-			double& c0 = m_nodalValues[0][ii];
-			double& c1 = m_nodalValues[1][ii];
-			double& c2 = m_nodalValues[2][ii];
-			double& c3 = m_nodalValues[6][ii];
-			double& c4 = m_nodalValues[7][ii];
-			double& c5 = m_nodalValues[8][ii];
-			double& c6 = m_nodalValues[9][ii];
-			double& c7 = m_nodalValues[10][ii];
-			double& c8 = m_nodalValues[11][ii];
-			double& c9 = m_nodalValues[24][ii];
-
-			C0[ii] = +c0;
-			Cu0[ii] = +(c1 + 9 * c3 - 4.5 * c4 - 5.5 * c0);
-			Cv0[ii] = +(c2 - 4.5 * c7 + 9 * c8 - 5.5 * c0);
-			Cuu0[ii] = +4.5 * (2 * c0 - c1 - 5 * c3 + 4 * c4);
-			Cuv0[ii] = +4.5 * (4 * c0 + c4 + c7 - c5 - c6 + 6 * c9 - 5 * c3 - 5 * c8);
-			Cvv0[ii] = +4.5 * (2 * c0 - c2 + 4 * c7 - 5 * c8);
-			Cuuu0[ii] = +4.5 * (-c0 + c1 + 3 * c3 - 3 * c4);
-			Cuuv0[ii] = +13.5 * (c5 - c0 - 2 * c9 + 2 * c3 + c8 - c4);
-			Cuvv0[ii] = +13.5 * (-2 * c9 - c0 + 2 * c8 - c7 + c6 + c3);
-			Cvvv0[ii] = +4.5 * (-c0 + c2 - 3 * c7 + 3 * c8);
-		}
-		{
-			// Lower interior layer
-			double& c0 = m_nodalValues[12][ii];
-			double& c1 = m_nodalValues[14][ii];
-			double& c2 = m_nodalValues[16][ii];
-			double& c3 = m_nodalValues[25][ii];
-			double& c4 = m_nodalValues[26][ii];
-			double& c5 = m_nodalValues[29][ii];
-			double& c6 = m_nodalValues[30][ii];
-			double& c7 = m_nodalValues[33][ii];
-			double& c8 = m_nodalValues[34][ii];
-			double& c9 = m_nodalValues[38][ii];
-
-			C1[ii] = +c0;
-			Cu1[ii] = +(c1 + 9 * c3 - 4.5 * c4 - 5.5 * c0);
-			Cv1[ii] = +(c2 - 4.5 * c7 + 9 * c8 - 5.5 * c0);
-			Cuu1[ii] = +4.5 * (2 * c0 - c1 - 5 * c3 + 4 * c4);
-			Cuv1[ii] = +4.5 * (4 * c0 + c4 + c7 - c5 - c6 + 6 * c9 - 5 * c3 - 5 * c8);
-			Cvv1[ii] = +4.5 * (2 * c0 - c2 + 4 * c7 - 5 * c8);
-			Cuuu1[ii] = +4.5 * (-c0 + c1 + 3 * c3 - 3 * c4);
-			Cuuv1[ii] = +13.5 * (c5 - c0 - 2 * c9 + 2 * c3 + c8 - c4);
-			Cuvv1[ii] = +13.5 * (-2 * c9 - c0 + 2 * c8 - c7 + c6 + c3);
-			Cvvv1[ii] = +4.5 * (-c0 + c2 - 3 * c7 + 3 * c8);
-		}
-		{
-			// Upper interior layer
-			double& c0 = m_nodalValues[13][ii];
-			double& c1 = m_nodalValues[15][ii];
-			double& c2 = m_nodalValues[17][ii];
-			double& c3 = m_nodalValues[28][ii];
-			double& c4 = m_nodalValues[27][ii];
-			double& c5 = m_nodalValues[32][ii];
-			double& c6 = m_nodalValues[31][ii];
-			double& c7 = m_nodalValues[36][ii];
-			double& c8 = m_nodalValues[35][ii];
-			double& c9 = m_nodalValues[39][ii];
+// The modal values are linear combinations of the nodal values, so each
+// row here gives one modal value in terms of the 40 nodal values.
+static const double prismNodalToModal[40][40] = {
+	// C0
+	{ 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu0
+	{ -5.5, 1, 0, 0, 0, 0, 9, -4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv0
+	{ -5.5, 0, 1, 0, 0, 0, 0, 0, 0, 0, -4.5, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuu0
+	{ 9, -4.5, 0, 0, 0, 0, -22.5, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuv0
+	{ 18, 0, 0, 0, 0, 0, -22.5, 4.5, -4.5, -4.5, 4.5, -22.5, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cvv0
+	{ 9, 0, -4.5, 0, 0, 0, 0, 0, 0, 0, 18, -22.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuuu0
+	{ -4.5, 4.5, 0, 0, 0, 0, 13.5, -13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuuv0
+	{ -13.5, 0, 0, 0, 0, 0, 27, -13.5, 13.5, 0, 0, 13.5, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, -27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuvv0
+	{ -13.5, 0, 0, 0, 0, 0, 13.5, 0, 0, 13.5, -13.5, 27, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, -27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cvvv0
+	{ -4.5, 0, 4.5, 0, 0, 0, 0, 0, 0, 0, -13.5, 13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// C1
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu1
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -5.5, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 9, -4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv1
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -5.5, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, -4.5, 9, 0, 0, 0, 0, 0 },
+	// Cuu1
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 0, -4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, -22.5, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuv1
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			-22.5, 4.5, 0, 0, -4.5, -4.5, 0, 0, 4.5, -22.5, 0, 0, 0, 27, 0 },
+	// Cvv1
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 0, 0, 0, -4.5, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 18, -22.5, 0, 0, 0, 0, 0 },
+	// Cuuu1
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -4.5, 0, 4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 13.5, -13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuuv1
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 27, -13.5, 0, 0, 13.5, 0, 0, 0, 0, 13.5, 0, 0, 0, -27, 0 },
+	// Cuvv1
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 13.5, 0, 0, 0, 0, 13.5, 0, 0, -13.5, 27, 0, 0, 0, -27, 0 },
+	// Cvvv1
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -4.5, 0, 0, 0, 4.5, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, -13.5, 13.5, 0, 0, 0, 0, 0 },
+	// C2
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu2
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -5.5, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, -4.5, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv2
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -5.5, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, -4.5, 0, 0, 0 },
+	// Cuu2
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 0, -4.5, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 18, -22.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuv2
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 4.5, -22.5, 0, 0, -4.5, -4.5, 0, 0, -22.5, 4.5, 0, 0, 27 },
+	// Cvv2
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 0, 0, 0, -4.5, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -22.5, 18, 0, 0, 0 },
+	// Cuuu2
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -4.5, 0, 4.5, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, -13.5, 13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuuv2
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, -13.5, 27, 0, 0, 0, 13.5, 0, 0, 13.5, 0, 0, 0, -27 },
+	// Cuvv2
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 13.5, 0, 0, 13.5, 0, 0, 0, 27, -13.5, 0, 0, -27 },
+	// Cvvv2
+	{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -4.5, 0, 0, 0, 4.5, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 13.5, -13.5, 0, 0, 0 },
+	// C3
+	{ 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu3
+	{ 0, 0, 0, -5.5, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, -4.5, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv3
+	{ 0, 0, 0, -5.5, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -4.5,
+			9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuu3
+	{ 0, 0, 0, 9, -4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -22.5, 18, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuv3
+	{ 0, 0, 0, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -22.5, 4.5, -4.5,
+			-4.5, 4.5, -22.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 27, 0, 0 },
+	// Cvv3
+	{ 0, 0, 0, 9, 0, -4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 18,
+			-22.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuuu3
+	{ 0, 0, 0, -4.5, 4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 13.5, -13.5, 0,
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuuv3
+	{ 0, 0, 0, -13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 27, -13.5, 13.5,
+			0, 0, 13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -27, 0, 0 },
+	// Cuvv3
+	{ 0, 0, 0, -13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 13.5, 0, 0, 13.5,
+			-13.5, 27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -27, 0, 0 },
+	// Cvvv3
+	{ 0, 0, 0, -4.5, 0, 4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			-13.5, 13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+};
 
-			C2[ii] = +c0;
-			Cu2[ii] = +(c1 + 9 * c3 - 4.5 * c4 - 5.5 * c0);
-			Cv2[ii] = +(c2 - 4.5 * c7 + 9 * c8 - 5.5 * c0);
-			Cuu2[ii] = +4.5 * (2 * c0 - c1 - 5 * c3 + 4 * c4);
-			Cuv2[ii] = +4.5 * (4 * c0 + c4 + c7 - c5 - c6 + 6 * c9 - 5 * c3 - 5 * c8);
-			Cvv2[ii] = +4.5 * (2 * c0 - c2 + 4 * c7 - 5 * c8);
-			Cuuu2[ii] = +4.5 * (-c0 + c1 + 3 * c3 - 3 * c4);
-			Cuuv2[ii] = +13.5 * (c5 - c0 - 2 * c9 + 2 * c3 + c8 - c4);
-			Cuvv2[ii] = +13.5 * (-2 * c9 - c0 + 2 * c8 - c7 + c6 + c3);
-			Cvvv2[ii] = +4.5 * (-c0 + c2 - 3 * c7 + 3 * c8);
-		}
-		{
-			// Top
-			double& c0 = m_nodalValues[3][ii];
-			double& c1 = m_nodalValues[4][ii];
-			double& c2 = m_nodalValues[5][ii];
-			double& c3 = m_nodalValues[18][ii];
-			double& c4 = m_nodalValues[19][ii];
-			double& c5 = m_nodalValues[20][ii];
-			double& c6 = m_nodalValues[21][ii];
-			double& c7 = m_nodalValues[22][ii];
-			double& c8 = m_nodalValues[23][ii];
-			double& c9 = m_nodalValues[37][ii];
-
-			C3[ii] = +c0;
-			Cu3[ii] = +(c1 + 9 * c3 - 4.5 * c4 - 5.5 * c0);
-			Cv3[ii] = +(c2 - 4.5 * c7 + 9 * c8 - 5.5 * c0);
-			Cuu3[ii] = +4.5 * (2 * c0 - c1 - 5 * c3 + 4 * c4);
-			Cuv3[ii] = +4.5 * (4 * c0 + c4 + c7 - c5 - c6 + 6 * c9 - 5 * c3 - 5 * c8);
-			Cvv3[ii] = +4.5 * (2 * c0 - c2 + 4 * c7 - 5 * c8);
-			Cuuu3[ii] = +4.5 * (-c0 + c1 + 3 * c3 - 3 * c4);
-			Cuuv3[ii] = +13.5 * (c5 - c0 - 2 * c9 + 2 * c3 + c8 - c4);
-			Cuvv3[ii] = +13.5 * (-2 * c9 - c0 + 2 * c8 - c7 + c6 + c3);
-			Cvvv3[ii] = +4.5 * (-c0 + c2 - 3 * c7 + 3 * c8);
-		}
-	}
+void LagrangeCubicPrismMapping::setModalValues() {
+	convertNodalToModal(&prismNodalToModal[0][0], m_modal);
 }
 
 void LagrangeCubicPrismMapping::computeTransformedCoords(const double uvw[3],
 		double xyz[3]) const {
+	// Names for the modal values, in the order of the rows of prismNodalToModal.
+	const double* const C0 = m_modal[0];
+	const double* const Cu0 = m_modal[1];
+	const double* const Cv0 = m_modal[2];
+	const double* const Cuu0 = m_modal[3];
+	const double* const Cuv0 = m_modal[4];
+	const double* const Cvv0 = m_modal[5];
+	const double* const Cuuu0 = m_modal[6];
+	const double* const Cuuv0 = m_modal[7];
+	const double* const Cuvv0 = m_modal[8];
+	const double* const Cvvv0 = m_modal[9];
+	const double* const C1 = m_modal[10];
+	const double* const Cu1 = m_modal[11];
+	const double* const Cv1 = m_modal[12];
+	const double* const Cuu1 = m_modal[13];
+	const double* const Cuv1 = m_modal[14];
+	const double* const Cvv1 = m_modal[15];
+	const double* const Cuuu1 = m_modal[16];
+	const double* const Cuuv1 = m_modal[17];
+	const double* const Cuvv1 = m_modal[18];
+	const double* const Cvvv1 = m_modal[19];
+	const double* const C2 = m_modal[20];
+	const double* const Cu2 = m_modal[21];
+	const double* const Cv2 = m_modal[22];
+	const double* const Cuu2 = m_modal[23];
+	const double* const Cuv2 = m_modal[24];
+	const double* const Cvv2 = m_modal[25];
+	const double* const Cuuu2 = m_modal[26];
+	const double* const Cuuv2 = m_modal[27];
+	const double* const Cuvv2 = m_modal[28];
+	const double* const Cvvv2 = m_modal[29];
+	const double* const C3 = m_modal[30];
+	const double* const Cu3 = m_modal[31];
+	const double* const Cv3 = m_modal[32];
+	const double* const Cuu3 = m_modal[33];
+	const double* const Cuv3 = m_modal[34];
+	const double* const Cvv3 = m_modal[35];
+	const double* const Cuuu3 = m_modal[36];
+	const double* const Cuuv3 = m_modal[37];
+	const double* const Cuvv3 = m_modal[38];
+	const double* const Cvvv3 = m_modal[39];
 	const double& u = uvw[0];
 	const double& v = uvw[1];
 	const double& w = uvw[2];
@@ -20,230 +20,203 @@
 
 #include "Mapping.h"
 
+// The modal values are linear combinations of the nodal values, so each
+// row here gives one modal value in terms of the 30 nodal values.
+static const double pyramidNodalToModal[30][30] = {
+	// C
+	{ 0.00390625, 0.00390625, 0.00390625, 0.00390625, 0, -0.03515625, -0.03515625,
+			-0.03515625, -0.03515625, -0.03515625, -0.03515625, -0.03515625,
+			-0.03515625, 0, 0, 0, 0, 0, 0, 0, 0, 0.31640625, 0.31640625, 0.31640625,
+			0.31640625, 0, 0, 0, 0, 0 },
+	// Cu
+	{ -0.00390625, 0.00390625, 0.00390625, -0.00390625, 0, 0.10546875,
+			-0.10546875, -0.03515625, -0.03515625, -0.10546875, 0.10546875,
+			0.03515625, 0.03515625, 0, 0, 0, 0, 0, 0, 0, 0, -0.94921875, 0.94921875,
+			0.94921875, -0.94921875, 0, 0, 0, 0, 0 },
+	// Cv
+	{ -0.00390625, -0.00390625, 0.00390625, 0.00390625, 0, 0.03515625, 0.03515625,
+			0.10546875, -0.10546875, -0.03515625, -0.03515625, -0.10546875,
+			0.10546875, 0, 0, 0, 0, 0, 0, 0, 0, -0.94921875, -0.94921875, 0.94921875,
+			0.94921875, 0, 0, 0, 0, 0 },
+	// Cw
+	{ -0.14453125, -0.14453125, -0.14453125, -0.14453125, 1, 0.17578125,
+			0.17578125, 0.17578125, 0.17578125, 0.17578125, 0.17578125, 0.17578125,
+			0.17578125, 0.5625, -1.125, 0.5625, -1.125, 0.5625, -1.125, 0.5625,
+			-1.125, -1.58203125, -1.58203125, -1.58203125, -1.58203125, 0, 0, 0, 0,
+			6.75 },
+	// Cuu
+	{ -0.03515625, -0.03515625, -0.03515625, -0.03515625, 0, 0.03515625,
+			0.03515625, 0.31640625, 0.31640625, 0.03515625, 0.03515625, 0.31640625,
+			0.31640625, 0, 0, 0, 0, 0, 0, 0, 0, -0.31640625, -0.31640625, -0.31640625,
+			-0.31640625, 0, 0, 0, 0, 0 },
+	// Cuv
+	{ -0.24609375, 0.24609375, -0.24609375, 0.24609375, 0, -0.10546875,
+			0.10546875, 0.10546875, -0.10546875, -0.10546875, 0.10546875, 0.10546875,
+			-0.10546875, 1.125, -2.25, -1.125, 2.25, 1.125, -2.25, -1.125, 2.25,
+			2.84765625, -2.84765625, 2.84765625, -2.84765625, 0, 0, 0, 0, 0 },
+	// Cuw
+	{ 0.0703125, -0.0703125, -0.0703125, 0.0703125, 0, -0.2109375, 0.2109375,
+			-0.4921875, -0.4921875, 0.2109375, -0.2109375, 0.4921875, 0.4921875,
+			-0.5625, 1.125, 0.5625, -1.125, 0.5625, -1.125, -0.5625, 1.125, 1.8984375,
+			-1.8984375, -1.8984375, 1.8984375, 0, 3.375, 0, -3.375, 0 },
+	// Cvv
+	{ -0.03515625, -0.03515625, -0.03515625, -0.03515625, 0, 0.31640625,
+			0.31640625, 0.03515625, 0.03515625, 0.31640625, 0.31640625, 0.03515625,
+			0.03515625, 0, 0, 0, 0, 0, 0, 0, 0, -0.31640625, -0.31640625, -0.31640625,
+			-0.31640625, 0, 0, 0, 0, 0 },
+	// Cvw
+	{ 0.0703125, 0.0703125, -0.0703125, -0.0703125, 0, 0.4921875, 0.4921875,
+			-0.2109375, 0.2109375, -0.4921875, -0.4921875, 0.2109375, -0.2109375,
+			-0.5625, 1.125, -0.5625, 1.125, 0.5625, -1.125, 0.5625, -1.125, 1.8984375,
+			1.8984375, -1.8984375, -1.8984375, -3.375, 0, 3.375, 0, 0 },
+	// Cww
+	{ 0.52734375, 0.52734375, 0.52734375, 0.52734375, -4.5, -0.24609375,
+			-0.24609375, -0.24609375, -0.24609375, -0.24609375, -0.24609375,
+			-0.24609375, -0.24609375, -2.25, 4.5, -2.25, 4.5, -2.25, 4.5, -2.25, 4.5,
+			2.21484375, 2.21484375, 2.21484375, 2.21484375, 0, 0, 0, 0, -13.5 },
+	// Cuuu
+	{ 0.03515625, -0.03515625, -0.03515625, 0.03515625, 0, -0.10546875,
+			0.10546875, 0.31640625, 0.31640625, 0.10546875, -0.10546875, -0.31640625,
+			-0.31640625, 0, 0, 0, 0, 0, 0, 0, 0, 0.94921875, -0.94921875, -0.94921875,
+			0.94921875, 0, 0, 0, 0, 0 },
+	// Cuuv
+	{ -0.52734375, -0.52734375, 0.52734375, 0.52734375, 0, 0.52734375, 0.52734375,
+			-0.94921875, 0.94921875, -0.52734375, -0.52734375, 0.94921875,
+			-0.94921875, 1.6875, 0, 1.6875, 0, -1.6875, 0, -1.6875, 0, 0.94921875,
+			0.94921875, -0.94921875, -0.94921875, -3.375, 0, 3.375, 0, 0 },
+	// Cuvv
+	{ -0.52734375, 0.52734375, 0.52734375, -0.52734375, 0, -0.94921875,
+			0.94921875, -0.52734375, -0.52734375, 0.94921875, -0.94921875, 0.52734375,
+			0.52734375, 1.6875, 0, -1.6875, 0, -1.6875, 0, 1.6875, 0, 0.94921875,
+			-0.94921875, -0.94921875, 0.94921875, 0, 3.375, 0, -3.375, 0 },
+	// Cuuw
+	{ 0.10546875, 0.10546875, 0.10546875, 0.10546875, 0, -0.10546875, -0.10546875,
+			-0.94921875, -0.94921875, -0.10546875, -0.10546875, -0.94921875,
+			-0.94921875, 0, 0, 0, 0, 0, 0, 0, 0, 0.94921875, 0.94921875, 0.94921875,
+			0.94921875, 0, 3.375, 0, 3.375, -6.75 },
+	// Cuww
+	{ -0.31640625, 0.31640625, 0.31640625, -0.31640625, 0, 0.10546875,
+			-0.10546875, 0.52734375, 0.52734375, -0.10546875, 0.10546875, -0.52734375,
+			-0.52734375, 1.6875, -3.375, -1.6875, 3.375, -1.6875, 3.375, 1.6875,
+			-3.375, -0.94921875, 0.94921875, 0.94921875, -0.94921875, 0, -3.375, 0,
+			3.375, 0 },
+	// Cuvw
+	{ -0.87890625, 0.87890625, -0.87890625, 0.87890625, 0, 0.10546875,
+			-0.10546875, -0.10546875, 0.10546875, 0.10546875, -0.10546875,
+			-0.10546875, 0.10546875, 3.375, -3.375, -3.375, 3.375, 3.375, -3.375,
+			-3.375, 3.375, -2.84765625, 2.84765625, -2.84765625, 2.84765625, 0, 0, 0,
+			0, 0 },
+	// Cvvv
+	{ 0.03515625, 0.03515625, -0.03515625, -0.03515625, 0, -0.31640625,
+			-0.31640625, -0.10546875, 0.10546875, 0.31640625, 0.31640625, 0.10546875,
+			-0.10546875, 0, 0, 0, 0, 0, 0, 0, 0, 0.94921875, 0.94921875, -0.94921875,
+			-0.94921875, 0, 0, 0, 0, 0 },
+	// Cvvw
+	{ 0.10546875, 0.10546875, 0.10546875, 0.10546875, 0, -0.94921875, -0.94921875,
+			-0.10546875, -0.10546875, -0.94921875, -0.94921875, -0.10546875,
+			-0.10546875, 0, 0, 0, 0, 0, 0, 0, 0, 0.94921875, 0.94921875, 0.94921875,
+			0.94921875, 3.375, 0, 3.375, 0, -6.75 },
+	// Cvww
+	{ -0.31640625, -0.31640625, 0.31640625, 0.31640625, 0, -0.52734375,
+			-0.52734375, 0.10546875, -0.10546875, 0.52734375, 0.52734375, -0.10546875,
+			0.10546875, 1.6875, -3.375, 1.6875, -3.375, -1.6875, 3.375, -1.6875,
+			3.375, -0.94921875, -0.94921875, 0.94921875, 0.94921875, 3.375, 0, -3.375,
+			0, 0 },
+	// Cwww
+	{ -0.38671875, -0.38671875, -0.38671875, -0.38671875, 4.5, 0.10546875,
+			0.10546875, 0.10546875, 0.10546875, 0.10546875, 0.10546875, 0.10546875,
+			0.10546875, 1.6875, -3.375, 1.6875, -3.375, 1.6875, -3.375, 1.6875,
+			-3.375, -0.94921875, -0.94921875, -0.94921875, -0.94921875, 0, 0, 0, 0,
+			6.75 },
+	// CuvOverw
+	{ -0.25, 0.25, -0.25, 0.25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1.125, -2.25, -1.125,
+			2.25, 1.125, -2.25, -1.125, 2.25, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu2vOverw
+	{ -0.5625, -0.5625, 0.5625, 0.5625, 0, 0.5625, 0.5625, 0, 0, -0.5625, -0.5625,
+			0, 0, 1.6875, 0, 1.6875, 0, -1.6875, 0, -1.6875, 0, 0, 0, 0, 0, -3.375, 0,
+			3.375, 0, 0 },
+	// Cuv2Overw
+	{ -0.5625, 0.5625, 0.5625, -0.5625, 0, 0, 0, -0.5625, -0.5625, 0, 0, 0.5625,
+			0.5625, 1.6875, 0, -1.6875, 0, -1.6875, 0, 1.6875, 0, 0, 0, 0, 0, 0,
+			3.375, 0, -3.375, 0 },
+	// Cu3vOverw
+	{ 0.03515625, -0.03515625, 0.03515625, -0.03515625, 0, -0.10546875,
+			0.10546875, 0.94921875, -0.94921875, -0.10546875, 0.10546875, 0.94921875,
+			-0.94921875, 0, 0, 0, 0, 0, 0, 0, 0, 2.84765625, -2.84765625, 2.84765625,
+			-2.84765625, 0, 0, 0, 0, 0 },
+	// Cu2v2Overw
+	{ -0.94921875, -0.94921875, -0.94921875, -0.94921875, 0, 0.94921875,
+			0.94921875, 0.94921875, 0.94921875, 0.94921875, 0.94921875, 0.94921875,
+			0.94921875, 1.6875, 0, 1.6875, 0, 1.6875, 0, 1.6875, 0, -0.94921875,
+			-0.94921875, -0.94921875, -0.94921875, -3.375, -3.375, -3.375, -3.375,
+			6.75 },
+	// Cuv3Overw
+	{ 0.03515625, -0.03515625, 0.03515625, -0.03515625, 0, -0.94921875,
+			0.94921875, 0.10546875, -0.10546875, -0.94921875, 0.94921875, 0.10546875,
+			-0.10546875, 0, 0, 0, 0, 0, 0, 0, 0, 2.84765625, -2.84765625, 2.84765625,
+			-2.84765625, 0, 0, 0, 0, 0 },
+	// Cu2v2Overw2
+	{ -0.6328125, -0.6328125, -0.6328125, -0.6328125, 0, 0.6328125, 0.6328125,
+			0.6328125, 0.6328125, 0.6328125, 0.6328125, 0.6328125, 0.6328125, 1.6875,
+			0, 1.6875, 0, 1.6875, 0, 1.6875, 0, -0.6328125, -0.6328125, -0.6328125,
+			-0.6328125, -3.375, -3.375, -3.375, -3.375, 6.75 },
+	// Cu3v2Overw2
+	{ -0.31640625, 0.31640625, 0.31640625, -0.31640625, 0, 0.94921875,
+			-0.94921875, -0.31640625, -0.31640625, -0.94921875, 0.94921875,
+			0.31640625, 0.31640625, 0, 0, 0, 0, 0, 0, 0, 0, -0.94921875, 0.94921875,
+			0.94921875, -0.94921875, 0, 0, 0, 0, 0 },
+	// Cu2v3Overw2
+	{ -0.31640625, -0.31640625, 0.31640625, 0.31640625, 0, 0.31640625, 0.31640625,
+			0.94921875, -0.94921875, -0.31640625, -0.31640625, -0.94921875,
+			0.94921875, 0, 0, 0, 0, 0, 0, 0, 0, -0.94921875, -0.94921875, 0.94921875,
+			0.94921875, 0, 0, 0, 0, 0 },
+	// Cu3v3Overw3
+	{ -0.31640625, 0.31640625, -0.31640625, 0.31640625, 0, 0.94921875,
+			-0.94921875, -0.94921875, 0.94921875, 0.94921875, -0.94921875,
+			-0.94921875, 0.94921875, 0, 0, 0, 0, 0, 0, 0, 0, -2.84765625, 2.84765625,
+			-2.84765625, 2.84765625, 0, 0, 0, 0, 0 }
+};
+
 void LagrangeCubicPyramidMapping::setModalValues() {
 	for (int ii = 0; ii < 3; ii++) {
-		// Some aliases for these coordinate values, which will greatly shorten the
-		// code that computes the modal values.
-		double& c0 = m_nodalValues[0][ii];
-		double& c1 = m_nodalValues[1][ii];
-		double& c2 = m_nodalValues[2][ii];
-		double& c3 = m_nodalValues[3][ii];
-		double& c4 = m_nodalValues[4][ii];
-		double& c5 = m_nodalValues[5][ii];
-		double& c6 = m_nodalValues[6][ii];
-		double& c7 = m_nodalValues[7][ii];
-		double& c8 = m_nodalValues[8][ii];
-		double& c9 = m_nodalValues[9][ii];
-		double& c10 = m_nodalValues[10][ii];
-		double& c11 = m_nodalValues[11][ii];
-		double& c12 = m_nodalValues[12][ii];
-		double& c13 = m_nodalValues[13][ii];
-		double& c14 = m_nodalValues[14][ii];
-		double& c15 = m_nodalValues[15][ii];
-		double& c16 = m_nodalValues[16][ii];
-		double& c17 = m_nodalValues[17][ii];
-		double& c18 = m_nodalValues[18][ii];
-		double& c19 = m_nodalValues[19][ii];
-		double& c20 = m_nodalValues[20][ii];
-		double& c21 = m_nodalValues[21][ii];
-		double& c22 = m_nodalValues[22][ii];
-		double& c23 = m_nodalValues[23][ii];
-		double& c24 = m_nodalValues[24][ii];
-		double& c25 = m_nodalValues[25][ii];
-		double& c26 = m_nodalValues[26][ii];
-		double& c27 = m_nodalValues[27][ii];
-		double& c28 = m_nodalValues[28][ii];
-		double& c29 = m_nodalValues[29][ii];
-
-		Apex[ii] = c4;
-
-		C[ii] =
-				1 / 256. * ((c0 + c2 + c1 + c3)
-						- 9 * (c11 + c10 + c9 + c8 + c7 + c5 + c12 + c6)
-										+ 81 * (c21 + c22 + c23 + c24));
-
-		Cu[ii] = +1 / 256.
-				* (27 * (-c6 + c5 - c9 + c10) + 9 * (-c8 - c7 + c12 + c11)
-						+ (-c3 + c2 + c1 - c0) + 243 * (-c21 + c22 + c23 - c24));
-
-		Cv[ii] = 1. / 256
-				* (9 * (c6 + c5 - c9 - c10) + 27 * (-c8 + c7 + c12 - c11) + c3 + c2 - c1
-						- c0
-						+ 243 * (-c21 - c22 + c23 + c24));
-
-		Cw[ii] = (+37. / 256 * (-c3 - c2 - c1 - c0)
-				+ 45. / 256 * (c6 + c8 + c7 + c5 + c12 + c9 + c11 + c10)
-				+ 9. / 16 * (+c13 + c15 + c17 + c19) + c4
-				+ 9. / 8 * (-c14 - c16 - c18 - c20)
-				+ 405. / 256 * (-c21 - c22 - c23 - c24) + 27. / 4 * c29);
-
-		Cuu[ii] = 9. / 256
-				* (c6 + c5 + c9 - c3 - c2 - c1 + c10 - c0 + 9
-						* (+c8 + c7 + c12 + c11 - c21 - c22 - c23 - c24));
-
-		Cuv[ii] = 63. / 256 * (+c3 - c2 + c1 - c0)
-				+ (9. / 8 * (+4 * (+c13 - c15 + c17 - c19)
-						+ 5 * (-c14 + c16 - c18 + c20)))
-							- 27. / 256 * (32
-									* (c13 - c15 + c17 - c19 - c14 + c16 - c18 + c20)
-															+ c12
-															- c11
-															+ c8
-															- c7 - c10 - c6
-															+ c5 + c9 + 27 * (-c21 + c22 - c23 + c24));
-
-		Cvv[ii] = 1. / 256
-				* (81 * (c6 + c5 + c9 + c10 - c21 - c22 - c23 - c24) + 9
-						* (+c12 + c8 + c7 - c3 - c2 - c1 + c11 - c0));
-
-		Cvw[ii] = 9. / 128
-				* ((-c3 - c2 + c1 + c0) + 3 * (+c8 - c7 - c12 + c11)
-						+ 27 * (c21 + c22 - c23 - c24) + 7 * (c6 + c5 - c10 - c9)
-						+ 8 * (-c15 - c13 + c19 + c17) + 16 * (+c14 + c16 - c18 - c20)
-						+ 48 * (-c25 + c27));
-
-		Cww[ii] = (63. / 256 * (-c6 - c8 - c7 - c5 - c12 - c9 - c11 - c10)
-				+ 135. / 256 * (+c3 + c2 + c1 + c0)
-				+ 567. / 256 * (+c21 + c22 + c23 + c24)
-				+ 4.5 * (+c14 + c16 + c18 + c20 - c4) + 2.25 * (-c13 - c15 - c17 - c19)
-								- 13.5 * c29);
-
-		Cuw[ii] = (+9 / 128.
-				* (3 * (c6 - c5 - c10 + c9) + 7 * (-c8 - c7 + c12 + c11)
-						+ 27 * (c21 - c22 - c23 + c24))
-								+ 9. / 16 * (-c13 + c17 - c19 + c15)
-								+ 27. / 8 * (c26 - c28)
-								+ 9. / 128 * (c0 + c3 - c1 - c2)
-								+ 1.125 * (c14 - c16 - c18 + c20));
-
-		Cuuu[ii] = 9. / 256
-				* (3 * (c6 - c5 + c9 - c10) + 9 * (+c8 + c7 - c12 - c11)
-						+ 27 * (+c21 - c22 - c23 + c24) + c3
-						- c2 - c1
-						+ c0);
-
-		Cuuv[ii] = 27. / 256
-				* (5 * (c6 + c5 - c9 + c3 + c2 - c1 - c10 - c0) + 9
-						* (+c8 - c7 - c12 + c11 + c21 + c22 - c23 - c24)
-						+ 16 * (+c13 + c15 - c17 - c19 - 2 * c25 + 2 * c27));
-
-		Cuvv[ii] = (27. / 256
-				* (9 * (-c5 - c10 + c6 + c9 + c21 - c22 - c23 + c24) + 5
-						* (c12 - c3 + c2 + c1 + c11 - c8 - c7 - c0)
-						+ 32 * (-c28 + c26) + 16 * (+c13 - c15 - c17 + c19)));
-
-		Cvvv[ii] = 1 / 256.
-				* (+81 * (-c6 - c5 + c9 + c10) + 27 * (c11 - c12 + c8 - c7)
-						+ 9 * (c0 + c1 - c2 - c3) + 243 * (c21 + c22 - c23 - c24));
-
-		Cvvw[ii] = 27. / 256
-				* ((-c12 - c11 - c8 - c7 + c3 + c2 + c1 + c0) + 9
-						* (-c10 + c21 + c22 + c23 + c24 - c6 - c5 - c9)
-						+ 32 * (c25 - 2 * c29 + c27));
-
-		Cvww[ii] = 27. / 256
-				* (-c8 + c7 + c12 - c11 + 3 * (+c3 + c2 - c1 - c0)
-						+ 5 * (+c9 + c10 - c6 - c5) + 9 * (-c21 - c22 + c23 + c24)
-						+ 16 * (+c13 + c15 - c19 - c17)
-						+ 32 * (-c14 - c16 + c18 + c20 + c25 - c27));
-
-		Cwww[ii] = 9. / 256
-				* (3 * (c6 + c8 + c7 + c5 + c12 + c9 + c11 + c10) - 11
-						* (c3 + c2 + c1 + c0)
-						- 27 * (+c21 + c22 + c23 + c24)
-						+ 48 * (+c13 + c15 + c17 + c19)
-						+ 96 * (-c20 - c18 - c16 - c14 + 2 * c29) + 128 * c4);
-
-		Cuww[ii] = (27 / 256.
-				* (+(-c6 + c5 - c9 + c10) + 3 * (-c3 + c2 + c1 - c0)
-						+ 5 * (-c11 + c8 + c7 - c12) + 9 * (-c21 + c22 + c23 - c24))
-								+ 27. / 16 * (c13 - c15 - c17 + c19)
-								+ 27. / 8 * (-c26 - c14 + c28 + c16 + c18 - c20));
-
-		Cuuw[ii] = 27. / 256
-				* (9 * (-c12 - c11 - c8 - c7 + c21 + c22 + c23 + c24) - c10 - c6 - c5
-						- c9
-						+ c3 + c2 + c1 + c0 + 32 * (+c28 + c26 - 2 * c29));
-
-		Cuvw[ii] =
-				(27. / 256 * (32 * (c13 - c15 + c17 - c19 - c14 + c16 - c18 + c20) + c12
-						- c11
-											+ c8
-											- c7 - c10 - c6
-											+ c5 + c9 + 27 * (-c21 + c22 - c23 + c24))
-					+ 225. / 256 * (c3 - c2 + c1 - c0));
-
-		CuvOverw[ii] =
-				(0.25 * (9 * (-c14 + c16 - c18 + c20) + 4.5 * (c13 - c15 + c17 - c19)
-									+ c3
-									- c2
-									+ c1
-									- c0));
-
-		Cu2vOverw[ii] =
-				9. / 16 * (3 * (+c13 + c15 - c17 - c19 - 2 * c25 + 2 * c27) + c6 + c5
-						- c9 - c10
-										+ c3 + c2
-										- c1 - c0);
-
-		Cuv2Overw[ii] =
-				9. / 16 * (3 * (c13 - c15 - c17 + c19) + 6 * (c26 - c28) - c8 - c7 + c12
-										+ c11
-										- c3
-										+ c2 + c1
-										- c0);
-
-		Cu3vOverw[ii] = 9. / 256
-				* (27 * (-c8 + c7 - c12 + c11) + 81 * (+c21 - c22 + c23 - c24)
-						+ 3 * (+c6 - c5 - c9 + c10)
-						- c3
-						+ c2
-						- c1
-						+ c0);
-
-		Cu2v2Overw[ii] = (27. / 16
-				* (4 * c29 + c13 + c15 + c17 + c19 - 2 * c26 - 2 * c28 - 2 * c25
-						- 2 * c27)
-											+ 243. / 256 * (+c8 + c7 + c12 + c11 - c21 - c22 - c23
-																			- c24
-																			+ c6 + c5 + c9 + c10
-																			- c3 - c2 - c1 - c0));
-
-		Cuv3Overw[ii] = 9. / 256
-				* (3 * (-c12 + c11 - c8 + c7) + 27 * (-c9 + c10 + c6 - c5)
-						+ 81 * (c21 - c22 + c23 - c24)
-						- c3
-						+ c2
-						- c1
-						+ c0);
-
-		Cu2v2Overw2[ii] = (27. / 16
-				* (4 * c29 + c13 + c15 + c17 + c19 - 2 * c26 - 2 * c28 - 2 * c25
-						- 2 * c27)
-												+ 81. / 128 * (+c6 + c8 + c7 + c5 + c12 + c9 + c11 + c10
-														- c3 - c2 - c1 - c0 - c21 - c22 - c23 - c24));
-
-		Cu3v2Overw2[ii] =
-				81. / 256 * (3 * (-c6 + c5 - c9 + c10 - c21 + c22 + c23 - c24) - c8 - c7
-						+ c12
-											- c3
-											+ c2 + c1 + c11
-											- c0);
-
-		Cu2v3Overw2[ii] = 81. / 256
-				* (c6 + c5 - c9 + c3 + c2 - c1 - c10 - c0 + 3
-						* (-c8 + c7 + c12 - c11 - c21 - c22 + c23 + c24));
-
-		Cu3v3Overw3[ii] =
-				81. / 256 * (3 * (-c6 + c8 - c7 + c5 + c12 + c9 - c11 - c10) + c3 - c2
-						+ c1
-											- c0
-											+ 9 * (-c21 + c22 - c23 + c24));
+		Apex[ii] = m_nodalValues[4][ii];
 	}
+	convertNodalToModal(&pyramidNodalToModal[0][0], m_modal);
 }
 
 void LagrangeCubicPyramidMapping::computeTransformedCoords(const double uvw[3],
 		double xyz[3]) const {
+	// Names for the modal values, in the order of the rows of pyramidNodalToModal.
+	const double* const C = m_modal[0];
+	const double* const Cu = m_modal[1];
+	const double* const Cv = m_modal[2];
+	const double* const Cw = m_modal[3];
+	const double* const Cuu = m_modal[4];
+	const double* const Cuv = m_modal[5];
+	const double* const Cuw = m_modal[6];
+	const double* const Cvv = m_modal[7];
+	const double* const Cvw = m_modal[8];
+	const double* const Cww = m_modal[9];
+	const double* const Cuuu = m_modal[10];
+	const double* const Cuuv = m_modal[11];
+	const double* const Cuvv = m_modal[12];
+	const double* const Cuuw = m_modal[13];
+	const double* const Cuww = m_modal[14];
+	const double* const Cuvw = m_modal[15];
+	const double* const Cvvv = m_modal[16];
+	const double* const Cvvw = m_modal[17];
+	const double* const Cvww = m_modal[18];
+	const double* const Cwww = m_modal[19];
+	const double* const CuvOverw = m_modal[20];
+	const double* const Cu2vOverw = m_modal[21];
+	const double* const Cuv2Overw = m_modal[22];
+	const double* const Cu3vOverw = m_modal[23];
+	const double* const Cu2v2Overw = m_modal[24];
+	const double* const Cuv3Overw = m_modal[25];
+	const double* const Cu2v2Overw2 = m_modal[26];
+	const double* const Cu3v2Overw2 = m_modal[27];
+	const double* const Cu2v3Overw2 = m_modal[28];
+	const double* const Cu3v3Overw3 = m_modal[29];
 	xyz[0] = xyz[1] = xyz[2] = 0;
 	double u = uvw[0];
 	double v = uvw[1];
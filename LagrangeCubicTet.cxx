@@ -18,8 +18,83 @@
 
 #include "Mapping.h"
 
+// The modal values are linear combinations of the nodal values, so each
+// row here gives one modal value in terms of the 20 nodal values.
+static const double tetNodalToModal[20][20] = {
+	// C
+	{ 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cu
+	{ -5.5, 1, 0, 0, 9, -4.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cv
+	{ -5.5, 0, 1, 0, 0, 0, 0, 0, -4.5, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cw
+	{ -5.5, 0, 0, 1, 0, 0, 0, 0, 0, 0, 9, -4.5, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuu
+	{ 9, -4.5, 0, 0, -22.5, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuv
+	{ 18, 0, 0, 0, -22.5, 4.5, -4.5, -4.5, 4.5, -22.5, 0, 0, 0, 0, 0, 0, 27, 0, 0,
+			0 },
+	// Cuw
+	{ 18, 0, 0, 0, -22.5, 4.5, 0, 0, 0, 0, -22.5, 4.5, -4.5, -4.5, 0, 0, 0, 27, 0,
+			0 },
+	// Cvv
+	{ 9, 0, -4.5, 0, 0, 0, 0, 0, 18, -22.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cvw
+	{ 18, 0, 0, 0, 0, 0, 0, 0, 4.5, -22.5, -22.5, 4.5, 0, 0, -4.5, -4.5, 0, 0, 0,
+			27 },
+	// Cww
+	{ 9, 0, 0, -4.5, 0, 0, 0, 0, 0, 0, -22.5, 18, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuuu
+	{ -4.5, 4.5, 0, 0, 13.5, -13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cuuv
+	{ -13.5, 0, 0, 0, 27, -13.5, 13.5, 0, 0, 13.5, 0, 0, 0, 0, 0, 0, -27, 0, 0,
+			0 },
+	// Cuvv
+	{ -13.5, 0, 0, 0, 13.5, 0, 0, 13.5, -13.5, 27, 0, 0, 0, 0, 0, 0, -27, 0, 0,
+			0 },
+	// Cuuw
+	{ -13.5, 0, 0, 0, 27, -13.5, 0, 0, 0, 0, 13.5, 0, 13.5, 0, 0, 0, 0, -27, 0,
+			0 },
+	// Cuww
+	{ -13.5, 0, 0, 0, 13.5, 0, 0, 0, 0, 0, 27, -13.5, 0, 13.5, 0, 0, 0, -27, 0,
+			0 },
+	// Cuvw
+	{ -27, 0, 0, 0, 27, 0, 0, 0, 0, 27, 27, 0, 0, 0, 0, 0, -27, -27, 27, -27 },
+	// Cvvv
+	{ -4.5, 0, 4.5, 0, 0, 0, 0, 0, -13.5, 13.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+	// Cvvw
+	{ -13.5, 0, 0, 0, 0, 0, 0, 0, -13.5, 27, 13.5, 0, 0, 0, 13.5, 0, 0, 0, 0,
+			-27 },
+	// Cvww
+	{ -13.5, 0, 0, 0, 0, 0, 0, 0, 0, 13.5, 27, -13.5, 0, 0, 0, 13.5, 0, 0, 0,
+			-27 },
+	// Cwww
+	{ -4.5, 0, 0, 4.5, 0, 0, 0, 0, 0, 0, 13.5, -13.5, 0, 0, 0, 0, 0, 0, 0, 0 }
+};
+
 void LagrangeCubicTetMapping::computeTransformedCoords(const double uvw[3],
 		double xyz[3]) const {
+	// Names for the modal values, in the order of the rows of tetNodalToModal.
+	const double* const C = m_modal[0];
+	const double* const Cu = m_modal[1];
+	const double* const Cv = m_modal[2];
+	const double* const Cw = m_modal[3];
+	const double* const Cuu = m_modal[4];
+	const double* const Cuv = m_modal[5];
+	const double* const Cuw = m_modal[6];
+	const double* const Cvv = m_modal[7];
+	const double* const Cvw = m_modal[8];
+	const double* const Cww = m_modal[9];
+	const double* const Cuuu = m_modal[10];
+	const double* const Cuuv = m_modal[11];
+	const double* const Cuvv = m_modal[12];
+	const double* const Cuuw = m_modal[13];
+	const double* const Cuww = m_modal[14];
+	const double* const Cuvw = m_modal[15];
+	const double* const Cvvv = m_modal[16];
+	const double* const Cvvw = m_modal[17];
+	const double* const Cvww = m_modal[18];
+	const double* const Cwww = m_modal[19];
 	xyz[0] = xyz[1] = xyz[2] = 0;
 	const double& u = uvw[0];
 	const double& v = uvw[1];
@@ -36,62 +111,6 @@ void LagrangeCubicTetMapping::computeTransformedCoords(const double uvw[3],
 }
 
 void LagrangeCubicTetMapping::setModalValues() {
-	const double (*c)[3] = m_nodalValues;
-	for (int ii = 0; ii < 3; ii++) {
-		C[ii] = c[0][ii];
-
-		Cu[ii] = -5.5 * c[0][ii] + c[1][ii] + 9 * c[4][ii] - 4.5 * c[5][ii];
-		Cv[ii] = -5.5 * c[0][ii] + c[2][ii] + 9 * c[9][ii] - 4.5 * c[8][ii];
-		Cw[ii] = -5.5 * c[0][ii] + c[3][ii] + 9 * c[10][ii] - 4.5 * c[11][ii];
-
-		Cuu[ii] = 4.5 * (2 * c[0][ii] - c[1][ii] - 5 * c[4][ii] + 4 * c[5][ii]);
-		Cvv[ii] = 4.5 * (2 * c[0][ii] - c[2][ii] - 5 * c[9][ii] + 4 * c[8][ii]);
-		Cww[ii] = 4.5 * (2 * c[0][ii] - c[3][ii] - 5 * c[10][ii] + 4 * c[11][ii]);
-
-		Cuv[ii] =
-				4.5 * (4 * c[0][ii] - 5 * c[4][ii] + c[5][ii] - c[6][ii] - c[7][ii]
-						+ c[8][ii]
-								- 5 * c[9][ii]
-								+ 6 * c[16][ii]);
-		Cvw[ii] =
-				4.5 * (4 * c[0][ii] - 5 * c[9][ii] + c[8][ii] - c[14][ii] - c[15][ii]
-						+ c[11][ii]
-								- 5 * c[10][ii]
-								+ 6 * c[19][ii]);
-		Cuw[ii] =
-				4.5 * (4 * c[0][ii] - 5 * c[4][ii] + c[5][ii] - c[13][ii] - c[12][ii]
-						+ c[11][ii]
-								- 5 * c[10][ii]
-								+ 6 * c[17][ii]);
-
-		Cuuu[ii] = 4.5 * (-c[0][ii] + c[1][ii] + 3 * c[4][ii] - 3 * c[5][ii]);
-		Cvvv[ii] = 4.5 * (-c[0][ii] + c[2][ii] + 3 * c[9][ii] - 3 * c[8][ii]);
-		Cwww[ii] = 4.5 * (-c[0][ii] + c[3][ii] + 3 * c[10][ii] - 3 * c[11][ii]);
-
-		Cuuv[ii] = 13.5
-				* (-c[0][ii] + 2 * c[4][ii] - c[5][ii] + c[6][ii] + c[9][ii] - 2
-						* c[16][ii]);
-		Cvvw[ii] = 13.5
-				* (-c[0][ii] + 2 * c[9][ii] - c[8][ii] + c[10][ii] + c[14][ii] - 2
-						* c[19][ii]);
-		Cuww[ii] = 13.5
-				* (-c[0][ii] + 2 * c[10][ii] - c[11][ii] + c[4][ii] + c[13][ii] - 2
-						* c[17][ii]);
-
-		Cuvv[ii] = 13.5
-				* (-c[0][ii] + c[4][ii] - c[8][ii] + c[7][ii] + 2 * c[9][ii] - 2
-						* c[16][ii]);
-		Cvww[ii] = 13.5
-				* (-c[0][ii] + c[9][ii] - c[11][ii] + c[15][ii] + 2 * c[10][ii] - 2
-						* c[19][ii]);
-		Cuuw[ii] = 13.5
-				* (-c[0][ii] + c[10][ii] - c[5][ii] + c[12][ii] + 2 * c[4][ii] - 2
-						* c[17][ii]);
-
-		Cuvw[ii] = 27
-				* (-c[0][ii] + c[4][ii] + c[9][ii] + c[10][ii] - c[16][ii] - c[17][ii]
-						- c[19][ii]
-						+ c[18][ii]);
-	}
+	convertNodalToModal(&tetNodalToModal[0][0], m_modal);
 }
 
@@ -56,3 +56,27 @@ void LagrangeMapping::setNodalValues(double inputValues[][3]) {
 	}
 }
 
+void LagrangeMapping::convertNodalToModal(const double nodalToModal[],
+		double modalValues[][3]) const {
+	// Split the nodal values by coordinate first, so that each modal value is
+	// three dot products of contiguous arrays, which vectorize.
+	double nodalX[m_numValues], nodalY[m_numValues], nodalZ[m_numValues];
+	for (int nn = 0; nn < m_numValues; nn++) {
+		nodalX[nn] = m_nodalValues[nn][0];
+		nodalY[nn] = m_nodalValues[nn][1];
+		nodalZ[nn] = m_nodalValues[nn][2];
+	}
+	for (int mm = 0; mm < m_numValues; mm++) {
+		const double *row = nodalToModal + mm * m_numValues;
+		double x = 0, y = 0, z = 0;
+#pragma omp simd reduction(+: x, y, z)
+		for (int nn = 0; nn < m_numValues; nn++) {
+			x += row[nn] * nodalX[nn];
+			y += row[nn] * nodalY[nn];
+			z += row[nn] * nodalZ[nn];
+		}
+		modalValues[mm][0] = x;
+		modalValues[mm][1] = y;
+		modalValues[mm][2] = z;
+	}
+}
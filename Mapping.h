@@ -42,6 +42,9 @@ public:
 	virtual ~Mapping() {
 	}
 	double getIsoLengthScale(const emInt vertInd);
+	// Mappings that can evaluate several cells at once, one per SIMD lane,
+	// override this and provide getLaneCoeffs and computeTransformedCoordsLanes.
+	static constexpr bool hasLaneEvaluation = false;
 	virtual void setupCoordMapping(const emInt verts[]) = 0;
 	virtual void computeTransformedCoords(const double uvw[3],
 			double xyz[3]) const = 0;
@@ -63,7 +66,7 @@ protected:
 	}
 };
 
-class Q1TetMapping: public Q1Mapping {
+class Q1TetMapping final: public Q1Mapping {
 private:
 	double A[3], dU[3], dV[3], dW[3];
 public:
@@ -74,7 +77,7 @@ public:
 	void computeTransformedCoords(const double uvw[3], double xyz[3]) const;
 };
 
-class Q1PyramidMapping: public Q1Mapping {
+class Q1PyramidMapping final: public Q1Mapping {
 private:
 	double A[3], dU[3], dV[3], dUV[3], dW[3], Apex[3];
 public:
@@ -85,7 +88,7 @@ public:
 	void computeTransformedCoords(const double uvw[3], double xyz[3]) const;
 };
 
-class Q1PrismMapping: public Q1Mapping {
+class Q1PrismMapping final: public Q1Mapping {
 private:
 	double A[3], dU[3], dV[3], dW[3], dUW[3], dVW[3];
 public:
@@ -94,9 +97,17 @@ public:
 	}
 	void setupCoordMapping(const emInt verts[]);
 	void computeTransformedCoords(const double uvw[3], double xyz[3]) const;
+
+	static constexpr bool hasLaneEvaluation = true;
+	static constexpr int numCoeffs = 6;
+	void getLaneCoeffs(double coeffs[numCoeffs][3][BATCH_WIDTH],
+			const int lane) const;
+	static void computeTransformedCoordsLanes(
+			const double coeffs[numCoeffs][3][BATCH_WIDTH],
+			const double uvw[3][BATCH_WIDTH], double xyz[3][BATCH_WIDTH]);
 };
 
-class Q1HexMapping: public Q1Mapping {
+class Q1HexMapping final: public Q1Mapping {
 private:
 	double A[3], dU[3], dV[3], dW[3], dUV[3], dUW[3], dVW[3], dUVW[3];
 public:
@@ -105,6 +116,14 @@ public:
 	}
 	void setupCoordMapping(const emInt verts[]);
 	void computeTransformedCoords(const double uvw[3], double xyz[3]) const;
+
+	static constexpr bool hasLaneEvaluation = true;
+	static constexpr int numCoeffs = 8;
+	void getLaneCoeffs(double coeffs[numCoeffs][3][BATCH_WIDTH],
+			const int lane) const;
+	static void computeTransformedCoordsLanes(
+			const double coeffs[numCoeffs][3][BATCH_WIDTH],
+			const double uvw[3][BATCH_WIDTH], double xyz[3][BATCH_WIDTH]);
 };
 
 class Q1TriMapping: public Q1Mapping {
@@ -133,12 +152,141 @@ public:
 	}
 };
 
+// Weights of the corners of a linear cell with nCorners corners (4, 5, 6 or
+// 8) at param coords uvw, so that the Q1 mapping of uvw is the weighted sum
+// of the corner coords.  Also the Q1 interpolant of anything else.
+void getQ1Weights(const int nCorners, const double uvw[3], double weights[8]);
+
+// The Q1 evaluations are defined here so that they can be inlined into the
+// cell dividers, which call them for every new vert.
+
+inline void Q1TetMapping::computeTransformedCoords(const double uvw[3],
+		double xyz[3]) const {
+	const double& u = uvw[0];
+	const double& v = uvw[1];
+	const double& w = uvw[2];
+	for (int ii = 0; ii < 3; ii++) {
+		xyz[ii] = A[ii] + u * dU[ii] + v * dV[ii] + w * dW[ii];
+	}
+}
+
+inline void Q1PyramidMapping::computeTransformedCoords(const double uvw[3],
+		double xyz[3]) const {
+	double u = uvw[0];
+	double v = uvw[1];
+	const double& w = uvw[2];
+	if (w == 1) {
+		xyz[0] = Apex[0];
+		xyz[1] = Apex[1];
+		xyz[2] = Apex[2];
+	}
+	u = 2 * u - (1 - w);
+	v = 2 * v - (1 - w);
+	for (int ii = 0; ii < 3; ii++) {
+		xyz[ii] = (A[ii] + u * dU[ii] + v * dV[ii] + u * v * dUV[ii] / (w - 1))
+				+ dW[ii] * w;
+	}
+}
+
+// One coordinate of the Q1 prism and hex maps.  The one-cell and batched
+// evaluations both use these, so they round identically.
+inline double q1PrismCoord(const double A, const double dU, const double dV,
+		const double dW, const double dUW, const double dVW, const double u,
+		const double v, const double w) {
+	return A + u * dU + v * dV + w * (dW + u * dUW + v * dVW);
+}
+
+inline double q1HexCoord(const double A, const double dU, const double dV,
+		const double dW, const double dUV, const double dUW, const double dVW,
+		const double dUVW, const double u, const double v, const double w) {
+	// Original, naive implementation of polynomial evaluation
+	return A + u * dU + v * dV + w * dW + u * v * dUV + u * w * dUW + v * w * dVW
+			+ u * v * w * dUVW;
+	// Faster version that has only one multiply-add per term.
+//	return A + u * (dU + v * dUV + w * (dUW + v * dUVW)) + v * dV
+//			+ w * (dW + v * dVW);
+}
+
+inline void Q1PrismMapping::computeTransformedCoords(const double uvw[3],
+		double xyz[3]) const {
+	for (int ii = 0; ii < 3; ii++) {
+		xyz[ii] = q1PrismCoord(A[ii], dU[ii], dV[ii], dW[ii], dUW[ii], dVW[ii],
+														uvw[0], uvw[1], uvw[2]);
+	}
+}
+
+inline void Q1PrismMapping::getLaneCoeffs(
+		double coeffs[numCoeffs][3][BATCH_WIDTH], const int lane) const {
+	for (int ii = 0; ii < 3; ii++) {
+		coeffs[0][ii][lane] = A[ii];
+		coeffs[1][ii][lane] = dU[ii];
+		coeffs[2][ii][lane] = dV[ii];
+		coeffs[3][ii][lane] = dW[ii];
+		coeffs[4][ii][lane] = dUW[ii];
+		coeffs[5][ii][lane] = dVW[ii];
+	}
+}
+
+inline void Q1PrismMapping::computeTransformedCoordsLanes(
+		const double coeffs[numCoeffs][3][BATCH_WIDTH],
+		const double uvw[3][BATCH_WIDTH], double xyz[3][BATCH_WIDTH]) {
+	for (int ii = 0; ii < 3; ii++) {
+#pragma omp simd
+		for (int ll = 0; ll < BATCH_WIDTH; ll++) {
+			xyz[ii][ll] = q1PrismCoord(coeffs[0][ii][ll], coeffs[1][ii][ll],
+																	coeffs[2][ii][ll], coeffs[3][ii][ll],
+																	coeffs[4][ii][ll], coeffs[5][ii][ll],
+																	uvw[0][ll], uvw[1][ll], uvw[2][ll]);
+		}
+	}
+}
+
+inline void Q1HexMapping::computeTransformedCoords(const double uvw[3],
+		double xyz[3]) const {
+	for (int ii = 0; ii < 3; ii++) {
+		xyz[ii] = q1HexCoord(A[ii], dU[ii], dV[ii], dW[ii], dUV[ii], dUW[ii],
+													dVW[ii], dUVW[ii], uvw[0], uvw[1], uvw[2]);
+	}
+}
+
+inline void Q1HexMapping::getLaneCoeffs(
+		double coeffs[numCoeffs][3][BATCH_WIDTH], const int lane) const {
+	for (int ii = 0; ii < 3; ii++) {
+		coeffs[0][ii][lane] = A[ii];
+		coeffs[1][ii][lane] = dU[ii];
+		coeffs[2][ii][lane] = dV[ii];
+		coeffs[3][ii][lane] = dW[ii];
+		coeffs[4][ii][lane] = dUV[ii];
+		coeffs[5][ii][lane] = dUW[ii];
+		coeffs[6][ii][lane] = dVW[ii];
+		coeffs[7][ii][lane] = dUVW[ii];
+	}
+}
+
+inline void Q1HexMapping::computeTransformedCoordsLanes(
+		const double coeffs[numCoeffs][3][BATCH_WIDTH],
+		const double uvw[3][BATCH_WIDTH], double xyz[3][BATCH_WIDTH]) {
+	for (int ii = 0; ii < 3; ii++) {
+#pragma omp simd
+		for (int ll = 0; ll < BATCH_WIDTH; ll++) {
+			xyz[ii][ll] = q1HexCoord(coeffs[0][ii][ll], coeffs[1][ii][ll],
+																coeffs[2][ii][ll], coeffs[3][ii][ll],
+																coeffs[4][ii][ll], coeffs[5][ii][ll],
+																coeffs[6][ii][ll], coeffs[7][ii][ll],
+																uvw[0][ll], uvw[1][ll], uvw[2][ll]);
+		}
+	}
+}
 
 class LagrangeMapping: public Mapping {
 	int m_numValues;
 	virtual void setModalValues() = 0;
 protected:
 	double (*m_nodalValues)[3];
+	// modal = nodalToModal * nodal, for a square matrix of size nVals stored
+	// by rows.
+	void convertNodalToModal(const double nodalToModal[],
+			double modalValues[][3]) const;
 public:
 	LagrangeMapping(const ExaMesh* const EM, const int nVals);
 	virtual ~LagrangeMapping();
@@ -159,10 +307,8 @@ private:
 	virtual void setModalValues() = 0;
 };
 
-class LagrangeCubicTetMapping: public LagrangeCubicMapping {
-	double C[3], Cu[3], Cv[3], Cw[3], Cuu[3], Cuv[3], Cuw[3], Cvv[3], Cvw[3],
-			Cww[3], Cuuu[3], Cuuv[3], Cuvv[3], Cuuw[3], Cuww[3], Cuvw[3], Cvvv[3],
-			Cvvw[3], Cvww[3], Cwww[3];
+class LagrangeCubicTetMapping final: public LagrangeCubicMapping {
+	double m_modal[20][3];
 public:
 	LagrangeCubicTetMapping(const ExaMesh* const EM) :
 			LagrangeCubicMapping(EM, 20) {
@@ -176,13 +322,8 @@ public:
 	void setModalValues();
 };
 
-class LagrangeCubicPyramidMapping: public LagrangeCubicMapping {
-	double C[3], Cu[3], Cv[3], Cw[3], Cuu[3], Cuv[3], Cuw[3], Cvv[3], Cvw[3],
-			Cww[3], Cuuu[3], Cuuv[3], Cuvv[3], Cuuw[3], Cuww[3], Cuvw[3], Cvvv[3],
-			Cvvw[3], Cvww[3], Cwww[3];
-	double CuvOverw[3], Cu2vOverw[3], Cuv2Overw[3], Cu3vOverw[3], Cu2v2Overw[3],
-			Cuv3Overw[3];
-	double Cu2v2Overw2[3], Cu3v2Overw2[3], Cu2v3Overw2[3], Cu3v3Overw3[3];
+class LagrangeCubicPyramidMapping final: public LagrangeCubicMapping {
+	double m_modal[30][3];
 	double Apex[3];
 public:
 	LagrangeCubicPyramidMapping(const ExaMesh* const EM) :
@@ -197,15 +338,8 @@ public:
 
 };
 
-class LagrangeCubicPrismMapping: public LagrangeCubicMapping {
-	double C0[3], Cu0[3], Cv0[3], Cuu0[3], Cuv0[3], Cvv0[3], Cuuu0[3], Cuuv0[3],
-			Cuvv0[3], Cvvv0[3];
-	double C1[3], Cu1[3], Cv1[3], Cuu1[3], Cuv1[3], Cvv1[3], Cuuu1[3], Cuuv1[3],
-			Cuvv1[3], Cvvv1[3];
-	double C2[3], Cu2[3], Cv2[3], Cuu2[3], Cuv2[3], Cvv2[3], Cuuu2[3], Cuuv2[3],
-			Cuvv2[3], Cvvv2[3];
-	double C3[3], Cu3[3], Cv3[3], Cuu3[3], Cuv3[3], Cvv3[3], Cuuu3[3], Cuuv3[3],
-			Cuvv3[3], Cvvv3[3];
+class LagrangeCubicPrismMapping final: public LagrangeCubicMapping {
+	double m_modal[40][3];
 public:
 	LagrangeCubicPrismMapping(const ExaMesh* const EM) :
 			LagrangeCubicMapping(EM, 40) {
@@ -219,16 +353,8 @@ public:
 
 };
 
-class LagrangeCubicHexMapping: public LagrangeCubicMapping {
-	double C[3], Cu[3], Cv[3], Cw[3], Cu2[3], Cuv[3], Cv2[3], Cvw[3], Cw2[3],
-			Cuw[3], Cu3[3], Cv3[3], Cw3[3], Cu2v[3], Cuv2[3], Cv2w[3], Cvw2[3],
-			Cu2w[3], Cuw2[3], Cuvw[3], Cu3v[3], Cu3w[3], Cuv3[3], Cv3w[3], Cuw3[3],
-			Cvw3[3], Cu2v2[3], Cu2w2[3], Cv2w2[3], Cu2vw[3], Cuv2w[3], Cuvw2[3],
-			Cu3vw[3], Cuv3w[3], Cuvw3[3], Cu3v2[3], Cu3w2[3], Cu2v3[3], Cv3w2[3],
-			Cu2w3[3], Cv2w3[3], Cu2v2w[3], Cu2vw2[3], Cuv2w2[3], Cu3v3[3], Cu3w3[3],
-			Cv3w3[3], Cu3v2w[3], Cu3vw2[3], Cu2v3w[3], Cuv3w2[3], Cu2vw3[3],
-			Cuv2w3[3], Cu2v2w2[3], Cu3v2w2[3], Cu2v3w2[3], Cu2v2w3[3], Cu3v3w[3],
-			Cu3vw3[3], Cuv3w3[3], Cu3v3w2[3], Cu3v2w3[3], Cu2v3w3[3], Cu3v3w3[3];
+class LagrangeCubicHexMapping final: public LagrangeCubicMapping {
+	double m_modal[64][3];
 public:
 	LagrangeCubicHexMapping(const ExaMesh* const EM) :
 			LagrangeCubicMapping(EM, 64) {
@@ -0,0 +1,175 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * ParentMapVisitor.cxx
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include <algorithm>
+
+#include "ParentMapVisitor.h"
+#include "Mapping.h"
+
+static int typeIndex(const int type) {
+	switch (type) {
+		case TETRA_4:
+			return 0;
+		case PYRA_5:
+			return 1;
+		case PENTA_6:
+			return 2;
+		default:
+			assert(type == HEXA_8);
+			return 3;
+	}
+}
+
+ParentMapVisitor::ParentMapVisitor(const MeshSize& fine, RefineVisitor *next) :
+		m_next(next), m_cellCount() {
+	m_firstCell[0] = 0;
+	m_firstCell[1] = m_firstCell[0] + fine.nTets;
+	m_firstCell[2] = m_firstCell[1] + fine.nPyrs;
+	m_firstCell[3] = m_firstCell[2] + fine.nPrisms;
+	m_cellParent.assign(size_t(m_firstCell[3]) + fine.nHexes, EMINT_MAX);
+	m_vertParent.reserve(fine.nVerts);
+	m_vertUVW.reserve(3 * size_t(fine.nVerts));
+}
+
+void ParentMapVisitor::onVerts(const emInt firstVert, const emInt count,
+		const double coords[][3]) {
+	if (m_next) m_next->onVerts(firstVert, count, coords);
+}
+
+void ParentMapVisitor::onVertParents(const emInt firstVert,
+		const emInt count, const emInt coarseCell, const double uvw[][3]) {
+	assert(firstVert == m_vertParent.size());
+	m_vertParent.resize(size_t(firstVert) + count, coarseCell);
+	if (uvw) {
+		m_vertUVW.insert(m_vertUVW.end(), &uvw[0][0], &uvw[0][0] + 3 * size_t(count));
+	}
+	else {
+		m_vertUVW.resize(3 * (size_t(firstVert) + count), 0);
+	}
+	if (m_next && m_next->wantsVertParents()) {
+		m_next->onVertParents(firstVert, count, coarseCell, uvw);
+	}
+}
+
+void ParentMapVisitor::onCells(const emInt coarseCell, const int type,
+		const emInt count, const emInt conn[]) {
+	const int tt = typeIndex(type);
+	const emInt first = m_firstCell[tt] + m_cellCount[tt];
+	assert(first + count <= m_cellParent.size());
+	std::fill(m_cellParent.begin() + first, m_cellParent.begin() + first + count,
+						coarseCell);
+	m_cellCount[tt] += count;
+	if (m_next) m_next->onCells(coarseCell, type, count, conn);
+}
+
+void ParentMapVisitor::onBdryFaces(const emInt coarseFace, const int type,
+		const emInt count, const emInt conn[]) {
+	if (m_next) m_next->onBdryFaces(coarseFace, type, count, conn);
+}
+
+void ParentMapVisitor::onDone() {
+	if (m_next) m_next->onDone();
+}
+
+// The corners of coarse cell cell, counting tets, pyramids, prisms and
+// hexes.
+static const emInt* getCoarseCellConn(const ExaMesh& coarse, emInt cell,
+		int& nCorners) {
+	if (cell < coarse.numTets()) {
+		nCorners = 4;
+		return coarse.getTetConn(cell);
+	}
+	cell -= coarse.numTets();
+	if (cell < coarse.numPyramids()) {
+		nCorners = 5;
+		return coarse.getPyrConn(cell);
+	}
+	cell -= coarse.numPyramids();
+	if (cell < coarse.numPrisms()) {
+		nCorners = 6;
+		return coarse.getPrismConn(cell);
+	}
+	cell -= coarse.numPrisms();
+	assert(cell < coarse.numHexes());
+	nCorners = 8;
+	return coarse.getHexConn(cell);
+}
+
+int ParentMapVisitor::getParentEntity(const ExaMesh& coarse,
+		const emInt vert, emInt corners[8]) const {
+	const emInt parent = m_vertParent[vert];
+	if (parent == EMINT_MAX) return 0;
+	int nCorners;
+	const emInt *conn = getCoarseCellConn(coarse, parent, nCorners);
+	double weights[8];
+	getQ1Weights(nCorners, getVertParamCoords(vert), weights);
+	int nEntityCorners = 0;
+	for (int cc = 0; cc < nCorners; cc++) {
+		if (fabs(weights[cc]) < 1.e-12) continue;
+		corners[nEntityCorners++] = conn[cc];
+	}
+	return nEntityCorners;
+}
+
+bool ParentMapVisitor::getProlongation(const ExaMesh& coarse,
+		CSRMatrix& P) const {
+	if (coarse.getDefaultMappingType() != Mapping::Uniform) {
+		fprintf(stderr, "Prolongation is only for meshes with straight-sided "
+						"cells.\n");
+		return false;
+	}
+	P.nRows = m_vertParent.size();
+	P.nCols = coarse.numVertsToCopy();
+	P.rowStart.assign(1, 0);
+	P.rowStart.reserve(size_t(P.nRows) + 1);
+	P.cols.clear();
+	P.values.clear();
+	for (emInt vv = 0; vv < P.nRows; vv++) {
+		const emInt parent = m_vertParent[vv];
+		if (parent == EMINT_MAX) {
+			assert(vv < P.nCols);
+			P.cols.push_back(vv);
+			P.values.push_back(1);
+		}
+		else {
+			int nCorners;
+			const emInt *conn = getCoarseCellConn(coarse, parent, nCorners);
+			double weights[8];
+			getQ1Weights(nCorners, getVertParamCoords(vv), weights);
+			// Verts on coarse edges and faces only depend on their corners,
+			// once roundoff in the other weights is dropped.
+			for (int cc = 0; cc < nCorners; cc++) {
+				if (fabs(weights[cc]) < 1.e-12) continue;
+				P.cols.push_back(conn[cc]);
+				P.values.push_back(weights[cc]);
+			}
+		}
+		P.rowStart.push_back(P.cols.size());
+	}
+	return true;
+}
@@ -0,0 +1,112 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * ParentMapVisitor.h
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#ifndef SRC_PARENTMAPVISITOR_H_
+#define SRC_PARENTMAPVISITOR_H_
+
+#include <vector>
+
+#include "ExaMesh.h"
+
+// A sparse matrix in compressed row form.
+struct CSRMatrix {
+	emInt nRows, nCols;
+	// Row rr has entries rowStart[rr] through rowStart[rr + 1] - 1.
+	std::vector<size_t> rowStart;
+	std::vector<emInt> cols;
+	std::vector<double> values;
+};
+
+// Records where each fine cell and vert came from while a mesh is being
+// refined, for transfers between levels in multigrid.  Cells and coarse
+// cells are numbered as in numCells order:  tets, then pyramids, prisms and
+// hexes.  A fine vert's parent is the coarse cell that created it, with its
+// param coords in that cell; verts on coarse edges and faces are created by
+// the first cell that has them.  Coarse verts keep their indices and have
+// no parent cell.
+//
+// Which coarse edge or face a fine vert lies on comes from its param coords,
+// which are on the matching edge or face of the parent's reference cell.
+// getParentEntity does this:  the corners of the parent with nonzero Q1
+// weights there are the two ends of the coarse edge, or the three or four
+// corners of the coarse face, or all the parent's corners for a vert inside
+// it.  Those corners name the entity whichever of its cells was the parent.
+//
+// Everything is passed on to another visitor, if there is one.
+class ParentMapVisitor: public RefineVisitor {
+	RefineVisitor *m_next;
+	emInt m_firstCell[4], m_cellCount[4];
+	std::vector<emInt> m_cellParent, m_vertParent;
+	std::vector<double> m_vertUVW;
+
+	ParentMapVisitor(const ParentMapVisitor&);
+	ParentMapVisitor& operator=(const ParentMapVisitor&);
+public:
+	// The sizes are those of the fine mesh, as from computeFineMeshSize.
+	ParentMapVisitor(const MeshSize& fine, RefineVisitor *next = nullptr);
+	virtual ~ParentMapVisitor() {
+	}
+	virtual void onVerts(const emInt firstVert, const emInt count,
+			const double coords[][3]);
+	virtual void onCells(const emInt coarseCell, const int type,
+			const emInt count, const emInt conn[]);
+	virtual void onBdryFaces(const emInt coarseFace, const int type,
+			const emInt count, const emInt conn[]);
+	virtual void onDone();
+	virtual bool wantsVertParents() const {
+		return true;
+	}
+	virtual void onVertParents(const emInt firstVert, const emInt count,
+			const emInt coarseCell, const double uvw[][3]);
+
+	// Parent coarse cell of each fine cell.
+	const std::vector<emInt>& getCellParents() const {
+		return m_cellParent;
+	}
+	// Parent coarse cell of each fine vert, or EMINT_MAX for a coarse vert.
+	const std::vector<emInt>& getVertParents() const {
+		return m_vertParent;
+	}
+	// Param coords of fine vert vert in its parent.
+	const double* getVertParamCoords(const emInt vert) const {
+		return &m_vertUVW[3 * size_t(vert)];
+	}
+
+	// The corners of the coarse edge, face or cell that fine vert vert lies
+	// inside, as above.  Returns how many there are, or zero for a coarse
+	// vert.  The coarse mesh must be the one that was refined.
+	int getParentEntity(const ExaMesh& coarse, const emInt vert,
+			emInt corners[8]) const;
+
+	// Linear interpolation from coarse verts to fine verts, with one row per
+	// fine vert and one column per coarse vert, using the Q1 shape functions
+	// of each parent cell.  The coarse mesh must be the one that was refined.
+	// That's only how the fine verts were placed if the coarse mesh has
+	// straight-sided cells, so anything else (a cubic Lagrange mesh) is
+	// refused, returning false.
+	bool getProlongation(const ExaMesh& coarse, CSRMatrix& P) const;
+};
+
+#endif /* SRC_PARENTMAPVISITOR_H_ */
@@ -25,18 +25,6 @@
 
 #include "PrismDivider.h"
 
-void PrismDivider::setupCoordMapping(const emInt verts[]) {
-	for (int ii = 0; ii < 6; ii++) {
-		cellVerts[ii] = verts[ii];
-	}
-	m_Map->setupCoordMapping(verts);
-}
-
-void PrismDivider::getPhysCoordsFromParamCoords(const double uvw[3],
-		double xyz[3]) {
-	m_Map->computeTransformedCoords(uvw, xyz);
-}
-
 //
 //void PrismDivider::setupCoordMapping(const emInt verts[]) {
 //	for (int ii = 0; ii < 6; ii++) {
@@ -121,7 +109,58 @@ void PrismDivider::getPhysCoordsFromParamCoords(const double uvw[3],
 ////	}   // Done looping over all levels for the prism.
 //}
 //
+template<typename MapT>
+void PrismDivider::divideInterior(const MapT& map) {
+	switch (nDivs) {
+		case 2:
+			divideInteriorFixed<2, PrismShape>(map);
+			break;
+		case 3:
+			divideInteriorFixed<3, PrismShape>(map);
+			break;
+		case 4:
+			divideInteriorFixed<4, PrismShape>(map);
+			break;
+		case 8:
+			divideInteriorFixed<8, PrismShape>(map);
+			break;
+		default:
+			CellDivider::divideInterior(map);
+			break;
+	}
+}
+
+template<int N>
+void PrismDivider::createNewCellsFixed() {
+	assert(nDivs == N);
+	static constexpr PrismChildTable<N> table;
+	const emInt* const verts = &localVerts[0][0][0];
+	emInt (*newPrisms)[6] = m_pMesh->reservePrisms(table.count);
+	for (int cc = 0; cc < table.count; cc++) {
+		for (int vv = 0; vv < 6; vv++) {
+			newPrisms[cc][vv] = verts[table.conn[cc][vv]];
+		}
+	}
+}
+
 void PrismDivider::createNewCells() {
+	switch (nDivs) {
+		case 2:
+			createNewCellsFixed<2>();
+			return;
+		case 3:
+			createNewCellsFixed<3>();
+			return;
+		case 4:
+			createNewCellsFixed<4>();
+			return;
+		case 8:
+			createNewCellsFixed<8>();
+			return;
+		default:
+			break;
+	}
+
 	// Output info about the points for this Prism, layer by layer
 //	double newVol = 0;
 //	for (int level = 0; level <= nDivs; level++) {
@@ -172,3 +211,7 @@ void PrismDivider::createNewCells() {
   }   // Done with this level
 //	logMessage(MSG_MANAGER, "  final volume: %G\n", newVol);
 }
+
+template void PrismDivider::divideInterior(const Q1PrismMapping& map);
+template void PrismDivider::divideInterior(
+		const LagrangeCubicPrismMapping& map);
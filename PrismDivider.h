@@ -33,10 +33,7 @@ class PrismDivider: public CellDivider {
 	double xyzOffsetBot[3], uVecBot[3], vVecBot[3];
 	double xyzOffsetTop[3], uVecTop[3], vVecTop[3];
 public:
-	PrismDivider(UMesh *pVolMesh, const ExaMesh* const pInitMesh,
-			const int segmentsPerEdge,
-			const Mapping::MappingType type = Mapping::Invalid)
-:
+	PrismDivider(UMesh *pVolMesh, const int segmentsPerEdge) :
 			CellDivider(pVolMesh, segmentsPerEdge) {
     vertIJK[0][0] = 0;
     vertIJK[0][1] = 0;
@@ -162,31 +159,22 @@ public:
 		faceEdgeIndices[4][0] = 4;
 		faceEdgeIndices[4][1] = 3;
 		faceEdgeIndices[4][2] = 5;
-
-		Mapping::MappingType myType = type;
-		if (myType == Mapping::Invalid) {
-			myType = pInitMesh->getDefaultMappingType();
-		}
-		switch (myType) {
-		case Mapping::Lagrange:
-			m_Map = new LagrangeCubicPrismMapping(pInitMesh);
-			break;
-		case Mapping::Uniform:
-		default:
-			m_Map = new Q1PrismMapping(pInitMesh);
-			break;
-		}
 	}
 	~PrismDivider() {
 	}
-//	virtual void divideInterior();
+	template<typename MapT> void divideInterior(const MapT& map);
 	virtual void createNewCells();
-	void setupCoordMapping(const emInt verts[]);
-	void getPhysCoordsFromParamCoords(const double uvw[], double xyz[]);
+	// Table-driven versions for the common numbers of divisions.
+	template<int N> void createNewCellsFixed();
+	// New cells come from the topology alone.
+	static constexpr bool newCellsNeedCoords = false;
 
 	virtual int maxI(const int j, const int /*k*/) const {return nDivs - j;}
 	virtual int maxJ(const int i, const int /*k*/) const {return nDivs - i;}
 
 };
 
+typedef MappedDivider<PrismDivider, Q1PrismMapping> Q1PrismDivider;
+typedef MappedDivider<PrismDivider, LagrangeCubicPrismMapping> CubicPrismDivider;
+
 #endif /* APPS_EXAMESH_PRISMDIVIDER_H_ */
@@ -26,18 +26,6 @@
 #include "GeomUtils.h"
 #include "PyrDivider.h"
 
-void PyrDivider::setupCoordMapping(const emInt verts[]) {
-	for (int ii = 0; ii < 5; ii++) {
-		cellVerts[ii] = verts[ii];
-	}
-	m_Map->setupCoordMapping(verts);
-}
-
-void PyrDivider::getPhysCoordsFromParamCoords(const double uvw[3],
-		double xyz[3]) {
-	m_Map->computeTransformedCoords(uvw, xyz);
-}
-
 //void PyrDivider::setupCoordMapping(const emInt verts[]) {
 //	for (int ii = 0; ii < 5; ii++) {
 //		cellVerts[ii] = verts[ii];
@@ -32,10 +32,7 @@
 class PyrDivider: public CellDivider {
 	double xyzOffset[3], uVec[3], vVec[3], uvVec[3], xyzApex[3];
 public:
-	PyrDivider(UMesh *pVolMesh, const ExaMesh* const pInitMesh,
-			const int segmentsPerEdge,
-			const Mapping::MappingType type = Mapping::Invalid)
-      :
+	PyrDivider(UMesh *pVolMesh, const int segmentsPerEdge) :
 			CellDivider(pVolMesh, segmentsPerEdge) {
     vertIJK[0][0] = 0;
     vertIJK[0][1] = 0;
@@ -146,27 +143,11 @@ public:
 		faceEdgeIndices[4][0] = 7;
 		faceEdgeIndices[4][1] = 2;
 		faceEdgeIndices[4][2] = 1;
-
-		Mapping::MappingType myType = type;
-		if (myType == Mapping::Invalid) {
-			myType = pInitMesh->getDefaultMappingType();
-		}
-		switch (myType) {
-		case Mapping::Lagrange:
-			m_Map = new LagrangeCubicPyramidMapping(pInitMesh);
-			break;
-		case Mapping::Uniform:
-		default:
-			m_Map = new Q1PyramidMapping(pInitMesh);
-			break;
-		}
   }
 	~PyrDivider() {
 	}
 //	void divideInterior();
   void createNewCells();
-	void setupCoordMapping(const emInt verts[]);
-	void getPhysCoordsFromParamCoords(const double uvw[], double xyz[]);
 
 	virtual int maxI(const int /*j*/, const int k) const {return nDivs - k;}
 	virtual int maxJ(const int /*i*/, const int k) const {return nDivs - k;}
@@ -175,4 +156,7 @@ public:
 	}
 };
 
+typedef MappedDivider<PyrDivider, Q1PyramidMapping> Q1PyrDivider;
+typedef MappedDivider<PyrDivider, LagrangeCubicPyramidMapping> CubicPyrDivider;
+
 #endif /* APPS_EXAMESH_PYRDIVIDER_H_ */
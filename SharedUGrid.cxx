@@ -0,0 +1,635 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * SharedUGrid.cxx
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "ByteOrder.h"
+#include "exa-defs.h"
+#include "Instrument.h"
+#include "SharedUGrid.h"
+
+#if (HAVE_CGNS == 1)
+#include <cgnslib.h>
+
+#define CHECK_STATUS if (status != CG_OK) cg_error_exit()
+#endif
+
+enum {
+	eCoords = 0, eTriConn, eQuadConn, eTriBC, eQuadBC, eTetConn, ePyrConn,
+	ePrismConn, eHexConn
+};
+
+static int triInteriorVerts(const int n) {
+	return (n - 1) * (n - 2) / 2;
+}
+
+static int quadInteriorVerts(const int n) {
+	return (n - 1) * (n - 1);
+}
+
+static bool writeAt(const int fd, const void* data, size_t bytes,
+		off_t offset) {
+	const char* ptr = static_cast<const char*>(data);
+	while (bytes > 0) {
+		ssize_t written = pwrite(fd, ptr, bytes, offset);
+		if (written < 0) {
+			if (errno == EINTR) continue;
+			fprintf(stderr, "Write to shared UGRID file failed: %s\n",
+							strerror(errno));
+			return false;
+		}
+		instrumentCount(eCountBytesWritten, written);
+		ptr += written;
+		bytes -= written;
+		offset += written;
+	}
+	return true;
+}
+
+// Copy the coords of some verts of a fine mesh to consecutive places in the
+// file, starting with global vert firstVert.
+template<typename T>
+static bool writeCoordsAs(const int fd, const UMesh& fine, const emInt verts[],
+		const size_t nVerts, const size_t coordsOffset, const emInt firstVert,
+		const bool swapBytes) {
+	if (nVerts == 0) return true;
+	std::vector<T> coords(3 * nVerts);
+	for (size_t ii = 0; ii < nVerts; ii++) {
+		double xyz[3];
+		fine.getCoords(verts[ii], xyz);
+		coords[3 * ii] = xyz[0];
+		coords[3 * ii + 1] = xyz[1];
+		coords[3 * ii + 2] = xyz[2];
+	}
+	if (swapBytes) swapByteOrder<sizeof(T)>(coords.data(), coords.size());
+	return writeAt(fd, coords.data(), coords.size() * sizeof(T),
+									coordsOffset + 3 * sizeof(T) * size_t(firstVert));
+}
+
+static bool writeCoords(const int fd, const UMesh& fine, const emInt verts[],
+		const size_t nVerts, const size_t coordsOffset, const emInt firstVert,
+		const int coordBytes, const bool swapBytes) {
+	if (coordBytes == sizeof(float)) {
+		return writeCoordsAs<float>(fd, fine, verts, nVerts, coordsOffset,
+																firstVert, swapBytes);
+	}
+	return writeCoordsAs<double>(fd, fine, verts, nVerts, coordsOffset,
+															firstVert, swapBytes);
+}
+
+typedef const emInt* (UMesh::*ConnGetter)(const emInt) const;
+
+// Write connectivity for nEnts entities, converting to global, 1-based vert
+// indices on the way.  UGRID pyramids have verts 2 and 4 switched compared
+// with ours; see UMesh::writeUGridFile.
+static bool writeConnectivity(const int fd, const UMesh& fine,
+		ConnGetter getConn, const emInt nEnts, const int nPts,
+		const std::vector<emInt>& globalVerts, const bool isPyramid,
+		const size_t offset, const bool swapBytes) {
+	const emInt chunk = 65536;
+	std::vector<emInt> buffer;
+	buffer.reserve(size_t(chunk) * nPts);
+	for (emInt first = 0; first < nEnts; first += chunk) {
+		emInt last = std::min(nEnts, first + chunk);
+		buffer.clear();
+		for (emInt ii = first; ii < last; ii++) {
+			const emInt* conn = (fine.*getConn)(ii);
+			for (int jj = 0; jj < nPts; jj++) {
+				buffer.push_back(globalVerts[conn[jj]] + 1);
+			}
+			if (isPyramid) {
+				std::swap(buffer[buffer.size() - 3], buffer[buffer.size() - 1]);
+			}
+		}
+		if (swapBytes) swapByteOrder<sizeof(emInt)>(buffer.data(), buffer.size());
+		if (!writeAt(fd, buffer.data(), buffer.size() * sizeof(emInt),
+									offset + size_t(first) * nPts * sizeof(emInt))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+SharedUGridLayout::SharedUGridLayout(const emInt nDivs, const emInt nParts,
+		const UGridFormat& format) :
+		m_nDivs(nDivs), m_format(format),
+				m_swapBytes(format.bigEndian != hostIsBigEndian()),
+				m_partSizes(nParts, MeshSize()),
+				m_partStarts(nParts, MeshSize()), m_total(MeshSize()),
+				m_nSharedVerts(0), m_cgnsBase(0), m_cgnsZone(0), m_cgnsSections {
+						0, 0, 0, 0, 0, 0 } {
+}
+
+void SharedUGridLayout::addPart(const emInt part,
+		const ExaMesh& coarsePart) {
+	assert(coarsePart.isPartMesh());
+	const int n = m_nDivs;
+
+	MeshSize MSIn, MSOut;
+	MSIn.nBdryVerts = coarsePart.numBdryVerts();
+	MSIn.nVerts = coarsePart.numVertsToCopy();
+	MSIn.nBdryTris = coarsePart.numBdryTris();
+	MSIn.nBdryQuads = coarsePart.numBdryQuads();
+	MSIn.nTets = coarsePart.numTets();
+	MSIn.nPyrs = coarsePart.numPyramids();
+	MSIn.nPrisms = coarsePart.numPrisms();
+	MSIn.nHexes = coarsePart.numHexes();
+	bool sizesOK = ::computeMeshSize(MSIn, n, MSOut);
+	if (!sizesOK) exit(2);
+
+	// Find all the coarse entities this part shares with others.  Those are
+	// exactly the ones on its part bdry faces.
+	std::set<emInt> verts;
+	std::set<std::pair<emInt, emInt> > edges;
+	std::vector<std::vector<emInt> > tris, quads;
+	emInt nRealTris = 0, nRealQuads = 0;
+	for (emInt ii = 0; ii < coarsePart.numBdryTris(); ii++) {
+		if (!coarsePart.isPartBdryTri(ii)) {
+			nRealTris++;
+			continue;
+		}
+		const emInt* conn = coarsePart.getBdryTriConn(ii);
+		emInt corners[3];
+		for (int cc = 0; cc < 3; cc++) {
+			corners[cc] = coarsePart.getGlobalVert(conn[cc]);
+			verts.insert(corners[cc]);
+		}
+		for (int cc = 0; cc < 3; cc++) {
+			emInt v0 = corners[cc], v1 = corners[(cc + 1) % 3];
+			edges.insert(std::make_pair(std::min(v0, v1), std::max(v0, v1)));
+		}
+		tris.push_back(triFaceKey(corners));
+	}
+	for (emInt ii = 0; ii < coarsePart.numBdryQuads(); ii++) {
+		if (!coarsePart.isPartBdryQuad(ii)) {
+			nRealQuads++;
+			continue;
+		}
+		const emInt* conn = coarsePart.getBdryQuadConn(ii);
+		emInt corners[4];
+		for (int cc = 0; cc < 4; cc++) {
+			corners[cc] = coarsePart.getGlobalVert(conn[cc]);
+			verts.insert(corners[cc]);
+		}
+		for (int cc = 0; cc < 4; cc++) {
+			emInt v0 = corners[cc], v1 = corners[(cc + 1) % 4];
+			edges.insert(std::make_pair(std::min(v0, v1), std::max(v0, v1)));
+		}
+		quads.push_back(quadFaceKey(corners));
+	}
+
+	size_t nShared = verts.size() + edges.size() * (n - 1)
+			+ tris.size() * triInteriorVerts(n) + quads.size() * quadInteriorVerts(n);
+	size_t nFineVerts = coarsePart.countFineVerts(n);
+	assert(nShared <= nFineVerts);
+
+	MeshSize& PS = m_partSizes[part];
+	PS.nBdryVerts = nFineVerts;
+	PS.nVerts = nFineVerts - nShared;
+	PS.nBdryTris = nRealTris * n * n;
+	PS.nBdryQuads = nRealQuads * n * n;
+	PS.nTets = MSOut.nTets;
+	PS.nPyrs = MSOut.nPyrs;
+	PS.nPrisms = MSOut.nPrisms;
+	PS.nHexes = MSOut.nHexes;
+
+#pragma omp critical(sharedUGridLayout)
+	{
+		for (auto vert : verts) {
+			mergeEntity(m_verts[vert], part);
+		}
+		for (auto& edge : edges) {
+			mergeEntity(m_edges[edge], part);
+		}
+		for (auto& tri : tris) {
+			mergeEntity(m_tris[tri], part);
+		}
+		for (auto& quad : quads) {
+			mergeEntity(m_quads[quad], part);
+		}
+	}
+}
+
+void SharedUGridLayout::finalize() {
+	const int n = m_nDivs;
+	size_t next = 0;
+	for (auto& vert : m_verts) {
+		vert.second.firstVert = next;
+		next++;
+	}
+	for (auto& edge : m_edges) {
+		edge.second.firstVert = next;
+		next += n - 1;
+	}
+	for (auto& tri : m_tris) {
+		tri.second.firstVert = next;
+		next += triInteriorVerts(n);
+	}
+	for (auto& quad : m_quads) {
+		quad.second.firstVert = next;
+		next += quadInteriorVerts(n);
+	}
+	m_nSharedVerts = next;
+
+	// Use 64-bit sums, so that overflow can be caught.
+	size_t totals[7] = { next, 0, 0, 0, 0, 0, 0 };
+	for (emInt part = 0; part < m_partSizes.size(); part++) {
+		const MeshSize& PS = m_partSizes[part];
+		MeshSize& start = m_partStarts[part];
+		start.nBdryVerts = 0;
+		start.nVerts = totals[0];
+		start.nBdryTris = totals[1];
+		start.nBdryQuads = totals[2];
+		start.nTets = totals[3];
+		start.nPyrs = totals[4];
+		start.nPrisms = totals[5];
+		start.nHexes = totals[6];
+		totals[0] += PS.nVerts;
+		totals[1] += PS.nBdryTris;
+		totals[2] += PS.nBdryQuads;
+		totals[3] += PS.nTets;
+		totals[4] += PS.nPyrs;
+		totals[5] += PS.nPrisms;
+		totals[6] += PS.nHexes;
+	}
+	for (int ii = 0; ii < 7; ii++) {
+		if (totals[ii] > EMINT_MAX) {
+			fprintf(stderr, "Output mesh will exceed max index size!\n");
+			exit(2);
+		}
+	}
+	m_total.nBdryVerts = 0;
+	m_total.nVerts = totals[0];
+	m_total.nBdryTris = totals[1];
+	m_total.nBdryQuads = totals[2];
+	m_total.nTets = totals[3];
+	m_total.nPyrs = totals[4];
+	m_total.nPrisms = totals[5];
+	m_total.nHexes = totals[6];
+}
+
+size_t SharedUGridLayout::getSectionOffset(const int section) const {
+	// Every offset into a shared file goes through here.
+	assert(!m_format.fortranRecords);
+	const size_t intSize = sizeof(emInt);
+	size_t sizes[] = {
+			3 * size_t(m_format.coordBytes) * m_total.nVerts,
+			3 * intSize * m_total.nBdryTris,
+			4 * intSize * m_total.nBdryQuads,
+			intSize * m_total.nBdryTris,
+			intSize * m_total.nBdryQuads,
+			4 * intSize * m_total.nTets,
+			5 * intSize * m_total.nPyrs,
+			6 * intSize * m_total.nPrisms,
+			8 * intSize * m_total.nHexes };
+	size_t offset = 7 * intSize;
+	for (int ii = 0; ii < section; ii++) {
+		offset += sizes[ii];
+	}
+	return offset;
+}
+
+size_t SharedUGridLayout::getFileSize() const {
+	return getSectionOffset(eHexConn + 1);
+}
+
+bool SharedUGridLayout::writeHeader(const int fd) const {
+	assert(!m_format.fortranRecords);
+	emInt header[] = { m_total.nVerts, m_total.nBdryTris, m_total.nBdryQuads,
+			m_total.nTets, m_total.nPyrs, m_total.nPrisms, m_total.nHexes };
+	if (m_swapBytes) swapByteOrder<sizeof(emInt)>(header, 7);
+	return writeAt(fd, header, sizeof(header), 0);
+}
+
+bool SharedUGridLayout::getGlobalVerts(const emInt part, const UMesh& fine,
+		std::vector<emInt>& globalVerts, std::vector<emInt>& owners) const {
+	const MeshSize& PS = m_partSizes[part];
+	const MeshSize& start = m_partStarts[part];
+	if (fine.numVerts() != PS.nBdryVerts) {
+		fprintf(stderr, "Part %u has %u verts; expected %u.\n", part,
+						fine.numVerts(), PS.nBdryVerts);
+		return false;
+	}
+
+	// Verts on shared entities get the global index for the entity, and its
+	// owner.
+	globalVerts.assign(fine.numVerts(), EMINT_MAX);
+	owners.assign(fine.numVerts(), part);
+	PartBdryVerts PBV;
+	fine.getPartBdryVerts(PBV);
+	for (auto& vert : PBV.verts) {
+		const SharedEntity& SE = m_verts.at(vert.first);
+		globalVerts[vert.second] = SE.firstVert;
+		owners[vert.second] = SE.owner;
+	}
+	for (auto& edge : PBV.edges) {
+		const SharedEntity& SE = m_edges.at(edge.first);
+		for (emInt ii = 0; ii < edge.second.size(); ii++) {
+			globalVerts[edge.second[ii]] = SE.firstVert + ii;
+			owners[edge.second[ii]] = SE.owner;
+		}
+	}
+	for (auto& tri : PBV.tris) {
+		const SharedEntity& SE = m_tris.at(tri.first);
+		for (emInt ii = 0; ii < tri.second.size(); ii++) {
+			globalVerts[tri.second[ii]] = SE.firstVert + ii;
+			owners[tri.second[ii]] = SE.owner;
+		}
+	}
+	for (auto& quad : PBV.quads) {
+		const SharedEntity& SE = m_quads.at(quad.first);
+		for (emInt ii = 0; ii < quad.second.size(); ii++) {
+			globalVerts[quad.second[ii]] = SE.firstVert + ii;
+			owners[quad.second[ii]] = SE.owner;
+		}
+	}
+
+	// All the rest belong to this part alone, and go in its block, in order.
+	emInt nPrivate = 0;
+	for (emInt vv = 0; vv < fine.numVerts(); vv++) {
+		if (globalVerts[vv] == EMINT_MAX) {
+			globalVerts[vv] = start.nVerts + nPrivate;
+			nPrivate++;
+		}
+	}
+	if (nPrivate != PS.nVerts) {
+		fprintf(stderr, "Part %u has %u unshared verts; expected %u.\n", part,
+						nPrivate, PS.nVerts);
+		return false;
+	}
+	return true;
+}
+
+bool SharedUGridLayout::writeGlobalIDs(const char fileName[],
+		const emInt part, const UMesh& fine) const {
+	std::vector<emInt> globalVerts, owners;
+	if (!getGlobalVerts(part, fine, globalVerts, owners)) return false;
+
+	FILE* outFile = fopen(fileName, "wb");
+	if (!outFile) {
+		fprintf(stderr, "Couldn't open file %s for writing.  Bummer!\n", fileName);
+		return false;
+	}
+	// Same one-based indexing as the verts in a UGRID file.
+	for (auto& gv : globalVerts) {
+		gv++;
+	}
+	emInt nVerts = fine.numVerts();
+	bool OK = (fwrite(&nVerts, sizeof(emInt), 1, outFile) == 1)
+			&& (fwrite(globalVerts.data(), sizeof(emInt), nVerts, outFile) == nVerts)
+			&& (fwrite(owners.data(), sizeof(emInt), nVerts, outFile) == nVerts);
+	instrumentCount(eCountBytesWritten, ftell(outFile));
+	fclose(outFile);
+	if (!OK) {
+		fprintf(stderr, "Write to file %s failed.\n", fileName);
+	}
+	return OK;
+}
+
+bool SharedUGridLayout::writePart(const int fd, const emInt part,
+		const UMesh& fine) const {
+	ScopedTimer writeTimer(eTimeWrite);
+	const MeshSize& PS = m_partSizes[part];
+	const MeshSize& start = m_partStarts[part];
+	std::vector<emInt> globalVerts, owners;
+	if (!getGlobalVerts(part, fine, globalVerts, owners)) return false;
+	assert(fine.numBdryTris() >= PS.nBdryTris);
+	assert(fine.numBdryQuads() >= PS.nBdryQuads);
+	assert(fine.numTets() == PS.nTets && fine.numPyramids() == PS.nPyrs);
+	assert(fine.numPrisms() == PS.nPrisms && fine.numHexes() == PS.nHexes);
+
+	// Each part writes coords only for the verts it owns.  Sorting those by
+	// global index turns them into a few long runs: the part's private block,
+	// plus one run per owned shared entity.
+	std::vector<std::pair<emInt, emInt> > owned;
+	owned.reserve(fine.numVerts());
+	for (emInt vv = 0; vv < fine.numVerts(); vv++) {
+		if (owners[vv] == part) {
+			owned.push_back(std::make_pair(globalVerts[vv], vv));
+		}
+	}
+	std::sort(owned.begin(), owned.end());
+	const size_t coordsOffset = getSectionOffset(eCoords);
+	std::vector<emInt> run;
+	bool OK = true;
+	for (size_t ii = 0; ii < owned.size(); ii++) {
+		run.push_back(owned[ii].second);
+		if (ii + 1 == owned.size() || owned[ii + 1].first != owned[ii].first + 1) {
+			OK = OK && writeCoords(fd, fine, run.data(), run.size(), coordsOffset,
+															owned[ii].first + 1 - run.size(),
+															m_format.coordBytes, m_swapBytes);
+			run.clear();
+		}
+	}
+
+	// Real bdry faces come first in the fine mesh, because they came first in
+	// the coarse part; the part bdry faces after them aren't written.  BCs
+	// are all zero, which the preallocated file already has.
+	OK = OK && writeConnectivity(fd, fine, &UMesh::getBdryTriConn, PS.nBdryTris,
+																3, globalVerts, false,
+																getSectionOffset(eTriConn)
+																+ 3 * sizeof(emInt) * size_t(start.nBdryTris), m_swapBytes);
+	OK = OK && writeConnectivity(fd, fine, &UMesh::getBdryQuadConn,
+																PS.nBdryQuads, 4, globalVerts, false,
+																getSectionOffset(eQuadConn)
+																+ 4 * sizeof(emInt) * size_t(start.nBdryQuads), m_swapBytes);
+	OK = OK && writeConnectivity(fd, fine, &UMesh::getTetConn, PS.nTets, 4,
+																globalVerts, false,
+																getSectionOffset(eTetConn)
+																+ 4 * sizeof(emInt) * size_t(start.nTets), m_swapBytes);
+	OK = OK && writeConnectivity(fd, fine, &UMesh::getPyrConn, PS.nPyrs, 5,
+																globalVerts, true,
+																getSectionOffset(ePyrConn)
+																+ 5 * sizeof(emInt) * size_t(start.nPyrs), m_swapBytes);
+	OK = OK && writeConnectivity(fd, fine, &UMesh::getPrismConn, PS.nPrisms, 6,
+																globalVerts, false,
+																getSectionOffset(ePrismConn)
+																+ 6 * sizeof(emInt) * size_t(start.nPrisms), m_swapBytes);
+	OK = OK && writeConnectivity(fd, fine, &UMesh::getHexConn, PS.nHexes, 8,
+																globalVerts, false,
+																getSectionOffset(eHexConn)
+																+ 8 * sizeof(emInt) * size_t(start.nHexes), m_swapBytes);
+	return OK;
+}
+
+#if (HAVE_CGNS == 1)
+// Sections in the zone, in the order their elements are numbered.
+enum {
+	eCGNSTets = 0, eCGNSPyrs, eCGNSPrisms, eCGNSHexes, eCGNSTris, eCGNSQuads
+};
+
+bool SharedUGridLayout::writeCGNSHeader(const int indexFile,
+		const int indexBase) {
+	int status;
+	cgsize_t nCells = cgsize_t(m_total.nTets) + m_total.nPyrs + m_total.nPrisms
+			+ m_total.nHexes;
+	cgsize_t zoneSize[] = { cgsize_t(m_total.nVerts), nCells, 0 };
+	m_cgnsBase = indexBase;
+	status = cg_zone_write(indexFile, indexBase, "Zone", zoneSize,
+													CGNS_ENUMV(Unstructured), &m_cgnsZone);
+	CHECK_STATUS;
+
+	// Every section is created at full size, even if it's empty, so that a
+	// part's range in it can be found without knowing what's there.
+	const char* names[] = { "Tets", "Pyramids", "Prisms", "Hexes", "BdryTris",
+			"BdryQuads" };
+	const ElementType_t types[] = { CGNS_ENUMV(TETRA_4), CGNS_ENUMV(PYRA_5),
+			CGNS_ENUMV(PENTA_6), CGNS_ENUMV(HEXA_8), CGNS_ENUMV(TRI_3),
+			CGNS_ENUMV(QUAD_4) };
+	const emInt counts[] = { m_total.nTets, m_total.nPyrs, m_total.nPrisms,
+			m_total.nHexes, m_total.nBdryTris, m_total.nBdryQuads };
+	cgsize_t nextElement = 1;
+	for (int ss = 0; ss < 6; ss++) {
+		m_cgnsSections[ss] = 0;
+		if (counts[ss] == 0) continue;
+		status = cg_section_partial_write(indexFile, indexBase, m_cgnsZone,
+																			names[ss], types[ss], nextElement,
+																			nextElement + counts[ss] - 1, 0,
+																			&m_cgnsSections[ss]);
+		CHECK_STATUS;
+		nextElement += counts[ss];
+	}
+	return true;
+}
+
+// Converts to global, 1-based vert indices a chunk at a time; only the
+// library calls themselves are serialized.
+static void writeCGNSElements(const int indexFile, const int indexBase,
+		const int indexZone, const int indexSection, const UMesh& fine,
+		ConnGetter getConn, const emInt nEnts, const int nPts,
+		const std::vector<emInt>& globalVerts, const cgsize_t firstElement) {
+	if (nEnts == 0) return;
+	const emInt chunk = 65536;
+	std::vector<cgsize_t> buffer;
+	buffer.reserve(size_t(chunk) * nPts);
+	for (emInt first = 0; first < nEnts; first += chunk) {
+		emInt last = std::min(nEnts, first + chunk);
+		buffer.clear();
+		for (emInt ii = first; ii < last; ii++) {
+			const emInt* conn = (fine.*getConn)(ii);
+			for (int jj = 0; jj < nPts; jj++) {
+				buffer.push_back(cgsize_t(globalVerts[conn[jj]]) + 1);
+			}
+		}
+		int status;
+#pragma omp critical(cgnsWrite)
+		{
+			status = cg_elements_partial_write(indexFile, indexBase, indexZone,
+																					indexSection, firstElement + first,
+																					firstElement + last - 1,
+																					buffer.data());
+			CHECK_STATUS;
+		}
+	}
+}
+
+bool SharedUGridLayout::writeCGNSPart(const int indexFile, const emInt part,
+		const UMesh& fine) const {
+	ScopedTimer writeTimer(eTimeWrite);
+	const MeshSize& PS = m_partSizes[part];
+	const MeshSize& start = m_partStarts[part];
+	std::vector<emInt> globalVerts, owners;
+	if (!getGlobalVerts(part, fine, globalVerts, owners)) return false;
+	assert(fine.numBdryTris() >= PS.nBdryTris);
+	assert(fine.numBdryQuads() >= PS.nBdryQuads);
+	assert(fine.numTets() == PS.nTets && fine.numPyramids() == PS.nPyrs);
+	assert(fine.numPrisms() == PS.nPrisms && fine.numHexes() == PS.nHexes);
+
+	// Owned verts go out in runs of consecutive global indices, as for UGRID.
+	std::vector<std::pair<emInt, emInt> > owned;
+	owned.reserve(fine.numVerts());
+	for (emInt vv = 0; vv < fine.numVerts(); vv++) {
+		if (owners[vv] == part) {
+			owned.push_back(std::make_pair(globalVerts[vv], vv));
+		}
+	}
+	std::sort(owned.begin(), owned.end());
+	const char* coordNames[] = { "CoordinateX", "CoordinateY", "CoordinateZ" };
+	std::vector<double> run[3];
+	for (size_t ii = 0; ii < owned.size(); ii++) {
+		double coords[3];
+		fine.getCoords(owned[ii].second, coords);
+		for (int dd = 0; dd < 3; dd++) {
+			run[dd].push_back(coords[dd]);
+		}
+		if (ii + 1 == owned.size() || owned[ii + 1].first != owned[ii].first + 1) {
+			cgsize_t rmax = cgsize_t(owned[ii].first) + 1;
+			cgsize_t rmin = rmax + 1 - cgsize_t(run[0].size());
+			int status, indexCoord;
+#pragma omp critical(cgnsWrite)
+			{
+				for (int dd = 0; dd < 3; dd++) {
+					status = cg_coord_partial_write(indexFile, m_cgnsBase, m_cgnsZone,
+																					CGNS_ENUMV(RealDouble),
+																					coordNames[dd], &rmin, &rmax,
+																					run[dd].data(), &indexCoord);
+					CHECK_STATUS;
+				}
+			}
+			for (int dd = 0; dd < 3; dd++) {
+				run[dd].clear();
+			}
+		}
+	}
+
+	// Element numbers run on from one section to the next.  As in the UGRID
+	// layout, part bdry faces aren't written.
+	const cgsize_t firstTet = 1;
+	const cgsize_t firstPyr = firstTet + m_total.nTets;
+	const cgsize_t firstPrism = firstPyr + m_total.nPyrs;
+	const cgsize_t firstHex = firstPrism + m_total.nPrisms;
+	const cgsize_t firstTri = firstHex + m_total.nHexes;
+	const cgsize_t firstQuad = firstTri + m_total.nBdryTris;
+	writeCGNSElements(indexFile, m_cgnsBase, m_cgnsZone,
+										m_cgnsSections[eCGNSTets], fine, &UMesh::getTetConn,
+										PS.nTets, 4, globalVerts, firstTet + start.nTets);
+	writeCGNSElements(indexFile, m_cgnsBase, m_cgnsZone,
+										m_cgnsSections[eCGNSPyrs], fine, &UMesh::getPyrConn,
+										PS.nPyrs, 5, globalVerts, firstPyr + start.nPyrs);
+	writeCGNSElements(indexFile, m_cgnsBase, m_cgnsZone,
+										m_cgnsSections[eCGNSPrisms], fine, &UMesh::getPrismConn,
+										PS.nPrisms, 6, globalVerts, firstPrism + start.nPrisms);
+	writeCGNSElements(indexFile, m_cgnsBase, m_cgnsZone,
+										m_cgnsSections[eCGNSHexes], fine, &UMesh::getHexConn,
+										PS.nHexes, 8, globalVerts, firstHex + start.nHexes);
+	writeCGNSElements(indexFile, m_cgnsBase, m_cgnsZone,
+										m_cgnsSections[eCGNSTris], fine, &UMesh::getBdryTriConn,
+										PS.nBdryTris, 3, globalVerts, firstTri + start.nBdryTris);
+	writeCGNSElements(indexFile, m_cgnsBase, m_cgnsZone,
+										m_cgnsSections[eCGNSQuads], fine, &UMesh::getBdryQuadConn,
+										PS.nBdryQuads, 4, globalVerts,
+										firstQuad + start.nBdryQuads);
+	return true;
+}
+#endif
@@ -0,0 +1,119 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * SharedUGrid.h
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+#ifndef SRC_SHAREDUGRID_H_
+#define SRC_SHAREDUGRID_H_
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "exa-defs.h"
+#include "ExaMesh.h"
+#include "UMesh.h"
+
+// Layout of a single UGRID file written by all parts of a parallel
+// refinement at once.  Each part writes its own slice of each section with
+// pwrite, so the layout has to be known before any part is refined.
+//
+// Fine verts on coarse entities shared between parts (verts, edges and faces
+// on part bdries) are numbered first, entity by entity, in order of the
+// global coarse verts that define the entity.  Any part can find their
+// global indices from the coarse entity alone.  Each part's other verts
+// follow in one block per part.  Only real bdry faces are written; part
+// bdry faces are interior to the whole mesh.
+class SharedUGridLayout {
+	struct SharedEntity {
+		// The lowest-numbered part touching an entity writes its coords.
+		emInt owner, firstVert;
+		SharedEntity() :
+				owner(EMINT_MAX), firstVert(EMINT_MAX) {
+		}
+	};
+	int m_nDivs;
+	UGridFormat m_format;
+	bool m_swapBytes;
+	std::map<emInt, SharedEntity> m_verts;
+	std::map<std::pair<emInt, emInt>, SharedEntity> m_edges;
+	std::map<std::vector<emInt>, SharedEntity> m_tris, m_quads;
+	// How much each part puts in the file, and where it starts.  nVerts is
+	// the count of verts not on shared entities; nBdryVerts is the total verts
+	// in the part's fine mesh.
+	std::vector<MeshSize> m_partSizes, m_partStarts;
+	MeshSize m_total;
+	emInt m_nSharedVerts;
+	// Where the zone and its sections are, once writeCGNSHeader has made them.
+	int m_cgnsBase, m_cgnsZone, m_cgnsSections[6];
+	SharedUGridLayout(const SharedUGridLayout&);
+	SharedUGridLayout& operator=(const SharedUGridLayout&);
+
+	size_t getSectionOffset(const int section) const;
+	void mergeEntity(SharedEntity& SE, const emInt part) {
+		SE.owner = std::min(SE.owner, part);
+	}
+public:
+	// Coords and byte order are as given by the format.  A shared file can't
+	// have Fortran records, but a layout that's only used for global vert
+	// numbering, with each part in its own file, can.  The default is b8.
+	SharedUGridLayout(const emInt nDivs, const emInt nParts,
+			const UGridFormat& format = UGridFormat { sizeof(double), true, false });
+	// Call for every part, in any order, before finalize.  Safe to call from
+	// several threads at once.
+	void addPart(const emInt part, const ExaMesh& coarsePart);
+	void finalize();
+
+	size_t getFileSize() const;
+	emInt numVerts() const {
+		return m_total.nVerts;
+	}
+	emInt numSharedVerts() const {
+		return m_nSharedVerts;
+	}
+
+	// Global (zero-based) index and owning part of every vert in a part's
+	// fine mesh.  A part owns all the verts it doesn't share, and shared
+	// verts are owned by the lowest-numbered part touching them.
+	bool getGlobalVerts(const emInt part, const UMesh& fine,
+			std::vector<emInt>& globalVerts, std::vector<emInt>& owners) const;
+	// Binary file with the vert count, then one-based global indices for all
+	// verts, then their owning parts.
+	bool writeGlobalIDs(const char fileName[], const emInt part,
+			const UMesh& fine) const;
+
+	bool writeHeader(const int fd) const;
+	bool writePart(const int fd, const emInt part, const UMesh& fine) const;
+
+#if (HAVE_CGNS == 1)
+	// The same layout as one CGNS zone: verts in the same global order, and
+	// each part's elements a contiguous range of each section.  Once the
+	// header has created the zone and its sections, parts can write their
+	// ranges in any order, from any thread.
+	bool writeCGNSHeader(const int indexFile, const int indexBase);
+	bool writeCGNSPart(const int indexFile, const emInt part,
+			const UMesh& fine) const;
+#endif
+};
+
+#endif /* SRC_SHAREDUGRID_H_ */
@@ -26,18 +26,6 @@
 #include "GeomUtils.h"
 #include "TetDivider.h"
 
-void TetDivider::setupCoordMapping(const emInt verts[]) {
-	for (int ii = 0; ii < 4; ii++) {
-		cellVerts[ii] = verts[ii];
-	}
-	m_Map->setupCoordMapping(verts);
-}
-
-void TetDivider::getPhysCoordsFromParamCoords(const double uvw[3],
-		double xyz[3]) {
-	m_Map->computeTransformedCoords(uvw, xyz);
-}
-
 //void TetDivider::divideInterior() {
 //	// Number of verts added:
 //	//    Tets:      (nD-1)(nD-2)(nD-3)/6
@@ -84,7 +72,113 @@ void TetDivider::stuffTetsIntoOctahedron(emInt vertsNew[][4]) {
 #endif
 }
 
+void TetDivider::splitOctahedron(const emInt vertA, const emInt vertB,
+		const emInt vertC, const emInt vertD, const emInt vertE,
+		const emInt vertF, emInt vertsNew[][4]) const {
+	double coordsA[3], coordsB[3], coordsC[3], coordsD[3], coordsE[3],
+			coordsF[3];
+	m_pMesh->getCoords(vertA, coordsA);
+	m_pMesh->getCoords(vertB, coordsB);
+	m_pMesh->getCoords(vertC, coordsC);
+	m_pMesh->getCoords(vertD, coordsD);
+	m_pMesh->getCoords(vertE, coordsE);
+	m_pMesh->getCoords(vertF, coordsF);
+
+	double distsqAF = dDISTSQ3D(coordsA, coordsF);
+	double distsqBD = dDISTSQ3D(coordsB, coordsD);
+	double distsqCE = dDISTSQ3D(coordsC, coordsE);
+	if (distsqAF <= distsqBD && distsqAF <= distsqCE) {
+		const emInt split[][4] = { { vertB, vertC, vertA, vertF },
+				{ vertC, vertD, vertA, vertF },
+				{ vertD, vertE, vertA, vertF },
+				{ vertE, vertB, vertA, vertF } };
+		std::copy(&split[0][0], &split[0][0] + 16, &vertsNew[0][0]);
+	}
+	else if (distsqBD <= distsqCE) {
+		const emInt split[][4] = { { vertC, vertA, vertB, vertD },
+				{ vertA, vertE, vertB, vertD },
+				{ vertE, vertF, vertB, vertD },
+				{ vertF, vertC, vertB, vertD } };
+		std::copy(&split[0][0], &split[0][0] + 16, &vertsNew[0][0]);
+	}
+	else {
+		const emInt split[][4] = { { vertA, vertB, vertC, vertE },
+				{ vertB, vertF, vertC, vertE },
+				{ vertF, vertD, vertC, vertE },
+				{ vertD, vertA, vertC, vertE } };
+		std::copy(&split[0][0], &split[0][0] + 16, &vertsNew[0][0]);
+	}
+}
+
+template<typename MapT>
+void TetDivider::divideInterior(const MapT& map) {
+	switch (nDivs) {
+		case 2:
+			divideInteriorFixed<2, TetShape>(map);
+			break;
+		case 3:
+			divideInteriorFixed<3, TetShape>(map);
+			break;
+		case 4:
+			divideInteriorFixed<4, TetShape>(map);
+			break;
+		case 8:
+			divideInteriorFixed<8, TetShape>(map);
+			break;
+		default:
+			CellDivider::divideInterior(map);
+			break;
+	}
+}
+
+template<int N>
+void TetDivider::createNewCellsFixed() {
+	assert(nDivs == N);
+	static constexpr TetChildTable<N> table;
+	const emInt* const verts = &localVerts[0][0][0];
+	emInt (*newTets)[4] = m_pMesh->reserveTets(table.count);
+	int tt = 0, ff = 0, oo = 0;
+	for (int level = 1; level <= N; level++) {
+		for (int ffEnd = ff + table.fixedInLevel(level); ff < ffEnd; ff++) {
+			for (int vv = 0; vv < 4; vv++) {
+				newTets[tt][vv] = verts[table.fixed[ff][vv]];
+			}
+			assert(checkOrient3D(newTets[tt]) == 1);
+			tt++;
+		}
+		for (int ooEnd = oo + table.octsInLevel(level); oo < ooEnd; oo++) {
+			const int* const oct = table.octs[oo];
+			splitOctahedron(verts[oct[0]], verts[oct[1]], verts[oct[2]],
+											verts[oct[3]], verts[oct[4]], verts[oct[5]],
+											newTets + tt);
+			assert(checkOrient3D(newTets[tt]) != -1);
+			assert(checkOrient3D(newTets[tt + 1]) != -1);
+			assert(checkOrient3D(newTets[tt + 2]) != -1);
+			assert(checkOrient3D(newTets[tt + 3]) != -1);
+			tt += 4;
+		}
+	}
+	assert(tt == table.count);
+}
+
 void TetDivider::createNewCells() {
+	switch (nDivs) {
+		case 2:
+			createNewCellsFixed<2>();
+			return;
+		case 3:
+			createNewCellsFixed<3>();
+			return;
+		case 4:
+			createNewCellsFixed<4>();
+			return;
+		case 8:
+			createNewCellsFixed<8>();
+			return;
+		default:
+			break;
+	}
+
 //		// Output info about the points for this tet, layer by layer
 //
 //	for (int level = 0; level <= nDivs; level++) {
@@ -152,8 +246,6 @@ void TetDivider::createNewCells() {
 		// on them, connecting them to an (up-pointing) tri the level above.
 		// There are (level)(level-1)/2 octahedra, each of which will be split
 		// into four tetrahedra.
-
-		bool useDiagAF = true, useDiagBD = false, useDiagCE = false;
 		for (int jj = 0; jj <= level - 2; jj++) {
 			for (int ii = 1; ii <= level - jj - 1; ii++) {
 				int kk = nDivs - level;
@@ -164,54 +256,14 @@ void TetDivider::createNewCells() {
 				emInt vertE = localVerts[ii][jj][kk + 1];
 				emInt vertF = localVerts[ii - 1][jj + 1][kk + 1];
 
-				double coordsA[3], coordsB[3], coordsC[3], coordsD[3], coordsE[3],
-						coordsF[3];
-				m_pMesh->getCoords(vertA, coordsA);
-				m_pMesh->getCoords(vertB, coordsB);
-				m_pMesh->getCoords(vertC, coordsC);
-				m_pMesh->getCoords(vertD, coordsD);
-				m_pMesh->getCoords(vertE, coordsE);
-				m_pMesh->getCoords(vertF, coordsF);
-
-				useDiagAF = useDiagBD = useDiagCE = false;
-				double distsqAF = dDISTSQ3D(coordsA, coordsF);
-				double distsqBD = dDISTSQ3D(coordsB, coordsD);
-				double distsqCE = dDISTSQ3D(coordsC, coordsE);
-				if (distsqAF <= distsqBD && distsqAF <= distsqCE) {
-					useDiagAF = true;
-				}
-				else if (distsqBD <= distsqCE) {
-					useDiagBD = true;
-				}
-				else {
-					useDiagCE = true;
-				}
-
-				if (useDiagAF) {
-					assert(!useDiagBD && !useDiagCE);
-					emInt vertsNew[][4] = { { vertB, vertC, vertA, vertF },
-							{ vertC, vertD, vertA, vertF },
-							{ vertD, vertE, vertA, vertF },
-							{ vertE, vertB, vertA, vertF } };
-					stuffTetsIntoOctahedron(vertsNew);
-				}
-				else if (useDiagBD) {
-					assert(!useDiagAF && !useDiagCE);
-					emInt vertsNew[][4] = { { vertC, vertA, vertB, vertD },
-							{ vertA, vertE, vertB, vertD },
-							{ vertE, vertF, vertB, vertD },
-							{ vertF, vertC, vertB, vertD } };
-					stuffTetsIntoOctahedron(vertsNew);
-				}
-				else {
-					assert(!useDiagAF && !useDiagBD);
-					emInt vertsNew[][4] = { { vertA, vertB, vertC, vertE },
-							{ vertB, vertF, vertC, vertE },
-							{ vertF, vertD, vertC, vertE },
-							{ vertD, vertA, vertC, vertE } };
-					stuffTetsIntoOctahedron(vertsNew);
-				}
+				emInt vertsNew[4][4];
+				splitOctahedron(vertA, vertB, vertC, vertD, vertE, vertF, vertsNew);
+				stuffTetsIntoOctahedron(vertsNew);
 			}
 		} // Done with octahedra
 	}   // Done with this level
 }
+
+template void TetDivider::divideInterior(const Q1TetMapping& map);
+template void TetDivider::divideInterior(
+		const LagrangeCubicTetMapping& map);
@@ -32,11 +32,7 @@
 
 class TetDivider: public CellDivider {
 public:
-	TetDivider(UMesh *pVolMesh, const ExaMesh* const pInitMesh,
-			const int segmentsPerEdge,
-			const Mapping::MappingType type =
-					Mapping::Invalid)
-      :
+	TetDivider(UMesh *pVolMesh, const int segmentsPerEdge) :
 			CellDivider(pVolMesh, segmentsPerEdge) {
     vertIJK[0][0] = 0;
     vertIJK[0][1] = 0;
@@ -124,27 +120,13 @@ public:
 		faceEdgeIndices[3][1] = 2;
 		faceEdgeIndices[3][2] = 1;
 
-		Mapping::MappingType myType = type;
-		if (myType == Mapping::Invalid) {
-			myType = pInitMesh->getDefaultMappingType();
-		}
-		switch (myType) {
-		case Mapping::Lagrange:
-			m_Map = new LagrangeCubicTetMapping(pInitMesh);
-			break;
-		case Mapping::Uniform:
-		default:
-			m_Map = new Q1TetMapping(pInitMesh);
-			break;
-		}
-
 	}
 	~TetDivider() {
 	}
-//	void divideInterior();
+	template<typename MapT> void divideInterior(const MapT& map);
   void createNewCells();
-	void setupCoordMapping(const emInt verts[]);
-	void getPhysCoordsFromParamCoords(const double uvw[], double xyz[]);
+	// Table-driven versions for the common numbers of divisions.
+	template<int N> void createNewCellsFixed();
 	void setPolyCoeffs(const double* xyz0, const double* xyz1, const double* xyz2,
 			const double* xyz3, double uderiv0[3], double vderiv0[3],
 			double wderiv0[3], double uderiv1[3], double vderiv1[3],
@@ -152,6 +134,11 @@ public:
 			double wderiv2[3], double uderiv3[3], double vderiv3[3],
 			double wderiv3[3]);
 	void stuffTetsIntoOctahedron(emInt vertsNew[][4]);
+	// Split the octahedron with verts A-F into four tets, along its shortest
+	// diagonal.
+	void splitOctahedron(const emInt vertA, const emInt vertB,
+			const emInt vertC, const emInt vertD, const emInt vertE,
+			const emInt vertF, emInt vertsNew[][4]) const;
 
 	virtual int maxI(const int j, const int k) const {return nDivs - k - j;}
 	virtual int maxJ(const int i, const int k) const {return nDivs - k - i;}
@@ -160,4 +147,7 @@ public:
 	virtual int getMinInteriorDivs() const {return 4;}
 };
 
+typedef MappedDivider<TetDivider, Q1TetMapping> Q1TetDivider;
+typedef MappedDivider<TetDivider, LagrangeCubicTetMapping> CubicTetDivider;
+
 #endif /* APPS_EXAMESH_TETDIVIDER_H_ */
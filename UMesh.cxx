@@ -27,6 +27,7 @@
 #include <cmath>
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <set>
 #include <vector>
@@ -41,12 +42,16 @@
 #undef PACKAGE_VERSION
 #undef PACKAGE_STRING
 
+#include "ByteOrder.h"
 #include "ExaMesh.h"
 #include "exa-defs.h"
+#include "Instrument.h"
 #include "UMesh.h"
 
 #if (HAVE_CGNS == 1)
 #include <cgnslib.h>
+
+#define CHECK_STATUS if (status != CG_OK) cg_error_exit()
 #endif
 
 #ifndef BDRY_TRI
@@ -165,7 +170,7 @@ UMesh::UMesh(const emInt nVerts, const emInt nBdryVerts, const emInt nBdryTris,
 				m_header(nullptr), m_coords(nullptr), m_TriConn(nullptr),
 				m_QuadConn(nullptr), m_TetConn(nullptr), m_PyrConn(nullptr),
 				m_PrismConn(nullptr), m_HexConn(nullptr), m_buffer(nullptr),
-				m_fileImage(nullptr) {
+				m_fileImage(nullptr), m_partBdryDivs(0) {
 
 	// All sizes are computed in bytes.
 
@@ -183,6 +188,42 @@ emInt UMesh::addVert(const double newCoords[3]) {
 	return (m_header[eVert]++);
 }
 
+emInt UMesh::reserveVerts(const emInt count) {
+	assert(m_header[eVert] + count <= m_nVerts);
+	emInt first = m_header[eVert];
+	m_header[eVert] += count;
+	return first;
+}
+
+void UMesh::clearCells() {
+#ifndef NDEBUG
+	// Debug builds check that new entities are written to untouched memory.
+	std::fill(&m_TriConn[0][0], &m_TriConn[0][0] + 3 * size_t(m_header[eTri]),
+						0);
+	std::fill(&m_QuadConn[0][0], &m_QuadConn[0][0] + 4 * size_t(m_header[eQuad]),
+						0);
+	std::fill(&m_TetConn[0][0], &m_TetConn[0][0] + 4 * size_t(m_header[eTet]),
+						0);
+	std::fill(&m_PyrConn[0][0], &m_PyrConn[0][0] + 5 * size_t(m_header[ePyr]),
+						0);
+	std::fill(&m_PrismConn[0][0],
+						&m_PrismConn[0][0] + 6 * size_t(m_header[ePrism]), 0);
+	std::fill(&m_HexConn[0][0], &m_HexConn[0][0] + 8 * size_t(m_header[eHex]),
+						0);
+#endif
+	m_header[eTri] = m_header[eQuad] = 0;
+	m_header[eTet] = m_header[ePyr] = m_header[ePrism] = m_header[eHex] = 0;
+}
+
+void UMesh::clearLastVerts(const emInt count) {
+	assert(count <= m_header[eVert]);
+	m_header[eVert] -= count;
+#ifndef NDEBUG
+	std::fill(&m_coords[m_header[eVert]][0],
+						&m_coords[m_header[eVert]][0] + 3 * size_t(count), 0);
+#endif
+}
+
 emInt UMesh::addBdryTri(const emInt verts[3]) {
 	assert(memoryCheck(m_TriConn[m_header[eTri]], 3 * sizeof(emInt)));
 	for (int ii = 0; ii < 3; ii++) {
@@ -269,6 +310,27 @@ emInt UMesh::addHex(const emInt verts[8]) {
 #endif
 }
 
+emInt (*UMesh::reserveTets(const emInt count))[4] {
+	assert(m_header[eTet] + count <= m_nTets);
+	emInt (*conn)[4] = m_TetConn + m_header[eTet];
+	m_header[eTet] += count;
+	return conn;
+}
+
+emInt (*UMesh::reservePrisms(const emInt count))[6] {
+	assert(m_header[ePrism] + count <= m_nPrisms);
+	emInt (*conn)[6] = m_PrismConn + m_header[ePrism];
+	m_header[ePrism] += count;
+	return conn;
+}
+
+emInt (*UMesh::reserveHexes(const emInt count))[8] {
+	assert(m_header[eHex] + count <= m_nHexes);
+	emInt (*conn)[8] = m_HexConn + m_header[eHex];
+	m_header[eHex] += count;
+	return conn;
+}
+
 UMesh::~UMesh() {
 	free(m_buffer);
 }
@@ -367,7 +429,8 @@ UMesh::UMesh(const char baseFileName[], const char type[],
 				m_header(nullptr), m_coords(nullptr), m_TriConn(nullptr),
 				m_QuadConn(nullptr), m_TetConn(nullptr), m_PyrConn(nullptr),
 				m_PrismConn(nullptr), m_HexConn(nullptr), m_buffer(nullptr),
-				m_fileImage(nullptr) {
+				m_fileImage(nullptr), m_partBdryDivs(0) {
+	ScopedTimer readTimer(eTimeRead);
 	// Use the same IO routines as the mesh analyzer code from GMGW.
 	FileWrapper* reader = FileWrapper::factory(baseFileName, type, ugridInfix);
 
@@ -514,6 +577,7 @@ UMesh::UMesh(const char baseFileName[], const char type[],
 	assert(m_nHexes == m_header[eHex]);
 
 	delete reader;
+	readTimer.stop();
 
 	setupLengthScales();
 }
@@ -524,7 +588,7 @@ UMesh::UMesh(const UMesh& UMIn, const int nDivs) :
 				m_header(nullptr), m_coords(nullptr), m_TriConn(nullptr),
 				m_QuadConn(nullptr), m_TetConn(nullptr), m_PyrConn(nullptr),
 				m_PrismConn(nullptr), m_HexConn(nullptr), m_buffer(nullptr),
-				m_fileImage(nullptr) {
+				m_fileImage(nullptr), m_partBdryDivs(0) {
 
 	setlocale(LC_ALL, "");
 	size_t totalInputCells = size_t(UMIn.m_nTets) + UMIn.m_nPyrs + UMIn.m_nPrisms
@@ -558,7 +622,7 @@ UMesh::UMesh(const CubicMesh& CMIn, const int nDivs) :
 				m_header(nullptr), m_coords(nullptr), m_TriConn(nullptr),
 				m_QuadConn(nullptr), m_TetConn(nullptr), m_PyrConn(nullptr),
 				m_PrismConn(nullptr), m_HexConn(nullptr), m_buffer(nullptr),
-				m_fileImage(nullptr) {
+				m_fileImage(nullptr), m_partBdryDivs(0) {
 
 #ifndef NDEBUG
 	setlocale(LC_ALL, "");
@@ -572,17 +636,7 @@ UMesh::UMesh(const CubicMesh& CMIn, const int nDivs) :
 			totalInputCells);
 #endif
 
-	MeshSize MSIn, MSOut;
-	MSIn.nBdryVerts = CMIn.numBdryVerts();
-	MSIn.nVerts = CMIn.numVertsToCopy();
-	MSIn.nBdryTris = CMIn.numBdryTris();
-	MSIn.nBdryQuads = CMIn.numBdryQuads();
-	MSIn.nTets = CMIn.numTets();
-	MSIn.nPyrs = CMIn.numPyramids();
-	MSIn.nPrisms = CMIn.numPrisms();
-	MSIn.nHexes = CMIn.numHexes();
-	bool sizesOK = ::computeMeshSize(MSIn, nDivs, MSOut);
-	if (!sizesOK) exit(2);
+	MeshSize MSOut = CMIn.computeFineMeshSize(nDivs);
 
 	init(MSOut.nVerts, MSOut.nBdryVerts, MSOut.nBdryTris, MSOut.nBdryQuads,
 				MSOut.nTets, MSOut.nPyrs, MSOut.nPrisms, MSOut.nHexes);
@@ -603,7 +657,102 @@ UMesh::UMesh(const CubicMesh& CMIn, const int nDivs) :
 #endif
 }
 
-bool UMesh::writeVTKFile(const char fileName[]) {
+// Appends a refined mesh to a UMesh as it's created.
+class UMeshAppender: public RefineVisitor {
+	UMesh& m_UM;
+public:
+	UMeshAppender(UMesh& UM) :
+			m_UM(UM) {
+	}
+	void onVerts(const emInt firstVert, const emInt count,
+			const double coords[][3]) {
+		assert(firstVert == m_UM.numVerts());
+		for (emInt vv = 0; vv < count; vv++) {
+			m_UM.addVert(coords[vv]);
+		}
+	}
+	void onCells(const emInt /*coarseCell*/, const int type, const emInt count,
+			const emInt conn[]) {
+		for (emInt ii = 0; ii < count; ii++) {
+			switch (type) {
+				case TETRA_4:
+					m_UM.addTet(conn + 4 * size_t(ii));
+					break;
+				case PYRA_5:
+					m_UM.addPyramid(conn + 5 * size_t(ii));
+					break;
+				case PENTA_6:
+					m_UM.addPrism(conn + 6 * size_t(ii));
+					break;
+				default:
+					assert(type == HEXA_8);
+					m_UM.addHex(conn + 8 * size_t(ii));
+					break;
+			}
+		}
+	}
+	void onBdryFaces(const emInt /*coarseFace*/, const int type,
+			const emInt count, const emInt conn[]) {
+		for (emInt ii = 0; ii < count; ii++) {
+			if (type == TRI_3) {
+				m_UM.addBdryTri(conn + 3 * size_t(ii));
+			}
+			else {
+				m_UM.addBdryQuad(conn + 4 * size_t(ii));
+			}
+		}
+	}
+};
+
+bool refineNestedLevels(const ExaMesh& coarse, const int nLevels,
+		const int nDivs[], std::vector<std::unique_ptr<UMesh> >& levels,
+		std::vector<emInt> coarseToFine[]) {
+	levels.clear();
+	std::vector<std::unique_ptr<UMeshAppender> > appenders;
+	std::vector<RefineVisitor*> visitors;
+	for (int ll = 0; ll < nLevels; ll++) {
+		MeshSize MS = coarse.computeFineMeshSize(nDivs[ll]);
+		levels.emplace_back(
+				new UMesh(MS.nVerts, MS.nBdryVerts, MS.nBdryTris, MS.nBdryQuads,
+									MS.nTets, MS.nPyrs, MS.nPrisms, MS.nHexes));
+		appenders.emplace_back(new UMeshAppender(*levels.back()));
+		visitors.push_back(appenders.back().get());
+	}
+	if (!subdivideNestedLevels(&coarse, nLevels, nDivs, visitors.data(),
+															coarseToFine)) {
+		levels.clear();
+		return false;
+	}
+	return true;
+}
+
+// Legacy VTK binary data is big-endian.
+static void writeVTKWords(FILE* outFile, std::vector<uint32_t>& words) {
+	if (!hostIsBigEndian()) swapByteOrder<4>(words.data(), words.size());
+	fwrite(words.data(), sizeof(uint32_t), words.size(), outFile);
+	words.clear();
+}
+
+// Connectivity for one cell type, with its vert count before each cell.
+static void writeVTKCells(FILE* outFile, const emInt* conn, const size_t nEnts,
+		const int nPts, std::vector<uint32_t>& words) {
+	const size_t chunk = 65536;
+	for (size_t ii = 0; ii < nEnts; ii++) {
+		words.push_back(nPts);
+		words.insert(words.end(), conn + ii * nPts, conn + (ii + 1) * nPts);
+		if (words.size() >= chunk) writeVTKWords(outFile, words);
+	}
+	writeVTKWords(outFile, words);
+}
+
+static void writeVTKCellTypes(FILE* outFile, const size_t nEnts,
+		const int cellType, std::vector<uint32_t>& words) {
+	words.assign(nEnts, cellType);
+	writeVTKWords(outFile, words);
+}
+
+bool UMesh::writeVTKFile(const char fileName[], const bool binary) {
+	ScopedTimer writeTimer(eTimeWrite);
 	double timeBefore = exaTime();
 
 	FILE* outFile = fopen(fileName, "w");
@@ -614,10 +763,70 @@ bool UMesh::writeVTKFile(const char fileName[]) {
 
 	fprintf(outFile, "# vtk DataFile Version 1.0\n");
 	fprintf(outFile, "GRUMMP Tetra example\n");
-	fprintf(outFile, "ASCII\n");
+	fprintf(outFile, binary ? "BINARY\n" : "ASCII\n");
 	fprintf(outFile, "DATASET UNSTRUCTURED_GRID\n");
 	fprintf(outFile, "POINTS %d float\n", m_header[eVert]);
 
+	if (binary) {
+		writeBinaryVTKData(outFile);
+	}
+	else {
+		writeASCIIVTKData(outFile);
+	}
+
+	instrumentCount(eCountBytesWritten, ftell(outFile));
+	fclose(outFile);
+	double timeAfter = exaTime();
+	double elapsed = timeAfter - timeBefore;
+	size_t totalCells = size_t(m_nTets) + m_nPyrs + m_nPrisms + m_nHexes;
+	fprintf(stderr, "CPU time for VTK file write = %5.2F seconds\n", elapsed);
+	fprintf(stderr, "                          %5.2F million cells / minute\n",
+					(totalCells / 1000000.) / (elapsed / 60));
+
+	return true;
+}
+
+// Coords are converted to float32 a chunk at a time, so there's never a
+// second copy of them.
+void UMesh::writeBinaryVTKData(FILE* outFile) const {
+	const size_t chunk = 65536;
+	std::vector<uint32_t> words;
+	words.reserve(chunk + 9);
+	for (emInt ii = 0; ii < m_nVerts; ii++) {
+		for (int jj = 0; jj < 3; jj++) {
+			float value = m_coords[ii][jj];
+			uint32_t word;
+			memcpy(&word, &value, sizeof(word));
+			words.push_back(word);
+		}
+		if (words.size() >= chunk) writeVTKWords(outFile, words);
+	}
+	writeVTKWords(outFile, words);
+
+	const size_t numEnts = size_t(m_nTris) + m_nQuads + m_nTets + m_nPyrs
+			+ m_nPrisms + m_nHexes;
+	const size_t dataSize = 4 * size_t(m_nTris) + 5 * (size_t(m_nQuads) + m_nTets)
+			+ 6 * size_t(m_nPyrs) + 7 * size_t(m_nPrisms) + 9 * size_t(m_nHexes);
+	fprintf(outFile, "\nCELLS %lu %lu\n", numEnts, dataSize);
+	writeVTKCells(outFile, m_TriConn[0], m_nTris, 3, words);
+	writeVTKCells(outFile, m_QuadConn[0], m_nQuads, 4, words);
+	writeVTKCells(outFile, m_TetConn[0], m_nTets, 4, words);
+	writeVTKCells(outFile, m_PyrConn[0], m_nPyrs, 5, words);
+	writeVTKCells(outFile, m_PrismConn[0], m_nPrisms, 6, words);
+	writeVTKCells(outFile, m_HexConn[0], m_nHexes, 8, words);
+
+	// Cell types are the same as for ASCII output.
+	fprintf(outFile, "\nCELL_TYPES %lu\n", numEnts);
+	writeVTKCellTypes(outFile, m_nTris, 5, words);
+	writeVTKCellTypes(outFile, m_nQuads, 9, words);
+	writeVTKCellTypes(outFile, m_nTets, 10, words);
+	writeVTKCellTypes(outFile, m_nPyrs, 14, words);
+	writeVTKCellTypes(outFile, m_nPrisms, 13, words);
+	writeVTKCellTypes(outFile, m_nHexes, 12, words);
+	fprintf(outFile, "\n");
+}
+
+void UMesh::writeASCIIVTKData(FILE* outFile) const {
 	//-------------------------------------
 	// write 3d vertex data
 	//-------------------------------------
@@ -695,45 +904,186 @@ bool UMesh::writeVTKFile(const char fileName[]) {
 		fprintf(outFile, "13\n");
 	for (emInt ct = 0; ct < nHexes; ++ct)
 		fprintf(outFile, "12\n");
+}
 
-	fclose(outFile);
-	double timeAfter = exaTime();
-	double elapsed = timeAfter - timeBefore;
-	size_t totalCells = size_t(m_nTets) + m_nPyrs + m_nPrisms + m_nHexes;
-	fprintf(stderr, "CPU time for VTK file write = %5.2F seconds\n", elapsed);
-	fprintf(stderr, "                          %5.2F million cells / minute\n",
-					(totalCells / 1000000.) / (elapsed / 60));
-
+bool parseUGridInfix(const char infix[], UGridFormat& format) {
+	const char* next = infix;
+	bool bigEndian = (*next != 'l');
+	if (*next == 'l') next++;
+	if (*next != 'b' && *next != 'r') return false;
+	bool fortranRecords = (*next == 'r');
+	next++;
+	if (strcmp(next, "8") != 0 && strcmp(next, "4") != 0) return false;
+	format.coordBytes = (*next == '8') ? 8 : 4;
+	format.bigEndian = bigEndian;
+	format.fortranRecords = fortranRecords;
 	return true;
 }
 
-void UMesh::incrementVertIndices(emInt* conn, emInt size) {
-	for (emInt ii = 0; ii < size; ii++) {
-		conn[ii] ++;
-	}
+// gfortran splits records longer than this into subrecords, each with its
+// own pair of length markers.
+static const size_t maxSubrecordBytes = 2147483639;
+
+static size_t fortranRecordBytes(const size_t dataBytes) {
+	size_t nSubrecords =
+			(dataBytes == 0) ? 1 : (dataBytes - 1) / maxSubrecordBytes + 1;
+	return dataBytes + 8 * nSubrecords;
 }
 
-void UMesh::decrementVertIndices(emInt* conn, emInt size) {
-	for (emInt ii = 0; ii < size; ii++) {
-		conn[ii] --;
+// Everything after the header: coords, connectivity and BCs.
+static size_t ugridBodyBytes(const size_t fileImageSize, const emInt nVerts,
+		const UGridFormat& format) {
+	return fileImageSize - 7 * sizeof(emInt)
+			- 3 * (sizeof(double) - format.coordBytes) * size_t(nVerts);
+}
+
+size_t UMesh::getUGridFileSize(const UGridFormat& format) const {
+	size_t headerBytes = 7 * sizeof(emInt);
+	size_t bodyBytes = ugridBodyBytes(m_fileImageSize, m_nVerts, format);
+	if (format.fortranRecords) {
+		return fortranRecordBytes(headerBytes) + fortranRecordBytes(bodyBytes);
 	}
+	return headerBytes + bodyBytes;
 }
 
-bool UMesh::writeUGridFile(const char fileName[]) {
-	double timeBefore = exaTime();
+// Streams the sections of a UGRID file a block at a time, converting each
+// block to the file's byte order as it goes, and adding record markers for
+// Fortran unformatted files.  Vert indices come out 1-based, and pyramids
+// come out in UGRID order.
+class UGridStreamWriter {
+	FILE* m_file;
+	UGridFormat m_format;
+	bool m_swap;
+	size_t m_recordLeft, m_subrecordBytes, m_subrecordLeft;
+	bool m_firstSubrecord;
+	static const size_t m_chunk = 65536;
+
+	void writeMarker(const int32_t marker) {
+		int32_t value = marker;
+		if (m_swap) swapByteOrder<4>(&value, 1);
+		fwrite(&value, sizeof(value), 1, m_file);
+	}
+	void startSubrecord() {
+		m_subrecordBytes = std::min(m_recordLeft, maxSubrecordBytes);
+		m_subrecordLeft = m_subrecordBytes;
+		// A negative leading marker means more subrecords follow.
+		writeMarker(
+				m_recordLeft > m_subrecordBytes ?
+						-int32_t(m_subrecordBytes) : int32_t(m_subrecordBytes));
+	}
+	void endSubrecord() {
+		// A negative trailing marker means other subrecords came before.
+		writeMarker(
+				m_firstSubrecord ?
+						int32_t(m_subrecordBytes) : -int32_t(m_subrecordBytes));
+		m_firstSubrecord = false;
+	}
+	void writeBytes(const void* data, size_t bytes) {
+		const char* ptr = static_cast<const char*>(data);
+		if (!m_format.fortranRecords) {
+			fwrite(ptr, 1, bytes, m_file);
+			return;
+		}
+		while (bytes > 0) {
+			assert(m_subrecordLeft > 0);
+			size_t thisWrite = std::min(bytes, m_subrecordLeft);
+			fwrite(ptr, 1, thisWrite, m_file);
+			ptr += thisWrite;
+			bytes -= thisWrite;
+			m_subrecordLeft -= thisWrite;
+			m_recordLeft -= thisWrite;
+			if (m_subrecordLeft == 0) {
+				endSubrecord();
+				if (m_recordLeft > 0) startSubrecord();
+			}
+		}
+	}
+	// Converts the buffer in place, so it can't be data the caller needs.
+	template<typename T>
+	void writeBuffer(std::vector<T>& buffer) {
+		if (m_swap) swapByteOrder<sizeof(T)>(buffer.data(), buffer.size());
+		writeBytes(buffer.data(), buffer.size() * sizeof(T));
+		buffer.clear();
+	}
+public:
+	UGridStreamWriter(FILE* file, const UGridFormat& format) :
+			m_file(file), m_format(format),
+					m_swap(format.bigEndian != hostIsBigEndian()), m_recordLeft(0),
+					m_subrecordBytes(0), m_subrecordLeft(0), m_firstSubrecord(true) {
+	}
+	void startRecord(const size_t bytes) {
+		if (!m_format.fortranRecords) return;
+		m_recordLeft = bytes;
+		m_firstSubrecord = true;
+		startSubrecord();
+		if (bytes == 0) endSubrecord();
+	}
+	void endRecord() {
+		assert(m_recordLeft == 0);
+	}
+	void writeInts(const emInt data[], const size_t n) {
+		if (!m_swap) {
+			writeBytes(data, n * sizeof(emInt));
+			return;
+		}
+		std::vector<emInt> buffer;
+		buffer.reserve(m_chunk);
+		for (size_t first = 0; first < n; first += m_chunk) {
+			size_t last = std::min(n, first + m_chunk);
+			buffer.assign(data + first, data + last);
+			writeBuffer(buffer);
+		}
+	}
+	void writeCoords(const double coords[][3], const emInt nVerts) {
+		if (m_format.coordBytes == sizeof(double) && !m_swap) {
+			writeBytes(coords, 3 * sizeof(double) * size_t(nVerts));
+			return;
+		}
+		std::vector<double> doubles;
+		std::vector<float> floats;
+		for (emInt first = 0; first < nVerts; first += m_chunk) {
+			emInt last = std::min(size_t(nVerts), first + m_chunk);
+			if (m_format.coordBytes == sizeof(double)) {
+				doubles.assign(coords[first], coords[last]);
+				writeBuffer(doubles);
+			}
+			else {
+				floats.assign(coords[first], coords[last]);
+				writeBuffer(floats);
+			}
+		}
+	}
+	void writeConnectivity(const emInt* conn, const emInt nEnts, const int nPts,
+			const bool isPyramid) {
+		std::vector<emInt> buffer;
+		buffer.reserve(m_chunk * nPts);
+		for (emInt first = 0; first < nEnts; first += m_chunk) {
+			emInt last = std::min(size_t(nEnts), first + m_chunk);
+			buffer.assign(conn + size_t(first) * nPts, conn + size_t(last) * nPts);
+			for (auto& vert : buffer) {
+				vert++;
+			}
+			// UGRID treats pyramids as prisms with the edge from 2 to 5
+			// collapsed.  Compared with the ordering the rest of the world uses,
+			// this has the effect of switching verts 2 and 4.
+			if (isPyramid) {
+				for (size_t ii = 0; ii < buffer.size(); ii += 5) {
+					std::swap(buffer[ii + 2], buffer[ii + 4]);
+				}
+			}
+			writeBuffer(buffer);
+		}
+	}
+};
 
-	// Need to increment all vert indices, because UGRID files are 1-based.
-	emInt size = m_nTris * 3 + m_nQuads * 4;
-	incrementVertIndices(reinterpret_cast<emInt*>(m_TriConn), size);
-	size = m_nTets * 4 + m_nPyrs * 5 + m_nPrisms * 6 + m_nHexes * 8;
-	incrementVertIndices(reinterpret_cast<emInt*>(m_TetConn), size);
+bool UMesh::writeUGridFile(const char fileName[], const char infix[]) const {
+	ScopedTimer writeTimer(eTimeWrite);
+	double timeBefore = exaTime();
 
-	// Also need to swap verts 2 and 4 for pyramids, because UGRID treats
-	// pyramids as prisms with the edge from 2 to 5 collapsed.  Compared
-	// with the ordering the rest of the world uses, this has the effect
-	// of switching verts 2 and 4.
-	for (emInt ii = 0; ii < m_nPyrs; ii++) {
-		std::swap(m_PyrConn[ii][2], m_PyrConn[ii][4]);
+	UGridFormat format;
+	if (!parseUGridInfix(infix, format)) {
+		fprintf(stderr, "Can't write UGRID files with infix %s.\n", infix);
+		return false;
 	}
 
 	FILE* outFile = fopen(fileName, "w");
@@ -742,20 +1092,24 @@ bool UMesh::writeUGridFile(const char fileName[]) {
 		return false;
 	}
 
-	fwrite(m_fileImage, m_fileImageSize, 1, outFile);
+	UGridStreamWriter writer(outFile, format);
+	writer.startRecord(7 * sizeof(emInt));
+	writer.writeInts(m_header, 7);
+	writer.endRecord();
+	writer.startRecord(ugridBodyBytes(m_fileImageSize, m_nVerts, format));
+	writer.writeCoords(m_coords, m_nVerts);
+	writer.writeConnectivity(m_TriConn[0], m_nTris, 3, false);
+	writer.writeConnectivity(m_QuadConn[0], m_nQuads, 4, false);
+	writer.writeInts(m_TriBC, m_nTris);
+	writer.writeInts(m_QuadBC, m_nQuads);
+	writer.writeConnectivity(m_TetConn[0], m_nTets, 4, false);
+	writer.writeConnectivity(m_PyrConn[0], m_nPyrs, 5, true);
+	writer.writeConnectivity(m_PrismConn[0], m_nPrisms, 6, false);
+	writer.writeConnectivity(m_HexConn[0], m_nHexes, 8, false);
+	writer.endRecord();
+	instrumentCount(eCountBytesWritten, getUGridFileSize(format));
 	fclose(outFile);
 
-	// Need to undo the increment for future use
-	size = m_nTris * 3 + m_nQuads * 4;
-	decrementVertIndices(reinterpret_cast<emInt*>(m_TriConn), size);
-	size = m_nTets * 4 + m_nPyrs * 5 + m_nPrisms * 6 + m_nHexes * 8;
-	decrementVertIndices(reinterpret_cast<emInt*>(m_TetConn), size);
-
-	// Need to swap verts 2 and 4 back for future use.
-	for (emInt ii = 0; ii < m_nPyrs; ii++) {
-		std::swap(m_PyrConn[ii][2], m_PyrConn[ii][4]);
-	}
-
 	double timeAfter = exaTime();
 	double elapsed = timeAfter - timeBefore;
 	size_t totalCells = size_t(m_nTets) + m_nPyrs + m_nPrisms + m_nHexes;
@@ -766,6 +1120,322 @@ bool UMesh::writeUGridFile(const char fileName[]) {
 	return true;
 }
 
+#if (HAVE_CGNS == 1)
+// Coords and connectivity are converted about this many values at a time.
+static const cgsize_t maxCGNSChunk = cgsize_t(1) << 20;
+
+// The CGNS library isn't thread-safe, so all calls into it from here are in
+// one named critical section; converting the next chunk needn't be.
+static void writeCGNSCoords(const int indexFile, const int indexBase,
+		const int indexZone, const double coords[][3], const emInt nVerts) {
+	const char* coordNames[] = { "CoordinateX", "CoordinateY", "CoordinateZ" };
+	std::vector<double> buffer;
+	for (int dd = 0; dd < 3; dd++) {
+		for (cgsize_t first = 0; first < cgsize_t(nVerts); first += maxCGNSChunk) {
+			cgsize_t last = std::min(cgsize_t(nVerts), first + maxCGNSChunk) - 1;
+			buffer.resize(last - first + 1);
+			for (cgsize_t ii = first; ii <= last; ii++) {
+				buffer[ii - first] = coords[ii][dd];
+			}
+			int status, indexCoord;
+			cgsize_t rmin = first + 1, rmax = last + 1;
+#pragma omp critical(cgnsWrite)
+			{
+				status = cg_coord_partial_write(indexFile, indexBase, indexZone,
+																				CGNS_ENUMV(RealDouble), coordNames[dd],
+																				&rmin, &rmax, buffer.data(), &indexCoord);
+				CHECK_STATUS;
+			}
+		}
+	}
+}
+
+// Element numbers run on from one section to the next, so nextElement is
+// updated.  Connectivity goes from 0-based emInts to 1-based cgsize_ts a
+// chunk at a time.
+static void writeCGNSSection(const int indexFile, const int indexBase,
+		const int indexZone, const char sectionName[], const ElementType_t eType,
+		const emInt conn[], const emInt nElements, const int nNodes,
+		cgsize_t& nextElement) {
+	if (nElements == 0) return;
+	int status, indexSection;
+	const cgsize_t start = nextElement, end = nextElement + nElements - 1;
+#pragma omp critical(cgnsWrite)
+	{
+		status = cg_section_partial_write(indexFile, indexBase, indexZone,
+																			sectionName, eType, start, end, 0,
+																			&indexSection);
+		CHECK_STATUS;
+	}
+	const cgsize_t chunkElements = std::max(cgsize_t(1), maxCGNSChunk / nNodes);
+	std::vector<cgsize_t> buffer;
+	for (cgsize_t first = start; first <= end; first += chunkElements) {
+		cgsize_t last = std::min(end, first + chunkElements - 1);
+		const emInt* chunkConn = conn + size_t(first - start) * nNodes;
+		size_t nValues = size_t(last - first + 1) * nNodes;
+		buffer.resize(nValues);
+		for (size_t ii = 0; ii < nValues; ii++) {
+			buffer[ii] = cgsize_t(chunkConn[ii]) + 1;
+		}
+#pragma omp critical(cgnsWrite)
+		{
+			status = cg_elements_partial_write(indexFile, indexBase, indexZone,
+																					indexSection, first, last,
+																					buffer.data());
+			CHECK_STATUS;
+		}
+	}
+	nextElement = end + 1;
+}
+
+// Node ordering within each element is the same in CGNS as here, so unlike
+// UGRID output, pyramids aren't permuted.
+bool UMesh::writeCGNSZone(const int indexFile, const int indexBase,
+		const char zoneName[]) const {
+	int status, indexZone;
+	cgsize_t zoneSize[] = { cgsize_t(m_nVerts), cgsize_t(numCells()), 0 };
+#pragma omp critical(cgnsWrite)
+	{
+		status = cg_zone_write(indexFile, indexBase, zoneName, zoneSize,
+														CGNS_ENUMV(Unstructured), &indexZone);
+		CHECK_STATUS;
+	}
+	writeCGNSCoords(indexFile, indexBase, indexZone, m_coords, m_nVerts);
+
+	// Cells first, then bdry faces.
+	cgsize_t nextElement = 1;
+	writeCGNSSection(indexFile, indexBase, indexZone, "Tets",
+										CGNS_ENUMV(TETRA_4), m_TetConn[0], m_nTets, 4,
+										nextElement);
+	writeCGNSSection(indexFile, indexBase, indexZone, "Pyramids",
+										CGNS_ENUMV(PYRA_5), m_PyrConn[0], m_nPyrs, 5,
+										nextElement);
+	writeCGNSSection(indexFile, indexBase, indexZone, "Prisms",
+										CGNS_ENUMV(PENTA_6), m_PrismConn[0], m_nPrisms, 6,
+										nextElement);
+	writeCGNSSection(indexFile, indexBase, indexZone, "Hexes",
+										CGNS_ENUMV(HEXA_8), m_HexConn[0], m_nHexes, 8,
+										nextElement);
+	writeCGNSSection(indexFile, indexBase, indexZone, "BdryTris",
+										CGNS_ENUMV(TRI_3), m_TriConn[0], m_nTris, 3, nextElement);
+	writeCGNSSection(indexFile, indexBase, indexZone, "BdryQuads",
+										CGNS_ENUMV(QUAD_4), m_QuadConn[0], m_nQuads, 4,
+										nextElement);
+	return true;
+}
+
+bool UMesh::writeCGNSFile(const char fileName[]) const {
+	ScopedTimer writeTimer(eTimeWrite);
+	double timeBefore = exaTime();
+
+	int status, indexFile, indexBase;
+	status = cg_open(fileName, CG_MODE_WRITE, &indexFile);
+	if (status != CG_OK) {
+		fprintf(stderr, "Couldn't open CGNS file %s for writing.\n", fileName);
+		return false;
+	}
+	status = cg_base_write(indexFile, "Base", 3, 3, &indexBase);
+	CHECK_STATUS;
+	bool OK = writeCGNSZone(indexFile, indexBase, "Zone");
+	status = cg_close(indexFile);
+	CHECK_STATUS;
+
+	double elapsed = exaTime() - timeBefore;
+	fprintf(stderr, "CPU time for CGNS file write = %5.2F seconds\n", elapsed);
+	fprintf(stderr, "                          %5.2F million cells / minute\n",
+					(numCells() / 1000000.) / (elapsed / 60));
+	return OK;
+}
+#endif
+
+void UMesh::addPartBdryFace(const int nDivs, const int nCorners,
+		const emInt globalCorners[], const emInt faceVerts[]) {
+	assert(nCorners == 3 || nCorners == 4);
+	assert(m_partBdryDivs == 0 || m_partBdryDivs == nDivs);
+	m_partBdryDivs = nDivs;
+	std::vector<emInt>& records =
+			(nCorners == 3) ? m_partBdryTriVerts : m_partBdryQuadVerts;
+	int nFaceVerts =
+			(nCorners == 3) ?
+					(nDivs + 1) * (nDivs + 2) / 2 : (nDivs + 1) * (nDivs + 1);
+	records.insert(records.end(), globalCorners, globalCorners + nCorners);
+	records.insert(records.end(), faceVerts, faceVerts + nFaceVerts);
+}
+
+// Index of lattice point (i,j) in a face record.  For tris, corners 0, 1, 2
+// are at (0,0), (n,0), (0,n); for quads, corners 0, 1, 2, 3 are at (0,0),
+// (n,0), (n,n), (0,n).
+static int triLatticeIndex(const int i, const int j, const int n) {
+	return j * (n + 1) - j * (j - 1) / 2 + i;
+}
+
+static int quadLatticeIndex(const int i, const int j, const int n) {
+	return j * (n + 1) + i;
+}
+
+// Record the corner verts and the verts along each edge of a face.  Edge
+// verts are listed from the lower-numbered global vert to the higher.
+static void addCornersAndEdges(const int nCorners, const int n,
+		const emInt globalCorners[], const emInt faceVerts[],
+		const int pos[][2], std::map<emInt, emInt>& vertMap,
+		std::map<std::pair<emInt, emInt>, std::vector<emInt> >& edgeMap) {
+	for (int cc = 0; cc < nCorners; cc++) {
+		int ind = (nCorners == 3) ? triLatticeIndex(pos[cc][0], pos[cc][1], n)
+													: quadLatticeIndex(pos[cc][0], pos[cc][1], n);
+		vertMap[globalCorners[cc]] = faceVerts[ind];
+	}
+	for (int cc = 0; cc < nCorners; cc++) {
+		int start = cc, end = (cc + 1) % nCorners;
+		if (globalCorners[start] > globalCorners[end]) std::swap(start, end);
+		std::vector<emInt>& edgeVerts = edgeMap[std::make_pair(
+				globalCorners[start], globalCorners[end])];
+		edgeVerts.clear();
+		for (int tt = 1; tt < n; tt++) {
+			int i = pos[start][0] + tt * (pos[end][0] - pos[start][0]) / n;
+			int j = pos[start][1] + tt * (pos[end][1] - pos[start][1]) / n;
+			int ind = (nCorners == 3) ? triLatticeIndex(i, j, n)
+														: quadLatticeIndex(i, j, n);
+			edgeVerts.push_back(faceVerts[ind]);
+		}
+	}
+}
+
+std::vector<emInt> triFaceKey(const emInt corners[3]) {
+	std::vector<emInt> key(corners, corners + 3);
+	std::sort(key.begin(), key.end());
+	return key;
+}
+
+// Which corner of a quad starts its key, and which of the corner's neighbors
+// are in the i and j directions.
+static void quadKeyOrientation(const emInt corners[4], int& start,
+		int& iNeigh, int& jNeigh) {
+	start = std::min_element(corners, corners + 4) - corners;
+	iNeigh = (start + 1) % 4;
+	jNeigh = (start + 3) % 4;
+	if (corners[iNeigh] > corners[jNeigh]) std::swap(iNeigh, jNeigh);
+}
+
+std::vector<emInt> quadFaceKey(const emInt corners[4]) {
+	int start, iNeigh, jNeigh;
+	quadKeyOrientation(corners, start, iNeigh, jNeigh);
+	std::vector<emInt> key = { corners[start], corners[iNeigh],
+			corners[(start + 2) % 4], corners[jNeigh] };
+	return key;
+}
+
+void UMesh::getPartBdryVerts(PartBdryVerts& PBV) const {
+	// Everything is keyed by global coarse verts and listed in an orientation
+	// that depends only on those, so the two parts sharing a face describe it
+	// identically.
+	const int n = m_partBdryDivs;
+
+	const int triPos[3][2] = { { 0, 0 }, { n, 0 }, { 0, n } };
+	const size_t triRecSize = 3 + (n + 1) * (n + 2) / 2;
+	for (size_t rec = 0; rec < m_partBdryTriVerts.size(); rec += triRecSize) {
+		const emInt* corners = &m_partBdryTriVerts[rec];
+		const emInt* faceVerts = corners + 3;
+		addCornersAndEdges(3, n, corners, faceVerts, triPos, PBV.verts,
+												PBV.edges);
+
+		// Interior verts:  origin at the lowest-numbered corner, i toward the
+		// middle one, j toward the highest.
+		int order[] = { 0, 1, 2 };
+		std::sort(order, order + 3, [corners](int a, int b) {
+			return corners[a] < corners[b];
+		});
+		std::vector<emInt>& interior = PBV.tris[triFaceKey(corners)];
+		interior.clear();
+		for (int jj = 1; jj <= n - 2; jj++) {
+			for (int ii = 1; ii <= n - 1 - jj; ii++) {
+				int weight[3];
+				weight[order[0]] = n - ii - jj;
+				weight[order[1]] = ii;
+				weight[order[2]] = jj;
+				interior.push_back(faceVerts[triLatticeIndex(weight[1], weight[2], n)]);
+			}
+		}
+	}
+
+	const int quadPos[4][2] = { { 0, 0 }, { n, 0 }, { n, n }, { 0, n } };
+	const size_t quadRecSize = 4 + (n + 1) * (n + 1);
+	for (size_t rec = 0; rec < m_partBdryQuadVerts.size(); rec += quadRecSize) {
+		const emInt* corners = &m_partBdryQuadVerts[rec];
+		const emInt* faceVerts = corners + 4;
+		addCornersAndEdges(4, n, corners, faceVerts, quadPos, PBV.verts,
+												PBV.edges);
+
+		// Interior verts:  origin at the lowest-numbered corner, i toward the
+		// lower-numbered of its neighbors, j toward the other.
+		int start, iNeigh, jNeigh;
+		quadKeyOrientation(corners, start, iNeigh, jNeigh);
+		std::vector<emInt>& interior = PBV.quads[quadFaceKey(corners)];
+		interior.clear();
+		int di[] = { (quadPos[iNeigh][0] - quadPos[start][0]) / n,
+				(quadPos[iNeigh][1] - quadPos[start][1]) / n };
+		int dj[] = { (quadPos[jNeigh][0] - quadPos[start][0]) / n,
+				(quadPos[jNeigh][1] - quadPos[start][1]) / n };
+		for (int jj = 1; jj <= n - 1; jj++) {
+			for (int ii = 1; ii <= n - 1; ii++) {
+				int i = quadPos[start][0] + ii * di[0] + jj * dj[0];
+				int j = quadPos[start][1] + ii * di[1] + jj * dj[1];
+				interior.push_back(faceVerts[quadLatticeIndex(i, j, n)]);
+			}
+		}
+	}
+}
+
+bool UMesh::writePartBdryMap(const char fileName[]) const {
+	PartBdryVerts PBV;
+	getPartBdryVerts(PBV);
+	const int n = m_partBdryDivs;
+	std::map<emInt, emInt>& vertMap = PBV.verts;
+	std::map<std::pair<emInt, emInt>, std::vector<emInt> >& edgeMap = PBV.edges;
+	std::map<std::vector<emInt>, std::vector<emInt> >& triMap = PBV.tris;
+	std::map<std::vector<emInt>, std::vector<emInt> >& quadMap = PBV.quads;
+
+	FILE* outFile = fopen(fileName, "w");
+	if (!outFile) {
+		fprintf(stderr, "Couldn't open file %s for writing.  Bummer!\n", fileName);
+		return false;
+	}
+	fprintf(outFile, "# ExaMesh part bdry vert map: global coarse verts -> "
+					"part-local fine verts\n");
+	fprintf(outFile, "divs %d\n", n);
+	fprintf(outFile, "verts %lu\n", vertMap.size());
+	for (auto& vert : vertMap) {
+		fprintf(outFile, "%u %u\n", vert.first, vert.second);
+	}
+	fprintf(outFile, "edges %lu\n", edgeMap.size());
+	for (auto& edge : edgeMap) {
+		fprintf(outFile, "%u %u", edge.first.first, edge.first.second);
+		for (emInt vert : edge.second) {
+			fprintf(outFile, " %u", vert);
+		}
+		fprintf(outFile, "\n");
+	}
+	fprintf(outFile, "tris %lu\n", triMap.size());
+	for (auto& tri : triMap) {
+		fprintf(outFile, "%u %u %u", tri.first[0], tri.first[1], tri.first[2]);
+		for (emInt vert : tri.second) {
+			fprintf(outFile, " %u", vert);
+		}
+		fprintf(outFile, "\n");
+	}
+	fprintf(outFile, "quads %lu\n", quadMap.size());
+	for (auto& quad : quadMap) {
+		fprintf(outFile, "%u %u %u %u", quad.first[0], quad.first[1],
+						quad.first[2], quad.first[3]);
+		for (emInt vert : quad.second) {
+			fprintf(outFile, " %u", vert);
+		}
+		fprintf(outFile, "\n");
+	}
+	instrumentCount(eCountBytesWritten, ftell(outFile));
+	fclose(outFile);
+	return true;
+}
+
 static void remapIndices(const emInt nPts, const std::vector<emInt>& newIndices,
 		const emInt* conn, emInt* newConn) {
 	for (emInt jj = 0; jj < nPts; jj++) {
@@ -957,11 +1627,13 @@ std::unique_ptr<UMesh> UMesh::extractCoarseMesh(Part& P,
 	// Store the vertices, while keeping a mapping from the full list of verts
 	// to the restricted list so the connectivity can be copied properly.
 	std::vector<emInt> newIndices(numVerts(), EMINT_MAX);
+	std::vector<emInt> globalVerts(nVerts);
 	for (emInt ii = 0; ii < numVerts(); ii++) {
 		if (isVertUsed[ii]) {
 			double coords[3];
 			getCoords(ii, coords);
 			newIndices[ii] = UUM->addVert(coords);
+			globalVerts[newIndices[ii]] = ii;
 			// Copy length scale for vertices from the parent; otherwise, there will be
 			// mismatches in the refined meshes.
 			UUM->setLengthScale(newIndices[ii], getLengthScale(ii));
@@ -1016,9 +1688,9 @@ std::unique_ptr<UMesh> UMesh::extractCoarseMesh(Part& P,
 		UUM->addBdryQuad(newConn);
 	}
 
-	// Now, finally, the part bdry connectivity.
-	// TODO: Currently, there's nothing in the data structure that marks which
-	// are part bdry faces.
+	// Now, finally, the part bdry connectivity.  These go after all the real
+	// bdry faces, which is how the part data identifies them.
+	UUM->setPartData(globalVerts, nTris, nQuads);
 	for (auto tri : partBdryTris) {
 		emInt conn[] = { newIndices[tri.getCorner(0)],
 				newIndices[tri.getCorner(1)],
@@ -1042,7 +1714,9 @@ std::unique_ptr<UMesh> UMesh::createFineUMesh(const emInt numDivs, Part& P,
 		std::vector<CellPartData>& vecCPD, struct RefineStats& RS) const {
 	// Create a coarse
 	double start = exaTime();
+	ScopedTimer extractTimer(eTimeExtract);
 	auto coarse = extractCoarseMesh(P, vecCPD, numDivs);
+	extractTimer.stop();
 	double middle = exaTime();
 	RS.extractTime = middle - start;
 
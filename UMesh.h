@@ -27,10 +27,38 @@
 #define SRC_UMESH_H_
 
 #include <assert.h>
+#include <stdio.h>
+
+#include <map>
+#include <vector>
 
 #include "CubicMesh.h"
 #include "ExaMesh.h"
 
+// Fine verts on the part bdry of a refined part, keyed by the global coarse
+// verts of the entity they lie on.  Edge verts run from the lower-numbered
+// end of the edge.  Face interior verts are listed in an orientation fixed
+// by the face key; see triFaceKey and quadFaceKey.
+struct PartBdryVerts {
+	std::map<emInt, emInt> verts;
+	std::map<std::pair<emInt, emInt>, std::vector<emInt> > edges;
+	std::map<std::vector<emInt>, std::vector<emInt> > tris, quads;
+};
+
+std::vector<emInt> triFaceKey(const emInt corners[3]);
+std::vector<emInt> quadFaceKey(const emInt corners[4]);
+
+// Binary UGRID flavours, named by their file name infix: b8 and b4 are
+// big-endian, with double and single precision coords; lb8 and lb4 are
+// little-endian.  r8, r4, lr8 and lr4 hold the same data as Fortran
+// unformatted sequential records.
+struct UGridFormat {
+	int coordBytes;
+	bool bigEndian, fortranRecords;
+};
+// Returns false for any other infix.
+bool parseUGridInfix(const char infix[], UGridFormat& format);
+
 class UMesh: public ExaMesh {
 	emInt m_nVerts, m_nBdryVerts, m_nTris, m_nQuads, m_nTets, m_nPyrs, m_nPrisms,
 			m_nHexes;
@@ -49,6 +77,11 @@ class UMesh: public ExaMesh {
 	emInt (*m_PrismConn)[6];
 	emInt (*m_HexConn)[8];
 	char *m_buffer, *m_fileImage;
+	// For a refined part mesh, the fine verts on each part bdry face.  Each
+	// record is the global coarse corners of the face, followed by the whole
+	// lattice of fine verts on the face, row by row.
+	std::vector<emInt> m_partBdryTriVerts, m_partBdryQuadVerts;
+	int m_partBdryDivs;
 	UMesh(const UMesh&);
 	UMesh& operator=(const UMesh&);
 
@@ -110,12 +143,32 @@ public:
 	}
 
 	emInt addVert(const double newCoords[3]);
+	// Space for a block of new verts, for dividers that set their coords
+	// later, with setCoords.  Returns the first of them.
+	emInt reserveVerts(const emInt count);
+	void setCoords(const emInt vert, const double coords[3]) {
+		assert(vert < m_header[eVert]);
+		m_coords[vert][0] = coords[0];
+		m_coords[vert][1] = coords[1];
+		m_coords[vert][2] = coords[2];
+	}
 	emInt addBdryTri(const emInt verts[]);
 	emInt addBdryQuad(const emInt verts[]);
 	emInt addTet(const emInt verts[]);
 	emInt addPyramid(const emInt verts[]);
 	emInt addPrism(const emInt verts[]);
 	emInt addHex(const emInt verts[]);
+	// Space for a block of new cells, for dividers that write all the
+	// children of a cell at once.  The caller must fill in every one.
+	emInt (*reserveTets(const emInt count))[4];
+	emInt (*reservePrisms(const emInt count))[6];
+	emInt (*reserveHexes(const emInt count))[8];
+	// Forget all the cells and bdry faces, but keep the verts, so that the
+	// space can be reused for the next batch of cells.
+	void clearCells();
+	// Forget the last count verts, so that their space can be reused.  Nothing
+	// may refer to them any more.
+	void clearLastVerts(const emInt count);
 
 	virtual void getCoords(const emInt vert, double coords[3]) const {
 		assert(vert < m_nVerts && vert < m_header[eVert]);
@@ -179,32 +232,61 @@ public:
 
 	std::unique_ptr<UMesh> extractCoarseMesh(Part& P,
 			std::vector<CellPartData>& vecCPD, const int numDivs) const;
+	virtual std::unique_ptr<ExaMesh> extractCoarsePart(const emInt numDivs,
+			Part& P, std::vector<CellPartData>& vecCPD) const {
+		return extractCoarseMesh(P, vecCPD, numDivs);
+	}
 
 	void setupCellDataForPartitioning(std::vector<CellPartData>& vecCPD,
 			double &xmin, double& ymin, double& zmin, double& xmax, double& ymax,
 			double& zmax) const;
 
-	bool writeVTKFile(const char fileName[]);
-	bool writeUGridFile(const char fileName[]);
+	// A binary VTK file has float32 coords and is about a quarter the size
+	// of an ASCII one.
+	bool writeVTKFile(const char fileName[], const bool binary = false);
+	// The file is written in the byte order, coord precision and record
+	// structure its infix calls for, converting a block at a time.  The mesh
+	// itself isn't touched.
+	bool writeUGridFile(const char fileName[], const char infix[] = "b8") const;
+#if (HAVE_CGNS == 1)
+	// One zone, with a section for each linear element type that's present.
+	bool writeCGNSFile(const char fileName[]) const;
+	// Adds this mesh as a zone in a CGNS file that's already open, so that
+	// parts can share a file.  Safe to call from several threads at once.
+	bool writeCGNSZone(const int indexFile, const int indexBase,
+			const char zoneName[]) const;
+#endif
 
 	size_t getFileImageSize() const {
 		return m_fileImageSize;
 	}
+	size_t getUGridFileSize(const UGridFormat& format) const;
 
-	void incrementVertIndices(emInt* conn, emInt size);
-	void decrementVertIndices(emInt* conn, emInt size);
+	void addPartBdryFace(const int nDivs, const int nCorners,
+			const emInt globalCorners[], const emInt faceVerts[]);
+	void getPartBdryVerts(PartBdryVerts& PBV) const;
+	bool writePartBdryMap(const char fileName[]) const;
+	int getPartBdryDivs() const {
+		return m_partBdryDivs;
+	}
 
 	// Writing with compression reduces file size by a little over a factor of two,
 	// at the expense of making file write slower by two orders of magnitude.
 	// So don't do it.
 	// bool writeCompressedUGridFile(const char fileName[]);
 private:
+	void writeASCIIVTKData(FILE* outFile) const;
+	void writeBinaryVTKData(FILE* outFile) const;
 	void init(const emInt nVerts, const emInt nBdryVerts, const emInt nBdryTris,
 			const emInt nBdryQuads, const emInt nTets, const emInt nPyramids,
 			const emInt nPrisms, const emInt nHexes);
 };
 
-
-
+// Refinement of coarse into nested levels in one pass, as by
+// subdivideNestedLevels, with each level kept as a UMesh.  Returns false,
+// with no levels, if they don't nest.
+bool refineNestedLevels(const ExaMesh& coarse, const int nLevels,
+		const int nDivs[], std::vector<std::unique_ptr<UMesh> >& levels,
+		std::vector<emInt> coarseToFine[] = nullptr);
 
 #endif /* SRC_UMESH_H_ */
@@ -44,16 +44,6 @@ void Q1TetMapping::setupCoordMapping(const emInt verts[]) {
 	}
 }
 
-void Q1TetMapping::computeTransformedCoords(const double uvw[3],
-		double xyz[3]) const {
-	const double& u = uvw[0];
-	const double& v = uvw[1];
-	const double& w = uvw[2];
-	for (int ii = 0; ii < 3; ii++) {
-		xyz[ii] = A[ii] + u * dU[ii] + v * dV[ii] + w * dW[ii];
-	}
-}
-
 void Q1PyramidMapping::setupCoordMapping(const emInt verts[]) {
 	double coords0[3], coords1[3], coords2[3], coords3[3], coords4[3];
 	m_pMesh->getCoords(verts[0], coords0);
@@ -72,24 +62,6 @@ void Q1PyramidMapping::setupCoordMapping(const emInt verts[]) {
 	}
 }
 
-void Q1PyramidMapping::computeTransformedCoords(const double uvw[3],
-		double xyz[3]) const {
-	double u = uvw[0];
-	double v = uvw[1];
-	const double& w = uvw[2];
-	if (w == 1) {
-		xyz[0] = Apex[0];
-		xyz[1] = Apex[1];
-		xyz[2] = Apex[2];
-	}
-	u = 2 * u - (1 - w);
-	v = 2 * v - (1 - w);
-	for (int ii = 0; ii < 3; ii++) {
-		xyz[ii] = (A[ii] + u * dU[ii] + v * dV[ii] + u * v * dUV[ii] / (w - 1))
-				+ dW[ii] * w;
-	}
-}
-
 void Q1PrismMapping::setupCoordMapping(const emInt verts[]) {
 	double coords0[3], coords1[3], coords2[3], coords3[3], coords4[3], coords5[3];
 	m_pMesh->getCoords(verts[0], coords0);
@@ -109,17 +81,6 @@ void Q1PrismMapping::setupCoordMapping(const emInt verts[]) {
 	}
 }
 
-void Q1PrismMapping::computeTransformedCoords(const double uvw[3],
-		double xyz[3]) const {
-	const double& u = uvw[0];
-	const double& v = uvw[1];
-	const double& w = uvw[2];
-	for (int ii = 0; ii < 3; ii++) {
-		xyz[ii] = A[ii] + u * dU[ii] + v * dV[ii]
-			+ w * (dW[ii] + u * dUW[ii]	+ v * dVW[ii]);
-	}
-}
-
 void Q1HexMapping::setupCoordMapping(const emInt verts[]) {
 	double coords0[3], coords1[3], coords2[3], coords3[3], coords4[3], coords5[3],
 			coords6[3], coords7[3];
@@ -162,19 +123,48 @@ void Q1HexMapping::setupCoordMapping(const emInt verts[]) {
 	}
 }
 
-void Q1HexMapping::computeTransformedCoords(const double uvw[3],
-		double xyz[3]) const {
-	const double& u = uvw[0];
-	const double& v = uvw[1];
-	const double& w = uvw[2];
-	for (int ii = 0; ii < 3; ii++) {
-		// Original, naive implementation of polynomial evaluation
-		xyz[ii] = A[ii] + u * dU[ii] + v * dV[ii] + w * dW[ii] + u * v * dUV[ii]
-							+ u * w * dUW[ii] + v * w * dVW[ii] + u * v * w * dUVW[ii];
-		// Faster version that has only one multiply-add per term.
-//		xyz[ii] = A[ii] + u * (dU[ii] + v * dUV[ii] + w * (dUW[ii] + v * dUVW[ii]))
-//								 + v * dV[ii] + w * (dW[ii] + v * dVW[ii]);
+void getQ1Weights(const int nCorners, const double uvw[3], double weights[8]) {
+	const double u = uvw[0], v = uvw[1], w = uvw[2];
+	switch (nCorners) {
+		case 4:
+			weights[0] = 1 - u - v - w;
+			weights[1] = u;
+			weights[2] = v;
+			weights[3] = w;
+			break;
+		case 5: {
+			weights[4] = w;
+			if (w == 1) {
+				weights[0] = weights[1] = weights[2] = weights[3] = 0;
+				break;
+			}
+			// The same shifted coords as Q1PyramidMapping.
+			const double U = 2 * u - (1 - w), V = 2 * v - (1 - w);
+			const double UV = U * V / (w - 1);
+			weights[0] = 0.25 * ((1 - w) - U - V - UV);
+			weights[1] = 0.25 * ((1 - w) + U - V + UV);
+			weights[2] = 0.25 * ((1 - w) + U + V - UV);
+			weights[3] = 0.25 * ((1 - w) - U + V + UV);
+			break;
+		}
+		case 6:
+			weights[0] = (1 - u - v) * (1 - w);
+			weights[1] = u * (1 - w);
+			weights[2] = v * (1 - w);
+			weights[3] = (1 - u - v) * w;
+			weights[4] = u * w;
+			weights[5] = v * w;
+			break;
+		default:
+			assert(nCorners == 8);
+			weights[0] = (1 - u) * (1 - v) * (1 - w);
+			weights[1] = u * (1 - v) * (1 - w);
+			weights[2] = u * v * (1 - w);
+			weights[3] = (1 - u) * v * (1 - w);
+			weights[4] = (1 - u) * (1 - v) * w;
+			weights[5] = u * (1 - v) * w;
+			weights[6] = u * v * w;
+			weights[7] = (1 - u) * v * w;
+			break;
 	}
 }
-
-
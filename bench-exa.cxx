@@ -0,0 +1,664 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * bench-exa.cxx
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+// Benchmarks refinement on synthetic meshes generated in memory, so that
+// results are reproducible without any input files.  For each mesh kind,
+// size and number of divisions, every phase is timed, and the results are
+// written as JSON.
+//
+//   bench-exa [-k kinds] [-s sizes] [-n divs] [-m maxCellsPerPart]
+//             [-o file.json] [-w]
+//
+// Kinds, sizes and divs are comma-separated lists.  Sizes are the number of
+// coarse hexes along each side of the unit cube the meshes fill.  -w skips
+// writing refined meshes.
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "exa-defs.h"
+#include "CubicMesh.h"
+#include "ExaMesh.h"
+#include "GeomUtils.h"
+#include "Part.h"
+#include "UMesh.h"
+
+// Collects a linear mesh before its final size is known.
+struct MeshBuilder {
+	std::vector<double> coords;
+	std::vector<emInt> tris, quads, tets, pyrs, prisms, hexes;
+	emInt addVert(const double x, const double y, const double z) {
+		coords.push_back(x);
+		coords.push_back(y);
+		coords.push_back(z);
+		return coords.size() / 3 - 1;
+	}
+	emInt numVerts() const {
+		return coords.size() / 3;
+	}
+	emInt numBdryVerts() const {
+		std::vector<bool> isBdry(numVerts(), false);
+		for (auto vv : tris)
+			isBdry[vv] = true;
+		for (auto vv : quads)
+			isBdry[vv] = true;
+		emInt count = 0;
+		for (emInt vv = 0; vv < numVerts(); vv++) {
+			if (isBdry[vv]) count++;
+		}
+		return count;
+	}
+	std::unique_ptr<UMesh> build() const {
+		std::unique_ptr<UMesh> pUM(
+				new UMesh(numVerts(), numBdryVerts(), tris.size() / 3,
+									quads.size() / 4, tets.size() / 4, pyrs.size() / 5,
+									prisms.size() / 6, hexes.size() / 8));
+		for (emInt vv = 0; vv < numVerts(); vv++) {
+			pUM->addVert(&coords[3 * vv]);
+		}
+		for (size_t ii = 0; ii < tris.size(); ii += 3)
+			pUM->addBdryTri(&tris[ii]);
+		for (size_t ii = 0; ii < quads.size(); ii += 4)
+			pUM->addBdryQuad(&quads[ii]);
+		for (size_t ii = 0; ii < tets.size(); ii += 4)
+			pUM->addTet(&tets[ii]);
+		for (size_t ii = 0; ii < pyrs.size(); ii += 5)
+			pUM->addPyramid(&pyrs[ii]);
+		for (size_t ii = 0; ii < prisms.size(); ii += 6)
+			pUM->addPrism(&prisms[ii]);
+		for (size_t ii = 0; ii < hexes.size(); ii += 8)
+			pUM->addHex(&hexes[ii]);
+		return pUM;
+	}
+};
+
+// Lattice of (N+1)^3 verts on the unit cube.
+static void addLatticeVerts(MeshBuilder& MB, const int N) {
+	for (int kk = 0; kk <= N; kk++) {
+		for (int jj = 0; jj <= N; jj++) {
+			for (int ii = 0; ii <= N; ii++) {
+				MB.addVert(double(ii) / N, double(jj) / N, double(kk) / N);
+			}
+		}
+	}
+}
+
+static emInt latticeVert(const int N, const int ii, const int jj,
+		const int kk) {
+	return ii + (N + 1) * (jj + (N + 1) * kk);
+}
+
+// Corners of lattice cell (i,j,k), in the same order as a hex.
+static void latticeHex(const int N, const int ii, const int jj, const int kk,
+		emInt verts[8]) {
+	verts[0] = latticeVert(N, ii, jj, kk);
+	verts[1] = latticeVert(N, ii + 1, jj, kk);
+	verts[2] = latticeVert(N, ii + 1, jj + 1, kk);
+	verts[3] = latticeVert(N, ii, jj + 1, kk);
+	verts[4] = latticeVert(N, ii, jj, kk + 1);
+	verts[5] = latticeVert(N, ii + 1, jj, kk + 1);
+	verts[6] = latticeVert(N, ii + 1, jj + 1, kk + 1);
+	verts[7] = latticeVert(N, ii, jj + 1, kk + 1);
+}
+
+// Faces of a hex, oriented with normals pointing into the hex.  Face 0 is
+// the bottom and face 5 the top; faces 1-4 are -y, +x, +y, -x.
+static const int hexFacesIn[6][4] = { { 0, 1, 2, 3 }, { 0, 4, 5, 1 }, { 1, 5,
+		6, 2 }, { 2, 6, 7, 3 }, { 0, 3, 7, 4 }, { 4, 7, 6, 5 } };
+
+static bool isBdryFace(const int N, const int ii, const int jj, const int kk,
+		const int face) {
+	switch (face) {
+		case 0:
+			return kk == 0;
+		case 1:
+			return jj == 0;
+		case 2:
+			return ii == N - 1;
+		case 3:
+			return jj == N - 1;
+		case 4:
+			return ii == 0;
+		case 5:
+			return kk == N - 1;
+		default:
+			assert(0);
+			return false;
+	}
+}
+
+// Quads are split into tris along the diagonal through their lowest
+// numbered vert, so that neighbors always agree.
+static void splitQuad(const emInt quad[4], emInt tri0[3], emInt tri1[3]) {
+	int start = std::min_element(quad, quad + 4) - quad;
+	if (start % 2 == 1) start = 1;
+	else start = 0;
+	tri0[0] = quad[start];
+	tri0[1] = quad[start + 1];
+	tri0[2] = quad[(start + 2) % 4];
+	tri1[0] = quad[start];
+	tri1[1] = quad[(start + 2) % 4];
+	tri1[2] = quad[(start + 3) % 4];
+}
+
+// Add a bdry face, given with its normal pointing into the mesh.
+static void addBdryQuad(MeshBuilder& MB, const emInt inward[4]) {
+	MB.quads.push_back(inward[0]);
+	MB.quads.push_back(inward[3]);
+	MB.quads.push_back(inward[2]);
+	MB.quads.push_back(inward[1]);
+}
+
+static void addBdryTris(MeshBuilder& MB, const emInt inward[4]) {
+	emInt tri0[3], tri1[3];
+	splitQuad(inward, tri0, tri1);
+	MB.tris.insert(MB.tris.end(), { tri0[0], tri0[2], tri0[1] });
+	MB.tris.insert(MB.tris.end(), { tri1[0], tri1[2], tri1[1] });
+}
+
+static void makeHexBox(MeshBuilder& MB, const int N) {
+	addLatticeVerts(MB, N);
+	for (int kk = 0; kk < N; kk++) {
+		for (int jj = 0; jj < N; jj++) {
+			for (int ii = 0; ii < N; ii++) {
+				emInt hex[8];
+				latticeHex(N, ii, jj, kk, hex);
+				MB.hexes.insert(MB.hexes.end(), hex, hex + 8);
+				for (int ff = 0; ff < 6; ff++) {
+					if (!isBdryFace(N, ii, jj, kk, ff)) continue;
+					emInt quad[4];
+					for (int cc = 0; cc < 4; cc++)
+						quad[cc] = hex[hexFacesIn[ff][cc]];
+					addBdryQuad(MB, quad);
+				}
+			}
+		}
+	}
+}
+
+// Each cube is split into six tets sharing its main diagonal (Kuhn
+// subdivision), which matches across cubes.
+static void makeTetBox(MeshBuilder& MB, const int N) {
+	static const int perms[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, {
+			1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+	addLatticeVerts(MB, N);
+	for (int kk = 0; kk < N; kk++) {
+		for (int jj = 0; jj < N; jj++) {
+			for (int ii = 0; ii < N; ii++) {
+				for (int pp = 0; pp < 6; pp++) {
+					int ijk[] = { ii, jj, kk };
+					emInt tet[4];
+					tet[0] = latticeVert(N, ijk[0], ijk[1], ijk[2]);
+					for (int ss = 0; ss < 3; ss++) {
+						ijk[perms[pp][ss]]++;
+						tet[ss + 1] = latticeVert(N, ijk[0], ijk[1], ijk[2]);
+					}
+					double xyz[4][3];
+					for (int cc = 0; cc < 4; cc++) {
+						std::copy(&MB.coords[3 * tet[cc]], &MB.coords[3 * tet[cc]] + 3,
+											xyz[cc]);
+					}
+					if (tetVolume(xyz[0], xyz[1], xyz[2], xyz[3]) < 0) {
+						std::swap(tet[0], tet[1]);
+					}
+					MB.tets.insert(MB.tets.end(), tet, tet + 4);
+				}
+				emInt hex[8];
+				latticeHex(N, ii, jj, kk, hex);
+				for (int ff = 0; ff < 6; ff++) {
+					if (!isBdryFace(N, ii, jj, kk, ff)) continue;
+					// Kuhn tets split each cube face along the diagonal through
+					// its lowest lattice vert, which is also its lowest index.
+					emInt quad[4];
+					for (int cc = 0; cc < 4; cc++)
+						quad[cc] = hex[hexFacesIn[ff][cc]];
+					addBdryTris(MB, quad);
+				}
+			}
+		}
+	}
+}
+
+// Triangulated squares extruded in z, with layers growing geometrically
+// away from z = 0 like a boundary layer mesh.
+static void makePrismLayers(MeshBuilder& MB, const int N) {
+	const double ratio = 1.2;
+	for (int kk = 0; kk <= N; kk++) {
+		double z = (pow(ratio, kk) - 1) / (pow(ratio, N) - 1);
+		for (int jj = 0; jj <= N; jj++) {
+			for (int ii = 0; ii <= N; ii++) {
+				MB.addVert(double(ii) / N, double(jj) / N, z);
+			}
+		}
+	}
+	for (int kk = 0; kk < N; kk++) {
+		for (int jj = 0; jj < N; jj++) {
+			for (int ii = 0; ii < N; ii++) {
+				emInt hex[8];
+				latticeHex(N, ii, jj, kk, hex);
+				const emInt prism0[] = { hex[0], hex[1], hex[2], hex[4], hex[5], hex[6] };
+				const emInt prism1[] = { hex[0], hex[2], hex[3], hex[4], hex[6], hex[7] };
+				MB.prisms.insert(MB.prisms.end(), prism0, prism0 + 6);
+				MB.prisms.insert(MB.prisms.end(), prism1, prism1 + 6);
+				if (kk == 0) {
+					MB.tris.insert(MB.tris.end(), { hex[0], hex[2], hex[1] });
+					MB.tris.insert(MB.tris.end(), { hex[0], hex[3], hex[2] });
+				}
+				if (kk == N - 1) {
+					MB.tris.insert(MB.tris.end(), { hex[4], hex[5], hex[6] });
+					MB.tris.insert(MB.tris.end(), { hex[4], hex[6], hex[7] });
+				}
+				for (int ff = 1; ff < 5; ff++) {
+					if (!isBdryFace(N, ii, jj, kk, ff)) continue;
+					emInt quad[4];
+					for (int cc = 0; cc < 4; cc++)
+						quad[cc] = hex[hexFacesIn[ff][cc]];
+					addBdryQuad(MB, quad);
+				}
+			}
+		}
+	}
+}
+
+// Hexes in the lower half.  In the upper half, each cube is split into six
+// pyramids with their apex at its center; pyramids on the interface with
+// the hexes stay that way, and the rest are split into two tets each.
+static void makeTransitionMix(MeshBuilder& MB, const int N) {
+	addLatticeVerts(MB, N);
+	const int firstSplit = N / 2;
+	for (int kk = 0; kk < N; kk++) {
+		for (int jj = 0; jj < N; jj++) {
+			for (int ii = 0; ii < N; ii++) {
+				emInt hex[8];
+				latticeHex(N, ii, jj, kk, hex);
+				if (kk < firstSplit) {
+					MB.hexes.insert(MB.hexes.end(), hex, hex + 8);
+				}
+				else {
+					emInt apex = MB.addVert((ii + 0.5) / N, (jj + 0.5) / N,
+																	(kk + 0.5) / N);
+					for (int ff = 0; ff < 6; ff++) {
+						emInt quad[4];
+						for (int cc = 0; cc < 4; cc++)
+							quad[cc] = hex[hexFacesIn[ff][cc]];
+						if (ff == 0 && kk == firstSplit) {
+							MB.pyrs.insert(MB.pyrs.end(), quad, quad + 4);
+							MB.pyrs.push_back(apex);
+						}
+						else {
+							emInt tri0[3], tri1[3];
+							splitQuad(quad, tri0, tri1);
+							MB.tets.insert(MB.tets.end(), tri0, tri0 + 3);
+							MB.tets.push_back(apex);
+							MB.tets.insert(MB.tets.end(), tri1, tri1 + 3);
+							MB.tets.push_back(apex);
+						}
+					}
+				}
+				for (int ff = 0; ff < 6; ff++) {
+					if (!isBdryFace(N, ii, jj, kk, ff)) continue;
+					emInt quad[4];
+					for (int cc = 0; cc < 4; cc++)
+						quad[cc] = hex[hexFacesIn[ff][cc]];
+					if (kk < firstSplit || (ff == 0 && kk == firstSplit)) {
+						addBdryQuad(MB, quad);
+					}
+					else {
+						addBdryTris(MB, quad);
+					}
+				}
+			}
+		}
+	}
+}
+
+// Smooth distortion of the unit cube, used to curve cubic meshes.
+static void curveCoords(const double in[3], double out[3]) {
+	const double amp = 0.05;
+	out[0] = in[0] + amp * sin(M_PI * in[1]) * sin(M_PI * in[2]);
+	out[1] = in[1] + amp * sin(M_PI * in[2]) * sin(M_PI * in[0]);
+	out[2] = in[2] + amp * sin(M_PI * in[0]) * sin(M_PI * in[1]);
+}
+
+// A cubic tet mesh built on the Kuhn tet box, with all nodes moved by
+// curveCoords.  Vert nodes come first, then two nodes per edge and one per
+// face, as CubicMesh expects.
+static std::unique_ptr<CubicMesh> makeCurvedCubicMesh(const int N) {
+	MeshBuilder MB;
+	makeTetBox(MB, N);
+	const emInt nCorners = MB.numVerts();
+	std::vector<double> nodes(MB.coords);
+
+	// Edge nodes, stored from the lower-numbered end.
+	std::map<std::pair<emInt, emInt>, emInt> edgeNodes;
+	std::map<std::vector<emInt>, emInt> faceNodes;
+	auto getEdgeNodes = [&](const emInt v0, const emInt v1, emInt& n0,
+			emInt& n1) {
+		auto key = std::make_pair(std::min(v0, v1), std::max(v0, v1));
+		auto iter = edgeNodes.find(key);
+		emInt first;
+		if (iter == edgeNodes.end()) {
+			first = nodes.size() / 3;
+			for (int ss = 1; ss <= 2; ss++) {
+				for (int cc = 0; cc < 3; cc++) {
+					nodes.push_back(
+							(MB.coords[3 * key.first + cc] * (3 - ss)
+									+ MB.coords[3 * key.second + cc] * ss) / 3);
+				}
+			}
+			edgeNodes[key] = first;
+		}
+		else {
+			first = iter->second;
+		}
+		n0 = (v0 < v1) ? first : first + 1;
+		n1 = (v0 < v1) ? first + 1 : first;
+	};
+	auto getFaceNode = [&](const emInt v0, const emInt v1, const emInt v2) {
+		std::vector<emInt> key = { v0, v1, v2 };
+		std::sort(key.begin(), key.end());
+		auto iter = faceNodes.find(key);
+		if (iter != faceNodes.end()) return iter->second;
+		emInt node = nodes.size() / 3;
+		for (int cc = 0; cc < 3; cc++) {
+			nodes.push_back(
+					(MB.coords[3 * v0 + cc] + MB.coords[3 * v1 + cc]
+							+ MB.coords[3 * v2 + cc]) / 3);
+		}
+		faceNodes[key] = node;
+		return node;
+	};
+
+	// CGNS node ordering for TETRA_20 and TRI_10.
+	static const int tetEdges[6][2] = { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 0, 3 },
+																			{ 1, 3 }, { 2, 3 } };
+	static const int tetFaces[4][3] = { { 0, 1, 2 }, { 0, 1, 3 }, { 1, 2, 3 },
+																			{ 0, 2, 3 } };
+	std::vector<emInt> tet20(MB.tets.size() / 4 * 20);
+	for (size_t tt = 0; tt < MB.tets.size() / 4; tt++) {
+		const emInt* corners = &MB.tets[4 * tt];
+		emInt* conn = &tet20[20 * tt];
+		std::copy(corners, corners + 4, conn);
+		for (int ee = 0; ee < 6; ee++) {
+			getEdgeNodes(corners[tetEdges[ee][0]], corners[tetEdges[ee][1]],
+										conn[4 + 2 * ee], conn[5 + 2 * ee]);
+		}
+		for (int ff = 0; ff < 4; ff++) {
+			conn[16 + ff] = getFaceNode(corners[tetFaces[ff][0]],
+																	corners[tetFaces[ff][1]],
+																	corners[tetFaces[ff][2]]);
+		}
+	}
+	std::vector<emInt> tri10(MB.tris.size() / 3 * 10);
+	for (size_t tt = 0; tt < MB.tris.size() / 3; tt++) {
+		const emInt* corners = &MB.tris[3 * tt];
+		emInt* conn = &tri10[10 * tt];
+		std::copy(corners, corners + 3, conn);
+		for (int ee = 0; ee < 3; ee++) {
+			getEdgeNodes(corners[ee], corners[(ee + 1) % 3], conn[3 + 2 * ee],
+										conn[4 + 2 * ee]);
+		}
+		conn[9] = getFaceNode(corners[0], corners[1], corners[2]);
+	}
+
+	const emInt nNodes = nodes.size() / 3;
+	std::unique_ptr<CubicMesh> pCM(
+			new CubicMesh(nNodes, MB.numBdryVerts(), MB.tris.size() / 3, 0,
+										MB.tets.size() / 4, 0, 0, 0));
+	for (emInt nn = 0; nn < nNodes; nn++) {
+		double xyz[3];
+		curveCoords(&nodes[3 * nn], xyz);
+		pCM->addVert(xyz);
+	}
+	for (size_t ii = 0; ii < tri10.size(); ii += 10)
+		pCM->addBdryTri(&tri10[ii]);
+	for (size_t ii = 0; ii < tet20.size(); ii += 20)
+		pCM->addTet(&tet20[ii]);
+	pCM->reorderCubicMesh();
+	assert(pCM->numVertsToCopy() == nCorners);
+	return pCM;
+}
+
+struct BenchResult {
+	std::string kind;
+	int size, nDivs;
+	emInt nParts;
+	size_t coarseCells, fineCells, fineVerts, bytesWritten;
+	// Phase times are summed over parts, so they're CPU-ish seconds when
+	// parts run in parallel; wallTime covers everything but generation.
+	double generateTime, lengthScaleTime, partitionTime, extractTime,
+			refineTime, writeTime, wallTime;
+};
+
+static std::unique_ptr<ExaMesh> generateMesh(const std::string& kind,
+		const int N) {
+	MeshBuilder MB;
+	if (kind == "hex") makeHexBox(MB, N);
+	else if (kind == "tet") makeTetBox(MB, N);
+	else if (kind == "prism") makePrismLayers(MB, N);
+	else if (kind == "mixed") makeTransitionMix(MB, N);
+	else if (kind == "cubic") return makeCurvedCubicMesh(N);
+	else {
+		fprintf(stderr, "Unknown mesh kind %s\n", kind.c_str());
+		exit(1);
+	}
+	return MB.build();
+}
+
+static BenchResult runBenchmark(const std::string& kind, const int N,
+		const int nDivs, const emInt maxCellsPerPart, const bool writeFiles,
+		const char tmpDir[]) {
+	BenchResult BR;
+	BR.kind = kind;
+	BR.size = N;
+	BR.nDivs = nDivs;
+
+	double start = exaTime();
+	std::unique_ptr<ExaMesh> pEM = generateMesh(kind, N);
+	BR.generateTime = exaTime() - start;
+	BR.coarseCells = size_t(pEM->numTets()) + pEM->numPyramids()
+			+ pEM->numPrisms() + pEM->numHexes();
+
+	double wallStart = exaTime();
+	start = wallStart;
+	pEM->setupLengthScales();
+	BR.lengthScaleTime = exaTime() - start;
+
+	// Parts are made just as refine makes them.
+	std::vector<Part> parts;
+	std::vector<CellPartData> vecCPD;
+	start = exaTime();
+	BR.nParts = pEM->partitionForRefinement(nDivs, maxCellsPerPart, false,
+																					parts, vecCPD);
+	BR.partitionTime = exaTime() - start;
+
+	double extractTime = 0, refineTime = 0, writeTime = 0;
+	size_t fineCells = 0, fineVerts = 0, bytesWritten = 0;
+#pragma omp parallel for schedule(dynamic) reduction(+: extractTime, refineTime, writeTime, fineCells, fineVerts, bytesWritten)
+	for (emInt ii = 0; ii < BR.nParts; ii++) {
+		RefineStats RS;
+		std::unique_ptr<UMesh> pUM = pEM->createFineUMesh(nDivs, parts[ii],
+																											vecCPD, RS);
+		extractTime += RS.extractTime;
+		refineTime += RS.refineTime;
+		fineCells += RS.cells;
+		fineVerts += pUM->numVerts();
+		if (writeFiles) {
+			char fileName[FILE_NAME_LEN];
+			snprintf(fileName, FILE_NAME_LEN, "%s/part%04u.b8.ugrid", tmpDir, ii);
+			double writeStart = exaTime();
+			pUM->writeUGridFile(fileName);
+			writeTime += exaTime() - writeStart;
+			bytesWritten += pUM->getFileImageSize();
+			unlink(fileName);
+		}
+	}
+	BR.wallTime = exaTime() - wallStart;
+	BR.extractTime = extractTime;
+	BR.refineTime = refineTime;
+	BR.writeTime = writeTime;
+	BR.fineCells = fineCells;
+	BR.fineVerts = fineVerts;
+	BR.bytesWritten = bytesWritten;
+	return BR;
+}
+
+static void writeJSON(FILE* outFile, const std::vector<BenchResult>& results,
+		const emInt maxCellsPerPart) {
+	fprintf(outFile, "{\n");
+	fprintf(outFile, "  \"benchmark\": \"bench-exa\",\n");
+#ifdef _OPENMP
+	fprintf(outFile, "  \"threads\": %d,\n", omp_get_max_threads());
+#else
+	fprintf(outFile, "  \"threads\": 1,\n");
+#endif
+	fprintf(outFile, "  \"max_cells_per_part\": %u,\n", maxCellsPerPart);
+	fprintf(outFile, "  \"cases\": [\n");
+	for (size_t ii = 0; ii < results.size(); ii++) {
+		const BenchResult& BR = results[ii];
+		fprintf(outFile, "    {\"mesh\": \"%s\", \"size\": %d, \"divs\": %d, "
+						"\"parts\": %u,\n",
+						BR.kind.c_str(), BR.size, BR.nDivs, BR.nParts);
+		fprintf(outFile, "     \"coarse_cells\": %lu, \"fine_cells\": %lu, "
+						"\"fine_verts\": %lu, \"bytes_written\": %lu,\n",
+						BR.coarseCells, BR.fineCells, BR.fineVerts, BR.bytesWritten);
+		fprintf(outFile, "     \"seconds\": {\"generate\": %.6f, "
+						"\"length_scales\": %.6f, \"partition\": %.6f, "
+						"\"extract\": %.6f, \"refine\": %.6f, \"write\": %.6f, "
+						"\"wall\": %.6f},\n",
+						BR.generateTime, BR.lengthScaleTime, BR.partitionTime,
+						BR.extractTime, BR.refineTime, BR.writeTime, BR.wallTime);
+		fprintf(outFile, "     \"fine_cells_per_second\": %.1f}%s\n",
+						BR.fineCells / BR.wallTime,
+						(ii + 1 < results.size()) ? "," : "");
+	}
+	fprintf(outFile, "  ]\n}\n");
+}
+
+static std::vector<std::string> splitList(const char list[]) {
+	std::vector<std::string> items;
+	std::string all(list);
+	size_t start = 0;
+	while (start <= all.size()) {
+		size_t end = all.find(',', start);
+		if (end == std::string::npos) end = all.size();
+		if (end > start) items.push_back(all.substr(start, end - start));
+		start = end + 1;
+	}
+	return items;
+}
+
+static std::vector<int> splitIntList(const char list[]) {
+	std::vector<int> values;
+	for (auto& item : splitList(list)) {
+		values.push_back(atoi(item.c_str()));
+	}
+	return values;
+}
+
+int main(int argc, char* const argv[]) {
+	char opt = EOF;
+	std::vector<std::string> kinds = splitList("hex,tet,prism,mixed,cubic");
+	std::vector<int> sizes = splitIntList("8,16");
+	std::vector<int> divs = splitIntList("2,4");
+	emInt maxCellsPerPart = 1000000;
+	char outFileName[FILE_NAME_LEN];
+	outFileName[0] = '\0';
+	bool writeFiles = true;
+
+	while ((opt = getopt(argc, argv, "k:m:n:o:s:w")) != EOF) {
+		switch (opt) {
+			case 'k':
+				kinds = splitList(optarg);
+				break;
+			case 'm':
+				sscanf(optarg, "%u", &maxCellsPerPart);
+				break;
+			case 'n':
+				divs = splitIntList(optarg);
+				break;
+			case 'o':
+				snprintf(outFileName, FILE_NAME_LEN, "%s", optarg);
+				break;
+			case 's':
+				sizes = splitIntList(optarg);
+				break;
+			case 'w':
+				writeFiles = false;
+				break;
+		}
+	}
+	for (auto nDivs : divs) {
+		if (nDivs < 1 || nDivs > MAX_DIVS) {
+			fprintf(stderr, "Number of divisions must be 1-%d\n", MAX_DIVS);
+			exit(1);
+		}
+	}
+
+	char tmpDir[] = "/tmp/bench-exa-XXXXXX";
+	if (writeFiles && !mkdtemp(tmpDir)) {
+		fprintf(stderr, "Couldn't create a scratch directory.  Bummer!\n");
+		exit(1);
+	}
+
+	std::vector<BenchResult> results;
+	for (auto& kind : kinds) {
+		for (auto N : sizes) {
+			for (auto nDivs : divs) {
+				fprintf(stderr, "Benchmarking %s, size %d, %d divs\n", kind.c_str(),
+								N, nDivs);
+				results.push_back(
+						runBenchmark(kind, N, nDivs, maxCellsPerPart, writeFiles, tmpDir));
+			}
+		}
+	}
+	if (writeFiles) rmdir(tmpDir);
+
+	FILE* outFile = stdout;
+	if (outFileName[0] != '\0') {
+		outFile = fopen(outFileName, "w");
+		if (!outFile) {
+			fprintf(stderr, "Couldn't open file %s for writing.  Bummer!\n",
+							outFileName);
+			exit(1);
+		}
+	}
+	writeJSON(outFile, results, maxCellsPerPart);
+	if (outFile != stdout) fclose(outFile);
+	return 0;
+}
@@ -56,6 +56,8 @@
 
 #endif
 
+// Callgrind slows everything down far too much for production runs; use
+// the hardware counters in Instrument.h (refine -P) there instead.
 #undef PROFILE
 #ifdef PROFILE
 #include <valgrind/callgrind.h>
@@ -64,6 +66,9 @@
 #endif
 
 #define MAX_DIVS 50
+// Coarse cells per group in the batched evaluation of interior verts.  At
+// least the SIMD width in doubles for current CPUs.
+#define BATCH_WIDTH 8
 #define FILE_NAME_LEN 1024
 
 typedef uint32_t emInt;
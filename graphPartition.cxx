@@ -0,0 +1,659 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * graphPartition.cxx
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+// Multilevel partitioning of the dual graph of a mesh, by recursive
+// bisection.  Each bisection coarsens the graph by heavy edge matching,
+// bisects the coarsest graph by greedy graph growing, then projects the
+// bisection back to the original graph, improving it at each level with
+// Fiduccia-Mattheyses refinement.
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <assert.h>
+#include <stdint.h>
+
+#include "exa-defs.h"
+#include "ExaMesh.h"
+#include "Part.h"
+
+// Compressed row storage for a graph whose vertices are cells and whose
+// edges are faces between them.
+struct DualGraph {
+	std::vector<emInt> xadj, adjncy, adjwgt, vwgt;
+	emInt numVerts() const {
+		return vwgt.size();
+	}
+	size_t totalWeight() const {
+		size_t total = 0;
+		for (auto w : vwgt)
+			total += w;
+		return total;
+	}
+};
+
+// Stop coarsening at about this size; greedy growing does well enough on
+// graphs this small.
+#define COARSEST_GRAPH 100
+// Allowed imbalance of the final partition.  Each level of bisection gets
+// its share of this.
+#define PARTITION_TOLERANCE 0.05
+#define MAX_FM_PASSES 8
+// Give up on an FM pass after this many moves without improvement.
+#define MAX_FM_UPHILL 100
+#define INITIAL_TRIES 4
+
+// Weights follow how much work and output a coarse cell generates: the
+// number of fine cells is about the same for all types, so this is the
+// connectivity written per fine cell.  Pyramids are split between pyramids
+// and tets.
+static emInt cellWeight(const emInt type) {
+	switch (type) {
+		case TETRA_4:
+		case TETRA_20:
+			return 4;
+		case PYRA_5:
+		case PYRA_30:
+		case PENTA_6:
+		case PENTA_40:
+			return 6;
+		case HEXA_8:
+		case HEXA_64:
+			return 8;
+		default:
+			assert(0);
+			return 1;
+	}
+}
+
+struct FaceRecord {
+	emInt verts[4];
+	emInt cell;
+	bool operator<(const FaceRecord& that) const {
+		return std::lexicographical_compare(verts, verts + 4, that.verts,
+																				that.verts + 4);
+	}
+	bool sameFace(const FaceRecord& that) const {
+		return std::equal(verts, verts + 4, that.verts);
+	}
+};
+
+static void addFace(std::vector<FaceRecord>& faces, const emInt conn[],
+		const int faceVerts[], const int nVerts, const emInt cell) {
+	FaceRecord FR;
+	for (int ii = 0; ii < nVerts; ii++) {
+		FR.verts[ii] = conn[faceVerts[ii]];
+	}
+	// Tris have a dummy fourth vert, so they can never match a quad.
+	if (nVerts == 3) FR.verts[3] = EMINT_MAX;
+	std::sort(FR.verts, FR.verts + nVerts);
+	FR.cell = cell;
+	faces.push_back(FR);
+}
+
+// Graph vertex ii is cell vecCPD[ii].  Only corner verts are used to match
+// faces, so this works for both linear and cubic meshes.
+static void buildDualGraph(const ExaMesh* const pEM,
+		const std::vector<CellPartData>& vecCPD, DualGraph& G) {
+	static const int tetFaces[][4] = { { 0, 1, 2 }, { 0, 1, 3 }, { 1, 2, 3 },
+																			{ 0, 2, 3 } };
+	static const int pyrTris[][4] = { { 0, 1, 4 }, { 1, 2, 4 }, { 2, 3, 4 },
+																		{ 3, 0, 4 } };
+	static const int pyrQuad[4] = { 0, 1, 2, 3 };
+	static const int prismTris[][4] = { { 0, 1, 2 }, { 3, 4, 5 } };
+	static const int prismQuads[][4] = { { 0, 1, 4, 3 }, { 1, 2, 5, 4 }, { 2, 0,
+			3, 5 } };
+	static const int hexFaces[][4] = { { 0, 1, 2, 3 }, { 4, 5, 6, 7 },
+																			{ 0, 1, 5, 4 }, { 1, 2, 6, 5 },
+																			{ 2, 3, 7, 6 }, { 3, 0, 4, 7 } };
+
+	const emInt nCells = vecCPD.size();
+	G.vwgt.resize(nCells);
+	std::vector<FaceRecord> faces;
+	faces.reserve(size_t(nCells) * 5);
+	for (emInt cc = 0; cc < nCells; cc++) {
+		const emInt index = vecCPD[cc].getIndex();
+		const emInt type = vecCPD[cc].getCellType();
+		G.vwgt[cc] = cellWeight(type);
+		switch (type) {
+			case TETRA_4:
+			case TETRA_20: {
+				const emInt* conn = pEM->getTetConn(index);
+				for (int ff = 0; ff < 4; ff++)
+					addFace(faces, conn, tetFaces[ff], 3, cc);
+				break;
+			}
+			case PYRA_5:
+			case PYRA_30: {
+				const emInt* conn = pEM->getPyrConn(index);
+				for (int ff = 0; ff < 4; ff++)
+					addFace(faces, conn, pyrTris[ff], 3, cc);
+				addFace(faces, conn, pyrQuad, 4, cc);
+				break;
+			}
+			case PENTA_6:
+			case PENTA_40: {
+				const emInt* conn = pEM->getPrismConn(index);
+				for (int ff = 0; ff < 2; ff++)
+					addFace(faces, conn, prismTris[ff], 3, cc);
+				for (int ff = 0; ff < 3; ff++)
+					addFace(faces, conn, prismQuads[ff], 4, cc);
+				break;
+			}
+			case HEXA_8:
+			case HEXA_64: {
+				const emInt* conn = pEM->getHexConn(index);
+				for (int ff = 0; ff < 6; ff++)
+					addFace(faces, conn, hexFaces[ff], 4, cc);
+				break;
+			}
+			default:
+				assert(0);
+				break;
+		}
+	}
+	std::sort(faces.begin(), faces.end());
+
+	// Faces that appear twice are interior, and become edges.
+	std::vector<std::pair<emInt, emInt> > edges;
+	for (size_t ii = 0; ii + 1 < faces.size(); ii++) {
+		if (faces[ii].sameFace(faces[ii + 1])) {
+			edges.push_back(std::make_pair(faces[ii].cell, faces[ii + 1].cell));
+			ii++;
+		}
+	}
+	faces.clear();
+	faces.shrink_to_fit();
+
+	G.xadj.assign(nCells + 1, 0);
+	for (auto& E : edges) {
+		G.xadj[E.first + 1]++;
+		G.xadj[E.second + 1]++;
+	}
+	for (emInt cc = 0; cc < nCells; cc++) {
+		G.xadj[cc + 1] += G.xadj[cc];
+	}
+	G.adjncy.resize(G.xadj[nCells]);
+	G.adjwgt.assign(G.xadj[nCells], 1);
+	std::vector<emInt> next(G.xadj.begin(), G.xadj.end() - 1);
+	for (auto& E : edges) {
+		G.adjncy[next[E.first]++] = E.second;
+		G.adjncy[next[E.second]++] = E.first;
+	}
+}
+
+// Heavy edge matching: each vertex, visited in random order, is paired with
+// the unmatched neighbor it shares the heaviest edge with.  Pairs (and
+// unmatched vertices) become the vertices of the coarse graph.
+static void coarsenGraph(const DualGraph& G, DualGraph& coarse,
+		std::vector<emInt>& cmap, std::mt19937& rng) {
+	const emInt nVerts = G.numVerts();
+	std::vector<emInt> order(nVerts);
+	for (emInt vv = 0; vv < nVerts; vv++) {
+		order[vv] = vv;
+	}
+	std::shuffle(order.begin(), order.end(), rng);
+
+	std::vector<emInt> match(nVerts, EMINT_MAX);
+	for (emInt ii = 0; ii < nVerts; ii++) {
+		emInt vv = order[ii];
+		if (match[vv] != EMINT_MAX) continue;
+		emInt best = vv, bestWgt = 0;
+		for (emInt jj = G.xadj[vv]; jj < G.xadj[vv + 1]; jj++) {
+			emInt uu = G.adjncy[jj];
+			if (match[uu] == EMINT_MAX && G.adjwgt[jj] > bestWgt) {
+				best = uu;
+				bestWgt = G.adjwgt[jj];
+			}
+		}
+		match[vv] = best;
+		match[best] = vv;
+	}
+
+	cmap.assign(nVerts, EMINT_MAX);
+	std::vector<emInt> members;
+	members.reserve(nVerts);
+	emInt nCoarse = 0;
+	for (emInt vv = 0; vv < nVerts; vv++) {
+		if (cmap[vv] != EMINT_MAX) continue;
+		cmap[vv] = cmap[match[vv]] = nCoarse++;
+		members.push_back(vv);
+		if (match[vv] != vv) members.push_back(match[vv]);
+	}
+
+	// Merge the adjacency lists of each pair, adding up weights of edges to
+	// the same coarse neighbor.
+	coarse.vwgt.assign(nCoarse, 0);
+	coarse.xadj.assign(1, 0);
+	coarse.adjncy.clear();
+	coarse.adjwgt.clear();
+	std::vector<emInt> where(nCoarse, EMINT_MAX);
+	emInt coarseVert = 0;
+	for (size_t ii = 0; ii < members.size(); coarseVert++) {
+		emInt pair[2] = { members[ii], match[members[ii]] };
+		int nInPair = (pair[0] == pair[1]) ? 1 : 2;
+		emInt start = coarse.adjncy.size();
+		for (int pp = 0; pp < nInPair; pp++) {
+			emInt vv = pair[pp];
+			coarse.vwgt[coarseVert] += G.vwgt[vv];
+			for (emInt jj = G.xadj[vv]; jj < G.xadj[vv + 1]; jj++) {
+				emInt cu = cmap[G.adjncy[jj]];
+				if (cu == coarseVert) continue;
+				if (where[cu] == EMINT_MAX) {
+					where[cu] = coarse.adjncy.size();
+					coarse.adjncy.push_back(cu);
+					coarse.adjwgt.push_back(G.adjwgt[jj]);
+				}
+				else {
+					coarse.adjwgt[where[cu]] += G.adjwgt[jj];
+				}
+			}
+		}
+		for (emInt jj = start; jj < coarse.adjncy.size(); jj++) {
+			where[coarse.adjncy[jj]] = EMINT_MAX;
+		}
+		coarse.xadj.push_back(coarse.adjncy.size());
+		ii += nInPair;
+	}
+	assert(coarseVert == nCoarse);
+}
+
+static size_t computeCut(const DualGraph& G, const std::vector<char>& side) {
+	size_t cut = 0;
+	for (emInt vv = 0; vv < G.numVerts(); vv++) {
+		for (emInt jj = G.xadj[vv]; jj < G.xadj[vv + 1]; jj++) {
+			if (side[vv] != side[G.adjncy[jj]]) cut += G.adjwgt[jj];
+		}
+	}
+	return cut / 2;
+}
+
+// How far side 0 is from the allowed weight range.
+static size_t balanceError(const size_t weight0, const size_t minWeight0,
+		const size_t maxWeight0) {
+	if (weight0 > maxWeight0) return weight0 - maxWeight0;
+	if (weight0 < minWeight0) return minWeight0 - weight0;
+	return 0;
+}
+
+// Fiduccia-Mattheyses refinement: repeatedly move the unlocked vertex with
+// the best gain, keeping balance, then roll back to the best partition seen
+// during the pass.
+static void refineFM(const DualGraph& G, const size_t minWeight0,
+		const size_t maxWeight0, std::vector<char>& side) {
+	typedef std::pair<long, emInt> GainEntry;
+	const emInt nVerts = G.numVerts();
+	size_t weight0 = 0;
+	for (emInt vv = 0; vv < nVerts; vv++) {
+		if (side[vv] == 0) weight0 += G.vwgt[vv];
+	}
+	std::vector<long> gain(nVerts);
+	std::vector<bool> locked(nVerts);
+	std::vector<emInt> moves;
+	for (int pass = 0; pass < MAX_FM_PASSES; pass++) {
+		std::priority_queue<GainEntry> heaps[2];
+		for (emInt vv = 0; vv < nVerts; vv++) {
+			long ext = 0, internal = 0;
+			for (emInt jj = G.xadj[vv]; jj < G.xadj[vv + 1]; jj++) {
+				if (side[G.adjncy[jj]] == side[vv]) internal += G.adjwgt[jj];
+				else ext += G.adjwgt[jj];
+			}
+			gain[vv] = ext - internal;
+			locked[vv] = false;
+			if (ext > 0 || balanceError(weight0, minWeight0, maxWeight0) > 0) {
+				heaps[int(side[vv])].push(GainEntry(gain[vv], vv));
+			}
+		}
+
+		long cut = computeCut(G, side);
+		long bestCut = cut;
+		size_t bestError = balanceError(weight0, minWeight0, maxWeight0);
+		size_t bestMoves = 0;
+		moves.clear();
+		while (moves.size() - bestMoves < MAX_FM_UPHILL) {
+			// Clear stale entries off the tops of the heaps.
+			for (int ss = 0; ss < 2; ss++) {
+				while (!heaps[ss].empty()) {
+					const GainEntry& top = heaps[ss].top();
+					emInt vv = top.second;
+					if (locked[vv] || side[vv] != ss || gain[vv] != top.first) {
+						heaps[ss].pop();
+					}
+					else break;
+				}
+			}
+
+			// A move is allowed if it doesn't make the balance worse.
+			size_t error = balanceError(weight0, minWeight0, maxWeight0);
+			int from = -1;
+			for (int ss = 0; ss < 2; ss++) {
+				if (heaps[ss].empty()) continue;
+				emInt vv = heaps[ss].top().second;
+				size_t newWeight0 =
+						(ss == 0) ? weight0 - G.vwgt[vv] : weight0 + G.vwgt[vv];
+				if (balanceError(newWeight0, minWeight0, maxWeight0) > error
+						&& balanceError(newWeight0, minWeight0, maxWeight0) > 0) continue;
+				if (from == -1 || heaps[ss].top().first > heaps[from].top().first) {
+					from = ss;
+				}
+			}
+			if (from == -1) break;
+
+			emInt vv = heaps[from].top().second;
+			heaps[from].pop();
+			cut -= gain[vv];
+			side[vv] = 1 - from;
+			locked[vv] = true;
+			if (from == 0) weight0 -= G.vwgt[vv];
+			else weight0 += G.vwgt[vv];
+			moves.push_back(vv);
+			for (emInt jj = G.xadj[vv]; jj < G.xadj[vv + 1]; jj++) {
+				emInt uu = G.adjncy[jj];
+				if (locked[uu]) continue;
+				if (side[uu] == side[vv]) gain[uu] -= 2 * long(G.adjwgt[jj]);
+				else gain[uu] += 2 * long(G.adjwgt[jj]);
+				heaps[int(side[uu])].push(GainEntry(gain[uu], uu));
+			}
+
+			error = balanceError(weight0, minWeight0, maxWeight0);
+			if (error < bestError || (error == bestError && cut < bestCut)) {
+				bestError = error;
+				bestCut = cut;
+				bestMoves = moves.size();
+			}
+		}
+
+		// Roll back everything after the best point in the pass.
+		for (size_t ii = moves.size(); ii > bestMoves; ii--) {
+			emInt vv = moves[ii - 1];
+			if (side[vv] == 0) weight0 -= G.vwgt[vv];
+			else weight0 += G.vwgt[vv];
+			side[vv] = 1 - side[vv];
+		}
+		if (bestMoves == 0) break;
+	}
+}
+
+// Grow side 0 breadth-first from a seed, always adding the vertex that
+// increases the cut least, until it reaches its target weight.
+static void growBisection(const DualGraph& G, const emInt seed,
+		const size_t target0, std::vector<char>& side) {
+	typedef std::pair<long, emInt> GainEntry;
+	const emInt nVerts = G.numVerts();
+	side.assign(nVerts, 1);
+	std::vector<long> gain(nVerts, 0);
+	for (emInt vv = 0; vv < nVerts; vv++) {
+		for (emInt jj = G.xadj[vv]; jj < G.xadj[vv + 1]; jj++) {
+			gain[vv] -= G.adjwgt[jj];
+		}
+	}
+	std::priority_queue<GainEntry> heap;
+	heap.push(GainEntry(gain[seed], seed));
+	size_t weight0 = 0;
+	emInt nextUnreached = 0;
+	while (weight0 < target0) {
+		while (!heap.empty()
+				&& (side[heap.top().second] == 0
+						|| gain[heap.top().second] != heap.top().first)) {
+			heap.pop();
+		}
+		emInt vv;
+		if (heap.empty()) {
+			// Disconnected graph; start again somewhere else.
+			while (nextUnreached < nVerts && side[nextUnreached] == 0)
+				nextUnreached++;
+			if (nextUnreached == nVerts) break;
+			vv = nextUnreached;
+		}
+		else {
+			vv = heap.top().second;
+			heap.pop();
+		}
+		// Stop short if adding this one would overshoot by more than it
+		// would undershoot.
+		if (weight0 + G.vwgt[vv] > target0
+				&& weight0 + G.vwgt[vv] - target0 > target0 - weight0) break;
+		side[vv] = 0;
+		weight0 += G.vwgt[vv];
+		for (emInt jj = G.xadj[vv]; jj < G.xadj[vv + 1]; jj++) {
+			emInt uu = G.adjncy[jj];
+			if (side[uu] == 0) continue;
+			gain[uu] += 2 * long(G.adjwgt[jj]);
+			heap.push(GainEntry(gain[uu], uu));
+		}
+	}
+}
+
+// The vertex farthest (in graph distance) from the given one.
+static emInt findFarthestVert(const DualGraph& G, const emInt start) {
+	std::vector<emInt> dist(G.numVerts(), EMINT_MAX);
+	std::vector<emInt> queue;
+	queue.reserve(G.numVerts());
+	queue.push_back(start);
+	dist[start] = 0;
+	for (size_t ii = 0; ii < queue.size(); ii++) {
+		emInt vv = queue[ii];
+		for (emInt jj = G.xadj[vv]; jj < G.xadj[vv + 1]; jj++) {
+			emInt uu = G.adjncy[jj];
+			if (dist[uu] == EMINT_MAX) {
+				dist[uu] = dist[vv] + 1;
+				queue.push_back(uu);
+			}
+		}
+	}
+	return queue.back();
+}
+
+static void bisectGraph(const DualGraph& G, const double fraction0,
+		const double tolerance, std::vector<char>& side, std::mt19937& rng) {
+	// Coarsen until the graph is small, or stops shrinking much.
+	std::vector<DualGraph> levels;
+	std::vector<std::vector<emInt> > cmaps;
+	const DualGraph* pCurr = &G;
+	while (pCurr->numVerts() > COARSEST_GRAPH) {
+		DualGraph coarse;
+		std::vector<emInt> cmap;
+		coarsenGraph(*pCurr, coarse, cmap, rng);
+		if (coarse.numVerts() > 0.9 * pCurr->numVerts()) break;
+		levels.push_back(std::move(coarse));
+		cmaps.push_back(std::move(cmap));
+		pCurr = &levels.back();
+	}
+
+	const size_t totalWeight = G.totalWeight();
+	const size_t target0 = totalWeight * fraction0 + 0.5;
+	emInt maxVertWeight = 0;
+	for (auto w : G.vwgt)
+		maxVertWeight = std::max(maxVertWeight, w);
+	const size_t slack = std::max(size_t(tolerance * totalWeight),
+																size_t(maxVertWeight));
+	const size_t minWeight0 = (target0 > slack) ? target0 - slack : 0;
+	const size_t maxWeight0 = target0 + slack;
+
+	// Initial bisection of the coarsest graph; try a few seeds, starting
+	// with one on the periphery, and keep the best.
+	size_t bestCut = SIZE_MAX;
+	std::vector<char> trial;
+	for (int tt = 0; tt < INITIAL_TRIES; tt++) {
+		emInt seed =
+				(tt == 0) ? findFarthestVert(*pCurr, 0) : rng() % pCurr->numVerts();
+		growBisection(*pCurr, seed, target0, trial);
+		refineFM(*pCurr, minWeight0, maxWeight0, trial);
+		size_t cut = computeCut(*pCurr, trial);
+		if (cut < bestCut) {
+			bestCut = cut;
+			side = trial;
+		}
+	}
+
+	// Project back up, refining as we go.
+	for (size_t ll = levels.size(); ll > 0; ll--) {
+		const DualGraph& fine = (ll == 1) ? G : levels[ll - 2];
+		const std::vector<emInt>& cmap = cmaps[ll - 1];
+		std::vector<char> fineSide(fine.numVerts());
+		for (emInt vv = 0; vv < fine.numVerts(); vv++) {
+			fineSide[vv] = side[cmap[vv]];
+		}
+		side.swap(fineSide);
+		refineFM(fine, minWeight0, maxWeight0, side);
+	}
+}
+
+// The part of G on one side of a bisection, with the original graph
+// vertex for each of its vertices.
+static void extractSubgraph(const DualGraph& G,
+		const std::vector<emInt>& origVerts, const std::vector<char>& side,
+		const char which, DualGraph& sub, std::vector<emInt>& subOrigVerts) {
+	std::vector<emInt> newIndex(G.numVerts(), EMINT_MAX);
+	subOrigVerts.clear();
+	sub.vwgt.clear();
+	for (emInt vv = 0; vv < G.numVerts(); vv++) {
+		if (side[vv] != which) continue;
+		newIndex[vv] = sub.vwgt.size();
+		sub.vwgt.push_back(G.vwgt[vv]);
+		subOrigVerts.push_back(origVerts[vv]);
+	}
+	sub.xadj.assign(1, 0);
+	sub.adjncy.clear();
+	sub.adjwgt.clear();
+	for (emInt vv = 0; vv < G.numVerts(); vv++) {
+		if (side[vv] != which) continue;
+		for (emInt jj = G.xadj[vv]; jj < G.xadj[vv + 1]; jj++) {
+			emInt uu = G.adjncy[jj];
+			if (side[uu] != which) continue;
+			sub.adjncy.push_back(newIndex[uu]);
+			sub.adjwgt.push_back(G.adjwgt[jj]);
+		}
+		sub.xadj.push_back(sub.adjncy.size());
+	}
+}
+
+static void partitionRecursively(const DualGraph& G,
+		const std::vector<emInt>& origVerts, const emInt nParts,
+		const emInt firstPart, const double tolerance,
+		std::vector<emInt>& cellPart, std::mt19937& rng) {
+	if (nParts == 1 || G.numVerts() <= 1) {
+		for (auto vv : origVerts) {
+			cellPart[vv] = firstPart;
+		}
+		return;
+	}
+	const emInt nParts0 = nParts / 2;
+	std::vector<char> side;
+	bisectGraph(G, double(nParts0) / nParts, tolerance, side, rng);
+
+	DualGraph sub;
+	std::vector<emInt> subOrigVerts;
+	extractSubgraph(G, origVerts, side, 0, sub, subOrigVerts);
+	partitionRecursively(sub, subOrigVerts, nParts0, firstPart, tolerance,
+												cellPart, rng);
+	extractSubgraph(G, origVerts, side, 1, sub, subOrigVerts);
+	partitionRecursively(sub, subOrigVerts, nParts - nParts0,
+												firstPart + nParts0, tolerance, cellPart, rng);
+}
+
+bool partitionCellsMultilevel(const ExaMesh* const pEM,
+		const emInt nPartsToMake, std::vector<Part>& parts,
+		std::vector<CellPartData>& vecCPD) {
+	double xmin, xmax, ymin, ymax, zmin, zmax;
+	xmin = ymin = zmin = DBL_MAX;
+	xmax = ymax = zmax = -DBL_MAX;
+	pEM->setupCellDataForPartitioning(vecCPD, xmin, ymin, zmin, xmax, ymax, zmax);
+	const emInt nCells = vecCPD.size();
+
+	DualGraph G;
+	buildDualGraph(pEM, vecCPD, G);
+	std::vector<emInt> origVerts(nCells);
+	for (emInt cc = 0; cc < nCells; cc++) {
+		origVerts[cc] = cc;
+	}
+	std::vector<emInt> cellPart(nCells, 0);
+	// Fixed seed, so the partition is repeatable.
+	std::mt19937 rng(12345);
+	int levels = ceil(log2(nPartsToMake));
+	double tolerance = pow(1 + PARTITION_TOLERANCE, 1. / std::max(levels, 1)) - 1;
+	partitionRecursively(G, origVerts, nPartsToMake, 0, tolerance, cellPart,
+												rng);
+
+	// Parts are contiguous ranges of cell data, as with partitionCells, so
+	// sort the cell data by part.
+	std::vector<emInt> partStart(nPartsToMake + 1, 0);
+	for (emInt cc = 0; cc < nCells; cc++) {
+		partStart[cellPart[cc] + 1]++;
+	}
+	for (emInt pp = 0; pp < nPartsToMake; pp++) {
+		partStart[pp + 1] += partStart[pp];
+	}
+	std::vector<CellPartData> sortedCPD(vecCPD);
+	std::vector<emInt> next(partStart.begin(), partStart.end() - 1);
+	for (emInt cc = 0; cc < nCells; cc++) {
+		sortedCPD[next[cellPart[cc]]++] = vecCPD[cc];
+	}
+	vecCPD.swap(sortedCPD);
+
+	parts.clear();
+	for (emInt pp = 0; pp < nPartsToMake; pp++) {
+		double mins[] = { DBL_MAX, DBL_MAX, DBL_MAX };
+		double maxes[] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+		for (emInt cc = partStart[pp]; cc < partStart[pp + 1]; cc++) {
+			for (int ii = 0; ii < 3; ii++) {
+				mins[ii] = std::min(mins[ii], vecCPD[cc].getCoord(ii));
+				maxes[ii] = std::max(maxes[ii], vecCPD[cc].getCoord(ii));
+			}
+		}
+		Part P;
+		P.setData(partStart[pp], partStart[pp + 1], 1, mins, maxes);
+		parts.push_back(P);
+	}
+	return true;
+}
+
+void evaluatePartition(const ExaMesh* const pEM,
+		const std::vector<Part>& parts, const std::vector<CellPartData>& vecCPD,
+		size_t& cutFaces, double& imbalance) {
+	DualGraph G;
+	buildDualGraph(pEM, vecCPD, G);
+	std::vector<emInt> cellPart(vecCPD.size(), EMINT_MAX);
+	std::vector<size_t> partWeight(parts.size(), 0);
+	for (emInt pp = 0; pp < parts.size(); pp++) {
+		for (emInt cc = parts[pp].getFirst(); cc < parts[pp].getLast(); cc++) {
+			cellPart[cc] = pp;
+			partWeight[pp] += G.vwgt[cc];
+		}
+	}
+	cutFaces = 0;
+	for (emInt vv = 0; vv < G.numVerts(); vv++) {
+		for (emInt jj = G.xadj[vv]; jj < G.xadj[vv + 1]; jj++) {
+			if (cellPart[vv] != cellPart[G.adjncy[jj]]) cutFaces++;
+		}
+	}
+	cutFaces /= 2;
+	size_t maxWeight = *std::max_element(partWeight.begin(), partWeight.end());
+	imbalance = maxWeight * double(parts.size()) / G.totalWeight();
+}
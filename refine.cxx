@@ -23,65 +23,321 @@
  *      Author: cfog
  */
 
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <cstdio>
 
 #include "ExaMesh.h"
 #include "CubicMesh.h"
+#include "Instrument.h"
 #include "UMesh.h"
 
+// Parse a size like 200G or 512M into bytes.  A bare number is in bytes.
+static size_t parseMemorySize(const char* arg) {
+	double value = 0;
+	char suffix = '\0';
+	int nRead = sscanf(arg, "%lf%c", &value, &suffix);
+	if (nRead < 1 || value < 0) {
+		fprintf(stderr, "Bad memory size: %s\n", arg);
+		exit(1);
+	}
+	switch (suffix) {
+		case 'T':
+		case 't':
+			value *= 1024;
+			// Fall through.
+		case 'G':
+		case 'g':
+			value *= 1024;
+			// Fall through.
+		case 'M':
+		case 'm':
+			value *= 1024;
+			// Fall through.
+		case 'K':
+		case 'k':
+			value *= 1024;
+			// Fall through.
+		case '\0':
+			break;
+		default:
+			fprintf(stderr, "Bad memory size suffix: %c\n", suffix);
+			exit(1);
+	}
+	return size_t(value);
+}
+
+// Serial refinement writes <base>.<outInfix>.ugrid (or <base>.cgns), and
+// optionally <base>.vtk.  Single-precision UGRID output goes with binary
+// VTK output, which has float32 coords.
+static void writeOutput(UMesh& UM, const char outFileBase[],
+		const char outInfix[], const bool writeVTK) {
+	if (!outFileBase) return;
+	char fileName[FILE_NAME_LEN];
+	UGridFormat format { sizeof(double), true, false };
+	if (strcmp(outInfix, "cgns") == 0) {
+#if (HAVE_CGNS == 1)
+		snprintf(fileName, FILE_NAME_LEN, "%s.cgns", outFileBase);
+		UM.writeCGNSFile(fileName);
+#endif
+	}
+	else {
+		snprintf(fileName, FILE_NAME_LEN, "%s.%s.ugrid", outFileBase, outInfix);
+		UM.writeUGridFile(fileName, outInfix);
+		parseUGridInfix(outInfix, format);
+	}
+	if (writeVTK) {
+		snprintf(fileName, FILE_NAME_LEN, "%s.vtk", outFileBase);
+		UM.writeVTKFile(fileName, format.coordBytes == sizeof(float));
+	}
+}
+
+// Parse a list of divisions like 2,4,8.
+static std::vector<int> parseDivisions(const char* arg) {
+	std::vector<int> divs;
+	const char* next = arg;
+	while (true) {
+		char* end;
+		long value = strtol(next, &end, 10);
+		if (end == next || value < 1) {
+			fprintf(stderr, "Bad number of divisions: %s\n", arg);
+			exit(1);
+		}
+		divs.push_back(int(value));
+		if (*end == '\0') break;
+		if (*end != ',') {
+			fprintf(stderr, "Bad number of divisions: %s\n", arg);
+			exit(1);
+		}
+		next = end + 1;
+	}
+	return divs;
+}
+
+// Serial refinement into nested levels writes each level as if its base
+// were <base>.n<divs>.
+static void refineLevels(const ExaMesh& coarse, const std::vector<int>& divs,
+		const char outFileBase[], const char outInfix[], const bool writeVTK) {
+	double start = exaTime();
+	std::vector<std::unique_ptr<UMesh> > levels;
+	if (!refineNestedLevels(coarse, divs.size(), divs.data(), levels)) exit(1);
+	double time = exaTime() - start;
+	size_t cells = 0;
+	for (auto& level : levels) {
+		cells += level->numCells();
+	}
+	fprintf(stderr, "\nDone serial refinement into %lu nested levels.\n",
+					divs.size());
+	fprintf(stderr, "CPU time for refinement = %5.2F seconds\n", time);
+	fprintf(stderr,
+					"                          %5.2F million cells / minute\n",
+					(cells / 1000000.) / (time / 60));
+	if (!outFileBase) return;
+	for (size_t ll = 0; ll < levels.size(); ll++) {
+		char levelBase[FILE_NAME_LEN];
+		snprintf(levelBase, FILE_NAME_LEN, "%s.n%d", outFileBase, divs[ll]);
+		writeOutput(*levels[ll], levelBase, outInfix, writeVTK);
+	}
+}
+
+#if (HAVE_CGNS == 1)
+// Serial cubic refinement writes <base>.cgns.
+static void writeCubicOutput(const CubicMesh& CM, const char outFileBase[]) {
+	if (!outFileBase) return;
+	char fileName[FILE_NAME_LEN];
+	snprintf(fileName, FILE_NAME_LEN, "%s.cgns", outFileBase);
+	if (!CM.writeCGNSFile(fileName)) exit(1);
+}
+#endif
+
 int main(int argc, char* const argv[]) {
 	char opt = EOF;
 	emInt nDivs = 1;
+	// -n 2,4,8 refines into nested levels in one pass; nDivs is the finest.
+	std::vector<int> levelDivs(1, 1);
 	emInt maxCellsPerPart = 1000000;
+	size_t memoryBudget = 0;
 	char type[10];
 	char infix[10];
+	char outInfix[10];
 	char inFileBaseName[1024];
 	char cgnsFileName[1024];
 	char outFileName[1024];
-	bool isInputCGNS = false, isParallel = false;
+	char reportFileName[1024];
+	bool isInputCGNS = false, isParallel = false, writeVTK = false;
+	bool singleFile = false, useGraphPartitioner = false;
+	// --evaluate-partition (or -e) reports partition quality.
+	bool evaluatePartitions = false;
+	// --verbose (or -V) shows refinement progress on stderr.
+	bool verbose = false;
+	bool useHardwareCounters = false;
+	// -C refines a curved mesh into a curved mesh, written as CGNS.
+	bool cubicOutput = false;
+	// --plan (or -d) only predicts what a parallel refinement would take.
+	bool planOnly = false;
+#ifdef _OPENMP
+	int nThreads = omp_get_max_threads();
+#else
+	int nThreads = 1;
+#endif
+	static const struct option longOptions[] = {
+		{ "plan", no_argument, nullptr, 'd' },
+		{ "evaluate-partition", no_argument, nullptr, 'e' },
+		{ "verbose", no_argument, nullptr, 'V' },
+		{ nullptr, 0, nullptr, 0 }
+	};
 
 	sprintf(type, "vtk");
 	sprintf(infix, "b8");
-	sprintf(outFileName, "/dev/null");
+	sprintf(outInfix, "b8");
+	// No output file unless one is requested.
+	outFileName[0] = '\0';
+	// No instrumentation unless a report is requested.
+	reportFileName[0] = '\0';
 	sprintf(inFileBaseName, "/need/a/file/name");
 	sprintf(cgnsFileName, "/need/a/file/name");
 
-	while ((opt = getopt(argc, argv, "c:i:m:n:o:pt:u:")) != EOF) {
+	while ((opt = getopt_long(argc, argv, "c:Cdef:gi:j:m:M:n:o:pPr:st:u:vV",
+														longOptions, nullptr)) != EOF) {
 		switch (opt) {
 			case 'c':
 				sscanf(optarg, "%1023s", cgnsFileName);
 				isInputCGNS = true;
 				break;
+			case 'C':
+				cubicOutput = true;
+				break;
+			case 'd':
+				planOnly = true;
+				break;
+			case 'e':
+				evaluatePartitions = true;
+				break;
+			case 'f':
+				sscanf(optarg, "%9s", outInfix);
+				break;
+			case 'g':
+				useGraphPartitioner = true;
+				break;
 			case 'i':
 				sscanf(optarg, "%1023s", inFileBaseName);
 				break;
+			case 'j':
+				sscanf(optarg, "%d", &nThreads);
+				break;
 			case 'n':
-				sscanf(optarg, "%d", &nDivs);
+				levelDivs = parseDivisions(optarg);
+				nDivs = levelDivs.back();
 				break;
 			case 'm':
 				sscanf(optarg, "%d", &maxCellsPerPart);
 				break;
+			case 'M':
+				memoryBudget = parseMemorySize(optarg);
+				break;
 			case 'o':
 				sscanf(optarg, "%1023s", outFileName);
 				break;
 			case 'p':
 				isParallel = true;
 				break;
+			case 'P':
+				useHardwareCounters = true;
+				break;
+			case 'r':
+				sscanf(optarg, "%1023s", reportFileName);
+				break;
+			case 's':
+				singleFile = true;
+				break;
 			case 't':
 				sscanf(optarg, "%9s", type);
 				break;
 			case 'u':
 				sscanf(optarg, "%9s", infix);
 				break;
+			case 'v':
+				writeVTK = true;
+				break;
+			case 'V':
+				verbose = true;
+				break;
 		}
 	}
 
+	const char* outFileBase = (outFileName[0] == '\0') ? nullptr : outFileName;
+	showRefineProgress(verbose);
+	// The report is JSON, or CSV if the file name ends in .csv.
+	if (reportFileName[0] != '\0') {
+		enableInstrumentation(true);
+		if (useHardwareCounters) enableHardwareCounters(true);
+	}
+	else if (useHardwareCounters) {
+		fprintf(stderr, "Hardware counters need a report file (-r).\n");
+		exit(1);
+	}
+	UGridFormat outFormat;
+	if (strcmp(outInfix, "cgns") == 0) {
+#if (HAVE_CGNS != 1)
+		fprintf(stderr, "Not compiled with CGNS; can't write CGNS files.\n");
+		exit(1);
+#endif
+	}
+	else if (!parseUGridInfix(outInfix, outFormat)) {
+		fprintf(stderr, "Output infix must be one of b8, lb8, r8, lr8, b4, lb4, "
+						"r4, lr4 or cgns, not %s.\n", outInfix);
+		exit(1);
+	}
+	if (nThreads < 1) {
+		fprintf(stderr, "Need at least one thread.\n");
+		exit(1);
+	}
+#ifdef _OPENMP
+	omp_set_num_threads(nThreads);
+#endif
+	const bool nestedLevels = (levelDivs.size() > 1);
+	if (nestedLevels && (isParallel || planOnly || cubicOutput)) {
+		fprintf(stderr, "Nested levels (-n with a list) are only for serial "
+						"refinement with linear output.\n");
+		exit(1);
+	}
+	if (cubicOutput && (!isInputCGNS || isParallel || planOnly)) {
+		fprintf(stderr, "Curved output (-C) is only for serial refinement of "
+						"CGNS input (-c).\n");
+		exit(1);
+	}
+
 	if (isInputCGNS) {
 #if (HAVE_CGNS == 1)
 		CubicMesh CMorig(cgnsFileName);
+		if (planOnly) {
+			RefinePlan plan;
+			exit(CMorig.planRefinement(nDivs, maxCellsPerPart, memoryBudget,
+																	nThreads, plan, useGraphPartitioner) ? 0 : 1);
+		}
 		if (isParallel) {
-			CMorig.refineForParallel(nDivs, maxCellsPerPart);
+			CMorig.refineForParallel(nDivs, maxCellsPerPart, memoryBudget,
+																outFileBase, singleFile,
+																useGraphPartitioner, outInfix,
+																evaluatePartitions);
+		}
+		else if (nestedLevels) {
+			refineLevels(CMorig, levelDivs, outFileBase, outInfix, writeVTK);
+		}
+		else if (cubicOutput) {
+			double start = exaTime();
+			CubicMesh CMrefined(CMorig, nDivs);
+			double time = exaTime() - start;
+			size_t cells = size_t(CMrefined.numTets()) + CMrefined.numPyramids()
+					+ CMrefined.numPrisms() + CMrefined.numHexes();
+			fprintf(stderr, "\nDone serial cubic refinement.\n");
+			fprintf(stderr, "CPU time for refinement = %5.2F seconds\n", time);
+			fprintf(stderr,
+							"                          %5.2F million cells / minute\n",
+							(cells / 1000000.) / (time / 60));
+			writeCubicOutput(CMrefined, outFileBase);
 		}
 		else {
 			double start = exaTime();
@@ -93,9 +349,7 @@ int main(int argc, char* const argv[]) {
 			fprintf(stderr,
 							"                          %5.2F million cells / minute\n",
 							(cells / 1000000.) / (time / 60));
-
-//			UMrefined.writeUGridFile("/tmp/junk.b8.ugrid");
-			UMrefined.writeVTKFile("/tmp/junk.vtk");
+			writeOutput(UMrefined, outFileBase, outInfix, writeVTK);
 		}
 #else
 		fprintf(stderr, "Not compiled with CGNS; curved meshes not supported.\n");
@@ -104,10 +358,21 @@ int main(int argc, char* const argv[]) {
 	}
 	else {
 		UMesh UMorig(inFileBaseName, type, infix);
+		if (planOnly) {
+			RefinePlan plan;
+			exit(UMorig.planRefinement(nDivs, maxCellsPerPart, memoryBudget,
+																	nThreads, plan, useGraphPartitioner) ? 0 : 1);
+		}
 		if (isParallel) {
-			UMorig.refineForParallel(nDivs, maxCellsPerPart);
+			UMorig.refineForParallel(nDivs, maxCellsPerPart, memoryBudget,
+																outFileBase, singleFile,
+																useGraphPartitioner, outInfix,
+																evaluatePartitions);
 		}
-		if (!isParallel) {
+		if (nestedLevels) {
+			refineLevels(UMorig, levelDivs, outFileBase, outInfix, writeVTK);
+		}
+		else if (!isParallel) {
 			double start = exaTime();
 			UMesh UMrefined(UMorig, nDivs);
 			double time = exaTime() - start;
@@ -117,11 +382,13 @@ int main(int argc, char* const argv[]) {
 			fprintf(stderr,
 							"                          %5.2F million cells / minute\n",
 							(cells / 1000000.) / (time / 60));
-			UMrefined.writeUGridFile("/tmp/junk.b8.ugrid");
-			UMrefined.writeVTKFile("/tmp/junk.vtk");
+			writeOutput(UMrefined, outFileBase, outInfix, writeVTK);
 		}
 	}
 
+	if (reportFileName[0] != '\0') {
+		writeInstrumentReport(reportFileName);
+	}
 	printf("Exiting\n");
 	exit(0);
 }
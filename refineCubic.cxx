@@ -0,0 +1,397 @@
+//  Copyright 2019 by Carl Ollivier-Gooch.  The University of British
+//  Columbia disclaims all copyright interest in the software ExaMesh.//
+//
+//  This file is part of ExaMesh.
+//
+//  ExaMesh is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as
+//  published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  ExaMesh is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with ExaMesh.  If not, see <https://www.gnu.org/licenses/>.
+
+/*
+ * refineCubic.cxx
+ *
+ *  Created on: Oct. 18, 2026
+ *      Author: cfog
+ */
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Refine a cubic mesh into a cubic mesh.  Each coarse cell is divided
+// 3 * nDivs times by the usual cubic dividers, so the nodes of the cubic
+// children are all lattice points, evaluated from the coarse mapping and
+// shared across edges and faces through the usual edge and face tables.
+// The children are then read off that lattice, three lattice steps per
+// child edge.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "CubicMesh.h"
+#include "HexDivider.h"
+#include "Instrument.h"
+#include "PrismDivider.h"
+#include "PyrDivider.h"
+#include "TetDivider.h"
+#include "BdryTriDivider.h"
+#include "BdryQuadDivider.h"
+#include "UMesh.h"
+
+// Cubic nodes in CGNS order, in thirds of the way along the axes from
+// corner 0 to three other corners of the cell.  Those are corners 1, 2 and
+// 3 for tets and prisms, and corners 1, 3 and 4 for pyramids and hexes.
+// Pyramid nodes are in the form with the apex over corner 0, as the
+// pyramid divider lays them out.
+static const int tetAxes[] = { 1, 2, 3 };
+static const int tetNodes[20][3] = { { 0, 0, 0 }, { 3, 0, 0 }, { 0, 3, 0 },
+		{ 0, 0, 3 }, { 1, 0, 0 }, { 2, 0, 0 }, { 2, 1, 0 }, { 1, 2, 0 },
+		{ 0, 2, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 0, 0, 2 }, { 2, 0, 1 },
+		{ 1, 0, 2 }, { 0, 2, 1 }, { 0, 1, 2 }, { 1, 1, 0 }, { 1, 0, 1 },
+		{ 1, 1, 1 }, { 0, 1, 1 } };
+
+static const int pyrAxes[] = { 1, 3, 4 };
+static const int pyrNodes[30][3] = { { 0, 0, 0 }, { 3, 0, 0 }, { 3, 3, 0 },
+		{ 0, 3, 0 }, { 0, 0, 3 }, { 1, 0, 0 }, { 2, 0, 0 }, { 3, 1, 0 },
+		{ 3, 2, 0 }, { 2, 3, 0 }, { 1, 3, 0 }, { 0, 2, 0 }, { 0, 1, 0 },
+		{ 0, 0, 1 }, { 0, 0, 2 }, { 2, 0, 1 }, { 1, 0, 2 }, { 2, 2, 1 },
+		{ 1, 1, 2 }, { 0, 2, 1 }, { 0, 1, 2 }, { 1, 1, 0 }, { 2, 1, 0 },
+		{ 2, 2, 0 }, { 1, 2, 0 }, { 1, 0, 1 }, { 2, 1, 1 }, { 1, 2, 1 },
+		{ 0, 1, 1 }, { 1, 1, 1 } };
+
+static const int prismAxes[] = { 1, 2, 3 };
+static const int prismNodes[40][3] = { { 0, 0, 0 }, { 3, 0, 0 },
+		{ 0, 3, 0 }, { 0, 0, 3 }, { 3, 0, 3 }, { 0, 3, 3 }, { 1, 0, 0 },
+		{ 2, 0, 0 }, { 2, 1, 0 }, { 1, 2, 0 }, { 0, 2, 0 }, { 0, 1, 0 },
+		{ 0, 0, 1 }, { 0, 0, 2 }, { 3, 0, 1 }, { 3, 0, 2 }, { 0, 3, 1 },
+		{ 0, 3, 2 }, { 1, 0, 3 }, { 2, 0, 3 }, { 2, 1, 3 }, { 1, 2, 3 },
+		{ 0, 2, 3 }, { 0, 1, 3 }, { 1, 1, 0 }, { 1, 0, 1 }, { 2, 0, 1 },
+		{ 2, 0, 2 }, { 1, 0, 2 }, { 2, 1, 1 }, { 1, 2, 1 }, { 1, 2, 2 },
+		{ 2, 1, 2 }, { 0, 2, 1 }, { 0, 1, 1 }, { 0, 1, 2 }, { 0, 2, 2 },
+		{ 1, 1, 3 }, { 1, 1, 1 }, { 1, 1, 2 } };
+
+static const int hexAxes[] = { 1, 3, 4 };
+static const int hexNodes[64][3] = { { 0, 0, 0 }, { 3, 0, 0 }, { 3, 3, 0 },
+		{ 0, 3, 0 }, { 0, 0, 3 }, { 3, 0, 3 }, { 3, 3, 3 }, { 0, 3, 3 },
+		{ 1, 0, 0 }, { 2, 0, 0 }, { 3, 1, 0 }, { 3, 2, 0 }, { 2, 3, 0 },
+		{ 1, 3, 0 }, { 0, 2, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 0, 0, 2 },
+		{ 3, 0, 1 }, { 3, 0, 2 }, { 3, 3, 1 }, { 3, 3, 2 }, { 0, 3, 1 },
+		{ 0, 3, 2 }, { 1, 0, 3 }, { 2, 0, 3 }, { 3, 1, 3 }, { 3, 2, 3 },
+		{ 2, 3, 3 }, { 1, 3, 3 }, { 0, 2, 3 }, { 0, 1, 3 }, { 1, 1, 0 },
+		{ 2, 1, 0 }, { 2, 2, 0 }, { 1, 2, 0 }, { 1, 0, 1 }, { 2, 0, 1 },
+		{ 2, 0, 2 }, { 1, 0, 2 }, { 3, 1, 1 }, { 3, 2, 1 }, { 3, 2, 2 },
+		{ 3, 1, 2 }, { 2, 3, 1 }, { 1, 3, 1 }, { 1, 3, 2 }, { 2, 3, 2 },
+		{ 0, 2, 1 }, { 0, 1, 1 }, { 0, 1, 2 }, { 0, 2, 2 }, { 1, 1, 3 },
+		{ 2, 1, 3 }, { 2, 2, 3 }, { 1, 2, 3 }, { 1, 1, 1 }, { 2, 1, 1 },
+		{ 2, 2, 1 }, { 1, 2, 1 }, { 1, 1, 2 }, { 2, 1, 2 }, { 2, 2, 2 },
+		{ 1, 2, 2 } };
+
+// Bdry faces have no third axis; corner 0 stands in for it.
+static const int triAxes[] = { 1, 2, 0 };
+static const int triNodes[10][3] = { { 0, 0, 0 }, { 3, 0, 0 }, { 0, 3, 0 },
+		{ 1, 0, 0 }, { 2, 0, 0 }, { 2, 1, 0 }, { 1, 2, 0 }, { 0, 2, 0 },
+		{ 0, 1, 0 }, { 1, 1, 0 } };
+
+static const int quadAxes[] = { 1, 3, 0 };
+static const int quadNodes[16][3] = { { 0, 0, 0 }, { 3, 0, 0 }, { 3, 3, 0 },
+		{ 0, 3, 0 }, { 1, 0, 0 }, { 2, 0, 0 }, { 3, 1, 0 }, { 3, 2, 0 },
+		{ 2, 3, 0 }, { 1, 3, 0 }, { 0, 2, 0 }, { 0, 1, 0 }, { 1, 1, 0 },
+		{ 2, 1, 0 }, { 2, 2, 0 }, { 1, 2, 0 } };
+
+// Look up the nodes of one cubic child.  Its corners are given in child
+// steps, and each of those is three lattice steps.
+static void gatherChildNodes(const CellDivider& CD, const int corners[][3],
+		const int axes[3], const int nodes[][3], const int nNodes,
+		emInt conn[]) {
+	const int* const origin = corners[0];
+	int dirs[3][3];
+	for (int aa = 0; aa < 3; aa++) {
+		for (int dd = 0; dd < 3; dd++) {
+			dirs[aa][dd] = corners[axes[aa]][dd] - origin[dd];
+		}
+	}
+	for (int nn = 0; nn < nNodes; nn++) {
+		int ijk[3];
+		for (int dd = 0; dd < 3; dd++) {
+			ijk[dd] = 3 * origin[dd] + nodes[nn][0] * dirs[0][dd]
+					+ nodes[nn][1] * dirs[1][dd] + nodes[nn][2] * dirs[2][dd];
+		}
+		conn[nn] = CD.getLocalVert(ijk[0], ijk[1], ijk[2]);
+	}
+}
+
+static void addTetChild(const CellDivider& CD, CubicMesh* const pCM_output,
+		const int corners[4][3]) {
+	emInt conn[20];
+	gatherChildNodes(CD, corners, tetAxes, tetNodes, 20, conn);
+	pCM_output->addTet(conn);
+}
+
+// Same layout of child tets as TetDivider::createNewCells.
+static void createTetChildren(const CubicTetDivider& TD,
+		CubicMesh* const pCM_output, const int nDivs) {
+	for (int level = 1; level <= nDivs; level++) {
+		const int kk = nDivs - level;
+		for (int jj = 0; jj < level; jj++) {
+			for (int ii = 0; ii < level - jj; ii++) {
+				const int corners[4][3] = { { ii, jj, kk }, { ii + 1, jj, kk },
+																		{ ii, jj + 1, kk }, { ii, jj, kk + 1 } };
+				addTetChild(TD, pCM_output, corners);
+			}
+		}
+		for (int jj = 0; jj <= level - 3; jj++) {
+			for (int ii = 1; ii <= level - jj - 2; ii++) {
+				const int corners[4][3] = { { ii, jj, kk + 1 },
+																		{ ii - 1, jj + 1, kk + 1 },
+																		{ ii, jj + 1, kk + 1 },
+																		{ ii, jj + 1, kk } };
+				addTetChild(TD, pCM_output, corners);
+			}
+		}
+		// Octahedra are split along their shortest diagonal, as for linear
+		// refinement, and the split comes back as verts; match those back up
+		// with corners.
+		for (int jj = 0; jj <= level - 2; jj++) {
+			for (int ii = 1; ii <= level - jj - 1; ii++) {
+				const int octCorners[6][3] = { { ii, jj, kk }, { ii, jj + 1, kk },
+																				{ ii - 1, jj + 1, kk },
+																				{ ii - 1, jj, kk + 1 },
+																				{ ii, jj, kk + 1 },
+																				{ ii - 1, jj + 1, kk + 1 } };
+				emInt octVerts[6];
+				for (int cc = 0; cc < 6; cc++) {
+					octVerts[cc] = TD.getLocalVert(3 * octCorners[cc][0],
+																					3 * octCorners[cc][1],
+																					3 * octCorners[cc][2]);
+				}
+				emInt vertsNew[4][4];
+				TD.splitOctahedron(octVerts[0], octVerts[1], octVerts[2],
+														octVerts[3], octVerts[4], octVerts[5], vertsNew);
+				for (int tt = 0; tt < 4; tt++) {
+					int corners[4][3];
+					for (int vv = 0; vv < 4; vv++) {
+						int cc = 0;
+						while (octVerts[cc] != vertsNew[tt][vv]) cc++;
+						assert(cc < 6);
+						corners[vv][0] = octCorners[cc][0];
+						corners[vv][1] = octCorners[cc][1];
+						corners[vv][2] = octCorners[cc][2];
+					}
+					addTetChild(TD, pCM_output, corners);
+				}
+			}
+		}
+	}
+}
+
+// Same layout of child pyramids and tets as PyrDivider::createNewCells.
+static void createPyrChildren(const CubicPyrDivider& PD,
+		CubicMesh* const pCM_output, const int nDivs) {
+	for (int kk = 0; kk < nDivs; kk++) {
+		const int jMax = nDivs - kk;
+		const int iMax = nDivs - kk;
+		for (int jj = 0; jj <= jMax - 1; jj++) {
+			for (int ii = 0; ii <= iMax - 1; ii++) {
+				const int corners[5][3] = { { ii, jj, kk }, { ii + 1, jj, kk },
+																		{ ii + 1, jj + 1, kk },
+																		{ ii, jj + 1, kk }, { ii, jj, kk + 1 } };
+				emInt conn[30];
+				gatherChildNodes(PD, corners, pyrAxes, pyrNodes, 30, conn);
+				pCM_output->addPyramid(conn);
+			}
+		}
+		for (int jj = 0; jj <= jMax - 2; jj++) {
+			for (int ii = 0; ii <= iMax - 2; ii++) {
+				const int corners[5][3] = { { ii, jj, kk + 1 },
+																		{ ii, jj + 1, kk + 1 },
+																		{ ii + 1, jj + 1, kk + 1 },
+																		{ ii + 1, jj, kk + 1 },
+																		{ ii + 1, jj + 1, kk } };
+				emInt conn[30];
+				gatherChildNodes(PD, corners, pyrAxes, pyrNodes, 30, conn);
+				pCM_output->addPyramid(conn);
+			}
+		}
+		for (int jj = 1; jj <= jMax - 1; jj++) {
+			for (int ii = 0; ii <= iMax - 1; ii++) {
+				const int corners[4][3] = { { ii, jj, kk }, { ii + 1, jj, kk },
+																		{ ii, jj, kk + 1 },
+																		{ ii, jj - 1, kk + 1 } };
+				addTetChild(PD, pCM_output, corners);
+			}
+		}
+		for (int jj = 0; jj <= jMax - 1; jj++) {
+			for (int ii = 1; ii <= iMax - 1; ii++) {
+				const int corners[4][3] = { { ii, jj, kk }, { ii, jj + 1, kk },
+																		{ ii - 1, jj, kk + 1 },
+																		{ ii, jj, kk + 1 } };
+				addTetChild(PD, pCM_output, corners);
+			}
+		}
+	}
+}
+
+// Child prisms and hexes keep the orientation of their parent, with
+// corners 0-2 (or 0-3) on the lower of their two layers.
+static void createPrismChildren(const CubicPrismDivider& PD,
+		CubicMesh* const pCM_output, const int nDivs) {
+	for (int kk = 0; kk < nDivs; kk++) {
+		for (int jj = 0; jj < nDivs; jj++) {
+			for (int ii = 0; ii < nDivs - jj; ii++) {
+				emInt conn[40];
+				const int corners[6][3] = { { ii, jj, kk }, { ii + 1, jj, kk },
+																		{ ii, jj + 1, kk }, { ii, jj, kk + 1 },
+																		{ ii + 1, jj, kk + 1 },
+																		{ ii, jj + 1, kk + 1 } };
+				gatherChildNodes(PD, corners, prismAxes, prismNodes, 40, conn);
+				pCM_output->addPrism(conn);
+				if (ii == nDivs - jj - 1) continue;
+
+				// And now the other in that pair.
+				const int cornersDown[6][3] = { { ii + 1, jj, kk },
+																				{ ii + 1, jj + 1, kk },
+																				{ ii, jj + 1, kk },
+																				{ ii + 1, jj, kk + 1 },
+																				{ ii + 1, jj + 1, kk + 1 },
+																				{ ii, jj + 1, kk + 1 } };
+				gatherChildNodes(PD, cornersDown, prismAxes, prismNodes, 40, conn);
+				pCM_output->addPrism(conn);
+			}
+		}
+	}
+}
+
+static void createHexChildren(const CubicHexDivider& HD,
+		CubicMesh* const pCM_output, const int nDivs) {
+	for (int kk = 0; kk < nDivs; kk++) {
+		for (int jj = 0; jj < nDivs; jj++) {
+			for (int ii = 0; ii < nDivs; ii++) {
+				const int corners[8][3] = { { ii, jj, kk }, { ii + 1, jj, kk },
+																		{ ii + 1, jj + 1, kk },
+																		{ ii, jj + 1, kk }, { ii, jj, kk + 1 },
+																		{ ii + 1, jj, kk + 1 },
+																		{ ii + 1, jj + 1, kk + 1 },
+																		{ ii, jj + 1, kk + 1 } };
+				emInt conn[64];
+				gatherChildNodes(HD, corners, hexAxes, hexNodes, 64, conn);
+				pCM_output->addHex(conn);
+			}
+		}
+	}
+}
+
+static void createBdryTriChildren(const BdryTriDivider& BTD,
+		CubicMesh* const pCM_output, const int nDivs) {
+	for (int jj = 0; jj < nDivs; jj++) {
+		for (int ii = 0; ii < nDivs - jj; ii++) {
+			emInt conn[10];
+			const int corners[3][3] = { { ii, jj, 0 }, { ii + 1, jj, 0 },
+																	{ ii, jj + 1, 0 } };
+			gatherChildNodes(BTD, corners, triAxes, triNodes, 10, conn);
+			pCM_output->addBdryTri(conn);
+			if (ii == nDivs - jj - 1) continue;
+
+			const int cornersDown[3][3] = { { ii + 1, jj, 0 },
+																			{ ii + 1, jj + 1, 0 },
+																			{ ii, jj + 1, 0 } };
+			gatherChildNodes(BTD, cornersDown, triAxes, triNodes, 10, conn);
+			pCM_output->addBdryTri(conn);
+		}
+	}
+}
+
+static void createBdryQuadChildren(const BdryQuadDivider& BQD,
+		CubicMesh* const pCM_output, const int nDivs) {
+	for (int jj = 0; jj < nDivs; jj++) {
+		for (int ii = 0; ii < nDivs; ii++) {
+			const int corners[4][3] = { { ii, jj, 0 }, { ii + 1, jj, 0 },
+																	{ ii + 1, jj + 1, 0 }, { ii, jj + 1, 0 } };
+			emInt conn[16];
+			gatherChildNodes(BQD, corners, quadAxes, quadNodes, 16, conn);
+			pCM_output->addBdryQuad(conn);
+		}
+	}
+}
+
+void subdivideCubicMesh(const CubicMesh* const pCM_input,
+		CubicMesh* const pCM_output, const int nDivs) {
+	assert(nDivs >= 1 && 3 * nDivs <= MAX_DIVS);
+	ScopedTimer refineTimer(eTimeRefine);
+	const int latticeDivs = 3 * nDivs;
+
+	// The lattice holds every node of the fine mesh, but no cells.
+	UMesh lattice(pCM_output->numVerts(), 0, 0, 0, 0, 0, 0, 0);
+	for (emInt iV = 0; iV < pCM_input->numVertsToCopy(); iV++) {
+		double coords[3];
+		pCM_input->getCoords(iV, coords);
+		lattice.addVert(coords);
+		lattice.setLengthScale(iV, pCM_input->getLengthScale(iV));
+	}
+
+	exa_map<Edge, EdgeVerts> vertsOnEdges;
+	exa_set<TriFaceVerts> vertsOnTris;
+	exa_set<QuadFaceVerts> vertsOnQuads;
+
+	CubicTetDivider TD(&lattice, pCM_input, latticeDivs);
+	for (emInt iT = 0; iT < pCM_input->numTets(); iT++) {
+		TD.setupCoordMapping(pCM_input->getTetConn(iT));
+		TD.createDivisionVerts(vertsOnEdges, vertsOnTris, vertsOnQuads);
+		createTetChildren(TD, pCM_output, nDivs);
+	}
+
+	CubicPyrDivider PD(&lattice, pCM_input, latticeDivs);
+	for (emInt iP = 0; iP < pCM_input->numPyramids(); iP++) {
+		PD.setupCoordMapping(pCM_input->getPyrConn(iP));
+		PD.createDivisionVerts(vertsOnEdges, vertsOnTris, vertsOnQuads);
+		createPyrChildren(PD, pCM_output, nDivs);
+	}
+
+	CubicPrismDivider PrismD(&lattice, pCM_input, latticeDivs);
+	for (emInt iP = 0; iP < pCM_input->numPrisms(); iP++) {
+		PrismD.setupCoordMapping(pCM_input->getPrismConn(iP));
+		PrismD.createDivisionVerts(vertsOnEdges, vertsOnTris, vertsOnQuads);
+		createPrismChildren(PrismD, pCM_output, nDivs);
+	}
+
+	CubicHexDivider HD(&lattice, pCM_input, latticeDivs);
+	for (emInt iH = 0; iH < pCM_input->numHexes(); iH++) {
+		HD.setupCoordMapping(pCM_input->getHexConn(iH));
+		HD.createDivisionVerts(vertsOnEdges, vertsOnTris, vertsOnQuads);
+		createHexChildren(HD, pCM_output, nDivs);
+	}
+
+	BdryTriDivider BTD(&lattice, latticeDivs);
+	for (emInt iBT = 0; iBT < pCM_input->numBdryTris(); iBT++) {
+		BTD.setupCoordMapping(pCM_input->getBdryTriConn(iBT));
+		BTD.createDivisionVerts(vertsOnEdges, vertsOnTris, vertsOnQuads);
+		createBdryTriChildren(BTD, pCM_output, nDivs);
+	}
+
+	BdryQuadDivider BQD(&lattice, latticeDivs);
+	for (emInt iBQ = 0; iBQ < pCM_input->numBdryQuads(); iBQ++) {
+		BQD.setupCoordMapping(pCM_input->getBdryQuadConn(iBQ));
+		BQD.createDivisionVerts(vertsOnEdges, vertsOnTris, vertsOnQuads);
+		createBdryQuadChildren(BQD, pCM_output, nDivs);
+	}
+
+	assert(lattice.numVerts() == pCM_output->numVerts());
+	for (emInt iV = 0; iV < lattice.numVerts(); iV++) {
+		double coords[3];
+		lattice.getCoords(iV, coords);
+		pCM_output->addVert(coords);
+	}
+	instrumentCount(eCountVertsCreated,
+									lattice.numVerts() - pCM_input->numVertsToCopy());
+	instrumentCount(eCountCellsCreated,
+									size_t(pCM_output->numTets()) + pCM_output->numPyramids()
+											+ pCM_output->numPrisms() + pCM_output->numHexes());
+}
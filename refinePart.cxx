@@ -28,18 +28,325 @@
 #include <unistd.h>
 #include <time.h>
 #include <cstdio>
+#include <algorithm>
 
 #include "ExaMesh.h"
 #include "HexDivider.h"
+#include "Instrument.h"
 #include "PrismDivider.h"
 #include "PyrDivider.h"
 #include "TetDivider.h"
 #include "BdryTriDivider.h"
 #include "BdryQuadDivider.h"
 #include "stdio.h"
-emInt subdividePartMesh(const ExaMesh *const pVM_input, UMesh *const pVM_output,
-		const int nDivs) {
+
+// Save the fine verts on a part bdry face, so that parts can be stitched
+// together later.
+static void recordPartBdryFace(const ExaMesh *const pVM_input,
+		UMesh *const pVM_output, const int nCorners, const emInt conn[],
+		const CellDivider& CD, const int nDivs) {
+	emInt globalCorners[4];
+	for (int cc = 0; cc < nCorners; cc++) {
+		globalCorners[cc] = pVM_input->getGlobalVert(conn[cc]);
+	}
+	std::vector<emInt> faceVerts;
+	for (int jj = 0; jj <= nDivs; jj++) {
+		int maxI = (nCorners == 3) ? nDivs - jj : nDivs;
+		for (int ii = 0; ii <= maxI; ii++) {
+			faceVerts.push_back(CD.getLocalVert(ii, jj, 0));
+		}
+	}
+	pVM_output->addPartBdryFace(nDivs, nCorners, globalCorners,
+			faceVerts.data());
+}
+
+// With a visitor, the work mesh only keeps verts that later cells use:  the
+// coarse verts and the verts on coarse edges and faces.  Each cell's
+// interior verts are cleared once the cell has been visited, and their
+// space is reused, so a vert's index in the work mesh isn't its fine vert
+// index.  fineVert has that for each work mesh vert.
+struct VisitedVerts {
+	emInt count, nFine;
+	std::vector<emInt> fineVert;
+	// Connectivity with fine vert indices, for one call to the visitor.
+	std::vector<emInt> conn;
+	explicit VisitedVerts(const emInt maxVerts) :
+			count(0), nFine(0), fineVert(maxVerts, EMINT_MAX) {
+	}
+};
+
+// Pass the verts created since the last call to the visitor.  They were
+// all created by coarse cell parent, whose divider is CD; or they're the
+// coarse verts, if there's no divider.
+static void visitNewVerts(UMesh *const pVM_output,
+		RefineVisitor *const visitor, VisitedVerts& VV, const emInt parent,
+		const CellDivider *const CD) {
+	const emInt nVerts = pVM_output->numVerts();
+	if (nVerts == VV.count) return;
+	const emInt count = nVerts - VV.count;
+	const emInt firstFine = VV.nFine;
+	std::vector<double> coords(3 * size_t(count));
+	for (emInt vv = VV.count; vv < nVerts; vv++) {
+		pVM_output->getCoords(vv, &coords[3 * size_t(vv - VV.count)]);
+		VV.fineVert[vv] = VV.nFine++;
+	}
+	visitor->onVerts(firstFine, count,
+										reinterpret_cast<const double (*)[3]>(coords.data()));
+	if (visitor->wantsVertParents()) {
+		if (!CD) {
+			visitor->onVertParents(firstFine, count, EMINT_MAX, nullptr);
+		}
+		else {
+			// Param coords of the new verts, from the divider's lattice.
+			const int nDivs = CD->getNumDivs();
+#ifndef NDEBUG
+			emInt found = 0;
+#endif
+			for (int kk = 0; kk <= nDivs; kk++) {
+				for (int jj = CD->minJ(0, kk); jj <= CD->maxJ(0, kk); jj++) {
+					for (int ii = CD->minI(jj, kk); ii <= CD->maxI(jj, kk); ii++) {
+						const emInt vert = CD->getLocalVert(ii, jj, kk);
+						if (vert < VV.count || vert >= nVerts) continue;
+						CD->getParamCoords(ii, jj, kk,
+								&coords[3 * size_t(vert - VV.count)]);
+#ifndef NDEBUG
+						found++;
+#endif
+					}
+				}
+			}
+			assert(found == count);
+			visitor->onVertParents(firstFine, count, parent,
+					reinterpret_cast<const double (*)[3]>(coords.data()));
+		}
+	}
+	VV.count = nVerts;
+}
+
+// Pass count entities of one type from the work mesh to the visitor, with
+// fine vert indices.
+static void visitConn(RefineVisitor *const visitor, VisitedVerts& VV,
+		const emInt parent, const int type, const int nPts, const emInt count,
+		const emInt conn[]) {
+	if (count == 0) return;
+	VV.conn.resize(size_t(count) * nPts);
+	for (size_t ii = 0; ii < VV.conn.size(); ii++) {
+		VV.conn[ii] = VV.fineVert[conn[ii]];
+		assert(VV.conn[ii] != EMINT_MAX);
+	}
+	if (type == TRI_3 || type == QUAD_4) {
+		visitor->onBdryFaces(parent, type, count, VV.conn.data());
+	}
+	else {
+		visitor->onCells(parent, type, count, VV.conn.data());
+	}
+}
+
+// Pass the verts created since the last call and the children of one coarse
+// cell (divided by CD) or bdry face (if CD is null) to the visitor, then
+// forget the children so that their space can be used again.  Returns the
+// number of fine cells visited.
+static emInt visitNewEntities(UMesh *const pVM_output,
+		RefineVisitor *const visitor, VisitedVerts& VV, const emInt parent,
+		const CellDivider *const CD) {
+	if (!visitor) return 0;
+	const bool isFace = (CD == nullptr);
+	visitNewVerts(pVM_output, visitor, VV, parent, CD);
+	if (isFace) {
+		visitConn(visitor, VV, parent, TRI_3, 3, pVM_output->numBdryTris(),
+							pVM_output->numBdryTris() ? pVM_output->getBdryTriConn(0) : nullptr);
+		visitConn(visitor, VV, parent, QUAD_4, 4, pVM_output->numBdryQuads(),
+							pVM_output->numBdryQuads() ?
+									pVM_output->getBdryQuadConn(0) : nullptr);
+	}
+	else {
+		visitConn(visitor, VV, parent, TETRA_4, 4, pVM_output->numTets(),
+							pVM_output->numTets() ? pVM_output->getTetConn(0) : nullptr);
+		visitConn(visitor, VV, parent, PYRA_5, 5, pVM_output->numPyramids(),
+							pVM_output->numPyramids() ? pVM_output->getPyrConn(0) : nullptr);
+		visitConn(visitor, VV, parent, PENTA_6, 6, pVM_output->numPrisms(),
+							pVM_output->numPrisms() ? pVM_output->getPrismConn(0) : nullptr);
+		visitConn(visitor, VV, parent, HEXA_8, 8, pVM_output->numHexes(),
+							pVM_output->numHexes() ? pVM_output->getHexConn(0) : nullptr);
+	}
+	const emInt nCells = pVM_output->numCells();
+	pVM_output->clearCells();
+	return nCells;
+}
+
+// One of the coarser levels in a nested refinement.  Its dividers never
+// create verts:  they take theirs from the finest level's lattice, and make
+// their cells in the working mesh, with its vert indices.  levelVert
+// renumbers those for this level, and finestVert goes back to the finest
+// level's fine vert indices.
+struct CoarserLevel {
+	RefineVisitor *visitor;
+	std::vector<emInt> levelVert, finestVert;
+	TetDivider TD;
+	PyrDivider PD;
+	PrismDivider PrismD;
+	HexDivider HD;
+	BdryTriDivider BTD;
+	BdryQuadDivider BQD;
+	CoarserLevel(UMesh *const work, const int nDivs, RefineVisitor *const vis) :
+			visitor(vis), levelVert(work->maxNVerts(), EMINT_MAX), TD(work, nDivs),
+					PD(work, nDivs), PrismD(work, nDivs), HD(work, nDivs),
+					BTD(work, nDivs), BQD(work, nDivs) {
+	}
+	// Cells are tets, pyramids, prisms and hexes; bdry faces tris and quads.
+	CellDivider& getDivider(const int which) {
+		switch (which) {
+			case 0:
+				return TD;
+			case 1:
+				return PD;
+			case 2:
+				return PrismD;
+			case 3:
+				return HD;
+			case 4:
+				return BTD;
+			default:
+				assert(which == 5);
+				return BQD;
+		}
+	}
+};
+typedef std::vector<std::unique_ptr<CoarserLevel> > CoarserLevels;
+
+// Give the next indices in this level to verts, which are the work mesh's,
+// and pass them to this level's visitor.
+static void visitLevelVerts(CoarserLevel& level, const UMesh *const work,
+		const VisitedVerts& VV, const std::vector<emInt>& verts,
+		const emInt parent, const double uvw[][3]) {
+	if (verts.empty()) return;
+	const emInt firstVert = level.finestVert.size();
+	const emInt count = verts.size();
+	std::vector<double> coords(3 * size_t(count));
+	for (emInt vv = 0; vv < count; vv++) {
+		level.levelVert[verts[vv]] = firstVert + vv;
+		level.finestVert.push_back(VV.fineVert[verts[vv]]);
+		work->getCoords(verts[vv], &coords[3 * size_t(vv)]);
+	}
+	level.visitor->onVerts(firstVert, count,
+													reinterpret_cast<const double (*)[3]>(coords.data()));
+	if (level.visitor->wantsVertParents()) {
+		level.visitor->onVertParents(firstVert, count, parent, uvw);
+	}
+}
+
+// Pass count entities of one type from the working mesh to this level's
+// visitor, with this level's vert indices.
+static void visitLevelConn(CoarserLevel& level, const emInt parent,
+		const int type, const int nPts, const emInt count, const emInt conn[]) {
+	if (count == 0) return;
+	std::vector<emInt> levelConn(size_t(count) * nPts);
+	for (size_t ii = 0; ii < levelConn.size(); ii++) {
+		levelConn[ii] = level.levelVert[conn[ii]];
+		assert(levelConn[ii] != EMINT_MAX);
+	}
+	if (type == TRI_3 || type == QUAD_4) {
+		level.visitor->onBdryFaces(parent, type, count, levelConn.data());
+	}
+	else {
+		level.visitor->onCells(parent, type, count, levelConn.data());
+	}
+}
+
+// Divide coarse cell or bdry face parent into each coarser level, using
+// every ratio'th vert of the finest level's divider, and pass the children
+// to that level's visitor.  Verts a level hasn't seen yet are numbered in
+// lattice order; bdry faces only use verts their cells have already seen.
+static void visitCoarserLevels(CoarserLevels *const levels,
+		UMesh *const work, const VisitedVerts& VV, const CellDivider& finest,
+		const int which, const emInt parent) {
+	if (!levels) return;
+	for (auto& level : *levels) {
+		CellDivider& CD = level->getDivider(which);
+		CD.copyCoarserLattice(finest);
+		{
+			ScopedTimer cellTimer(eTimeCells);
+			CD.createNewCells();
+		}
+		if (which < 4) {
+			const int nDivs = CD.getNumDivs();
+			std::vector<emInt> newVerts;
+			std::vector<double> uvw;
+			for (int kk = 0; kk <= nDivs; kk++) {
+				for (int jj = CD.minJ(0, kk); jj <= CD.maxJ(0, kk); jj++) {
+					for (int ii = CD.minI(jj, kk); ii <= CD.maxI(jj, kk); ii++) {
+						const emInt vert = CD.getLocalVert(ii, jj, kk);
+						if (level->levelVert[vert] != EMINT_MAX) continue;
+						newVerts.push_back(vert);
+						uvw.resize(uvw.size() + 3);
+						CD.getParamCoords(ii, jj, kk, &uvw[uvw.size() - 3]);
+					}
+				}
+			}
+			visitLevelVerts(*level, work, VV, newVerts, parent,
+											reinterpret_cast<const double (*)[3]>(uvw.data()));
+		}
+		visitLevelConn(*level, parent, TRI_3, 3, work->numBdryTris(),
+										work->numBdryTris() ? work->getBdryTriConn(0) : nullptr);
+		visitLevelConn(*level, parent, QUAD_4, 4, work->numBdryQuads(),
+										work->numBdryQuads() ? work->getBdryQuadConn(0) : nullptr);
+		visitLevelConn(*level, parent, TETRA_4, 4, work->numTets(),
+										work->numTets() ? work->getTetConn(0) : nullptr);
+		visitLevelConn(*level, parent, PYRA_5, 5, work->numPyramids(),
+										work->numPyramids() ? work->getPyrConn(0) : nullptr);
+		visitLevelConn(*level, parent, PENTA_6, 6, work->numPrisms(),
+										work->numPrisms() ? work->getPrismConn(0) : nullptr);
+		visitLevelConn(*level, parent, HEXA_8, 8, work->numHexes(),
+										work->numHexes() ? work->getHexConn(0) : nullptr);
+		work->clearCells();
+	}
+}
+
+// Once a coarse cell has been visited at every level, nothing else uses its
+// interior verts, so their space in the work mesh can be reused.
+static void clearInteriorVerts(UMesh *const work, VisitedVerts& VV,
+		CoarserLevels *const levels, const CellDivider& CD) {
+	const emInt count = CD.countInteriorVerts();
+	const emInt first = work->numVerts() - count;
+	assert(VV.count == work->numVerts());
+	if (levels) {
+		for (auto& level : *levels) {
+			std::fill(level->levelVert.begin() + first,
+								level->levelVert.begin() + VV.count, EMINT_MAX);
+		}
+	}
+#ifndef NDEBUG
+	std::fill(VV.fineVert.begin() + first, VV.fineVert.begin() + VV.count,
+						EMINT_MAX);
+#endif
+	work->clearLastVerts(count);
+	VV.count = first;
+}
+
+// Progress lines are for watching a long serial refinement from a terminal,
+// so they're off unless asked for.
+static bool s_showRefineProgress = false;
+
+void showRefineProgress(const bool show) {
+	s_showRefineProgress = show;
+}
+
+// The cell dividers are templated on their mappings, so that evaluating the
+// mapping for each new vert is an inlined or direct call; this is the only
+// place where the choice of mapping is made at run time.  With a visitor,
+// the output mesh only has room for the children of one coarse cell, and
+// they're handed over as soon as they're made.
+template<class TetDiv, class PyrDiv, class PrismDiv, class HexDiv>
+static emInt subdivideWith(const ExaMesh *const pVM_input,
+		UMesh *const pVM_output, const int nDivs,
+		RefineVisitor *const visitor = nullptr,
+		CoarserLevels *const levels = nullptr, const bool showProgress = true) {
 	assert(nDivs >= 1);
+	ScopedTimer refineTimer(eTimeRefine);
+	const bool verbose = showProgress && s_showRefineProgress;
+	const emInt cellsBefore = pVM_output->numCells();
+	emInt coarseCell = 0, fineCellsVisited = 0;
+	VisitedVerts visited(visitor ? pVM_output->maxNVerts() : 0);
 	// Assumption:  the mesh is already ordered in a way that seems sensible
 	// to the caller, both cells and vertices.  As a result, we can create new
 	// verts and cells on the fly, with the expectation that the new ones will
@@ -73,9 +380,23 @@ emInt subdividePartMesh(const ExaMesh *const pVM_input, UMesh *const pVM_output,
 //				coords[1], coords[2], len);
 	}
 	assert(pVM_input->numVertsToCopy() == pVM_output->numVerts());
+	if (visitor) {
+		// The coarse verts have no parent cell, so they go by themselves.
+		visitNewVerts(pVM_output, visitor, visited, EMINT_MAX, nullptr);
+	}
+	if (levels) {
+		std::vector<emInt> coarseVerts(pVM_output->numVerts());
+		for (emInt vv = 0; vv < pVM_output->numVerts(); vv++) {
+			coarseVerts[vv] = vv;
+		}
+		for (auto& level : *levels) {
+			visitLevelVerts(*level, pVM_output, visited, coarseVerts, EMINT_MAX,
+											nullptr);
+		}
+	}
 
-	// Need to explicitly specify the type of mapping here.
-	TetDivider TD(pVM_output, pVM_input, nDivs);
+	ScopedTimer tetTimer(eTimeTetLoop);
+	TetDiv TD(pVM_output, pVM_input, nDivs);
 	for (emInt iT = 0; iT < pVM_input->numTets(); iT++) {
 		// Divide all the edges, including storing info about which new verts
 		// are on which edges
@@ -85,18 +406,27 @@ emInt subdividePartMesh(const ExaMesh *const pVM_input, UMesh *const pVM_output,
 				vertsOnQuads);
 
 		// And now the moment of truth:  create a flock of new tets.
-		TD.createNewCells();
-		if ((iT + 1) % 100000 == 0)
+		{
+			ScopedTimer cellTimer(eTimeCells);
+			TD.createNewCells();
+		}
+		fineCellsVisited += visitNewEntities(pVM_output, visitor, visited,
+																					coarseCell, &TD);
+		visitCoarserLevels(levels, pVM_output, visited, TD, 0, coarseCell++);
+		if (visitor) clearInteriorVerts(pVM_output, visited, levels, TD);
+		if (verbose && (iT + 1) % 100000 == 0)
 			fprintf(
 			stderr, "Refined %'12d tets.  Tree sizes: %'12lu %'12lu %'12lu\r",
 					iT + 1, vertsOnEdges.size(), vertsOnTris.size(),
 					vertsOnQuads.size());
 	} // Done looping over all tets
+	tetTimer.stop();
 #ifndef NDEBUG
-	fprintf(stderr, "\nDone with tets\n");
+	if (verbose) fprintf(stderr, "\nDone with tets\n");
 #endif
 
-	PyrDivider PD(pVM_output, pVM_input, nDivs);
+	ScopedTimer pyrTimer(eTimePyrLoop);
+	PyrDiv PD(pVM_output, pVM_input, nDivs);
 	for (emInt iP = 0; iP < pVM_input->numPyramids(); iP++) {
 		// Divide all the edges, including storing info about which new verts
 		// are on which edges
@@ -107,60 +437,100 @@ emInt subdividePartMesh(const ExaMesh *const pVM_input, UMesh *const pVM_output,
 				vertsOnQuads);
 
 		// And now the moment of truth:  create a flock of new pyramids.
-		PD.createNewCells();
-		if ((iP + 1) % 100000 == 0)
+		{
+			ScopedTimer cellTimer(eTimeCells);
+			PD.createNewCells();
+		}
+		fineCellsVisited += visitNewEntities(pVM_output, visitor, visited,
+																					coarseCell, &PD);
+		visitCoarserLevels(levels, pVM_output, visited, PD, 1, coarseCell++);
+		if (visitor) clearInteriorVerts(pVM_output, visited, levels, PD);
+		if (verbose && (iP + 1) % 100000 == 0)
 			fprintf(
 			stderr, "Refined %'12d pyrs.  Tree sizes: %'12lu %'12lu %'12lu\r",
 					iP + 1, vertsOnEdges.size(), vertsOnTris.size(),
 					vertsOnQuads.size());
 	} // Done looping over all pyramids
+	pyrTimer.stop();
 #ifndef NDEBUG
-	fprintf(stderr, "\nDone with pyramids\n");
+	if (verbose) fprintf(stderr, "\nDone with pyramids\n");
 #endif
 
-	PrismDivider PrismD(pVM_output, pVM_input, nDivs);
+	ScopedTimer prismTimer(eTimePrismLoop);
+	PrismDiv PrismD(pVM_output, pVM_input, nDivs);
 	for (emInt iP = 0; iP < pVM_input->numPrisms(); iP++) {
 		// Divide all the edges, including storing info about which new verts
 		// are on which edges
 		const emInt *const thisPrism = pVM_input->getPrismConn(iP);
 		PrismD.setupCoordMapping(thisPrism);
-		PrismD.createDivisionVerts(vertsOnEdges, vertsOnTris,
-				vertsOnQuads);
+		// A visitor needs the coords of each cell's verts right away.
+		if (visitor) {
+			PrismD.createDivisionVerts(vertsOnEdges, vertsOnTris, vertsOnQuads);
+		}
+		else {
+			PrismD.createDivisionVertsDeferred(vertsOnEdges, vertsOnTris,
+					vertsOnQuads);
+		}
 
 		// And now the moment of truth:  create a flock of new prisms.
-		PrismD.createNewCells();
-		if ((iP + 1) % 100000 == 0)
+		{
+			ScopedTimer cellTimer(eTimeCells);
+			PrismD.createNewCells();
+		}
+		fineCellsVisited += visitNewEntities(pVM_output, visitor, visited,
+																					coarseCell, &PrismD);
+		visitCoarserLevels(levels, pVM_output, visited, PrismD, 2, coarseCell++);
+		if (visitor) clearInteriorVerts(pVM_output, visited, levels, PrismD);
+		if (verbose && (iP + 1) % 100000 == 0)
 			fprintf(
 			stderr, "Refined %'12d prisms.  Tree sizes: %'12lu %'12lu %'12lu\r",
 					iP + 1, vertsOnEdges.size(), vertsOnTris.size(),
 					vertsOnQuads.size());
 	} // Done looping over all prisms
+	PrismD.flushInteriorVerts();
+	prismTimer.stop();
 #ifndef NDEBUG
-	fprintf(stderr, "\nDone with prisms\n");
+	if (verbose) fprintf(stderr, "\nDone with prisms\n");
 #endif
 
-	HexDivider HD(pVM_output, pVM_input, nDivs);
+	ScopedTimer hexTimer(eTimeHexLoop);
+	HexDiv HD(pVM_output, pVM_input, nDivs);
 	for (emInt iH = 0; iH < pVM_input->numHexes(); iH++) {
 		// Divide all the edges, including storing info about which new verts
 		// are on which edges
 		const emInt *const thisHex = pVM_input->getHexConn(iH);
 		HD.setupCoordMapping(thisHex);
 
-		HD.createDivisionVerts(vertsOnEdges, vertsOnTris,
-				vertsOnQuads);
+		if (visitor) {
+			HD.createDivisionVerts(vertsOnEdges, vertsOnTris, vertsOnQuads);
+		}
+		else {
+			HD.createDivisionVertsDeferred(vertsOnEdges, vertsOnTris,
+					vertsOnQuads);
+		}
 
 		// And now the moment of truth:  create a flock of new hexes.
-		HD.createNewCells();
-		if ((iH + 1) % 100000 == 0)
+		{
+			ScopedTimer cellTimer(eTimeCells);
+			HD.createNewCells();
+		}
+		fineCellsVisited += visitNewEntities(pVM_output, visitor, visited,
+																					coarseCell, &HD);
+		visitCoarserLevels(levels, pVM_output, visited, HD, 3, coarseCell++);
+		if (visitor) clearInteriorVerts(pVM_output, visited, levels, HD);
+		if (verbose && (iH + 1) % 100000 == 0)
 			fprintf(
 			stderr, "Refined %'12d hexes.  Tree sizes: %'12lu %'12lu %'12lu\r",
 					iH + 1, vertsOnEdges.size(), vertsOnTris.size(),
 					vertsOnQuads.size());
 	} // Done looping over all hexes
+	HD.flushInteriorVerts();
+	hexTimer.stop();
 #ifndef NDEBUG
-	fprintf(stderr, "\nDone with hexes\n");
+	if (verbose) fprintf(stderr, "\nDone with hexes\n");
 #endif
 
+	ScopedTimer bdryTriTimer(eTimeBdryTriLoop);
 	BdryTriDivider BTD(pVM_output, nDivs);
 	for (emInt iBT = 0; iBT < pVM_input->numBdryTris(); iBT++) {
 		const emInt *const thisBdryTri = pVM_input->getBdryTriConn(iBT);
@@ -169,18 +539,30 @@ emInt subdividePartMesh(const ExaMesh *const pVM_input, UMesh *const pVM_output,
 		// copy the vertices into the CellDivider internal data structure.
 		BTD.createDivisionVerts(vertsOnEdges, vertsOnTris, vertsOnQuads);
 
-		BTD.createNewCells();
-		if ((iBT + 1) % 100000 == 0)
+		{
+			ScopedTimer cellTimer(eTimeCells);
+			BTD.createNewCells();
+		}
+		if (visitor) {
+			visitNewEntities(pVM_output, visitor, visited, iBT, nullptr);
+			visitCoarserLevels(levels, pVM_output, visited, BTD, 4, iBT);
+		}
+		else if (pVM_input->isPartMesh() && pVM_input->isPartBdryTri(iBT)) {
+			recordPartBdryFace(pVM_input, pVM_output, 3, thisBdryTri, BTD, nDivs);
+		}
+		if (verbose && (iBT + 1) % 100000 == 0)
 			fprintf(
 			stderr,
 					"Refined %'12d bdry tris.  Tree sizes: %'12lu %'12lu %'12lu\r",
 					iBT + 1, vertsOnEdges.size(), vertsOnTris.size(),
 					vertsOnQuads.size());
 	}
+	bdryTriTimer.stop();
 #ifndef NDEBUG
-	fprintf(stderr, "\nDone with bdry tris\n");
+	if (verbose) fprintf(stderr, "\nDone with bdry tris\n");
 #endif
 
+	ScopedTimer bdryQuadTimer(eTimeBdryQuadLoop);
 	BdryQuadDivider BQD(pVM_output, nDivs);
 	for (emInt iBQ = 0; iBQ < pVM_input->numBdryQuads(); iBQ++) {
 		const emInt *const thisBdryQuad = pVM_input->getBdryQuadConn(iBQ);
@@ -190,30 +572,171 @@ emInt subdividePartMesh(const ExaMesh *const pVM_input, UMesh *const pVM_output,
 		// copies the triangle vertices into the CellDivider internal data structure.
 		BQD.createDivisionVerts(vertsOnEdges, vertsOnTris, vertsOnQuads);
 
-		BQD.createNewCells();
-		if ((iBQ + 1) % 100000 == 0)
+		{
+			ScopedTimer cellTimer(eTimeCells);
+			BQD.createNewCells();
+		}
+		if (visitor) {
+			visitNewEntities(pVM_output, visitor, visited, iBQ, nullptr);
+			visitCoarserLevels(levels, pVM_output, visited, BQD, 5, iBQ);
+		}
+		else if (pVM_input->isPartMesh() && pVM_input->isPartBdryQuad(iBQ)) {
+			recordPartBdryFace(pVM_input, pVM_output, 4, thisBdryQuad, BQD, nDivs);
+		}
+		if (verbose && (iBQ + 1) % 100000 == 0)
 			fprintf(
 			stderr,
 					"Refined %'12d bdry quads.  Tree sizes: %'12lu %'12lu %'12lu\r",
 					iBQ + 1, vertsOnEdges.size(), vertsOnTris.size(),
 					vertsOnQuads.size());
 	}
+	bdryQuadTimer.stop();
 #ifndef NDEBUG
-	fprintf(stderr, "\nDone with bdry quads\n");
+	if (verbose) fprintf(stderr, "\nDone with bdry quads\n");
 #endif
 
 //	assert(vertsOnTris.empty());
 //	assert(vertsOnQuads.empty());
 //
 #ifndef NDEBUG
-	fprintf(stderr, "Final size of edge list: %'lu\n", vertsOnEdges.size());
-	fprintf(stderr, "Final size of tri list: %'lu\n", vertsOnTris.size());
-	fprintf(stderr, "Final size of quad list: %'lu\n", vertsOnQuads.size());
+	if (verbose) {
+		fprintf(stderr, "Final size of edge list: %'lu\n", vertsOnEdges.size());
+		fprintf(stderr, "Final size of tri list: %'lu\n", vertsOnTris.size());
+		fprintf(stderr, "Final size of quad list: %'lu\n", vertsOnQuads.size());
+	}
 #endif
 
+	instrumentCount(eCountVertsCreated,
+									(visitor ? visited.nFine : pVM_output->numVerts())
+											- pVM_input->numVertsToCopy());
+	if (levels) {
+		for (auto& level : *levels) {
+			level->visitor->onDone();
+		}
+	}
+	if (visitor) {
+		visitor->onDone();
+		instrumentCount(eCountCellsCreated, fineCellsVisited);
+		return fineCellsVisited;
+	}
+	instrumentCount(eCountCellsCreated, pVM_output->numCells() - cellsBefore);
 	return pVM_output->numCells();
 }
 
+emInt subdividePartMesh(const ExaMesh *const pVM_input, UMesh *const pVM_output,
+		const int nDivs, const bool showProgress) {
+	switch (pVM_input->getDefaultMappingType()) {
+		case Mapping::Lagrange:
+			return subdivideWith<CubicTetDivider, CubicPyrDivider, CubicPrismDivider,
+					CubicHexDivider>(pVM_input, pVM_output, nDivs, nullptr, nullptr,
+														showProgress);
+		case Mapping::Uniform:
+		default:
+			return subdivideWith<Q1TetDivider, Q1PyrDivider, Q1PrismDivider,
+					Q1HexDivider>(pVM_input, pVM_output, nDivs, nullptr, nullptr,
+												showProgress);
+	}
+}
+
+// Everything goes to the visitors, so the working mesh only has room for
+// the verts that are shared between coarse cells, the interior verts of one
+// coarse cell, and the children of one coarse cell or bdry face.  The
+// finest level's visitor is the last.
+static emInt subdivideVisited(const ExaMesh *const pVM_input,
+		const int nLevels, const int nDivs[], RefineVisitor *const visitors[],
+		std::vector<emInt> coarseToFine[]) {
+	const emInt n = nDivs[nLevels - 1];
+	MeshSize MS = pVM_input->computeFineMeshSize(n);
+	// Interior verts of each cell type, as in countFineVerts.
+	const ssize_t nn = n;
+	const ssize_t interiorVerts = pVM_input->numTets()
+			* ((nn - 3) * (nn - 2) * (nn - 1) / 6)
+			+ pVM_input->numPyramids() * ((2 * nn - 3) * (nn - 2) * (nn - 1) / 6)
+			+ pVM_input->numPrisms() * ((nn - 1) * (nn - 2) * (nn - 1) / 2)
+			+ pVM_input->numHexes() * ((nn - 1) * (nn - 1) * (nn - 1));
+	const emInt workVerts = MS.nVerts - interiorVerts
+			+ (nn - 1) * (nn - 1) * (nn - 1);
+	const emInt tetsPerPyr = (n * n * n - n) * 2 / 3;
+	UMesh work(workVerts, MS.nBdryVerts, n * n, n * n,
+							std::max(n * n * n, tetsPerPyr), (2 * n * n * n + n) / 3,
+							n * n * n, n * n * n);
+	CoarserLevels levels;
+	for (int ll = 0; ll < nLevels - 1; ll++) {
+		levels.emplace_back(new CoarserLevel(&work, nDivs[ll], visitors[ll]));
+	}
+	CoarserLevels *const pLevels = levels.empty() ? nullptr : &levels;
+	emInt nCells;
+	switch (pVM_input->getDefaultMappingType()) {
+		case Mapping::Lagrange:
+			nCells = subdivideWith<CubicTetDivider, CubicPyrDivider,
+					CubicPrismDivider, CubicHexDivider>(pVM_input, &work, n,
+																							visitors[nLevels - 1], pLevels);
+			break;
+		case Mapping::Uniform:
+		default:
+			nCells = subdivideWith<Q1TetDivider, Q1PyrDivider, Q1PrismDivider,
+					Q1HexDivider>(pVM_input, &work, n, visitors[nLevels - 1], pLevels);
+			break;
+	}
+	if (coarseToFine) {
+		for (int ll = 0; ll < nLevels - 1; ll++) {
+			const std::vector<emInt>& finestVert = levels[ll]->finestVert;
+			if (ll + 2 == nLevels) {
+				coarseToFine[ll] = finestVert;
+				continue;
+			}
+			// The next level's verts, in order of the finest level's indices.
+			const std::vector<emInt>& nextFinest = levels[ll + 1]->finestVert;
+			std::vector<std::pair<emInt, emInt> > nextVerts(nextFinest.size());
+			for (size_t vv = 0; vv < nextFinest.size(); vv++) {
+				nextVerts[vv] = std::make_pair(nextFinest[vv], emInt(vv));
+			}
+			std::sort(nextVerts.begin(), nextVerts.end());
+			coarseToFine[ll].resize(finestVert.size());
+			for (size_t vv = 0; vv < finestVert.size(); vv++) {
+				auto iter = std::lower_bound(nextVerts.begin(), nextVerts.end(),
+						std::make_pair(finestVert[vv], emInt(0)));
+				assert(iter != nextVerts.end() && iter->first == finestVert[vv]);
+				coarseToFine[ll][vv] = iter->second;
+			}
+		}
+	}
+	return nCells;
+}
+
+emInt subdividePartMesh(const ExaMesh *const pVM_input,
+		RefineVisitor& visitor, const int nDivs) {
+	// Part bdry faces only get recorded in an output mesh.
+	assert(!pVM_input->isPartMesh());
+	RefineVisitor *const visitors[] = { &visitor };
+	return subdivideVisited(pVM_input, 1, &nDivs, visitors, nullptr);
+}
+
+bool subdivideNestedLevels(const ExaMesh *const pVM_input, const int nLevels,
+		const int nDivs[], RefineVisitor *const visitors[],
+		std::vector<emInt> coarseToFine[]) {
+	assert(!pVM_input->isPartMesh());
+	if (nLevels < 1) {
+		fprintf(stderr, "Need at least one level to refine into.\n");
+		return false;
+	}
+	const int finest = nDivs[nLevels - 1];
+	if (finest > MAX_DIVS) {
+		fprintf(stderr, "Can't divide by more than %d.\n", MAX_DIVS);
+		return false;
+	}
+	for (int ll = 0; ll < nLevels; ll++) {
+		if (nDivs[ll] < 1 || (ll > 0 && (nDivs[ll] <= nDivs[ll - 1]
+				|| nDivs[ll] % nDivs[ll - 1] != 0))) {
+			fprintf(stderr, "Each level must divide the next one; %d doesn't.\n",
+							ll > 0 ? nDivs[ll - 1] : nDivs[ll]);
+			return false;
+		}
+	}
+	subdivideVisited(pVM_input, nLevels, nDivs, visitors, coarseToFine);
+	return true;
+}
+
 bool computeMeshSize(const struct MeshSize &MSIn, const emInt nDivs,
 		struct MeshSize &MSOut) {
 	// It's relatively easy to compute some of these quantities:
@@ -274,3 +797,111 @@ bool computeMeshSize(const struct MeshSize &MSIn, const emInt nDivs,
 	return true;
 }
 
+
+// Bytes used by a UMesh of the given size.  This mirrors the buffer layout
+// in UMesh::init, plus the length scale array.
+static size_t uMeshBytes(const struct MeshSize &MS) {
+	size_t intSize = sizeof(emInt);
+	size_t headerSize = 7 * intSize + 4;
+	size_t coordSize = 3 * sizeof(double) * size_t(MS.nVerts);
+	size_t connSize = (3 * size_t(MS.nBdryTris) + 4 * size_t(MS.nBdryQuads)
+			+ 4 * size_t(MS.nTets) + 5 * size_t(MS.nPyrs) + 6 * size_t(MS.nPrisms)
+			+ 8 * size_t(MS.nHexes)) * intSize;
+	size_t BCSize = (size_t(MS.nBdryTris) + MS.nBdryQuads) * intSize;
+	size_t lenScaleSize = sizeof(double) * size_t(MS.nVerts);
+	return headerSize + coordSize + connSize + BCSize + 8 + lenScaleSize;
+}
+
+// Each hash table entry costs the payload, a node with a next pointer and
+// cached hash, and (at a load factor of one) a bucket pointer.
+template<typename T>
+static size_t hashEntryBytes() {
+	return sizeof(T) + 3 * sizeof(void*);
+}
+
+size_t estimateRefinementMemory(const struct MeshSize &MSIn,
+		const emInt nDivs) {
+	MeshSize MSOut;
+	if (!computeMeshSize(MSIn, nDivs, MSOut)) {
+		return SIZE_MAX;
+	}
+
+	// The coarse mesh and the fine mesh are both alive during refinement.
+	size_t bytes = uMeshBytes(MSIn) + uMeshBytes(MSOut);
+
+	size_t inputTris = (size_t(MSIn.nBdryTris) + MSIn.nTets * size_t(4)
+			+ MSIn.nPyrs * size_t(4) + MSIn.nPrisms * size_t(2)) / 2;
+	size_t inputQuads = (size_t(MSIn.nBdryQuads) + MSIn.nPyrs
+			+ MSIn.nPrisms * size_t(3) + MSIn.nHexes * size_t(6)) / 2;
+	size_t inputCells = size_t(MSIn.nTets) + MSIn.nPyrs + MSIn.nPrisms
+			+ MSIn.nHexes;
+
+	// Edges are assumed never to be removed from the edge map, which is
+	// a slight overestimate.  Genus is ignored.
+	ssize_t inputEdges = ssize_t(MSIn.nVerts) + inputTris + inputQuads
+			- inputCells - 1;
+	if (inputEdges < 0) inputEdges = 0;
+	bytes += inputEdges * hashEntryBytes<std::pair<const Edge, EdgeVerts> >();
+
+	// Faces are dropped from the face sets once both sides have been seen, so
+	// what's left at the peak is the boundary of the part plus the front
+	// between done and not-done cells.  Face data is large, so a bound based
+	// on all the faces would be wildly pessimistic.
+	double front = 2 * pow(double(inputCells), 2. / 3.);
+	size_t liveTris = std::min(inputTris,
+			size_t(MSIn.nBdryTris + front * inputTris / (inputTris + inputQuads + 1)));
+	size_t liveQuads = std::min(inputQuads,
+			size_t(MSIn.nBdryQuads + front * inputQuads / (inputTris + inputQuads + 1)));
+	bytes += liveTris * hashEntryBytes<TriFaceVerts>()
+			+ liveQuads * hashEntryBytes<QuadFaceVerts>();
+
+	return bytes;
+}
+
+size_t ugridFileBytes(const struct MeshSize &MS) {
+	size_t intSize = sizeof(emInt);
+	size_t headerSize = 7 * intSize;
+	size_t coordSize = 3 * sizeof(double) * size_t(MS.nVerts);
+	size_t connSize = (3 * size_t(MS.nBdryTris) + 4 * size_t(MS.nBdryQuads)
+			+ 4 * size_t(MS.nTets) + 5 * size_t(MS.nPyrs) + 6 * size_t(MS.nPrisms)
+			+ 8 * size_t(MS.nHexes)) * intSize;
+	size_t BCSize = (size_t(MS.nBdryTris) + MS.nBdryQuads) * intSize;
+	return headerSize + coordSize + connSize + BCSize;
+}
+
+// Single-thread costs of refinement, from bench-exa runs (-O3, one thread,
+// 2 to 8 divisions) fit to a + b * (fine cells) for each cell type.  The
+// per-coarse-cell part is mostly hashing edges and faces; the per-fine-cell
+// part is mapping new verts and writing connectivity.  Pyramids weren't
+// isolated, and are taken to be between tets and hexes.  These are only
+// good for rough planning on other hardware.
+static const double coarseTetCost = 3.6e-5;
+static const double coarsePyrCost = 5.0e-5;
+static const double coarsePrismCost = 5.4e-5;
+static const double coarseHexCost = 6.6e-5;
+static const double fineTetCost = 2.7e-7;
+static const double finePyrCost = 3.0e-7;
+static const double finePrismCost = 2.6e-7;
+static const double fineHexCost = 5.9e-7;
+// Extracting a coarse part, per coarse cell.
+static const double extractCost = 2.5e-5;
+// Sustained write bandwidth, in bytes per second.
+static const double writeRate = 1.e9;
+
+double estimateExtractTime(const struct MeshSize &MSIn) {
+	return (double(MSIn.nTets) + MSIn.nPyrs + MSIn.nPrisms + MSIn.nHexes)
+			* extractCost;
+}
+
+double estimateRefinementTime(const struct MeshSize &MSIn,
+		const emInt nDivs) {
+	double volFactor = double(nDivs) * nDivs * nDivs;
+	return MSIn.nTets * (coarseTetCost + volFactor * fineTetCost)
+			+ MSIn.nPyrs * (coarsePyrCost + volFactor * finePyrCost)
+			+ MSIn.nPrisms * (coarsePrismCost + volFactor * finePrismCost)
+			+ MSIn.nHexes * (coarseHexCost + volFactor * fineHexCost);
+}
+
+double estimateWriteTime(const size_t bytes) {
+	return bytes / writeRate;
+}
@@ -24,11 +24,24 @@
  */
 
 #define BOOST_TEST_MODULE test-exa
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
 #include <boost/test/unit_test.hpp>
 
 #include "ExaMesh.h"
 #include "UMesh.h"
 #include "CubicMesh.h"
+#include "HashedFaceCellVisitor.h"
+#include "ParentMapVisitor.h"
+#include "ImplicitRefinedMesh.h"
+#include "Instrument.h"
+#include "SharedUGrid.h"
 
 #include "TetDivider.h"
 #include "PyrDivider.h"
@@ -36,6 +49,7 @@
 #include "HexDivider.h"
 
 #include "Mapping.h"
+#include "GeomUtils.h"
 
 #define DO_SUBDIVISION_TESTS
 
@@ -92,6 +106,7 @@ struct MixedMeshFixture {
 	}
 	~MixedMeshFixture() {
 		delete pUM_In;
+		delete pUM_Out;
 	}
 };
 
@@ -411,6 +426,56 @@ BOOST_AUTO_TEST_CASE(CubicHex) {
 		BOOST_CHECK_CLOSE(LCHMxyz[2], xyz[ii][2], 1.e-8);
 	}
 }
+
+BOOST_AUTO_TEST_CASE(ReorderCubicMesh) {
+	// Enough nodes, in a scrambled order, that the permutation has cycles
+	// longer than one segment.
+	const emInt nTets = 10000, nNodes = 20 * nTets;
+	std::vector<emInt> order(nNodes);
+	for (emInt ii = 0; ii < nNodes; ii++) {
+		order[ii] = ii;
+	}
+	unsigned seed = 12345;
+	for (emInt ii = nNodes - 1; ii > 0; ii--) {
+		seed = seed * 1103515245 + 12345;
+		std::swap(order[ii], order[(seed >> 8) % (ii + 1)]);
+	}
+	CubicMesh CM(nNodes, 0, 0, 0, nTets, 0, 0, 0);
+	for (emInt ii = 0; ii < nNodes; ii++) {
+		double xyz[] = { double(ii), -double(ii), 0.5 * ii };
+		CM.addVert(xyz);
+	}
+	for (emInt ii = 0; ii < nTets; ii++) {
+		CM.addTet(&order[20 * ii]);
+	}
+	CM.reorderCubicMesh();
+	BOOST_CHECK_EQUAL(CM.numVertsToCopy(), 4 * nTets);
+
+	// Vertex nodes come first, and otherwise nodes keep their order.  Every
+	// node still has its own coords.
+	bool cornersFirst = true, coordsMatch = true, orderKept = true;
+	std::vector<emInt> newIndex(nNodes);
+	for (emInt ii = 0; ii < nTets; ii++) {
+		const emInt* conn = CM.getTetConn(ii);
+		for (int jj = 0; jj < 20; jj++) {
+			cornersFirst = cornersFirst && ((jj < 4) == (conn[jj] < 4 * nTets));
+			double xyz[3];
+			CM.getCoords(conn[jj], xyz);
+			emInt original = order[20 * ii + jj];
+			coordsMatch = coordsMatch && xyz[0] == original && xyz[1] == -xyz[0]
+					&& xyz[2] == 0.5 * original;
+			newIndex[original] = conn[jj];
+		}
+	}
+	for (emInt ii = 1; ii < nNodes; ii++) {
+		bool sameKind = (newIndex[ii - 1] < 4 * nTets)
+				== (newIndex[ii] < 4 * nTets);
+		orderKept = orderKept && (!sameKind || newIndex[ii - 1] < newIndex[ii]);
+	}
+	BOOST_CHECK(cornersFirst);
+	BOOST_CHECK(coordsMatch);
+	BOOST_CHECK(orderKept);
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_FIXTURE_TEST_SUITE(MappingTests, MixedMeshFixture)
@@ -420,7 +485,7 @@ BOOST_AUTO_TEST_CASE(EdgeMappingUniform)
 	// Check the uniform length scale cases.
 	makeLengthScaleUniform(pUM_In);
 
-	TetDivider TD(pUM_Out, pUM_In, 4);
+	Q1TetDivider TD(pUM_Out, pUM_In, 4);
 
 	// Compute point locations and compare to the analytic
 	// result
@@ -451,7 +516,7 @@ BOOST_AUTO_TEST_CASE(TetFaceMappingUniform) {
 	// Check the uniform length scale cases.
 	makeLengthScaleUniform(pUM_In);
 
-	TetDivider TD(pUM_Out, pUM_In, 4);
+	Q1TetDivider TD(pUM_Out, pUM_In, 4);
 	// Compute point locations and compare to the analytic
 	// result
 	const emInt *const thisTet = pUM_In->getTetConn(0);
@@ -489,7 +554,7 @@ BOOST_AUTO_TEST_CASE(PyramidFaceMappingUniform) {
 	// Check the uniform length scale cases.
 makeLengthScaleUniform(pUM_In);
 
-	PyrDivider PD(pUM_Out, pUM_In, 4);
+	Q1PyrDivider PD(pUM_Out, pUM_In, 4);
 	// Compute point locations and compare to the analytic
 	// result
 	const emInt *const thisPyr = pUM_In->getPyrConn(0);
@@ -548,7 +613,7 @@ BOOST_AUTO_TEST_CASE(PrismFaceMappingUniform) {
 	// Check the uniform length scale cases.
 makeLengthScaleUniform(pUM_In);
 
-	PrismDivider PD(pUM_Out, pUM_In, 4);
+	Q1PrismDivider PD(pUM_Out, pUM_In, 4);
 	// Compute point locations and compare to the analytic
 	// result
 	const emInt *const thisPrism = pUM_In->getPrismConn(0);
@@ -607,7 +672,7 @@ BOOST_AUTO_TEST_CASE(HexFaceMappingUniform) {
 	// Check the uniform length scale cases.
 makeLengthScaleUniform(pUM_In);
 
-	HexDivider HD(pUM_Out, pUM_In, 4);
+	Q1HexDivider HD(pUM_Out, pUM_In, 4);
 	// Compute point locations and compare to the analytic
 	// result
 	const emInt *const thisHex = pUM_In->getHexConn(0);
@@ -645,7 +710,7 @@ BOOST_AUTO_TEST_CASE(TetMappingUniform) {
 	// Check the uniform length scale cases.
 makeLengthScaleUniform(pUM_In);
 
-	TetDivider TD(pUM_Out, pUM_In, 5);
+	Q1TetDivider TD(pUM_Out, pUM_In, 5);
 
 	const emInt *const thisTet = pUM_In->getTetConn(0);
 	TD.setupCoordMapping(thisTet);
@@ -706,7 +771,7 @@ BOOST_AUTO_TEST_CASE(PyramidMappingUniform) {
 	// Check the uniform length scale cases.
 makeLengthScaleUniform(pUM_In);
 
-	PyrDivider PD(pUM_Out, pUM_In, 5);
+	Q1PyrDivider PD(pUM_Out, pUM_In, 5);
 
 	const emInt *const thisPyr = pUM_In->getPyrConn(0);
 	PD.setupCoordMapping(thisPyr);
@@ -753,7 +818,7 @@ BOOST_AUTO_TEST_CASE(PrismMappingUniform) {
 	// Check the uniform length scale cases.
 makeLengthScaleUniform(pUM_In);
 
-	PrismDivider PD(pUM_Out, pUM_In, 4);
+	Q1PrismDivider PD(pUM_Out, pUM_In, 4);
 
 	const emInt *const thisPrism = pUM_In->getPrismConn(0);
 	PD.setupCoordMapping(thisPrism);
@@ -802,7 +867,7 @@ BOOST_AUTO_TEST_CASE(HexMappingUniform) {
 	// Check the uniform length scale cases.
 	makeLengthScaleUniform(pUM_In);
 
-	HexDivider HD(pUM_Out, pUM_In, 3);
+	Q1HexDivider HD(pUM_Out, pUM_In, 3);
 
 	const emInt *const thisHex = pUM_In->getHexConn(0);
 	HD.setupCoordMapping(thisHex);
@@ -843,11 +908,51 @@ BOOST_AUTO_TEST_CASE(HexMappingUniform) {
 	}
 }
 
+BOOST_AUTO_TEST_CASE(BatchedInteriorVerts) {
+	printf("Batched interior verts\n");
+	// Non-uniform, so that the interior param coords aren't trivial.
+	setPrescribedLengthScale(pUM_In);
+
+	Q1PrismDivider PD(pUM_Out, pUM_In, 4);
+	PD.setupCoordMapping(pUM_In->getPrismConn(0));
+	PD.createDivisionVertsDeferred(vertsOnEdges, vertsOnTris, vertsOnQuads);
+
+	Q1HexDivider HD(pUM_Out, pUM_In, 4);
+	HD.setupCoordMapping(pUM_In->getHexConn(0));
+	HD.createDivisionVertsDeferred(vertsOnEdges, vertsOnTris, vertsOnQuads);
+
+	PD.flushInteriorVerts();
+	HD.flushInteriorVerts();
+
+	// The batched coords must match evaluating one vert at a time exactly.
+	for (int kk = 1; kk < 4; kk++) {
+		for (int jj = 1; jj < 4; jj++) {
+			for (int ii = 1; ii < 4; ii++) {
+				double uvw[3], xyz[3];
+				emInt vert = HD.getLocalVert(ii, jj, kk);
+				HD.getParamCoords(ii, jj, kk, uvw);
+				HD.getPhysCoordsFromParamCoords(uvw, xyz);
+				BOOST_CHECK_EQUAL(pUM_Out->getX(vert), xyz[0]);
+				BOOST_CHECK_EQUAL(pUM_Out->getY(vert), xyz[1]);
+				BOOST_CHECK_EQUAL(pUM_Out->getZ(vert), xyz[2]);
+				if (ii + jj < 4) {
+					vert = PD.getLocalVert(ii, jj, kk);
+					PD.getParamCoords(ii, jj, kk, uvw);
+					PD.getPhysCoordsFromParamCoords(uvw, xyz);
+					BOOST_CHECK_EQUAL(pUM_Out->getX(vert), xyz[0]);
+					BOOST_CHECK_EQUAL(pUM_Out->getY(vert), xyz[1]);
+					BOOST_CHECK_EQUAL(pUM_Out->getZ(vert), xyz[2]);
+				}
+			}
+		}
+	}
+}
+
 BOOST_AUTO_TEST_CASE(EdgeMappingNonuniformPrescribed) {
 	printf("Edge non-uniform mapping\n");
 	setPrescribedLengthScale(pUM_In);
 
-	TetDivider TD(pUM_Out, pUM_In, 4);
+	Q1TetDivider TD(pUM_Out, pUM_In, 4);
 
 	// Compute point locations and compare to the analytic
 	// result
@@ -1334,6 +1439,29 @@ BOOST_AUTO_TEST_CASE(SizeTestMixedMeshBy3) {
 	BOOST_CHECK_EQUAL(MSOut.nHexes, 21600);
 }
 
+BOOST_AUTO_TEST_CASE(MemoryEstimate) {
+	MeshSize MSIn, MSOut;
+	MSIn.nBdryVerts = 11;
+	MSIn.nVerts = 11;
+	MSIn.nBdryTris = 6;
+	MSIn.nBdryQuads = 6;
+	MSIn.nTets = 1;
+	MSIn.nPyrs = 1;
+	MSIn.nPrisms = 1;
+	MSIn.nHexes = 1;
+	computeMeshSize(MSIn, 4, MSOut);
+	UMesh UMOut(MSOut.nVerts, MSOut.nBdryVerts, MSOut.nBdryTris,
+			MSOut.nBdryQuads, MSOut.nTets, MSOut.nPyrs, MSOut.nPrisms,
+			MSOut.nHexes);
+
+	// The estimate must at least cover the fine mesh itself, and grow with
+	// the number of divisions.
+	size_t bytes4 = estimateRefinementMemory(MSIn, 4);
+	BOOST_CHECK_GT(bytes4, UMOut.getFileImageSize());
+	BOOST_CHECK_GT(estimateRefinementMemory(MSIn, 8), bytes4);
+	BOOST_CHECK_LT(estimateRefinementMemory(MSIn, 2), bytes4);
+}
+
 BOOST_AUTO_TEST_CASE(SingleTetN2) {
 	UMesh UM(4, 4, 4, 0, 1, 0, 0, 0);
 
@@ -1646,5 +1774,1315 @@ BOOST_AUTO_TEST_CASE(MixedN5) {
 	BOOST_CHECK(result);
 }
 
+static std::vector<char> readWholeFile(const char fileName[]) {
+	std::vector<char> contents;
+	FILE* inFile = fopen(fileName, "r");
+	if (!inFile) return contents;
+	char buffer[4096];
+	size_t bytes;
+	while ((bytes = fread(buffer, 1, sizeof(buffer), inFile)) > 0) {
+		contents.insert(contents.end(), buffer, buffer + bytes);
+	}
+	fclose(inFile);
+	return contents;
+}
+
+BOOST_AUTO_TEST_CASE(UGridOutputFormats) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+	makeLengthScaleUniform(&UM);
+
+	UMesh UMOut(UM, 3);
+	UGridFormat format;
+	BOOST_CHECK(parseUGridInfix("lb4", format));
+	BOOST_CHECK_EQUAL(format.coordBytes, 4);
+	BOOST_CHECK(!format.bigEndian);
+	BOOST_CHECK(!format.fortranRecords);
+	BOOST_CHECK(parseUGridInfix("r8", format));
+	BOOST_CHECK_EQUAL(format.coordBytes, 8);
+	BOOST_CHECK(format.bigEndian);
+	BOOST_CHECK(format.fortranRecords);
+	BOOST_CHECK(!parseUGridInfix("b2", format));
+	BOOST_CHECK(!UMOut.writeUGridFile("/tmp/test-exa.b2.ugrid", "b2"));
+
+	// These tests assume a little-endian host.
+	char doubleName[] = "/tmp/examesh-lb8-XXXXXX";
+	char floatName[] = "/tmp/examesh-lb4-XXXXXX";
+	close(mkstemp(doubleName));
+	close(mkstemp(floatName));
+	BOOST_CHECK(UMOut.writeUGridFile(doubleName, "lb8"));
+	BOOST_CHECK(UMOut.writeUGridFile(floatName, "lb4"));
+	std::vector<char> doubleFile = readWholeFile(doubleName);
+	std::vector<char> floatFile = readWholeFile(floatName);
+	BOOST_CHECK(UMOut.writeUGridFile(doubleName, "b8"));
+	std::vector<char> bigFile = readWholeFile(doubleName);
+	BOOST_CHECK(UMOut.writeUGridFile(doubleName, "r8"));
+	std::vector<char> recordFile = readWholeFile(doubleName);
+	unlink(doubleName);
+	unlink(floatName);
+
+	// Indices are 1-based and pyramids are in UGRID order.
+	const size_t nVerts = UMOut.numVerts();
+	const size_t headerBytes = 7 * sizeof(emInt);
+	const emInt* fileConn = reinterpret_cast<const emInt*>(doubleFile.data()
+			+ headerBytes + 24 * nVerts);
+	BOOST_CHECK_EQUAL(fileConn[0], UMOut.getBdryTriConn(0)[0] + 1);
+	// Tri and quad BCs come before the tets.
+	const emInt* filePyr = fileConn + 4 * UMOut.numBdryTris()
+			+ 5 * UMOut.numBdryQuads() + 4 * UMOut.numTets();
+	const emInt* pyr = UMOut.getPyrConn(0);
+	BOOST_CHECK_EQUAL(filePyr[2], pyr[4] + 1);
+	BOOST_CHECK_EQUAL(filePyr[4], pyr[2] + 1);
+
+	// b8 has every word reversed: 4-byte ints and 8-byte coords.
+	BOOST_REQUIRE_EQUAL(bigFile.size(), doubleFile.size());
+	bool isSwapped = true;
+	for (size_t ii = 0; ii < doubleFile.size(); ii++) {
+		size_t wordStart, wordBytes;
+		if (ii < headerBytes || ii >= headerBytes + 24 * nVerts) {
+			wordBytes = 4;
+			wordStart = ii - ii % 4;
+		}
+		else {
+			wordBytes = 8;
+			wordStart = ii - (ii - headerBytes) % 8;
+		}
+		size_t mirror = 2 * wordStart + wordBytes - 1 - ii;
+		isSwapped = isSwapped && (bigFile[ii] == doubleFile[mirror]);
+	}
+	BOOST_CHECK(isSwapped);
+
+	// r8 is b8 as two Fortran records, each with big-endian byte counts
+	// before and after.
+	BOOST_REQUIRE_EQUAL(recordFile.size(), bigFile.size() + 16);
+	BOOST_CHECK_EQUAL(recordFile.size(), UMOut.getUGridFileSize(format));
+	const size_t bodyBytes = bigFile.size() - headerBytes;
+	const size_t markers[] = { 0, 4 + headerBytes, 8 + headerBytes, 12
+			+ headerBytes + bodyBytes };
+	const size_t markerValues[] = { headerBytes, headerBytes, bodyBytes,
+			bodyBytes };
+	for (int ii = 0; ii < 4; ii++) {
+		uint32_t marker;
+		memcpy(&marker, recordFile.data() + markers[ii], sizeof(marker));
+		BOOST_CHECK_EQUAL(__builtin_bswap32(marker), markerValues[ii]);
+	}
+	BOOST_CHECK(
+			std::equal(bigFile.begin(), bigFile.begin() + headerBytes,
+									recordFile.begin() + 4));
+	BOOST_CHECK(
+			std::equal(bigFile.begin() + headerBytes, bigFile.end(),
+									recordFile.begin() + 12 + headerBytes));
+
+	// Same header and connectivity, with coords rounded to float.
+	parseUGridInfix("lb4", format);
+	BOOST_REQUIRE_EQUAL(doubleFile.size(), UMOut.getFileImageSize());
+	BOOST_REQUIRE_EQUAL(floatFile.size(), UMOut.getUGridFileSize(format));
+	BOOST_CHECK_EQUAL(floatFile.size() + 12 * nVerts, doubleFile.size());
+	BOOST_CHECK(
+			std::equal(floatFile.begin(), floatFile.begin() + headerBytes,
+									doubleFile.begin()));
+	const float* floatCoords =
+			reinterpret_cast<const float*>(floatFile.data() + headerBytes);
+	for (emInt vv = 0; vv < nVerts; vv++) {
+		double xyz[3];
+		UMOut.getCoords(vv, xyz);
+		for (int ii = 0; ii < 3; ii++) {
+			BOOST_CHECK_EQUAL(floatCoords[3 * vv + ii], float(xyz[ii]));
+		}
+	}
+	BOOST_CHECK(
+			std::equal(floatFile.begin() + headerBytes + 12 * nVerts,
+									floatFile.end(),
+									doubleFile.begin() + headerBytes + 24 * nVerts));
+
+	// Binary VTK has big-endian float32 coords right after the POINTS line.
+	char vtkName[] = "/tmp/examesh-vtk-XXXXXX";
+	close(mkstemp(vtkName));
+	BOOST_CHECK(UMOut.writeVTKFile(vtkName, true));
+	std::vector<char> vtkFile = readWholeFile(vtkName);
+	unlink(vtkName);
+	std::string vtkText(vtkFile.begin(), vtkFile.end());
+	char pointsLine[64];
+	snprintf(pointsLine, sizeof(pointsLine), "POINTS %lu float\n", nVerts);
+	size_t pointsStart = vtkText.find(pointsLine);
+	BOOST_REQUIRE(pointsStart != std::string::npos);
+	pointsStart += strlen(pointsLine);
+	BOOST_REQUIRE_GE(vtkFile.size(), pointsStart + 12 * nVerts);
+	for (emInt vv = 0; vv < nVerts; vv++) {
+		uint32_t word;
+		memcpy(&word, vtkFile.data() + pointsStart + 12 * vv, sizeof(word));
+		word = __builtin_bswap32(word);
+		float x;
+		memcpy(&x, &word, sizeof(x));
+		BOOST_CHECK_EQUAL(x, float(UMOut.getX(vv)));
+	}
+	BOOST_CHECK(vtkText.find("CELL_TYPES", pointsStart + 12 * nVerts)
+							!= std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(FixedDivisionTables) {
+	BOOST_CHECK_EQUAL(HexChildTable<8>::count, 512);
+	BOOST_CHECK_EQUAL(PrismChildTable<8>::count, 512);
+	BOOST_CHECK_EQUAL(TetChildTable<8>::count, 512);
+	BOOST_CHECK_EQUAL((InteriorVertTable<4, TetShape>::count), 1);
+	BOOST_CHECK_EQUAL((InteriorVertTable<3, TetShape>::count), 0);
+	BOOST_CHECK_EQUAL((InteriorVertTable<8, PrismShape>::count), 147);
+	BOOST_CHECK_EQUAL((InteriorVertTable<2, HexShape>::count), 1);
+
+	// Every fine vert must be used by some fine cell, and every cell must
+	// have distinct verts.
+	MixedMeshFixture MMF;
+	makeLengthScaleUniform(MMF.pUM_In);
+	UMesh UMfine(*MMF.pUM_In, 8);
+	checkExpectedSize(UMfine);
+	std::vector<bool> isUsed(UMfine.numVerts(), false);
+	bool cellsOK = true;
+	auto checkCell = [&](const emInt* conn, const int nVerts) {
+		for (int ii = 0; ii < nVerts; ii++) {
+			isUsed[conn[ii]] = true;
+			for (int jj = ii + 1; jj < nVerts; jj++) {
+				if (conn[ii] == conn[jj]) cellsOK = false;
+			}
+		}
+	};
+	for (emInt ii = 0; ii < UMfine.numTets(); ii++) {
+		checkCell(UMfine.getTetConn(ii), 4);
+	}
+	for (emInt ii = 0; ii < UMfine.numPyramids(); ii++) {
+		checkCell(UMfine.getPyrConn(ii), 5);
+	}
+	for (emInt ii = 0; ii < UMfine.numPrisms(); ii++) {
+		checkCell(UMfine.getPrismConn(ii), 6);
+	}
+	for (emInt ii = 0; ii < UMfine.numHexes(); ii++) {
+		checkCell(UMfine.getHexConn(ii), 8);
+	}
+	BOOST_CHECK(cellsOK);
+	BOOST_CHECK(std::find(isUsed.begin(), isUsed.end(), false) == isUsed.end());
+}
+
+BOOST_AUTO_TEST_CASE(PartExtraction) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+	makeLengthScaleUniform(&UM);
+	BOOST_CHECK(!UM.isPartMesh());
+
+	std::vector<Part> parts;
+	std::vector<CellPartData> vecCPD;
+	partitionCells(&UM, 2, parts, vecCPD);
+	BOOST_CHECK_EQUAL(parts.size(), 2);
+
+	emInt nPartBdryFaces = 0;
+	for (auto& P : parts) {
+		auto coarse = UM.extractCoarseMesh(P, vecCPD, 2);
+		BOOST_CHECK(coarse->isPartMesh());
+		// Part verts must be the same as the global verts they map to.
+		for (emInt vv = 0; vv < coarse->numVerts(); vv++) {
+			emInt global = coarse->getGlobalVert(vv);
+			BOOST_CHECK_EQUAL(coarse->getX(vv), UM.getX(global));
+			BOOST_CHECK_EQUAL(coarse->getY(vv), UM.getY(global));
+			BOOST_CHECK_EQUAL(coarse->getZ(vv), UM.getZ(global));
+		}
+		for (emInt ii = 0; ii < coarse->numBdryTris(); ii++) {
+			if (coarse->isPartBdryTri(ii)) nPartBdryFaces++;
+		}
+		for (emInt ii = 0; ii < coarse->numBdryQuads(); ii++) {
+			if (coarse->isPartBdryQuad(ii)) nPartBdryFaces++;
+		}
+	}
+	// Every face between the two parts shows up once in each part.
+	BOOST_CHECK_GT(nPartBdryFaces, 0);
+	BOOST_CHECK_EQUAL(nPartBdryFaces % 2, 0);
+}
+
+BOOST_AUTO_TEST_CASE(CubicPartExtraction) {
+	// Separate cubic tets in a row, each with a bdry tri on face 012.  Every
+	// other face is a part bdry face.
+	const emInt nTets = 40;
+	CubicMesh CM(20 * nTets, 3 * nTets, nTets, 0, nTets, 0, 0, 0);
+	for (emInt ii = 0; ii < 20 * nTets; ii++) {
+		double xyz[] = { double(ii / 20) + 0.01 * (ii % 20), 0.001 * ii, 0 };
+		CM.addVert(xyz);
+	}
+	for (emInt ii = 0; ii < nTets; ii++) {
+		emInt tetConn[20], triConn[10];
+		for (int jj = 0; jj < 20; jj++) {
+			tetConn[jj] = 20 * ii + jj;
+		}
+		const int face012[] = { 0, 1, 2, 4, 5, 6, 7, 8, 9, 16 };
+		for (int jj = 0; jj < 10; jj++) {
+			triConn[jj] = tetConn[face012[jj]];
+		}
+		CM.addTet(tetConn);
+		CM.addBdryTri(triConn);
+	}
+	CM.reorderCubicMesh();
+
+	std::vector<Part> parts;
+	std::vector<CellPartData> vecCPD;
+	partitionCells(&CM, 4, parts, vecCPD);
+	BOOST_CHECK_EQUAL(parts.size(), 4);
+
+	// Extract each part twice, with the other parts in between, so stale
+	// marks from one part would show up in the next.
+	std::vector<emInt> firstGlobals[4];
+	for (int pass = 0; pass < 2; pass++) {
+		emInt totalTets = 0;
+		for (int pp = 0; pp < 4; pp++) {
+			auto coarse = CM.extractCoarseMesh(parts[pp], vecCPD, 3);
+			const emInt partTets = coarse->numTets();
+			totalTets += partTets;
+			BOOST_CHECK_EQUAL(coarse->numVerts(), 20 * partTets);
+			BOOST_CHECK_EQUAL(coarse->numVertsToCopy(), 4 * partTets);
+			BOOST_CHECK_EQUAL(coarse->numBdryVerts(), 4 * partTets);
+			BOOST_CHECK_EQUAL(coarse->numBdryTris(), 4 * partTets);
+			std::vector<emInt> globals;
+			bool coordsMatch = true;
+			for (emInt vv = 0; vv < coarse->numVerts(); vv++) {
+				const emInt global = coarse->getGlobalVert(vv);
+				coordsMatch = coordsMatch && coarse->getX(vv) == CM.getX(global)
+						&& coarse->getY(vv) == CM.getY(global);
+				globals.push_back(global);
+			}
+			BOOST_CHECK(coordsMatch);
+			BOOST_CHECK(std::is_sorted(globals.begin(), globals.end()));
+			if (pass == 0) {
+				firstGlobals[pp] = globals;
+			}
+			else {
+				BOOST_CHECK(globals == firstGlobals[pp]);
+			}
+		}
+		BOOST_CHECK_EQUAL(totalTets, nTets);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(CubicRefinement) {
+	// A straight-sided cubic tet in parametric space, so each fine node
+	// should sit exactly where its child's corners put it.
+	const double thirds[20][3] = { { 0, 0, 0 }, { 3, 0, 0 }, { 0, 3, 0 }, { 0,
+			0, 3 }, { 1, 0, 0 }, { 2, 0, 0 }, { 2, 1, 0 }, { 1, 2, 0 }, { 0, 2, 0 },
+			{ 0, 1, 0 }, { 0, 0, 1 }, { 0, 0, 2 }, { 2, 0, 1 }, { 1, 0, 2 }, { 0, 2,
+					1 }, { 0, 1, 2 }, { 1, 1, 0 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+	const int faces[4][10] = { { 0, 1, 2, 4, 5, 6, 7, 8, 9, 16 }, { 0, 1, 3, 4,
+			5, 12, 13, 11, 10, 17 }, { 1, 2, 3, 6, 7, 14, 15, 13, 12, 18 }, { 2, 0, 3,
+			8, 9, 10, 11, 15, 14, 19 } };
+	CubicMesh CM(20, 4, 4, 0, 1, 0, 0, 0);
+	emInt tetConn[20];
+	for (int ii = 0; ii < 20; ii++) {
+		double xyz[] = { thirds[ii][0] / 3, thirds[ii][1] / 3, thirds[ii][2] / 3 };
+		tetConn[ii] = CM.addVert(xyz);
+	}
+	CM.addTet(tetConn);
+	for (int ff = 0; ff < 4; ff++) {
+		emInt triConn[10];
+		for (int ii = 0; ii < 10; ii++) {
+			triConn[ii] = tetConn[faces[ff][ii]];
+		}
+		CM.addBdryTri(triConn);
+	}
+	CM.reorderCubicMesh();
+
+	const int nDivs = 2;
+	CubicMesh fine(CM, nDivs);
+	BOOST_CHECK_EQUAL(fine.numTets(), 8);
+	BOOST_CHECK_EQUAL(fine.numBdryTris(), 16);
+	// Every point of a tet divided six times is a node.
+	BOOST_CHECK_EQUAL(fine.numVerts(), 84);
+	BOOST_CHECK_EQUAL(fine.numVertsToCopy(), 10);
+	BOOST_CHECK_EQUAL(fine.numBdryVerts(), 10);
+
+	for (emInt tt = 0; tt < fine.numTets(); tt++) {
+		const emInt* conn = fine.getTetConn(tt);
+		double corners[4][3];
+		for (int cc = 0; cc < 4; cc++) {
+			fine.getCoords(conn[cc], corners[cc]);
+			BOOST_CHECK_LT(conn[cc], fine.numVertsToCopy());
+		}
+		double edge1[3], edge2[3], edge3[3];
+		for (int dd = 0; dd < 3; dd++) {
+			edge1[dd] = corners[1][dd] - corners[0][dd];
+			edge2[dd] = corners[2][dd] - corners[0][dd];
+			edge3[dd] = corners[3][dd] - corners[0][dd];
+		}
+		double vol = edge1[0] * (edge2[1] * edge3[2] - edge2[2] * edge3[1])
+				+ edge1[1] * (edge2[2] * edge3[0] - edge2[0] * edge3[2])
+				+ edge1[2] * (edge2[0] * edge3[1] - edge2[1] * edge3[0]);
+		BOOST_CHECK_CLOSE(vol, 1. / 8, 1.e-8);
+		for (int nn = 4; nn < 20; nn++) {
+			double xyz[3];
+			fine.getCoords(conn[nn], xyz);
+			for (int dd = 0; dd < 3; dd++) {
+				double expected = corners[0][dd]
+						+ (thirds[nn][0] * edge1[dd] + thirds[nn][1] * edge2[dd]
+								+ thirds[nn][2] * edge3[dd]) / 3;
+				BOOST_CHECK_SMALL(xyz[dd] - expected, 1.e-12);
+			}
+		}
+	}
+	for (emInt tri = 0; tri < fine.numBdryTris(); tri++) {
+		const emInt* conn = fine.getBdryTriConn(tri);
+		double xyz[10][3];
+		for (int nn = 0; nn < 10; nn++) {
+			fine.getCoords(conn[nn], xyz[nn]);
+		}
+		for (int dd = 0; dd < 3; dd++) {
+			BOOST_CHECK_SMALL(xyz[3][dd] - (2 * xyz[0][dd] + xyz[1][dd]) / 3, 1.e-12);
+			BOOST_CHECK_SMALL(xyz[6][dd] - (xyz[1][dd] + 2 * xyz[2][dd]) / 3, 1.e-12);
+			BOOST_CHECK_SMALL(xyz[9][dd] - (xyz[0][dd] + xyz[1][dd] + xyz[2][dd]) / 3,
+												1.e-12);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(GraphPartition) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+
+	std::vector<Part> parts;
+	std::vector<CellPartData> vecCPD;
+	partitionCellsMultilevel(&UM, 2, parts, vecCPD);
+	BOOST_REQUIRE_EQUAL(parts.size(), 2);
+	BOOST_CHECK_EQUAL(parts[0].getFirst(), 0);
+	BOOST_CHECK_EQUAL(parts[0].getLast(), parts[1].getFirst());
+	BOOST_CHECK_EQUAL(parts[1].getLast(), 4);
+	// Each cell shows up exactly once.
+	std::set<std::pair<emInt, emInt> > cells;
+	for (auto& CPD : vecCPD) {
+		cells.insert(std::make_pair(CPD.getCellType(), CPD.getIndex()));
+	}
+	BOOST_CHECK_EQUAL(cells.size(), 4);
+
+	// The dual graph is a ring: tet, pyramid, hex, prism, with weights 4, 6,
+	// 8 and 6.  With parts this coarse, cutting two faces beats perfect
+	// balance.
+	size_t cutFaces;
+	double imbalance;
+	evaluatePartition(&UM, parts, vecCPD, cutFaces, imbalance);
+	BOOST_CHECK_EQUAL(cutFaces, 2);
+	BOOST_CHECK_CLOSE(imbalance, 14. / 12., 1.e-10);
+}
+
+BOOST_AUTO_TEST_CASE(SharedFileLayout) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+	makeLengthScaleUniform(&UM);
+
+	const emInt nDivs = 3;
+	UMesh UMserial(UM, nDivs);
+
+	std::vector<Part> parts;
+	std::vector<CellPartData> vecCPD;
+	partitionCells(&UM, 4, parts, vecCPD);
+	SharedUGridLayout layout(nDivs, parts.size());
+	for (emInt ii = 0; ii < parts.size(); ii++) {
+		auto coarse = UM.extractCoarsePart(nDivs, parts[ii], vecCPD);
+		layout.addPart(ii, *coarse);
+	}
+	layout.finalize();
+	// Verts on part bdries are only counted once.
+	BOOST_CHECK_EQUAL(layout.numVerts(), UMserial.numVerts());
+	BOOST_CHECK_GT(layout.numSharedVerts(), 0);
+
+	char fileName[] = "/tmp/examesh-shared-XXXXXX";
+	int fd = mkstemp(fileName);
+	BOOST_REQUIRE(fd >= 0);
+	BOOST_CHECK_EQUAL(ftruncate(fd, layout.getFileSize()), 0);
+	BOOST_CHECK(layout.writeHeader(fd));
+	// Every global vert is owned by exactly one part, and all parts agree on
+	// where it is.
+	std::vector<emInt> nOwners(layout.numVerts(), 0);
+	std::vector<double> globalX(layout.numVerts(), -10);
+	for (emInt ii = 0; ii < parts.size(); ii++) {
+		RefineStats RS;
+		auto fine = UM.createFineUMesh(nDivs, parts[ii], vecCPD, RS);
+		std::vector<emInt> globalVerts, owners;
+		BOOST_CHECK(layout.getGlobalVerts(ii, *fine, globalVerts, owners));
+		for (emInt vv = 0; vv < fine->numVerts(); vv++) {
+			emInt gv = globalVerts[vv];
+			if (owners[vv] == ii) nOwners[gv]++;
+			if (globalX[gv] == -10) globalX[gv] = fine->getX(vv);
+			BOOST_CHECK_SMALL(globalX[gv] - fine->getX(vv), 1.e-12);
+		}
+		BOOST_CHECK(layout.writePart(fd, ii, *fine));
+	}
+	for (emInt gv = 0; gv < layout.numVerts(); gv++) {
+		BOOST_CHECK_EQUAL(nOwners[gv], 1);
+	}
+	emInt header[7];
+	BOOST_CHECK_EQUAL(pread(fd, header, sizeof(header), 0),
+										ssize_t(sizeof(header)));
+	close(fd);
+	unlink(fileName);
+	// The default layout is b8, which is big-endian.
+	for (int ii = 0; ii < 7; ii++) {
+		header[ii] = __builtin_bswap32(header[ii]);
+	}
+	BOOST_CHECK_EQUAL(header[0], UMserial.numVerts());
+	BOOST_CHECK_EQUAL(header[1], UMserial.numBdryTris());
+	BOOST_CHECK_EQUAL(header[2], UMserial.numBdryQuads());
+	BOOST_CHECK_EQUAL(header[3], UMserial.numTets());
+	BOOST_CHECK_EQUAL(header[4], UMserial.numPyramids());
+	BOOST_CHECK_EQUAL(header[5], UMserial.numPrisms());
+	BOOST_CHECK_EQUAL(header[6], UMserial.numHexes());
+}
+
+BOOST_AUTO_TEST_CASE(PerPartFortranRecords) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+	UM.setupLengthScales();
+
+	// Each part in its own file can have Fortran records, even though the
+	// global vert numbering comes from a shared file layout.
+	char dirName[] = "/tmp/examesh-r8-XXXXXX";
+	BOOST_REQUIRE(mkdtemp(dirName));
+	char base[64];
+	snprintf(base, sizeof(base), "%s/mesh", dirName);
+	UM.refineForParallel(2, 20, 0, base, false, false, "r8");
+
+	emInt nParts = 0;
+	while (true) {
+		char fileName[FILE_NAME_LEN];
+		snprintf(fileName, FILE_NAME_LEN, "%s.part%04u.r8.ugrid", base, nParts);
+		FILE* partFile = fopen(fileName, "rb");
+		if (!partFile) break;
+		// The header is one record of seven ints.
+		uint32_t marker = 0;
+		BOOST_CHECK_EQUAL(fread(&marker, sizeof(marker), 1, partFile), 1);
+		fclose(partFile);
+		BOOST_CHECK_EQUAL(__builtin_bswap32(marker), 7 * sizeof(emInt));
+		unlink(fileName);
+		const char* suffixes[] = { "bdrymap", "gids" };
+		for (auto suffix : suffixes) {
+			snprintf(fileName, FILE_NAME_LEN, "%s.part%04u.%s", base, nParts,
+								suffix);
+			BOOST_CHECK_EQUAL(unlink(fileName), 0);
+		}
+		nParts++;
+	}
+	BOOST_CHECK_GT(nParts, 1);
+	char fileName[FILE_NAME_LEN];
+	snprintf(fileName, FILE_NAME_LEN, "%s.manifest", base);
+	BOOST_CHECK_EQUAL(unlink(fileName), 0);
+	rmdir(dirName);
+}
+
+// Rounded, so that roundoff can't change the sort order.
+static std::vector<double> roundedPoint(const double xyz[3]) {
+	std::vector<double> point(3);
+	for (int dd = 0; dd < 3; dd++) {
+		point[dd] = round(xyz[dd] * 1.e9) * 1.e-9;
+	}
+	return point;
+}
+
+// Sorted centroids of the cells (or faces) of one type, so that two meshes
+// with the same cells can be compared regardless of numbering.
+template<typename ConnGetter>
+static std::vector<std::vector<double> > sortedCentroids(const ExaMesh& EM,
+		const emInt nEnts, const int nPts, ConnGetter getConn) {
+	std::vector<std::vector<double> > centroids;
+	for (emInt ii = 0; ii < nEnts; ii++) {
+		emInt verts[8];
+		std::copy(getConn(ii), getConn(ii) + nPts, verts);
+		double centroid[] = { 0, 0, 0 };
+		for (int jj = 0; jj < nPts; jj++) {
+			BOOST_REQUIRE_LT(verts[jj], EM.numVerts());
+			double coords[3];
+			EM.getCoords(verts[jj], coords);
+			for (int dd = 0; dd < 3; dd++) {
+				centroid[dd] += coords[dd] / nPts;
+			}
+		}
+		centroids.push_back(roundedPoint(centroid));
+	}
+	std::sort(centroids.begin(), centroids.end());
+	return centroids;
+}
+
+static void checkSameCentroids(const std::vector<std::vector<double> >& a,
+		const std::vector<std::vector<double> >& b) {
+	BOOST_REQUIRE_EQUAL(a.size(), b.size());
+	for (size_t ii = 0; ii < a.size(); ii++) {
+		for (int dd = 0; dd < 3; dd++) {
+			BOOST_CHECK_SMALL(a[ii][dd] - b[ii][dd], 1.e-8);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(ImplicitRefinement) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+	makeLengthScaleUniform(&UM);
+
+	const emInt nDivs = 3;
+	UMesh UMserial(UM, nDivs);
+	ImplicitRefinedMesh IRM(UM, nDivs, 4);
+	BOOST_CHECK_EQUAL(IRM.numVerts(), UMserial.numVerts());
+	BOOST_CHECK_EQUAL(IRM.numBdryTris(), UMserial.numBdryTris());
+	BOOST_CHECK_EQUAL(IRM.numBdryQuads(), UMserial.numBdryQuads());
+	BOOST_CHECK_EQUAL(IRM.numTets(), UMserial.numTets());
+	BOOST_CHECK_EQUAL(IRM.numPyramids(), UMserial.numPyramids());
+	BOOST_CHECK_EQUAL(IRM.numPrisms(), UMserial.numPrisms());
+	BOOST_CHECK_EQUAL(IRM.numHexes(), UMserial.numHexes());
+	// Nothing is refined until it's asked for, and coarse verts keep their
+	// indices.
+	BOOST_CHECK_EQUAL(IRM.numExpansions(), 0);
+	BOOST_CHECK_EQUAL(IRM.getX(7), 1);
+	BOOST_CHECK_EQUAL(IRM.getZ(7), -1);
+	BOOST_CHECK_EQUAL(IRM.numExpansions(), 0);
+
+	// All the hexes come from one coarse cell, so it's refined only once.
+	for (emInt ii = 0; ii < IRM.numHexes(); ii++) {
+		IRM.getHexConn(ii);
+	}
+	BOOST_CHECK_EQUAL(IRM.numExpansions(), 1);
+
+	// The same verts, cells and bdry faces as refining explicitly.
+	std::vector<std::vector<double> > implicitVerts, explicitVerts;
+	for (emInt vv = 0; vv < IRM.numVerts(); vv++) {
+		double xyz[3];
+		IRM.getCoords(vv, xyz);
+		implicitVerts.push_back(roundedPoint(xyz));
+		UMserial.getCoords(vv, xyz);
+		explicitVerts.push_back(roundedPoint(xyz));
+	}
+	std::sort(implicitVerts.begin(), implicitVerts.end());
+	std::sort(explicitVerts.begin(), explicitVerts.end());
+	checkSameCentroids(implicitVerts, explicitVerts);
+	BOOST_CHECK(std::adjacent_find(implicitVerts.begin(), implicitVerts.end())
+							== implicitVerts.end());
+
+	auto implicitTri = [&IRM](emInt ii) {return IRM.getBdryTriConn(ii);};
+	auto explicitTri = [&UMserial](emInt ii) {return UMserial.getBdryTriConn(ii);};
+	checkSameCentroids(sortedCentroids(IRM, IRM.numBdryTris(), 3, implicitTri),
+			sortedCentroids(UMserial, UMserial.numBdryTris(), 3, explicitTri));
+	auto implicitQuad = [&IRM](emInt ii) {return IRM.getBdryQuadConn(ii);};
+	auto explicitQuad =
+			[&UMserial](emInt ii) {return UMserial.getBdryQuadConn(ii);};
+	checkSameCentroids(sortedCentroids(IRM, IRM.numBdryQuads(), 4, implicitQuad),
+			sortedCentroids(UMserial, UMserial.numBdryQuads(), 4, explicitQuad));
+	auto implicitTet = [&IRM](emInt ii) {return IRM.getTetConn(ii);};
+	auto explicitTet = [&UMserial](emInt ii) {return UMserial.getTetConn(ii);};
+	checkSameCentroids(sortedCentroids(IRM, IRM.numTets(), 4, implicitTet),
+			sortedCentroids(UMserial, UMserial.numTets(), 4, explicitTet));
+	auto implicitPyr = [&IRM](emInt ii) {return IRM.getPyrConn(ii);};
+	auto explicitPyr = [&UMserial](emInt ii) {return UMserial.getPyrConn(ii);};
+	checkSameCentroids(sortedCentroids(IRM, IRM.numPyramids(), 5, implicitPyr),
+			sortedCentroids(UMserial, UMserial.numPyramids(), 5, explicitPyr));
+	auto implicitPrism = [&IRM](emInt ii) {return IRM.getPrismConn(ii);};
+	auto explicitPrism =
+			[&UMserial](emInt ii) {return UMserial.getPrismConn(ii);};
+	checkSameCentroids(sortedCentroids(IRM, IRM.numPrisms(), 6, implicitPrism),
+			sortedCentroids(UMserial, UMserial.numPrisms(), 6, explicitPrism));
+	auto implicitHex = [&IRM](emInt ii) {return IRM.getHexConn(ii);};
+	auto explicitHex = [&UMserial](emInt ii) {return UMserial.getHexConn(ii);};
+	checkSameCentroids(sortedCentroids(IRM, IRM.numHexes(), 8, implicitHex),
+			sortedCentroids(UMserial, UMserial.numHexes(), 8, explicitHex));
+
+	// The cache never grows past its limit.
+	BOOST_CHECK_EQUAL(IRM.numCachedCells(), 4);
+}
+
+// A unit cube of N^3 smaller cubes, each split into six tets around its
+// main diagonal, with each bdry square split into two tris.
+static std::unique_ptr<UMesh> buildTetBox(const int N) {
+	const emInt nVerts = (N + 1) * (N + 1) * (N + 1);
+	const emInt nBdryVerts = nVerts - (N - 1) * (N - 1) * (N - 1);
+	auto pUM = std::make_unique<UMesh>(nVerts, nBdryVerts, 12 * N * N, 0,
+																			6 * N * N * N, 0, 0, 0);
+	auto index = [N](const int ijk[3]) {
+		return emInt(ijk[0] + (N + 1) * (ijk[1] + (N + 1) * ijk[2]));
+	};
+	for (int kk = 0; kk <= N; kk++) {
+		for (int jj = 0; jj <= N; jj++) {
+			for (int ii = 0; ii <= N; ii++) {
+				double coords[] = { double(ii) / N, double(jj) / N, double(kk) / N };
+				pUM->addVert(coords);
+			}
+		}
+	}
+	// The tets' faces on the bdry all contain the diagonal of their square
+	// from its lowest corner to its highest.
+	const int perms[][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 },
+			{ 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+	for (int kk = 0; kk < N; kk++) {
+		for (int jj = 0; jj < N; jj++) {
+			for (int ii = 0; ii < N; ii++) {
+				for (auto& perm : perms) {
+					int ijk[] = { ii, jj, kk };
+					emInt tet[4];
+					tet[0] = index(ijk);
+					for (int ss = 0; ss < 3; ss++) {
+						ijk[perm[ss]]++;
+						tet[ss + 1] = index(ijk);
+					}
+					double coords[4][3];
+					for (int cc = 0; cc < 4; cc++) {
+						pUM->getCoords(tet[cc], coords[cc]);
+					}
+					if (tetVolume(coords[0], coords[1], coords[2], coords[3]) < 0) {
+						std::swap(tet[0], tet[1]);
+						std::swap(coords[0], coords[1]);
+					}
+					pUM->addTet(tet);
+					// A tet face with all three verts on one side of the box is a bdry
+					// tri, which points out of the box.
+					for (int dir = 0; dir < 3; dir++) {
+						for (int side = 0; side <= N; side += N) {
+							emInt tri[4];
+							int onSide[4], nOnSide = 0;
+							for (int cc = 0; cc < 4; cc++) {
+								if (coords[cc][dir] * N == side) {
+									onSide[nOnSide] = cc;
+									tri[nOnSide++] = tet[cc];
+								}
+							}
+							if (nOnSide != 3) continue;
+							double edge1[3], edge2[3], normal[3];
+							for (int dd = 0; dd < 3; dd++) {
+								edge1[dd] = coords[onSide[1]][dd] - coords[onSide[0]][dd];
+								edge2[dd] = coords[onSide[2]][dd] - coords[onSide[0]][dd];
+							}
+							CROSS(edge1, edge2, normal);
+							if ((normal[dir] < 0) == (side == N)) std::swap(tri[1], tri[2]);
+							pUM->addBdryTri(tri);
+						}
+					}
+				}
+			}
+		}
+	}
+	makeLengthScaleUniform(pUM.get());
+	return pUM;
+}
+
+BOOST_AUTO_TEST_CASE(ImplicitRefinementTetBox) {
+	// With many tets, some of the octahedra inside them are split differently
+	// when each tet is refined on its own, but the result is just as valid.
+	auto pUM = buildTetBox(2);
+	const emInt nDivs = 5;
+	UMesh UMserial(*pUM, nDivs);
+	ImplicitRefinedMesh IRM(*pUM, nDivs, 4);
+	BOOST_CHECK_EQUAL(IRM.numVerts(), UMserial.numVerts());
+	BOOST_CHECK_EQUAL(IRM.numBdryTris(), UMserial.numBdryTris());
+	BOOST_CHECK_EQUAL(IRM.numTets(), UMserial.numTets());
+
+	std::vector<std::vector<double> > implicitVerts, explicitVerts;
+	for (emInt vv = 0; vv < IRM.numVerts(); vv++) {
+		double xyz[3];
+		IRM.getCoords(vv, xyz);
+		implicitVerts.push_back(roundedPoint(xyz));
+		UMserial.getCoords(vv, xyz);
+		explicitVerts.push_back(roundedPoint(xyz));
+	}
+	std::sort(implicitVerts.begin(), implicitVerts.end());
+	std::sort(explicitVerts.begin(), explicitVerts.end());
+	checkSameCentroids(implicitVerts, explicitVerts);
+	BOOST_CHECK(std::adjacent_find(implicitVerts.begin(), implicitVerts.end())
+							== implicitVerts.end());
+
+	auto implicitTri = [&IRM](emInt ii) {return IRM.getBdryTriConn(ii);};
+	auto explicitTri = [&UMserial](emInt ii) {return UMserial.getBdryTriConn(ii);};
+	checkSameCentroids(sortedCentroids(IRM, IRM.numBdryTris(), 3, implicitTri),
+			sortedCentroids(UMserial, UMserial.numBdryTris(), 3, explicitTri));
+
+	// Every fine tet is right-handed, and together they fill the box.
+	double totalVolume = 0;
+	emInt nInverted = 0;
+	for (emInt tet = 0; tet < IRM.numTets(); tet++) {
+		emInt verts[4];
+		std::copy(IRM.getTetConn(tet), IRM.getTetConn(tet) + 4, verts);
+		double coords[4][3];
+		for (int cc = 0; cc < 4; cc++) {
+			IRM.getCoords(verts[cc], coords[cc]);
+		}
+		const double volume = tetVolume(coords[0], coords[1], coords[2],
+																		coords[3]);
+		if (volume <= 0) nInverted++;
+		totalVolume += volume;
+	}
+	BOOST_CHECK_EQUAL(nInverted, 0);
+	BOOST_CHECK_CLOSE(totalVolume, 1, 1.e-8);
+
+	// Each fine tri is shared by two fine tets, or is on the bdry.
+	std::map<std::vector<emInt>, int> triUses;
+	const int tetFaces[][3] = { { 0, 1, 2 }, { 0, 1, 3 }, { 1, 2, 3 },
+			{ 2, 0, 3 } };
+	for (emInt tet = 0; tet < IRM.numTets(); tet++) {
+		emInt verts[4];
+		std::copy(IRM.getTetConn(tet), IRM.getTetConn(tet) + 4, verts);
+		for (auto& face : tetFaces) {
+			std::vector<emInt> tri = { verts[face[0]], verts[face[1]],
+					verts[face[2]] };
+			std::sort(tri.begin(), tri.end());
+			triUses[tri]++;
+		}
+	}
+	emInt nBdryTris = 0;
+	bool allMatched = true;
+	for (auto& use : triUses) {
+		if (use.second == 1) nBdryTris++;
+		else if (use.second != 2) allMatched = false;
+	}
+	BOOST_CHECK(allMatched);
+	BOOST_CHECK_EQUAL(nBdryTris, IRM.numBdryTris());
+}
+
+// Builds a UMesh from what a refinement visitor is given, checking that
+// it's given things in the promised order.
+class UMeshVisitor: public RefineVisitor {
+public:
+	UMesh m_UM;
+	emInt m_nextCell, m_nextFace[2], m_calls;
+	UMeshVisitor(const MeshSize& MS) :
+			m_UM(MS.nVerts, MS.nBdryVerts, MS.nBdryTris, MS.nBdryQuads, MS.nTets,
+						MS.nPyrs, MS.nPrisms, MS.nHexes), m_nextCell(0), m_nextFace(),
+					m_calls(0) {
+	}
+	void onVerts(const emInt firstVert, const emInt count,
+			const double coords[][3]) {
+		BOOST_CHECK_EQUAL(firstVert, m_UM.numVerts());
+		for (emInt ii = 0; ii < count; ii++) {
+			m_UM.addVert(coords[ii]);
+		}
+		m_calls++;
+	}
+	void onCells(const emInt coarseCell, const int type, const emInt count,
+			const emInt conn[]) {
+		// Children of each coarse cell come together, in order.
+		BOOST_CHECK(coarseCell == m_nextCell || coarseCell + 1 == m_nextCell);
+		m_nextCell = coarseCell + 1;
+		const int nPts = (type == TETRA_4) ? 4 :
+											(type == PYRA_5) ? 5 : (type == PENTA_6) ? 6 : 8;
+		for (emInt ii = 0; ii < count; ii++) {
+			const emInt *verts = conn + ii * nPts;
+			for (int jj = 0; jj < nPts; jj++) {
+				BOOST_CHECK_LT(verts[jj], m_UM.numVerts());
+			}
+			switch (type) {
+				case TETRA_4:
+					m_UM.addTet(verts);
+					break;
+				case PYRA_5:
+					m_UM.addPyramid(verts);
+					break;
+				case PENTA_6:
+					m_UM.addPrism(verts);
+					break;
+				default:
+					BOOST_CHECK_EQUAL(type, HEXA_8);
+					m_UM.addHex(verts);
+					break;
+			}
+		}
+		m_calls++;
+	}
+	void onBdryFaces(const emInt coarseFace, const int type, const emInt count,
+			const emInt conn[]) {
+		const bool isTri = (type == TRI_3);
+		BOOST_CHECK_EQUAL(coarseFace, m_nextFace[!isTri]++);
+		for (emInt ii = 0; ii < count; ii++) {
+			if (isTri) m_UM.addBdryTri(conn + 3 * ii);
+			else m_UM.addBdryQuad(conn + 4 * ii);
+		}
+		m_calls++;
+	}
+};
+
+BOOST_AUTO_TEST_CASE(RefinementVisitor) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+	makeLengthScaleUniform(&UM);
+
+	const int nDivs = 3;
+	UMesh UMserial(UM, nDivs);
+	UMeshVisitor UMV(UM.computeFineMeshSize(nDivs));
+	emInt nCells = subdividePartMesh(&UM, UMV, nDivs);
+	BOOST_CHECK_EQUAL(nCells, UMserial.numCells());
+	// The coarse verts, one batch of verts and one of cells per coarse cell,
+	// plus a pyramid's tets, and one batch per bdry face.
+	BOOST_CHECK_EQUAL(UMV.m_calls, 1 + 4 * 2 + 1 + 12);
+
+	// The same mesh, entity for entity.
+	const UMesh& UMvisited = UMV.m_UM;
+	BOOST_REQUIRE_EQUAL(UMvisited.numVerts(), UMserial.numVerts());
+	for (emInt vv = 0; vv < UMserial.numVerts(); vv++) {
+		BOOST_CHECK_SMALL(UMvisited.getX(vv) - UMserial.getX(vv), 1.e-12);
+		BOOST_CHECK_SMALL(UMvisited.getY(vv) - UMserial.getY(vv), 1.e-12);
+		BOOST_CHECK_SMALL(UMvisited.getZ(vv) - UMserial.getZ(vv), 1.e-12);
+	}
+	BOOST_REQUIRE_EQUAL(UMvisited.numBdryTris(), UMserial.numBdryTris());
+	for (emInt ii = 0; ii < UMserial.numBdryTris(); ii++) {
+		BOOST_CHECK_EQUAL_COLLECTIONS(UMvisited.getBdryTriConn(ii),
+				UMvisited.getBdryTriConn(ii) + 3, UMserial.getBdryTriConn(ii),
+				UMserial.getBdryTriConn(ii) + 3);
+	}
+	BOOST_REQUIRE_EQUAL(UMvisited.numBdryQuads(), UMserial.numBdryQuads());
+	for (emInt ii = 0; ii < UMserial.numBdryQuads(); ii++) {
+		BOOST_CHECK_EQUAL_COLLECTIONS(UMvisited.getBdryQuadConn(ii),
+				UMvisited.getBdryQuadConn(ii) + 4, UMserial.getBdryQuadConn(ii),
+				UMserial.getBdryQuadConn(ii) + 4);
+	}
+	BOOST_REQUIRE_EQUAL(UMvisited.numTets(), UMserial.numTets());
+	for (emInt ii = 0; ii < UMserial.numTets(); ii++) {
+		BOOST_CHECK_EQUAL_COLLECTIONS(UMvisited.getTetConn(ii),
+				UMvisited.getTetConn(ii) + 4, UMserial.getTetConn(ii),
+				UMserial.getTetConn(ii) + 4);
+	}
+	BOOST_REQUIRE_EQUAL(UMvisited.numPyramids(), UMserial.numPyramids());
+	for (emInt ii = 0; ii < UMserial.numPyramids(); ii++) {
+		BOOST_CHECK_EQUAL_COLLECTIONS(UMvisited.getPyrConn(ii),
+				UMvisited.getPyrConn(ii) + 5, UMserial.getPyrConn(ii),
+				UMserial.getPyrConn(ii) + 5);
+	}
+	BOOST_REQUIRE_EQUAL(UMvisited.numPrisms(), UMserial.numPrisms());
+	for (emInt ii = 0; ii < UMserial.numPrisms(); ii++) {
+		BOOST_CHECK_EQUAL_COLLECTIONS(UMvisited.getPrismConn(ii),
+				UMvisited.getPrismConn(ii) + 6, UMserial.getPrismConn(ii),
+				UMserial.getPrismConn(ii) + 6);
+	}
+	BOOST_REQUIRE_EQUAL(UMvisited.numHexes(), UMserial.numHexes());
+	for (emInt ii = 0; ii < UMserial.numHexes(); ii++) {
+		BOOST_CHECK_EQUAL_COLLECTIONS(UMvisited.getHexConn(ii),
+				UMvisited.getHexConn(ii) + 8, UMserial.getHexConn(ii),
+				UMserial.getHexConn(ii) + 8);
+	}
+}
+
+// Verts of fine cell cell, numbered tets first, then pyramids, prisms and
+// hexes.
+static std::vector<emInt> fineCellVerts(const UMesh& UM, emInt cell) {
+	if (cell < UM.numTets()) {
+		return std::vector<emInt>(UM.getTetConn(cell), UM.getTetConn(cell) + 4);
+	}
+	cell -= UM.numTets();
+	if (cell < UM.numPyramids()) {
+		return std::vector<emInt>(UM.getPyrConn(cell), UM.getPyrConn(cell) + 5);
+	}
+	cell -= UM.numPyramids();
+	if (cell < UM.numPrisms()) {
+		return std::vector<emInt>(UM.getPrismConn(cell),
+															UM.getPrismConn(cell) + 6);
+	}
+	cell -= UM.numPrisms();
+	BOOST_REQUIRE_LT(cell, UM.numHexes());
+	return std::vector<emInt>(UM.getHexConn(cell), UM.getHexConn(cell) + 8);
+}
+
+BOOST_AUTO_TEST_CASE(RefinementFaceCells) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+	makeLengthScaleUniform(&UM);
+
+	const int nDivs = 3;
+	const MeshSize MS = UM.computeFineMeshSize(nDivs);
+	UMeshVisitor UMV(MS);
+	HashedFaceCellVisitor FCV(MS, &UMV);
+	subdividePartMesh(&UM, FCV, nDivs);
+	const UMesh& fine = UMV.m_UM;
+	const emInt nCells = fine.numCells();
+	BOOST_CHECK_EQUAL(FCV.numUnmatchedFaces(), 0);
+
+	// Every face of every cell, counted by brute force.
+	const std::vector<FineFace>& faces = FCV.getFaces();
+	size_t cellFaces = 4 * size_t(fine.numTets()) + 5 * fine.numPyramids()
+			+ 5 * fine.numPrisms() + 6 * fine.numHexes();
+	size_t bdryFaces = fine.numBdryTris() + fine.numBdryQuads();
+	BOOST_CHECK_EQUAL(faces.size(), (cellFaces + bdryFaces) / 2);
+
+	std::set<std::vector<emInt> > seen;
+	size_t nBdry = 0;
+	for (auto& face : faces) {
+		std::vector<emInt> key(face.verts, face.verts + 4);
+		std::sort(key.begin(), key.end());
+		BOOST_CHECK(seen.insert(key).second);
+		const int nPts = (face.verts[3] == EMINT_MAX) ? 3 : 4;
+
+		// Each face's verts are verts of both its cells.
+		BOOST_REQUIRE_LT(face.left, nCells);
+		std::vector<emInt> left = fineCellVerts(fine, face.left);
+		for (int ii = 0; ii < nPts; ii++) {
+			BOOST_CHECK(std::count(left.begin(), left.end(), face.verts[ii]) == 1);
+		}
+		BOOST_REQUIRE_NE(face.right, EMINT_MAX);
+		if (face.right >= nCells) {
+			// The right side is a bdry face, with the same verts.
+			emInt bdry = face.right - nCells;
+			nBdry++;
+			const emInt *conn;
+			if (bdry < fine.numBdryTris()) {
+				BOOST_CHECK_EQUAL(nPts, 3);
+				conn = fine.getBdryTriConn(bdry);
+			}
+			else {
+				BOOST_CHECK_EQUAL(nPts, 4);
+				conn = fine.getBdryQuadConn(bdry - fine.numBdryTris());
+			}
+			std::vector<emInt> bdryKey(conn, conn + nPts);
+			bdryKey.resize(4, EMINT_MAX);
+			std::sort(bdryKey.begin(), bdryKey.end());
+			BOOST_CHECK(bdryKey == key);
+			continue;
+		}
+		BOOST_CHECK_NE(face.left, face.right);
+		std::vector<emInt> right = fineCellVerts(fine, face.right);
+		for (int ii = 0; ii < nPts; ii++) {
+			BOOST_CHECK(std::count(right.begin(), right.end(), face.verts[ii]) == 1);
+		}
+	}
+	BOOST_CHECK_EQUAL(nBdry, bdryFaces);
+}
+
+BOOST_AUTO_TEST_CASE(RefinementParents) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+	makeLengthScaleUniform(&UM);
+
+	const int nDivs = 3;
+	const MeshSize MS = UM.computeFineMeshSize(nDivs);
+	UMeshVisitor UMV(MS);
+	ParentMapVisitor PMV(MS, &UMV);
+	subdividePartMesh(&UM, PMV, nDivs);
+	const UMesh& fine = UMV.m_UM;
+
+	// Fine cells per coarse cell:  the pyramid also makes tets.
+	const std::vector<emInt>& cellParents = PMV.getCellParents();
+	BOOST_REQUIRE_EQUAL(cellParents.size(), fine.numCells());
+	std::vector<emInt> nChildren(UM.numCells(), 0);
+	for (emInt parent : cellParents) {
+		BOOST_REQUIRE_LT(parent, UM.numCells());
+		nChildren[parent]++;
+	}
+	BOOST_CHECK_EQUAL(nChildren[0], nDivs * nDivs * nDivs);
+	BOOST_CHECK_EQUAL(nChildren[1],
+										fine.numPyramids() + fine.numTets() - nChildren[0]);
+	BOOST_CHECK_EQUAL(nChildren[2], nDivs * nDivs * nDivs);
+	BOOST_CHECK_EQUAL(nChildren[3], nDivs * nDivs * nDivs);
+
+	// Prolongation of the coarse coords gives the fine coords.
+	CSRMatrix P;
+	BOOST_REQUIRE(PMV.getProlongation(UM, P));
+	BOOST_REQUIRE_EQUAL(P.nRows, fine.numVerts());
+	BOOST_CHECK_EQUAL(P.nCols, UM.numVerts());
+	BOOST_REQUIRE_EQUAL(P.rowStart.size(), size_t(P.nRows) + 1);
+	BOOST_CHECK_EQUAL(P.rowStart.back(), P.cols.size());
+	for (emInt row = 0; row < P.nRows; row++) {
+		double sum = 0, coords[] = { 0, 0, 0 }, fineCoords[3];
+		for (size_t ii = P.rowStart[row]; ii < P.rowStart[row + 1]; ii++) {
+			double coarseCoords[3];
+			UM.getCoords(P.cols[ii], coarseCoords);
+			for (int dd = 0; dd < 3; dd++) {
+				coords[dd] += P.values[ii] * coarseCoords[dd];
+			}
+			sum += P.values[ii];
+		}
+		fine.getCoords(row, fineCoords);
+		BOOST_CHECK_CLOSE_FRACTION(sum, 1, 1.e-12);
+		for (int dd = 0; dd < 3; dd++) {
+			BOOST_CHECK_SMALL(coords[dd] - fineCoords[dd], 1.e-12);
+		}
+	}
+
+	// Every vert of a fine cell interpolates from corners of its parent.
+	for (emInt cell = 0; cell < fine.numCells(); cell++) {
+		std::vector<emInt> corners = fineCellVerts(UM, cellParents[cell]);
+		for (emInt vert : fineCellVerts(fine, cell)) {
+			for (size_t ii = P.rowStart[vert]; ii < P.rowStart[vert + 1]; ii++) {
+				BOOST_CHECK(
+						std::count(corners.begin(), corners.end(), P.cols[ii]) == 1);
+			}
+		}
+	}
+
+	// Those corners are the ones of the coarse edge, face or cell the vert
+	// lies in.
+	for (emInt vert = UM.numVerts(); vert < fine.numVerts(); vert++) {
+		emInt corners[8];
+		const int nCorners = PMV.getParentEntity(UM, vert, corners);
+		BOOST_CHECK_GE(nCorners, 2);
+		BOOST_CHECK(
+				std::vector<emInt>(corners, corners + nCorners)
+						== std::vector<emInt>(P.cols.begin() + P.rowStart[vert],
+																	P.cols.begin() + P.rowStart[vert + 1]));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(CubicRefinementParents) {
+	// A curved cubic tet:  the mid-edge and face nodes are pushed off the
+	// straight-sided positions, so fine verts aren't where Q1 would put them.
+	const double thirds[20][3] = { { 0, 0, 0 }, { 3, 0, 0 }, { 0, 3, 0 }, { 0,
+			0, 3 }, { 1, 0, 0 }, { 2, 0, 0 }, { 2, 1, 0 }, { 1, 2, 0 }, { 0, 2, 0 },
+			{ 0, 1, 0 }, { 0, 0, 1 }, { 0, 0, 2 }, { 2, 0, 1 }, { 1, 0, 2 }, { 0, 2,
+					1 }, { 0, 1, 2 }, { 1, 1, 0 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+	const int faces[4][10] = { { 0, 1, 2, 4, 5, 6, 7, 8, 9, 16 }, { 0, 1, 3, 4,
+			5, 12, 13, 11, 10, 17 }, { 1, 2, 3, 6, 7, 14, 15, 13, 12, 18 }, { 2, 0, 3,
+			8, 9, 10, 11, 15, 14, 19 } };
+	CubicMesh CM(20, 4, 4, 0, 1, 0, 0, 0);
+	emInt tetConn[20];
+	for (int ii = 0; ii < 20; ii++) {
+		double bump = (ii < 4) ? 0 : 0.02;
+		double xyz[] = { thirds[ii][0] / 3 + bump, thirds[ii][1] / 3 + bump,
+				thirds[ii][2] / 3 + bump };
+		tetConn[ii] = CM.addVert(xyz);
+	}
+	CM.addTet(tetConn);
+	for (int ff = 0; ff < 4; ff++) {
+		emInt triConn[10];
+		for (int ii = 0; ii < 10; ii++) {
+			triConn[ii] = tetConn[faces[ff][ii]];
+		}
+		CM.addBdryTri(triConn);
+	}
+	CM.reorderCubicMesh();
+
+	const int nDivs = 4;
+	const MeshSize MS = CM.computeFineMeshSize(nDivs);
+	UMeshVisitor UMV(MS);
+	ParentMapVisitor PMV(MS, &UMV);
+	subdividePartMesh(&CM, PMV, nDivs);
+	const UMesh& fine = UMV.m_UM;
+	BOOST_CHECK_EQUAL(fine.numTets(), nDivs * nDivs * nDivs);
+
+	// Q1 interpolation isn't how these verts were placed.
+	CSRMatrix P;
+	BOOST_CHECK(!PMV.getProlongation(CM, P));
+
+	// Fine verts on each coarse edge, on each coarse face and inside.
+	const emInt* corners = CM.getTetConn(0);
+	int nOnEntity[5] = { 0, 0, 0, 0, 0 };
+	for (emInt vert = 0; vert < fine.numVerts(); vert++) {
+		emInt entity[8];
+		const int nCorners = PMV.getParentEntity(CM, vert, entity);
+		BOOST_REQUIRE_LE(nCorners, 4);
+		nOnEntity[nCorners]++;
+		for (int cc = 0; cc < nCorners; cc++) {
+			BOOST_CHECK(std::count(corners, corners + 4, entity[cc]) == 1);
+		}
+	}
+	BOOST_CHECK_EQUAL(nOnEntity[0], 4);
+	BOOST_CHECK_EQUAL(nOnEntity[1], 0);
+	BOOST_CHECK_EQUAL(nOnEntity[2], 6 * (nDivs - 1));
+	BOOST_CHECK_EQUAL(nOnEntity[3], 4 * (nDivs - 1) * (nDivs - 2) / 2);
+	BOOST_CHECK_EQUAL(nOnEntity[4], (nDivs - 1) * (nDivs - 2) * (nDivs - 3) / 6);
+}
+
+BOOST_AUTO_TEST_CASE(NestedRefinement) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+	makeLengthScaleUniform(&UM);
+
+	const int nLevels = 3;
+	const int nDivs[] = { 2, 4, 8 };
+	UMeshVisitor UMV0(UM.computeFineMeshSize(nDivs[0]));
+	UMeshVisitor UMV1(UM.computeFineMeshSize(nDivs[1]));
+	UMeshVisitor UMV2(UM.computeFineMeshSize(nDivs[2]));
+	ParentMapVisitor PMV(UM.computeFineMeshSize(nDivs[0]), &UMV0);
+	RefineVisitor *const visitors[] = { &PMV, &UMV1, &UMV2 };
+	std::vector<emInt> coarseToFine[nLevels - 1];
+	BOOST_REQUIRE(
+			subdivideNestedLevels(&UM, nLevels, nDivs, visitors, coarseToFine));
+	const UMesh *const levels[] = { &UMV0.m_UM, &UMV1.m_UM, &UMV2.m_UM };
+
+	// Each level is the same mesh as refining by itself.
+	for (int ll = 0; ll < nLevels; ll++) {
+		const UMesh& level = *levels[ll];
+		UMesh UMserial(UM, nDivs[ll]);
+		BOOST_CHECK_EQUAL(level.numVerts(), UMserial.numVerts());
+		BOOST_CHECK_EQUAL(level.numBdryTris(), UMserial.numBdryTris());
+		BOOST_CHECK_EQUAL(level.numBdryQuads(), UMserial.numBdryQuads());
+		BOOST_CHECK_EQUAL(level.numTets(), UMserial.numTets());
+		BOOST_CHECK_EQUAL(level.numPyramids(), UMserial.numPyramids());
+		BOOST_CHECK_EQUAL(level.numPrisms(), UMserial.numPrisms());
+		BOOST_CHECK_EQUAL(level.numHexes(), UMserial.numHexes());
+		for (emInt vv = 0; vv < UM.numVerts(); vv++) {
+			BOOST_CHECK_EQUAL(level.getX(vv), UM.getX(vv));
+		}
+
+		std::vector<std::vector<double> > nestedVerts, serialVerts;
+		for (emInt vv = 0; vv < level.numVerts(); vv++) {
+			double xyz[3];
+			level.getCoords(vv, xyz);
+			nestedVerts.push_back(roundedPoint(xyz));
+			UMserial.getCoords(vv, xyz);
+			serialVerts.push_back(roundedPoint(xyz));
+		}
+		std::sort(nestedVerts.begin(), nestedVerts.end());
+		std::sort(serialVerts.begin(), serialVerts.end());
+		checkSameCentroids(nestedVerts, serialVerts);
+
+		auto nestedTri = [&level](emInt ii) {return level.getBdryTriConn(ii);};
+		auto serialTri = [&UMserial](emInt ii) {return UMserial.getBdryTriConn(ii);};
+		checkSameCentroids(sortedCentroids(level, level.numBdryTris(), 3, nestedTri),
+				sortedCentroids(UMserial, UMserial.numBdryTris(), 3, serialTri));
+		auto nestedTet = [&level](emInt ii) {return level.getTetConn(ii);};
+		auto serialTet = [&UMserial](emInt ii) {return UMserial.getTetConn(ii);};
+		checkSameCentroids(sortedCentroids(level, level.numTets(), 4, nestedTet),
+				sortedCentroids(UMserial, UMserial.numTets(), 4, serialTet));
+		auto nestedPyr = [&level](emInt ii) {return level.getPyrConn(ii);};
+		auto serialPyr = [&UMserial](emInt ii) {return UMserial.getPyrConn(ii);};
+		checkSameCentroids(sortedCentroids(level, level.numPyramids(), 5, nestedPyr),
+				sortedCentroids(UMserial, UMserial.numPyramids(), 5, serialPyr));
+		auto nestedHex = [&level](emInt ii) {return level.getHexConn(ii);};
+		auto serialHex = [&UMserial](emInt ii) {return UMserial.getHexConn(ii);};
+		checkSameCentroids(sortedCentroids(level, level.numHexes(), 8, nestedHex),
+				sortedCentroids(UMserial, UMserial.numHexes(), 8, serialHex));
+	}
+
+	// Every vert of a level is a different vert of the next one, in the same
+	// place.
+	for (int ll = 0; ll < nLevels - 1; ll++) {
+		const UMesh& coarse = *levels[ll];
+		const UMesh& fine = *levels[ll + 1];
+		BOOST_REQUIRE_EQUAL(coarseToFine[ll].size(), coarse.numVerts());
+		std::set<emInt> used;
+		for (emInt vv = 0; vv < coarse.numVerts(); vv++) {
+			const emInt fineVert = coarseToFine[ll][vv];
+			BOOST_REQUIRE_LT(fineVert, fine.numVerts());
+			BOOST_CHECK(used.insert(fineVert).second);
+			BOOST_CHECK_EQUAL(coarse.getX(vv), fine.getX(fineVert));
+			BOOST_CHECK_EQUAL(coarse.getY(vv), fine.getY(fineVert));
+			BOOST_CHECK_EQUAL(coarse.getZ(vv), fine.getZ(fineVert));
+		}
+	}
+
+	// Coarser levels can still find where their verts came from.
+	CSRMatrix P;
+	BOOST_REQUIRE(PMV.getProlongation(UM, P));
+	BOOST_REQUIRE_EQUAL(P.nRows, levels[0]->numVerts());
+	for (emInt row = 0; row < P.nRows; row++) {
+		double coords[] = { 0, 0, 0 }, levelCoords[3];
+		for (size_t ii = P.rowStart[row]; ii < P.rowStart[row + 1]; ii++) {
+			double coarseCoords[3];
+			UM.getCoords(P.cols[ii], coarseCoords);
+			for (int dd = 0; dd < 3; dd++) {
+				coords[dd] += P.values[ii] * coarseCoords[dd];
+			}
+		}
+		levels[0]->getCoords(row, levelCoords);
+		for (int dd = 0; dd < 3; dd++) {
+			BOOST_CHECK_SMALL(coords[dd] - levelCoords[dd], 1.e-12);
+		}
+	}
+
+	// Levels that don't nest are refused.
+	const int badDivs[] = { 2, 3 };
+	BOOST_CHECK(!subdivideNestedLevels(&UM, 2, badDivs, visitors));
+}
+
+BOOST_AUTO_TEST_CASE(RefinementPlan) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+	makeLengthScaleUniform(&UM);
+
+	// Predicted file size must match what refinement actually produces.
+	UMesh UMfine(UM, 3);
+	MeshSize MSOut = UM.computeFineMeshSize(3);
+	BOOST_CHECK_EQUAL(ugridFileBytes(MSOut), UMfine.getFileImageSize());
+
+	// With one part, the fine cell count is exact; part bdry estimates can
+	// only make the file bigger.
+	RefinePlan plan;
+	BOOST_CHECK(UM.planRefinement(3, 1000000, 0, 2, plan));
+	BOOST_CHECK_EQUAL(plan.nParts, 1);
+	BOOST_CHECK_EQUAL(plan.fineCells, UMfine.numCells());
+	BOOST_CHECK_GE(plan.fileBytes, UMfine.getFileImageSize());
+	BOOST_CHECK_GT(plan.wallTime, 0);
+	BOOST_CHECK_GE(plan.peakBytesInFlight, plan.largestPartBytes);
+	BOOST_CHECK(!plan.indexOverflow);
+
+	// Four parts, with a budget too small for two at once, have to run one
+	// at a time.
+	BOOST_CHECK(UM.planRefinement(3, 27, 1, 4, plan));
+	BOOST_CHECK_EQUAL(plan.nParts, 4);
+	BOOST_CHECK_EQUAL(plan.peakBytesInFlight, plan.largestPartBytes);
+}
+
+BOOST_AUTO_TEST_CASE(Instrumentation) {
+	MixedMeshFixture MMF;
+	UMesh& UM = *MMF.pUM_In;
+	makeLengthScaleUniform(&UM);
+
+	// Nothing is recorded while instrumentation is off.
+	resetInstrumentation();
+	UMesh UMoff(UM, 3);
+	BOOST_CHECK_EQUAL(getInstrumentCalls(eTimeRefine), 0);
+	BOOST_CHECK_EQUAL(getInstrumentCount(eCountCellsCreated), 0);
+
+	enableInstrumentation(true);
+	UMesh UMOut(UM, 3);
+	char fileName[] = "/tmp/examesh-instrument-XXXXXX";
+	int fd = mkstemp(fileName);
+	BOOST_REQUIRE(fd >= 0);
+	close(fd);
+	BOOST_CHECK(UMOut.writeUGridFile(fileName));
+	enableInstrumentation(false);
+
+	BOOST_CHECK_EQUAL(getInstrumentCalls(eTimeRefine), 1);
+	BOOST_CHECK_EQUAL(getInstrumentCalls(eTimeTetLoop), 1);
+	// One call per cell and per bdry face.
+	BOOST_CHECK_EQUAL(getInstrumentCalls(eTimeCells), 16);
+	BOOST_CHECK_GT(getInstrumentTime(eTimeRefine), 0);
+	BOOST_CHECK_EQUAL(getInstrumentCount(eCountCellsCreated), UMOut.numCells());
+	BOOST_CHECK_EQUAL(getInstrumentCount(eCountVertsCreated),
+										UMOut.numVerts() - UM.numVerts());
+	// Every new vert takes exactly one mapping evaluation.
+	BOOST_CHECK_EQUAL(getInstrumentCount(eCountMappingEvals),
+										getInstrumentCount(eCountVertsCreated));
+	// Each edge and face is inserted once: 22 edges, 8 tris and 8 quads.
+	BOOST_CHECK_EQUAL(getInstrumentCount(eCountEdgeInserts), 22);
+	BOOST_CHECK_EQUAL(getInstrumentCount(eCountTriInserts), 8);
+	BOOST_CHECK_EQUAL(getInstrumentCount(eCountQuadInserts), 8);
+	BOOST_CHECK_EQUAL(getInstrumentCount(eCountBytesWritten),
+										UMOut.getFileImageSize());
+
+	BOOST_CHECK(writeInstrumentReport(fileName));
+	FILE* report = fopen(fileName, "r");
+	BOOST_REQUIRE(report);
+	char firstLine[80];
+	BOOST_CHECK(fgets(firstLine, 80, report));
+	BOOST_CHECK_EQUAL(firstLine[0], '{');
+	fclose(report);
+	unlink(fileName);
+	resetInstrumentation();
+}
+
+BOOST_AUTO_TEST_CASE(HardwareCounters) {
+	UMesh UM(4, 4, 4, 0, 1, 0, 0, 0);
+	double coords[][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+	emInt triVerts[][3] = { { 0, 1, 2 }, { 0, 1, 3 }, { 1, 2, 3 }, { 2, 0, 3 } };
+	emInt tetVerts[] = { 0, 1, 2, 3 };
+	for (int ii = 0; ii < 4; ii++) {
+		UM.addVert(coords[ii]);
+	}
+	for (int ii = 0; ii < 4; ii++) {
+		UM.addBdryTri(triVerts[ii]);
+	}
+	UM.addTet(tetVerts);
+	makeLengthScaleUniform(&UM);
+
+	resetInstrumentation();
+	enableInstrumentation(true);
+	if (!enableHardwareCounters(true)) {
+		// Not an error; lots of containers and VMs don't allow perf events.
+		BOOST_TEST_MESSAGE("Hardware counters unavailable; skipping.");
+		enableInstrumentation(false);
+		return;
+	}
+	UMesh UMOut(UM, 10);
+	enableHardwareCounters(false);
+	enableInstrumentation(false);
+	BOOST_CHECK_GT(getHardwareCount(eTimeRefine, eHWCycles), 0);
+	BOOST_CHECK_GT(getHardwareCount(eTimeRefine, eHWInstructions), 0);
+	// Nested phases never count more than the phase around them.
+	BOOST_CHECK_LE(getHardwareCount(eTimeTetLoop, eHWInstructions),
+								 getHardwareCount(eTimeRefine, eHWInstructions));
+	// Too fine-grained to be sampled.
+	BOOST_CHECK_EQUAL(getHardwareCount(eTimeMapping, eHWCycles), 0);
+	BOOST_CHECK_EQUAL(getHardwareCount(eTimeCells, eHWCycles), 0);
+	BOOST_CHECK_EQUAL(getHardwareCount(eTimeEdges, eHWCycles), 0);
+	resetInstrumentation();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 #endif // DO_SUBDIVISION_TESTS